@@ -24,6 +24,9 @@
 //
 #ifndef LLG_H_
 #define LLG_H_
+
+#include <cmath>
+#include <vector>
 /// Header file for LLG namespace
 namespace LLG_arrays{
 	
@@ -49,5 +52,40 @@ namespace LLG_arrays{
 
 	extern bool LLG_set;
 
+}
+
+//==========================================================
+// Inline functions for rotation based (Depondt) integrator
+//==========================================================
+namespace LLG_rotation{
+
+	/// Calculates rotation vector Omega for which the LLG equation
+	/// dS/dt = a S x H + b S x (S x H) is written dS/dt = Omega x S
+	inline void rotation_vector(const double S[3], const double H[3], const double a, const double b, double Omega[3]){
+		const double SxH[3] = { S[1]*H[2]-S[2]*H[1], S[2]*H[0]-S[0]*H[2], S[0]*H[1]-S[1]*H[0] };
+		Omega[0] = -(a*H[0] + b*SxH[0]);
+		Omega[1] = -(a*H[1] + b*SxH[1]);
+		Omega[2] = -(a*H[2] + b*SxH[2]);
+	}
+
+	/// Rotates spin S by angle |Omega| dt about Omega (Rodrigues formula),
+	/// which preserves the spin length exactly
+	inline void rotate(const double S[3], const double Omega[3], const double dt, double S_new[3]){
+		const double mod_Omega = sqrt(Omega[0]*Omega[0] + Omega[1]*Omega[1] + Omega[2]*Omega[2]);
+		if(mod_Omega*dt < 1.0e-300){
+			S_new[0] = S[0]; S_new[1] = S[1]; S_new[2] = S[2];
+			return;
+		}
+		const double n[3] = { Omega[0]/mod_Omega, Omega[1]/mod_Omega, Omega[2]/mod_Omega };
+		const double theta = mod_Omega*dt;
+		const double cos_theta = cos(theta);
+		const double sin_theta = sin(theta);
+		const double nxS[3] = { n[1]*S[2]-n[2]*S[1], n[2]*S[0]-n[0]*S[2], n[0]*S[1]-n[1]*S[0] };
+		const double ndotS_1mcos = (n[0]*S[0] + n[1]*S[1] + n[2]*S[2])*(1.0 - cos_theta);
+		S_new[0] = S[0]*cos_theta + nxS[0]*sin_theta + n[0]*ndotS_1mcos;
+		S_new[1] = S[1]*cos_theta + nxS[1]*sin_theta + n[1]*ndotS_1mcos;
+		S_new[2] = S[2]*cos_theta + nxS[2]*sin_theta + n[2]*ndotS_1mcos;
+	}
+
 }
 #endif /*LLG_H_*/
@@ -47,6 +47,7 @@
 ///	Revision:	  ---
 ///=====================================================================================
 ///
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <cmath>
@@ -192,6 +193,11 @@ namespace create{
 	// Variable for total number of atoms that are not filler
 	extern int num_total_atoms_non_filler;
 
+   // Variables for persistent on-disk structure cache
+   extern bool structure_cache;                   // flag to enable reading/writing of structure cache
+   extern std::string structure_cache_file_name;  // name of structure cache file
+   extern uint64_t structure_hash;                // hash of structure-relevant input parameters
+
 
 	// Functions
    void initialize();
@@ -200,6 +206,7 @@ namespace create{
    bool match_input_parameter(std::string const key, std::string const word, std::string const value, std::string const unit, int const line);
 	double get_material_height_min(const int material);
 	double get_material_height_max(const int material);
+   void hash_input_line(std::string const key, std::string const word, std::string const value, std::string const unit, const int super_index, const int sub_index);
 
 
 } // end of namespace create
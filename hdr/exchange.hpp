@@ -77,8 +77,8 @@ namespace exchange{
    //-----------------------------------------------------------------------------
    // Function to initialise exchange module
    //-----------------------------------------------------------------------------
-   void initialize(std::vector<std::vector <neighbours::neighbour_t> >& bilinear,
-                   std::vector<std::vector <neighbours::neighbour_t> >& biquadratic);
+   void initialize(neighbours::list_t& bilinear,
+                   neighbours::list_t& biquadratic);
 
    //-----------------------------------------------------------------------------
    // Functions to set exchange type isotropic, vectorial or tensorial
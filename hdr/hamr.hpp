@@ -32,6 +32,8 @@ namespace hamr{
                    const std::vector<double>& atom_coords_y,
                    const std::vector<double>& atom_coords_z,
                    const std::vector<int>& atom_type_array,
+                   const std::vector<int>& atom_grain_array,
+                   const int num_grains,
                    const int num_local_atoms);
 
    //-----------------------------------------------------------------------------
@@ -76,6 +76,12 @@ namespace montecarlo{
 
    extern algorithm_t algorithm; // Selected algorithm for Monte Carlo simulations
 
+   //---------------------------------------------------------------------------
+   // Energy changes of accepted moves for incremental energy statistics
+   //---------------------------------------------------------------------------
+   extern bool incremental_energy; // flag to update energy statistics from accepted moves
+   bool get_energy_change(std::vector<double>& delta_energy);
+
 
    //---------------------------------------------------------------------------
    // CMC namespace; must be given external access to be initialised by
@@ -140,6 +146,9 @@ namespace montecarlo{
       extern bool masked_cmc;         // determine if generic masked constraint is required
       extern bool constrain_by_grain; // constrains by grain rather than globally
 
+      extern int num_tasks;  // number of independent tasks sharing constraint angle points
+      extern int task_index; // index of this task in ensemble (0 to num_tasks-1)
+
    	extern int active_material; /// material in current hybrid loop
 
    	extern std::vector<std::vector< int > > atom_list;
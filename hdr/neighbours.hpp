@@ -14,7 +14,9 @@
 #define NEIGHBOURS_H_
 
 // C++ standard library headers
+#include <cstdint>
 #include <string>
+#include <vector>
 
 // Vampire headers
 #include "create_atoms_class.hpp"
@@ -42,14 +44,56 @@ namespace neighbours{
 
 	};
 
+   //-----------------------------------------------------------------------------
+   // Lightweight view of the neighbours of a single atom in a neighbour list
+   //-----------------------------------------------------------------------------
+   class row_t{
+   private:
+
+      neighbours::neighbour_t* first; // pointer to first neighbour of atom
+      uint64_t num;                   // number of neighbours of atom
+
+   public:
+
+      row_t(neighbours::neighbour_t* f, const uint64_t n): first(f), num(n){}
+
+      // number of neighbours for atom
+      inline uint64_t size() const { return num; }
+
+      // access neighbour nn of atom
+      inline neighbours::neighbour_t& operator[](const uint64_t nn) const { return first[nn]; }
+
+   };
+
    //-----------------------------------------------------------------------------
    // Simple class of neighbour list definining a set of interactions
+   //
+   // Neighbours are stored in compressed sparse row (CSR) form, where the
+   // neighbours of atom i are stored contiguously in the range
+   //
+   //             list[ start_index[i] ] ... list[ start_index[i+1] - 1 ]
+   //
+   // Individual atoms are accessed as list_t[atom][nn] in the same way as a
+   // 2D array.
    //-----------------------------------------------------------------------------
    class list_t{
    public:
 
-      // list of neighbours in terms of atom IDs
-      std::vector<std::vector <neighbours::neighbour_t> > list;
+      // index of first neighbour for each atom (num_atoms + 1 entries)
+      std::vector<uint64_t> start_index;
+
+      // packed list of neighbours in terms of atom IDs
+      std::vector<neighbours::neighbour_t> list;
+
+      // access neighbours of atom
+      inline row_t operator[](const uint64_t atom){
+         return row_t(list.data() + start_index[atom], start_index[atom+1] - start_index[atom]);
+      }
+
+      // number of atoms in neighbour list
+      inline uint64_t num_atoms() const {
+         return start_index.size() > 0 ? start_index.size() - 1 : 0;
+      }
 
       // generate neighbour list from interaction template and list of atoms
       void generate(std::vector<cs::catom_t>& atoms,
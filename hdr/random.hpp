@@ -24,6 +24,7 @@
 //
 #ifndef RANDOM_H_
 #define RANDOM_H_
+#include <random>
 #include "mtrand.hpp"
 namespace mtrandom
 //==========================================================
@@ -33,6 +34,7 @@ namespace mtrandom
 	extern MTRand grnd; /// single sequence of random numbers
 	extern double gaussian();
 	extern double gaussianc(MTRand&);
+	extern double gaussianc(std::mt19937&); /// independent sequence (MTRand state is shared by all instances)
 	
 	extern int voronoi_seed;
 	extern int integration_seed;
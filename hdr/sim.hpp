@@ -73,7 +73,8 @@ namespace sim{
 
 	// enumerated list for integrators
 	enum integrator_t{ llg_heun = 0, monte_carlo = 1, llg_midpoint = 2,
-							 cmc = 3, hybrid_cmc = 4, llg_quantum = 5};
+							 cmc = 3, hybrid_cmc = 4, llg_quantum = 5, minimiser = 6, llg_adaptive = 7, llg_depondt = 8};
+	enum minimiser_t{ fire = 0, conjugate_gradient = 1 };
     //定义不同的积分器类型
 
 	extern std::ofstream mag_file;
@@ -164,7 +165,13 @@ namespace sim{
 	//用于控制系统和哈密顿量的模拟选项
 
 	extern integrator_t integrator; // variable to specify integrator
+	extern minimiser_t minimiser_algorithm; // algorithm used for zero temperature energy minimisation
+	extern double minimiser_torque_tolerance; // maximum torque on any spin for minimisation to be converged (T)
+	extern double adaptive_tolerance; // maximum local error in spin direction per adaptive time step
+	extern double adaptive_min_dt_SI; // minimum adaptive time step (s)
+	extern double adaptive_max_dt_SI; // maximum adaptive time step (s)
 	extern int program;
+	extern std::vector<int> active_atom_ranges; // list of (start,end) ranges of atoms integrated with llg-heun (all atoms if empty)
 
 
     // Local system variables
@@ -191,6 +198,8 @@ namespace sim{
 	extern int run();
 	extern int initialise();
 	extern int integrate(uint64_t);
+	extern uint64_t minimise(const uint64_t max_iterations);
+	extern uint64_t minimise(const uint64_t max_iterations, const std::vector<bool>& fixed);
 	//初始化、参数匹配、主控运行、积分等
 
 	// Legacy integrators
@@ -205,6 +214,8 @@ namespace sim{
 	extern int LLG_Midpoint();
 	extern int LLG_Midpoint_mpi();
 	extern int LLG_Midpoint_cuda();
+	extern int LLG_Depondt();
+	extern int LLG_Depondt_mpi();
 
 
 	// Integrator initialisers
@@ -213,6 +224,8 @@ namespace sim{
 
 	// Field and energy functions
     extern double calculate_spin_energy(const int atom);
+    extern double calculate_spin_energy_difference(const int atom, const double Sold[3], const double Snew[3]);
+    extern double calculate_spin_energy_difference(const int atom, const double Sold[3], const double Snew[3], double components[4]);
     extern double spin_applied_field_energy(const double, const double, const double);
     extern double spin_magnetostatic_energy(const int, const double, const double, const double);
 
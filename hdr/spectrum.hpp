@@ -0,0 +1,86 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) Richard F L Evans 2022. All rights reserved.
+//
+//   Email: richard.evans@york.ac.uk
+//
+//------------------------------------------------------------------------------
+//
+
+#ifndef SPECTRUM_H_
+#define SPECTRUM_H_
+
+// C++ standard library headers
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Vampire headers
+#include "spectrum.hpp"
+
+//--------------------------------------------------------------------------------
+// Namespace for variables and functions for spectrum module
+//
+//   Calculates power spectra and dynamic susceptibility of the system, material
+//   and cell magnetisation during a simulation, avoiding the need to write the
+//   full time series (or spin configurations) to disk. Each sampled signal is
+//   accumulated into a bank of windowed discrete Fourier transforms at user
+//   specified frequencies, with a cost per sample proportional to the number
+//   of frequencies times the number of signals.
+//
+//   The dynamic structure factor S(q,w) is calculated in the same way from
+//   projections of the spins onto a list of q-points, with a cost per sample
+//   proportional to the number of atoms times the number of q-points.
+//
+//--------------------------------------------------------------------------------
+namespace spectrum{
+
+   //-----------------------------------------------------------------------------
+   // Function to initialise spectrum module
+   //-----------------------------------------------------------------------------
+   void initialize(const int num_materials,    // number of materials
+                   const int num_cells,        // number of macrocells
+                   const uint64_t num_atoms,   // number of local atoms
+                   const std::vector<int>& atoms_type_array, // material types of atoms
+                   const std::vector<int>& atoms_cell_array, // macrocell of atoms
+                   const std::vector<double>& atoms_m_spin_array, // moments of atoms (muB)
+                   const std::vector<bool>& is_magnetic_material, // array of size num_mat to state whether material is magnetic (true) or not (false)
+                   const std::vector<double>& cell_position_array, // positions and moments of cells (x,y,z,m)
+                   const std::vector<double>& atoms_x_coord_array, // x-coordinates of atoms (A)
+                   const std::vector<double>& atoms_y_coord_array, // y-coordinates of atoms (A)
+                   const std::vector<double>& atoms_z_coord_array, // z-coordinates of atoms (A)
+                   const double unit_cell_size_x, // unit cell size in x (A)
+                   const double unit_cell_size_y, // unit cell size in y (A)
+                   const double unit_cell_size_z  // unit cell size in z (A)
+   );
+
+   //-----------------------------------------------------------------------------
+   // Function to start accumulation of spectra for a time series
+   //-----------------------------------------------------------------------------
+   void start(const uint64_t num_samples,     // expected number of samples (for window function)
+              const double sample_interval); // time between samples (s)
+
+   //-----------------------------------------------------------------------------
+   // Function to add current magnetisation to spectra
+   //-----------------------------------------------------------------------------
+   void update(const std::vector<double>& atoms_x_spin_array, // x-spin vector of atoms
+               const std::vector<double>& atoms_y_spin_array, // y-spin vector of atoms
+               const std::vector<double>& atoms_z_spin_array, // z-spin-vector of atoms
+               const double driving_field); // instantaneous driving field strength (T)
+
+   //-----------------------------------------------------------------------------
+   // Function to write spectra to disk
+   //-----------------------------------------------------------------------------
+   void output();
+
+   //---------------------------------------------------------------------------
+   // Function to process input file parameters for spectrum module
+   //---------------------------------------------------------------------------
+   bool match_input_parameter(std::string const key, std::string const word, std::string const value, std::string const unit, int const line);
+
+} // end of spectrum namespace
+
+#endif //SPECTRUM_H_
@@ -67,6 +67,11 @@ namespace st{
                   const std::vector<int>& atom_type_array,
                   const int num_local_atoms);
 
+   //-----------------------------------------------------------------------------
+   // Function to check if spin torque calculation is enabled
+   //-----------------------------------------------------------------------------
+   bool is_enabled();
+
    //-----------------------------------------------------------------------------
    // Function to copy spin torque fields to external field array
    //-----------------------------------------------------------------------------
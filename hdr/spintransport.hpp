@@ -80,6 +80,11 @@ namespace spin_transport{
    //---------------------------------------------------------------------------
    double get_voltage();
 
+   //---------------------------------------------------------------------------
+   // Function to check if spin transport calculation is enabled
+   //---------------------------------------------------------------------------
+   bool is_enabled();
+
 } // end of spin_transport namespace
 
 #endif //SPINTRANSPORT_H_
@@ -53,6 +53,10 @@ namespace stats
 	// Function to reset average statistics counters
    void reset();
 
+   // Function to restrict magnetization updates to ranges of atoms (start,end), caching contributions
+   // of all other (frozen) atoms. An empty list updates all atoms.
+   void set_active_atom_ranges(const std::vector<int>& ranges);
+
 	// Statistics control flags (to be moved internally when long-awaited refactoring of vio is done)
 	extern bool calculate_system_energy;
 	extern bool calculate_grain_energy;
@@ -93,12 +97,46 @@ namespace stats
         class binder_cumulant_statistic_t;
 
 	class standard_deviation_statistic_t;
+   class energy_statistic_t;
+
+   namespace internal{
+
+      extern bool exact_energy_required;
+      extern int num_incremental_energy_updates;
+      extern double last_energy_temperature;
+      extern double last_energy_applied_field[4];
+
+      // energy statistics calculated in full and incrementally in the current update
+      extern std::vector<energy_statistic_t*> exact_energy_statistics;
+      extern std::vector<energy_statistic_t*> incremental_energy_statistics;
+      extern std::vector<double> energy_change;
+
+      // ranges of atoms updated in magnetization statistics and counter of changes to ranges
+      extern std::vector<int> active_atom_ranges;
+      extern int active_atom_ranges_id;
+
+      // packed reduction of statistics over all processors
+      void add_to_reduction(std::vector<double>& data, const int size);
+      void start_reduction();
+      void complete_reduction();
+      void finalize_update();
+
+      void sum_energies(const std::vector<energy_statistic_t*>& statistics,
+                        const std::vector<double>& sx, const std::vector<double>& sy, const std::vector<double>& sz,
+                        const std::vector<double>& mm, const std::vector<int>& mat, const double temperature);
+      void finalize_energies(const std::vector<energy_statistic_t*>& statistics);
+   }
+
    //----------------------------------
    // Energy class definition
    //----------------------------------
    class energy_statistic_t{
 
       friend class specific_heat_statistic_t;
+      friend void internal::sum_energies(const std::vector<energy_statistic_t*>& statistics,
+                                         const std::vector<double>& sx, const std::vector<double>& sy, const std::vector<double>& sz,
+                                         const std::vector<double>& mm, const std::vector<int>& mat, const double temperature);
+      friend void internal::finalize_energies(const std::vector<energy_statistic_t*>& statistics);
 
    public:
       energy_statistic_t (std::string n):initialized(false){
@@ -107,8 +145,8 @@ namespace stats
       bool is_initialized();
       void set_mask(const int in_mask_size, const std::vector<int> in_mask);
       void get_mask(std::vector<int>& out_mask, std::vector<double>& out_normalisation);
-      void calculate(const std::vector<double>& sx, const std::vector<double>& sy, const std::vector<double>& sz,
-                     const std::vector<double>& mm, const std::vector<int>& mat, const double temperature);
+      bool has_material_mask(const int num_materials, const std::vector<int>& mat);
+      void add_energy_change(const std::vector<double>& delta_energy);
 
       void reset_averages();
 
@@ -152,6 +190,8 @@ namespace stats
       std::vector<int> zero_list;
       std::vector<double> normalisation;
 
+      std::vector<int> material_mask; // mask id of each material for incremental updates (-1 if not unique)
+
       std::string name;
 
    };
@@ -165,13 +205,14 @@ namespace stats
       friend class standard_deviation_statistic_t;
       friend class binder_cumulant_statistic_t;
       public:
-         magnetization_statistic_t (std::string n):initialized(false){
+         magnetization_statistic_t (std::string n):initialized(false),frozen_ranges_id(-1){
            name = n;
          };
          bool is_initialized();
          void set_mask(const int mask_size, std::vector<int> inmask, const std::vector<double>& mm);
          void get_mask(std::vector<int>& out_mask, std::vector<double>& out_saturation);
-         void calculate_magnetization(const std::vector<double>& sx, const std::vector<double>& sy, const std::vector<double>& sz, const std::vector<double>& mm);
+         void sum_magnetization(const std::vector<double>& sx, const std::vector<double>& sy, const std::vector<double>& sz, const std::vector<double>& mm);
+         void finalize_magnetization();
          void set_magnetization(std::vector<double>& magnetization, std::vector<double>& mean_magnetization, long counter);
          void reset_magnetization_averages();
          const std::vector<double>& get_magnetization();
@@ -198,6 +239,8 @@ namespace stats
          std::vector<int> zero_list;
          std::vector<double> saturation;
          std::string name;
+         int frozen_ranges_id; // active atom ranges for which frozen magnetization was calculated
+         std::vector<double> frozen_magnetization; // magnetization of atoms outside active atom ranges
 
    };
 
@@ -213,10 +256,11 @@ namespace stats
          bool is_initialized();
          void set_mask(const int mask_size, std::vector<int> inmask, const std::vector<double>& mm);
          void get_mask(std::vector<int>& out_mask);
-         void calculate_torque(const std::vector<double>& sx, const std::vector<double>& sy, const std::vector<double>& sz,
-										 const std::vector<double>& bxs, const std::vector<double>& bys, const std::vector<double>& bzs,
-										 const std::vector<double>& bxe, const std::vector<double>& bye, const std::vector<double>& bze,
-										 const std::vector<double>& mm);
+         void sum_torque(const std::vector<double>& sx, const std::vector<double>& sy, const std::vector<double>& sz,
+								 const std::vector<double>& bxs, const std::vector<double>& bys, const std::vector<double>& bzs,
+								 const std::vector<double>& bxe, const std::vector<double>& bye, const std::vector<double>& bze,
+								 const std::vector<double>& mm);
+         void finalize_torque();
          void set_torque(std::vector<double>& torque, std::vector<double>& mean_torque, long counter);
          void reset_torque_averages();
          const std::vector<double>& get_torque();
@@ -249,10 +293,11 @@ namespace stats
 			bool is_initialized();
       	void set_mask(const int mask_size, std::vector<int> inmask, const std::vector<double>& mm);
 			void get_mask(std::vector<int>& out_mask);
-			void calculate_spin_temp(const std::vector<double>& sx, const std::vector<double>& sy, const std::vector<double>& sz,
-									 		 const std::vector<double>& bxs, const std::vector<double>& bys, const std::vector<double>& bzs,
-									 	    const std::vector<double>& bxe, const std::vector<double>& bye, const std::vector<double>& bze,
-									 	 	 const std::vector<double>& mm);
+			void sum_spin_temp(const std::vector<double>& sx, const std::vector<double>& sy, const std::vector<double>& sz,
+									 const std::vector<double>& bxs, const std::vector<double>& bys, const std::vector<double>& bzs,
+									 const std::vector<double>& bxe, const std::vector<double>& bye, const std::vector<double>& bze,
+									 const std::vector<double>& mm);
+			void finalize_spin_temp();
 
 			void set_spin_temp(std::vector<double>& spin_temp, std::vector<double>& mean_spin_temp, long counter);
          void reset_spin_temp_averages();
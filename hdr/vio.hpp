@@ -150,6 +150,11 @@ namespace vout{
     
     extern std::string output_file_name;
 
+    // destinations of column values and names collected directly from the
+    // output functions for binary files (NULL when writing text)
+    extern std::vector<double>* column_values;
+    extern std::vector<std::string>* column_names;
+
 //class that creates an object which acts like an output
 //stream but delivers fixed width output separated by
 //tabs
@@ -171,6 +176,19 @@ class fixed_width_output{
   private:
     int width; // the width of each output
     std::ostringstream& stream_obj; // the initial stream object
+
+    // collects column names and numerical values for binary output
+    void collect(const std::string& name){
+      if(column_names != NULL) column_names->push_back(name);
+    }
+    void collect(const char* name){
+      collect(std::string(name));
+    }
+    template<typename T>
+    void collect(const T& value){
+      if(column_values != NULL) column_values->push_back(double(value));
+    }
+
   public:
     //constructor, calls constructors of width and stream_obj
     //                                          :-> member initialization list
@@ -181,6 +199,11 @@ class fixed_width_output{
     // defines a function which returns a pointer to the fixed... object
     // takes one of type T as input.
     fixed_width_output& operator<<(const T& output){
+      // values are collected without formatting when writing binary files
+      if(column_values != NULL || column_names != NULL){
+        collect(output);
+        return *this;
+      }
       //sends the formatted output to a stream_obj
       stream_obj <<std::left<<std::setw(width) << output <<"\t";
 
@@ -11,6 +11,11 @@
 
 // System headers
 #include <chrono>
+#include <cstdint>
+#include <string>
+#ifndef WIN_COMPILE
+   #include <sys/resource.h>
+#endif
 
 // Program headers
 
@@ -46,6 +51,94 @@ namespace vutil{
       }
    };
 
+   //------------------------------------------------------------------------
+   // Function to return peak resident memory usage of process in MB
+   //------------------------------------------------------------------------
+   inline double peak_memory_usage(){
+      #ifndef WIN_COMPILE
+         struct rusage usage;
+         if(getrusage(RUSAGE_SELF, &usage) != 0) return 0.0;
+         #ifdef __APPLE__
+            return double(usage.ru_maxrss)/1.0e6; // bytes on macOS
+         #else
+            return double(usage.ru_maxrss)/1.0e3; // kilobytes on Linux
+         #endif
+      #else
+         return 0.0;
+      #endif
+   }
+
+   //------------------------------------------------------------------------
+   // Simple incremental 64-bit FNV-1a hash for generating cache keys
+   //------------------------------------------------------------------------
+   class hash_t{
+
+   private:
+      uint64_t hash = 14695981039346656037ULL; // FNV offset basis
+
+   public:
+      // add raw bytes to the hash
+      void add(const void* data, const uint64_t bytes){
+         const unsigned char* c = static_cast<const unsigned char*>(data);
+         for(uint64_t i = 0; i < bytes; i++){
+            hash ^= uint64_t(c[i]);
+            hash *= 1099511628211ULL; // FNV prime
+         }
+      }
+
+      // add a string including a terminating separator
+      void add(const std::string& str){
+         add(str.data(), str.size());
+         const char separator = '\0';
+         add(&separator, 1);
+      }
+
+      // return the current hash value
+      uint64_t value() const{
+         return hash;
+      }
+
+   };
+
+   //------------------------------------------------------------------------
+   // Lightweight profiler accumulating time spent in main code sections.
+   // Timers only read the clock when profiling is enabled (sim:profile).
+   //------------------------------------------------------------------------
+   namespace profile{
+
+      // list of profiled code sections (times are inclusive)
+      enum section_t { integrate = 0, exchange, anisotropy, thermal, applied_field,
+                       dipole, cells, stats, config, halo_swap, num_sections };
+
+      extern bool enabled; // flag to enable profiling
+
+      // add time for single call of section
+      void add(const section_t section, const double time);
+
+      // output profile aggregated over all processors to file
+      void output(const double total_time);
+
+      // simple class timing enclosing scope for section
+      class scope_t{
+
+      private:
+         const section_t section;
+         std::chrono::high_resolution_clock::time_point start_time;
+
+      public:
+         scope_t(const section_t s): section(s){
+            if(enabled) start_time = std::chrono::high_resolution_clock::now();
+         }
+
+         ~scope_t(){
+            if(enabled) add(section, 1.e-9*double(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                                  std::chrono::high_resolution_clock::now() - start_time).count()));
+         }
+
+      };
+
+   } // end of namespace profile
+
 } // end of namespace vutil
 
 #endif //VUTIL_H_
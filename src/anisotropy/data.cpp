@@ -118,6 +118,11 @@ namespace anisotropy{
       // arrays for storing unrolled parameters for lattice anisotropy
       std::vector<double> klattice(0); // anisotropy constant
       std::vector<double> klattice_array(0); // array for unrolled anisotropy including temperature dependence
+      double klattice_temperature = -1.0; // temperature at which klattice_array was last calculated
+
+      // fused anisotropy plan
+      std::vector<plan_t> plan(0); // list of active anisotropy terms for each material
+      std::vector<atom_range_t> plan_atom_ranges(0); // ranges of atoms with anisotropy terms
 
    } // end of internal namespace
 
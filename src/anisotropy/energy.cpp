@@ -33,26 +33,12 @@ namespace anisotropy{
       // variable to add energies
       double energy = 0.0;
 
-      // if not enabled then do nothing
-      if(internal::enable_uniaxial_second_order)         energy += internal::uniaxial_second_order_energy(atom, mat, sx, sy, sz);
-      if(internal::enable_uniaxial_fourth_order)         energy += internal::uniaxial_fourth_order_energy(atom, mat, sx, sy, sz);
-      if(internal::enable_biaxial_fourth_order_simple)   energy += internal::biaxial_fourth_order_simple_energy(atom, mat, sx, sy, sz);
-      if(internal::enable_uniaxial_sixth_order)          energy += internal::uniaxial_sixth_order_energy (atom, mat, sx, sy, sz);
-
-      if(internal::enable_cubic_fourth_order)            energy += internal::cubic_fourth_order_energy(atom, mat, sx, sy, sz);
-      if(internal::enable_cubic_fourth_order_rotation)   energy += internal::cubic_fourth_order_rotation_energy(atom, mat, sx, sy, sz);
-      if(internal::enable_cubic_sixth_order)             energy += internal::cubic_sixth_order_energy (atom, mat, sx, sy, sz);
-
-      if(internal::enable_fourth_order_rotational)       energy += internal::rotational_fourth_order_energy_fixed_basis(atom, mat, sx, sy, sz);
+      // all uniaxial, triaxial, rotational and cubic terms
+      energy += internal::plan_energy(mat, sx, sy, sz);
 
       if(internal::enable_neel_anisotropy)               energy += internal::neel_energy(atom, mat, sx, sy, sz);
       if(internal::enable_lattice_anisotropy)            energy += internal::lattice_energy(atom, mat, sx, sy, sz, temperature);
 
-      if(internal::enable_triaxial_anisotropy)           energy += internal::triaxial_second_order_energy_fixed_basis(atom, mat, sx, sy, sz);
-      if(internal::enable_triaxial_anisotropy_rotated)   energy += internal::triaxial_second_order_energy(atom, mat, sx, sy, sz);
-      if(internal::enable_triaxial_fourth_order)         energy += internal::triaxial_fourth_order_energy_fixed_basis(atom, mat, sx, sy, sz);
-      if(internal::enable_triaxial_fourth_order_rotated) energy += internal::triaxial_fourth_order_energy(atom, mat, sx, sy, sz);
-
       return energy;
 
    }
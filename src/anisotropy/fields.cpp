@@ -19,6 +19,7 @@
 #include "errors.hpp"
 #include "units.hpp"
 #include "vio.hpp"
+#include "vutil.hpp"
 
 // anisotropy module headers
 #include "internal.hpp"
@@ -39,41 +40,11 @@ namespace anisotropy{
                const int end_index,
                const double temperature){
 
-      // second order uniaxial anisotropy
-      internal::uniaxial_second_order_fields(spin_array_x, spin_array_y, spin_array_z, type_array, field_array_x, field_array_y, field_array_z, start_index, end_index);
+      // time anisotropy field calculation
+      vutil::profile::scope_t profile(vutil::profile::anisotropy);
 
-      // fourth order uniaxial anisotropy
-      internal::uniaxial_fourth_order_fields(spin_array_x, spin_array_y, spin_array_z, type_array, field_array_x, field_array_y, field_array_z, start_index, end_index);
-
-      // fourth order biaxial anisotropy (simple version)
-      internal::biaxial_fourth_order_simple_fields(spin_array_x, spin_array_y, spin_array_z, type_array, field_array_x, field_array_y, field_array_z, start_index, end_index);
-
-      //triaxial anisotropy variable basis
-      internal::triaxial_second_order_fields(spin_array_x, spin_array_y, spin_array_z, type_array, field_array_x, field_array_y, field_array_z, start_index, end_index);
-
-      //triaxial anisotropy fixed basis
-      internal::triaxial_second_order_fields_fixed_basis(spin_array_x, spin_array_y, spin_array_z, type_array, field_array_x, field_array_y, field_array_z, start_index, end_index);
-
-      // triaxial fourth order anisotropy
-      internal::triaxial_fourth_order_fields(spin_array_x, spin_array_y, spin_array_z, type_array, field_array_x, field_array_y, field_array_z, start_index, end_index);
-
-      // triaxial fourth order anisotropy fixed basis
-      internal::triaxial_fourth_order_fields_fixed_basis(spin_array_x, spin_array_y, spin_array_z, type_array, field_array_x, field_array_y, field_array_z, start_index, end_index);
-
-      // sixth order uniaxial anisotropy
-      internal::uniaxial_sixth_order_fields(spin_array_x, spin_array_y, spin_array_z, type_array, field_array_x, field_array_y, field_array_z, start_index, end_index);
-
-      // fourth order rotational anisotropy
-      internal::rotational_fourth_order_fields_fixed_basis(spin_array_x, spin_array_y, spin_array_z, type_array, field_array_x, field_array_y, field_array_z, start_index, end_index);
-
-      // fourth order cubic anisotropy
-      internal::cubic_fourth_order_fields(spin_array_x, spin_array_y, spin_array_z, type_array, field_array_x, field_array_y, field_array_z, start_index, end_index);
-
-      // fourth order cubic anisotropy (rotated basis)
-      internal::cubic_fourth_order_rotation_fields(spin_array_x, spin_array_y, spin_array_z, type_array, field_array_x, field_array_y, field_array_z, start_index, end_index);
-
-      // sixth order cubic anisotropy
-      internal::cubic_sixth_order_fields(spin_array_x, spin_array_y, spin_array_z, type_array, field_array_x, field_array_y, field_array_z, start_index, end_index);
+      // all uniaxial, triaxial, rotational and cubic terms in a single pass
+      internal::plan_fields(spin_array_x, spin_array_y, spin_array_z, field_array_x, field_array_y, field_array_z, start_index, end_index);
 
       // Neel anisotropy
       internal::neel_fields(spin_array_x, spin_array_y, spin_array_z, type_array, field_array_x, field_array_y, field_array_z, start_index, end_index);
@@ -414,6 +414,7 @@ namespace anisotropy{
          // arrays for storing unrolled parameters for lattice anisotropy
          internal::klattice.resize(num_materials);
          internal::klattice_array.resize(num_materials); // anisoptropy constant
+         internal::klattice_temperature = -1.0; // force calculation of constants at first use
 
          // loop over all materials and set up lattice anisotropy constants
          for(int m = 0; m < num_materials; m++){
@@ -431,6 +432,11 @@ namespace anisotropy{
 
       }
 
+      //---------------------------------------------------------------------
+      // compile active anisotropy terms into a plan for each material
+      //---------------------------------------------------------------------
+      internal::initialize_plan(num_atoms, atom_material_array);
+
       //---------------------------------------------------------------------
       // set flag after initialization
       //---------------------------------------------------------------------
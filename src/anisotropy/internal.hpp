@@ -74,6 +74,52 @@ namespace anisotropy{
          double z;
       };
 
+      //-----------------------------------------------------------------------------
+      // Types of anisotropy term evaluated in the fused per-material plan, listed
+      // in order of evaluation
+      //-----------------------------------------------------------------------------
+      enum term_type_t {
+         uniaxial_second_order_term = 0,
+         uniaxial_fourth_order_term,
+         biaxial_fourth_order_simple_term,
+         triaxial_second_order_term,
+         triaxial_second_order_fixed_basis_term,
+         triaxial_fourth_order_term,
+         triaxial_fourth_order_fixed_basis_term,
+         uniaxial_sixth_order_term,
+         rotational_fourth_order_term,
+         cubic_fourth_order_term,
+         cubic_fourth_order_rotation_term,
+         cubic_sixth_order_term
+      };
+
+      //-----------------------------------------------------------------------------
+      // Single anisotropy term of a material with precomputed constants and axes
+      //-----------------------------------------------------------------------------
+      struct term_t{
+         term_type_t type; // type of anisotropy term
+         double k[3]; // anisotropy constants (T)
+         double h[3]; // prefactors of field (T)
+         evec_t e[3]; // unit vectors defining axes
+      };
+
+      //-----------------------------------------------------------------------------
+      // List of active anisotropy terms for a material, evaluated in a single pass
+      //-----------------------------------------------------------------------------
+      struct plan_t{
+         std::vector<term_t> terms; // list of active terms
+         int key; // identifier of term combination for specialised kernels (-1 for generic)
+      };
+
+      //-----------------------------------------------------------------------------
+      // Contiguous range of atoms [start, end) of a single material with anisotropy
+      //-----------------------------------------------------------------------------
+      struct atom_range_t{
+         int start;
+         int end;
+         int mat;
+      };
+
       //-----------------------------------------------------------------------------
       // materials class for storing anisotropy material parameters
       //-----------------------------------------------------------------------------
@@ -263,6 +309,11 @@ namespace anisotropy{
       // arrays for storing unrolled parameters for lattice anisotropy
       extern std::vector< double > klattice; // anisotropy constant
       extern std::vector< double > klattice_array; // array for unrolled anisotropy including temperature dependence
+      extern double klattice_temperature; // temperature at which klattice_array was last calculated
+
+      // fused anisotropy plan
+      extern std::vector<plan_t> plan; // list of active anisotropy terms for each material
+      extern std::vector<atom_range_t> plan_atom_ranges; // ranges of atoms with anisotropy terms
 
       //-------------------------------------------------------------------------
       // internal function declarations
@@ -490,9 +541,23 @@ namespace anisotropy{
                           const double sz);
 
       double lattice_energy(const int atom, const int mat, const double sx, const double sy, const double sz, const double temperature);
+      void update_lattice_anisotropy(const double temperature);
+
+      void initialize_plan(const unsigned int num_atoms, const std::vector<int>& atom_material_array);
+
+      void plan_fields(const std::vector<double>& spin_array_x,
+                       const std::vector<double>& spin_array_y,
+                       const std::vector<double>& spin_array_z,
+                       std::vector<double>& field_array_x,
+                       std::vector<double>& field_array_y,
+                       std::vector<double>& field_array_z,
+                       const int start_index,
+                       const int end_index);
+
+      double plan_energy(const int mat, const double sx, const double sy, const double sz);
 
       void initialise_neel_anisotropy_tensor(std::vector <std::vector <bool> >& nearest_neighbour_interactions_list,
-                                             std::vector<std::vector <neighbours::neighbour_t> >& cneighbourlist);
+                                             neighbours::list_t& cneighbourlist);
 
    } // end of internal namespace
 
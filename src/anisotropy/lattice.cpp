@@ -50,10 +50,8 @@ namespace anisotropy{
          // if lattice anisotropy is not used, then do nothing
          if(!internal::enable_lattice_anisotropy) return;
 
-         // Precalculate material lattice anisotropy constants from current temperature
-         for(int imat=0; imat<mp::num_materials; imat++){
-            internal::klattice_array[imat] = 2.0 * internal::klattice[imat] * internal::mp[imat].lattice_anisotropy.get_lattice_anisotropy_constant(temperature);
-         }
+         // Update material lattice anisotropy constants if temperature has changed
+         internal::update_lattice_anisotropy(temperature);
 
          // Now calculate fields
          for(int atom = start_index; atom < end_index; atom++){
@@ -101,8 +99,9 @@ namespace anisotropy{
       //------------------------------------------------------
       double lattice_energy(const int atom, const int mat, const double sx, const double sy, const double sz, const double temperature){
 
-         // get lattice anisotropy constant at temperature
-         const double klatt = -1.0 * internal::klattice[mat] * internal::mp[mat].lattice_anisotropy.get_lattice_anisotropy_constant(temperature);
+         // get lattice anisotropy constant at temperature (klattice_array includes factor 2 for field)
+         internal::update_lattice_anisotropy(temperature);
+         const double klatt = -0.5 * internal::klattice_array[mat];
 
          // calculate s . e
          const double ex = internal::ku_vector[mat].x;
@@ -115,6 +114,26 @@ namespace anisotropy{
 
       }
 
+      //------------------------------------------------------
+      ///  Function to calculate temperature dependent lattice
+      ///  anisotropy constants for all materials. Constants are
+      ///  only recalculated when the temperature changes.
+      //------------------------------------------------------
+      void update_lattice_anisotropy(const double temperature){
+
+         // constants are already known at this temperature
+         if(temperature == internal::klattice_temperature) return;
+
+         for(unsigned int imat = 0; imat < internal::klattice_array.size(); imat++){
+            internal::klattice_array[imat] = 2.0 * internal::klattice[imat] * internal::mp[imat].lattice_anisotropy.get_lattice_anisotropy_constant(temperature);
+         }
+
+         internal::klattice_temperature = temperature;
+
+         return;
+
+      }
+
    } // end of internal namespace
 
 } // end of anisotropy namespace
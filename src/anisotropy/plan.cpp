@@ -0,0 +1,626 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) Sam Westmoreland and Richard Evans 2017. All rights reserved.
+//
+//   Email: richard.evans@york.ac.uk
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <algorithm>
+#include <vector>
+
+// Vampire headers
+#include "anisotropy.hpp"
+#include "vio.hpp"
+
+// anisotropy module headers
+#include "internal.hpp"
+
+namespace anisotropy{
+
+   namespace internal{
+
+      //------------------------------------------------------------------------
+      // Function to generate a unique key for combinations of up to three terms
+      //------------------------------------------------------------------------
+      constexpr int plan_key(const int a, const int b = -1, const int c = -1){
+         return (a + 1) + ((b + 1) << 4) + ((c + 1) << 8);
+      }
+
+      //------------------------------------------------------------------------
+      // Function to add field from a single anisotropy term. The type is a
+      // compile time constant in the specialised kernels so that the switch
+      // is resolved by the compiler. The expressions are identical to those
+      // in the separate kernels for each term.
+      //------------------------------------------------------------------------
+      inline void add_term_field(const int type, const term_t& t,
+                                 const double sx, const double sy, const double sz,
+                                 double& hx, double& hy, double& hz){
+
+         const double sixtyothirtyfive = 60.0/35.0;
+
+         switch(type){
+
+            case uniaxial_second_order_term : {
+               const double sdote = (sx*t.e[0].x + sy*t.e[0].y + sz*t.e[0].z);
+               const double k2 = t.h[0]*sdote;
+               hx += t.e[0].x*k2;
+               hy += t.e[0].y*k2;
+               hz += t.e[0].z*k2;
+               break;
+            }
+
+            case uniaxial_fourth_order_term : {
+               const double sdote  = (sx*t.e[0].x + sy*t.e[0].y + sz*t.e[0].z);
+               const double sdote3 = sdote*sdote*sdote;
+               const double k4 = t.h[0]*(4.0*sdote3 - sixtyothirtyfive*sdote);
+               hx += t.e[0].x*k4;
+               hy += t.e[0].y*k4;
+               hz += t.e[0].z*k4;
+               break;
+            }
+
+            case biaxial_fourth_order_simple_term : {
+               const double sdotu1 = (sx*t.e[0].x + sy*t.e[0].y + sz*t.e[0].z);
+               const double sdotu13 = sdotu1*sdotu1*sdotu1;
+               const double sdotu2 = (sx*t.e[1].x + sy*t.e[1].y + sz*t.e[1].z);
+               const double sdotu23 = sdotu2*sdotu2*sdotu2;
+               hx += t.h[0]*(t.e[0].x*sdotu13 + t.e[1].x*sdotu23);
+               hy += t.h[0]*(t.e[0].y*sdotu13 + t.e[1].y*sdotu23);
+               hz += t.h[0]*(t.e[0].z*sdotu13 + t.e[1].z*sdotu23);
+               break;
+            }
+
+            case triaxial_second_order_term : {
+               hx += 2.0*(t.k[0]*t.e[0].x*sx + t.k[1]*t.e[1].x*sx + t.k[2]*t.e[2].x*sx);
+               hy += 2.0*(t.k[0]*t.e[0].y*sy + t.k[1]*t.e[1].y*sy + t.k[2]*t.e[2].y*sy);
+               hz += 2.0*(t.k[0]*t.e[0].z*sz + t.k[1]*t.e[1].z*sz + t.k[2]*t.e[2].z*sz);
+               break;
+            }
+
+            case triaxial_second_order_fixed_basis_term : {
+               hx += t.h[0]*sx;
+               hy += t.h[1]*sy;
+               hz += t.h[2]*sz;
+               break;
+            }
+
+            case triaxial_fourth_order_term : {
+               const double sdoteA = t.e[0].x*sx + t.e[0].y*sy + t.e[0].z*sz;
+               const double sdoteB = t.e[1].x*sx + t.e[1].y*sy + t.e[1].z*sz;
+               const double sdoteC = t.e[2].x*sx + t.e[2].y*sy + t.e[2].z*sz;
+               const double sdoteA3 = sdoteA*sdoteA*sdoteA;
+               const double sdoteB3 = sdoteB*sdoteB*sdoteB;
+               const double sdoteC3 = sdoteC*sdoteC*sdoteC;
+               const double k4A = 4.0*sdoteA3 - sixtyothirtyfive*sdoteA;
+               const double k4B = 4.0*sdoteB3 - sixtyothirtyfive*sdoteB;
+               const double k4C = 4.0*sdoteC3 - sixtyothirtyfive*sdoteC;
+               hx += t.k[0]*t.e[0].x*k4A + t.k[1]*t.e[1].x*k4B + t.k[2]*t.e[2].x*k4C;
+               hy += t.k[0]*t.e[0].y*k4A + t.k[1]*t.e[1].y*k4B + t.k[2]*t.e[2].y*k4C;
+               hz += t.k[0]*t.e[0].z*k4A + t.k[1]*t.e[1].z*k4B + t.k[2]*t.e[2].z*k4C;
+               break;
+            }
+
+            case triaxial_fourth_order_fixed_basis_term : {
+               const double sx3 = sx*sx*sx;
+               const double sy3 = sy*sy*sy;
+               const double sz3 = sz*sz*sz;
+               hx += t.k[0]*(4.0*sx3 - sixtyothirtyfive*sx);
+               hy += t.k[1]*(4.0*sy3 - sixtyothirtyfive*sy);
+               hz += t.k[2]*(4.0*sz3 - sixtyothirtyfive*sz);
+               break;
+            }
+
+            case uniaxial_sixth_order_term : {
+               const double sdote  = (sx*t.e[0].x + sy*t.e[0].y + sz*t.e[0].z);
+               const double sdote3 = sdote*sdote*sdote;
+               const double sdote5 = sdote3*sdote*sdote;
+               const double k6 = t.h[0]*(1386.0*sdote5 - 1260.0*sdote3 + 210.0*sdote);
+               hx += t.e[0].x*k6;
+               hy += t.e[0].y*k6;
+               hz += t.e[0].z*k6;
+               break;
+            }
+
+            case rotational_fourth_order_term : {
+               const double sx2 = sx*sx;
+               const double sy2 = sy*sy;
+               const double sz2 = sz*sz;
+               hx += t.h[0] * sx * (1.0 - sz2 - 2.0 * sx2);
+               hy += t.h[0] * sy * (1.0 - sz2 - 2.0 * sy2);
+               hz += t.h[1] * sz * (1.0 - 2.0 * sz2 - 4.0 * sx2 - 4.0 * sy2);
+               break;
+            }
+
+            case cubic_fourth_order_term : {
+               hx += sx*sx*sx*t.h[0];
+               hy += sy*sy*sy*t.h[0];
+               hz += sz*sz*sz*t.h[0];
+               break;
+            }
+
+            case cubic_fourth_order_rotation_term : {
+               const double sdote1 = sx * t.e[0].x + sy * t.e[0].y + sz * t.e[0].z;
+               const double sdote2 = sx * t.e[1].x + sy * t.e[1].y + sz * t.e[1].z;
+               const double sdote3 = sx * t.e[2].x + sy * t.e[2].y + sz * t.e[2].z;
+               const double sdote1_3 = sdote1 * sdote1 * sdote1;
+               const double sdote2_3 = sdote2 * sdote2 * sdote2;
+               const double sdote3_3 = sdote3 * sdote3 * sdote3;
+               hx += t.h[0]*(sdote1_3*t.e[0].x + sdote2_3*t.e[1].x + sdote3_3*t.e[2].x);
+               hy += t.h[0]*(sdote1_3*t.e[0].y + sdote2_3*t.e[1].y + sdote3_3*t.e[2].y);
+               hz += t.h[0]*(sdote1_3*t.e[0].z + sdote2_3*t.e[1].z + sdote3_3*t.e[2].z);
+               break;
+            }
+
+            case cubic_sixth_order_term : {
+               const double sx2 = sx*sx;
+               const double sy2 = sy*sy;
+               const double sz2 = sz*sz;
+               hx += sx*sy2*sz2*t.h[0];
+               hy += sy*sz2*sx2*t.h[0];
+               hz += sz*sx2*sy2*t.h[0];
+               break;
+            }
+
+         }
+
+         return;
+
+      }
+
+      //------------------------------------------------------------------------
+      // Function to calculate energy of a single anisotropy term
+      //------------------------------------------------------------------------
+      inline double term_energy(const term_t& t, const double sx, const double sy, const double sz){
+
+         const double fiveothirtyfive  = 5.0  / 35.0;
+         const double thirtyothirtyfive = 30.0 / 35.0;
+
+         switch(t.type){
+
+            case uniaxial_second_order_term : {
+               const double sdote = (sx*t.e[0].x + sy*t.e[0].y + sz*t.e[0].z);
+               return -t.k[0]*(sdote*sdote);
+            }
+
+            case uniaxial_fourth_order_term : {
+               const double sdote  = (sx*t.e[0].x + sy*t.e[0].y + sz*t.e[0].z);
+               const double sdote2 = sdote*sdote;
+               return t.k[0]*(sdote2*sdote2 - thirtyothirtyfive*sdote2 - fiveothirtyfive);
+            }
+
+            case biaxial_fourth_order_simple_term : {
+               const double sdotu1 = (sx*t.e[0].x + sy*t.e[0].y + sz*t.e[0].z);
+               const double sdotu2 = (sx*t.e[1].x + sy*t.e[1].y + sz*t.e[1].z);
+               const double sdotu14 = sdotu1*sdotu1*sdotu1*sdotu1;
+               const double sdotu24 = sdotu2*sdotu2*sdotu2*sdotu2;
+               return -(t.k[0]/2.0)*(sdotu14+sdotu24);
+            }
+
+            case triaxial_second_order_term : {
+               const double sdoteA = t.e[0].x*sx + t.e[0].y*sy + t.e[0].z*sz;
+               const double sdoteB = t.e[1].x*sx + t.e[1].y*sy + t.e[1].z*sz;
+               const double sdoteC = t.e[2].x*sx + t.e[2].y*sy + t.e[2].z*sz;
+               return -(t.k[0]*sdoteA*sdoteA + t.k[1]*sdoteB*sdoteB + t.k[2]*sdoteC*sdoteC);
+            }
+
+            case triaxial_second_order_fixed_basis_term : {
+               return -(sx*sx*t.k[0] + sy*sy*t.k[1] + sz*sz*t.k[2]);
+            }
+
+            case triaxial_fourth_order_term : {
+               const double sdoteA = t.e[0].x*sx + t.e[0].y*sy + t.e[0].z*sz;
+               const double sdoteB = t.e[1].x*sx + t.e[1].y*sy + t.e[1].z*sz;
+               const double sdoteC = t.e[2].x*sx + t.e[2].y*sy + t.e[2].z*sz;
+               const double sdoteA2 = sdoteA*sdoteA;
+               const double sdoteB2 = sdoteB*sdoteB;
+               const double sdoteC2 = sdoteC*sdoteC;
+               return -(t.k[0]*(sdoteA2*sdoteA2 - thirtyothirtyfive*sdoteA2) +
+                        t.k[1]*(sdoteB2*sdoteB2 - thirtyothirtyfive*sdoteB2) +
+                        t.k[2]*(sdoteC2*sdoteC2 - thirtyothirtyfive*sdoteC2));
+            }
+
+            case triaxial_fourth_order_fixed_basis_term : {
+               const double sx2 = sx*sx;
+               const double sy2 = sy*sy;
+               const double sz2 = sz*sz;
+               return -(t.k[0]*(sx2*sx2 - thirtyothirtyfive*sx2) +
+                        t.k[1]*(sy2*sy2 - thirtyothirtyfive*sy2) +
+                        t.k[2]*(sz2*sz2 - thirtyothirtyfive*sz2));
+            }
+
+            case uniaxial_sixth_order_term : {
+               const double sdote  = (sx*t.e[0].x + sy*t.e[0].y + sz*t.e[0].z);
+               const double sdote2 = sdote*sdote;
+               return -0.04166666666*t.k[0]*(231.0*sdote2*sdote2*sdote2 - 315.0*sdote2*sdote2 + 105.0*sdote2);
+            }
+
+            case rotational_fourth_order_term : {
+               const double sx2 = sx*sx;
+               const double sz2 = sz*sz;
+               const double sx4 = sx2*sx2;
+               const double sz4 = sz2*sz2;
+               return t.k[0]*(1.0 + sz4 - 8.0*sx2 + 8.0*sx2*sz2 + 8.0*sx4-2.0*sz2);
+            }
+
+            case cubic_fourth_order_term : {
+               return -0.5*t.k[0]*(sx*sx*sx*sx + sy*sy*sy*sy + sz*sz*sz*sz);
+            }
+
+            case cubic_fourth_order_rotation_term : {
+               const double sdote1 = sx * t.e[0].x + sy * t.e[0].y + sz * t.e[0].z;
+               const double sdote2 = sx * t.e[1].x + sy * t.e[1].y + sz * t.e[1].z;
+               const double sdote3 = sx * t.e[2].x + sy * t.e[2].y + sz * t.e[2].z;
+               return -0.5*t.k[0]*(sdote1*sdote1*sdote1*sdote1 + sdote2*sdote2*sdote2*sdote2 + sdote3*sdote3*sdote3*sdote3);
+            }
+
+            case cubic_sixth_order_term : {
+               return t.k[0]*sx*sx*sy*sy*sz*sz;
+            }
+
+         }
+
+         return 0.0;
+
+      }
+
+      //------------------------------------------------------------------------
+      // Kernel for a fixed combination of up to three terms (B,C = -1 unused)
+      //------------------------------------------------------------------------
+      template <int A, int B, int C>
+      void fused_fields(const term_t* terms,
+                        const std::vector<double>& spin_array_x,
+                        const std::vector<double>& spin_array_y,
+                        const std::vector<double>& spin_array_z,
+                        std::vector<double>& field_array_x,
+                        std::vector<double>& field_array_y,
+                        std::vector<double>& field_array_z,
+                        const int start_index,
+                        const int end_index){
+
+         for(int atom = start_index; atom < end_index; atom++){
+
+            const double sx = spin_array_x[atom]; // store spin direction in temporary variables
+            const double sy = spin_array_y[atom];
+            const double sz = spin_array_z[atom];
+
+            double hx = field_array_x[atom];
+            double hy = field_array_y[atom];
+            double hz = field_array_z[atom];
+
+            add_term_field(A, terms[0], sx, sy, sz, hx, hy, hz);
+            if(B >= 0) add_term_field(B, terms[1], sx, sy, sz, hx, hy, hz);
+            if(C >= 0) add_term_field(C, terms[2], sx, sy, sz, hx, hy, hz);
+
+            field_array_x[atom] = hx;
+            field_array_y[atom] = hy;
+            field_array_z[atom] = hz;
+
+         }
+
+         return;
+
+      }
+
+      //------------------------------------------------------------------------
+      // Kernel for an arbitrary list of terms
+      //------------------------------------------------------------------------
+      void generic_fields(const std::vector<term_t>& terms,
+                          const std::vector<double>& spin_array_x,
+                          const std::vector<double>& spin_array_y,
+                          const std::vector<double>& spin_array_z,
+                          std::vector<double>& field_array_x,
+                          std::vector<double>& field_array_y,
+                          std::vector<double>& field_array_z,
+                          const int start_index,
+                          const int end_index){
+
+         const int num_terms = terms.size();
+
+         for(int atom = start_index; atom < end_index; atom++){
+
+            const double sx = spin_array_x[atom]; // store spin direction in temporary variables
+            const double sy = spin_array_y[atom];
+            const double sz = spin_array_z[atom];
+
+            double hx = field_array_x[atom];
+            double hy = field_array_y[atom];
+            double hz = field_array_z[atom];
+
+            for(int t = 0; t < num_terms; t++) add_term_field(terms[t].type, terms[t], sx, sy, sz, hx, hy, hz);
+
+            field_array_x[atom] = hx;
+            field_array_y[atom] = hy;
+            field_array_z[atom] = hz;
+
+         }
+
+         return;
+
+      }
+
+      //------------------------------------------------------------------------
+      // Function to calculate fields from all terms of the plan in a single
+      // pass, looping only over atoms of materials with anisotropy
+      //------------------------------------------------------------------------
+      void plan_fields(const std::vector<double>& spin_array_x,
+                       const std::vector<double>& spin_array_y,
+                       const std::vector<double>& spin_array_z,
+                       std::vector<double>& field_array_x,
+                       std::vector<double>& field_array_y,
+                       std::vector<double>& field_array_z,
+                       const int start_index,
+                       const int end_index){
+
+         // find first range ending after start index
+         std::vector<atom_range_t>::const_iterator range = std::upper_bound(plan_atom_ranges.begin(), plan_atom_ranges.end(), start_index,
+                                                                            [](const int atom, const atom_range_t& r){ return atom < r.end; });
+
+         for(; range != plan_atom_ranges.end() && range->start < end_index; ++range){
+
+            const int start = std::max(range->start, start_index);
+            const int end   = std::min(range->end, end_index);
+
+            const plan_t& p = plan[range->mat];
+            const term_t* t = &p.terms[0];
+
+            switch(p.key){
+               case plan_key(uniaxial_second_order_term) :
+                  fused_fields<uniaxial_second_order_term, -1, -1>(t, spin_array_x, spin_array_y, spin_array_z, field_array_x, field_array_y, field_array_z, start, end);
+                  break;
+               case plan_key(uniaxial_fourth_order_term) :
+                  fused_fields<uniaxial_fourth_order_term, -1, -1>(t, spin_array_x, spin_array_y, spin_array_z, field_array_x, field_array_y, field_array_z, start, end);
+                  break;
+               case plan_key(uniaxial_sixth_order_term) :
+                  fused_fields<uniaxial_sixth_order_term, -1, -1>(t, spin_array_x, spin_array_y, spin_array_z, field_array_x, field_array_y, field_array_z, start, end);
+                  break;
+               case plan_key(triaxial_second_order_fixed_basis_term) :
+                  fused_fields<triaxial_second_order_fixed_basis_term, -1, -1>(t, spin_array_x, spin_array_y, spin_array_z, field_array_x, field_array_y, field_array_z, start, end);
+                  break;
+               case plan_key(cubic_fourth_order_term) :
+                  fused_fields<cubic_fourth_order_term, -1, -1>(t, spin_array_x, spin_array_y, spin_array_z, field_array_x, field_array_y, field_array_z, start, end);
+                  break;
+               case plan_key(cubic_fourth_order_rotation_term) :
+                  fused_fields<cubic_fourth_order_rotation_term, -1, -1>(t, spin_array_x, spin_array_y, spin_array_z, field_array_x, field_array_y, field_array_z, start, end);
+                  break;
+               case plan_key(uniaxial_second_order_term, uniaxial_fourth_order_term) :
+                  fused_fields<uniaxial_second_order_term, uniaxial_fourth_order_term, -1>(t, spin_array_x, spin_array_y, spin_array_z, field_array_x, field_array_y, field_array_z, start, end);
+                  break;
+               case plan_key(uniaxial_second_order_term, cubic_fourth_order_term) :
+                  fused_fields<uniaxial_second_order_term, cubic_fourth_order_term, -1>(t, spin_array_x, spin_array_y, spin_array_z, field_array_x, field_array_y, field_array_z, start, end);
+                  break;
+               case plan_key(uniaxial_second_order_term, cubic_fourth_order_rotation_term) :
+                  fused_fields<uniaxial_second_order_term, cubic_fourth_order_rotation_term, -1>(t, spin_array_x, spin_array_y, spin_array_z, field_array_x, field_array_y, field_array_z, start, end);
+                  break;
+               case plan_key(cubic_fourth_order_term, cubic_sixth_order_term) :
+                  fused_fields<cubic_fourth_order_term, cubic_sixth_order_term, -1>(t, spin_array_x, spin_array_y, spin_array_z, field_array_x, field_array_y, field_array_z, start, end);
+                  break;
+               case plan_key(uniaxial_second_order_term, uniaxial_fourth_order_term, uniaxial_sixth_order_term) :
+                  fused_fields<uniaxial_second_order_term, uniaxial_fourth_order_term, uniaxial_sixth_order_term>(t, spin_array_x, spin_array_y, spin_array_z, field_array_x, field_array_y, field_array_z, start, end);
+                  break;
+               case plan_key(uniaxial_second_order_term, cubic_fourth_order_term, cubic_sixth_order_term) :
+                  fused_fields<uniaxial_second_order_term, cubic_fourth_order_term, cubic_sixth_order_term>(t, spin_array_x, spin_array_y, spin_array_z, field_array_x, field_array_y, field_array_z, start, end);
+                  break;
+               default :
+                  generic_fields(p.terms, spin_array_x, spin_array_y, spin_array_z, field_array_x, field_array_y, field_array_z, start, end);
+                  break;
+            }
+
+         }
+
+         return;
+
+      }
+
+      //------------------------------------------------------------------------
+      // Function to calculate energy from all terms of the plan for a material
+      //------------------------------------------------------------------------
+      double plan_energy(const int mat, const double sx, const double sy, const double sz){
+
+         const std::vector<term_t>& terms = plan[mat].terms;
+
+         double energy = 0.0;
+         for(unsigned int t = 0; t < terms.size(); t++) energy += term_energy(terms[t], sx, sy, sz);
+
+         return energy;
+
+      }
+
+      //------------------------------------------------------------------------
+      // Function to create a term with zero constants and axes
+      //------------------------------------------------------------------------
+      term_t new_term(const term_type_t type){
+         term_t term;
+         term.type = type;
+         for(int i = 0; i < 3; i++){
+            term.k[i] = 0.0;
+            term.h[i] = 0.0;
+            term.e[i].x = 0.0;
+            term.e[i].y = 0.0;
+            term.e[i].z = 0.0;
+         }
+         return term;
+      }
+
+      //------------------------------------------------------------------------
+      // Function to set an axis of a term
+      //------------------------------------------------------------------------
+      void set_axis(term_t& term, const int i, const double x, const double y, const double z){
+         term.e[i].x = x;
+         term.e[i].y = y;
+         term.e[i].z = z;
+         return;
+      }
+
+      //------------------------------------------------------------------------
+      // Function to compile unrolled anisotropy constants into a list of active
+      // terms for each material, and atoms into ranges of single materials
+      // with anisotropy so that other materials are skipped entirely
+      //------------------------------------------------------------------------
+      void initialize_plan(const unsigned int num_atoms, const std::vector<int>& atom_material_array){
+
+         const int num_materials = mp.size();
+
+         plan.assign(num_materials, plan_t());
+
+         const double oneo16 = 1.0/16.0;
+
+         for(int mat = 0; mat < num_materials; mat++){
+
+            std::vector<term_t>& terms = plan[mat].terms;
+
+            // second order uniaxial
+            if(enable_uniaxial_second_order && ku2[mat] != 0.0){
+               term_t term = new_term(uniaxial_second_order_term);
+               term.k[0] = ku2[mat];
+               term.h[0] = 2.0*ku2[mat];
+               set_axis(term, 0, ku_vector[mat].x, ku_vector[mat].y, ku_vector[mat].z);
+               terms.push_back(term);
+            }
+
+            // fourth order uniaxial
+            if(enable_uniaxial_fourth_order && ku4[mat] != 0.0){
+               term_t term = new_term(uniaxial_fourth_order_term);
+               term.k[0] = ku4[mat];
+               term.h[0] = -ku4[mat];
+               set_axis(term, 0, ku_vector[mat].x, ku_vector[mat].y, ku_vector[mat].z);
+               terms.push_back(term);
+            }
+
+            // fourth order biaxial (simple version)
+            if(enable_biaxial_fourth_order_simple && ku4[mat] != 0.0){
+               term_t term = new_term(biaxial_fourth_order_simple_term);
+               term.k[0] = ku4[mat];
+               term.h[0] = 2.0*ku4[mat];
+               set_axis(term, 0, mp[mat].u1_vector[0], mp[mat].u1_vector[1], mp[mat].u1_vector[2]);
+               set_axis(term, 1, mp[mat].u2_vector[0], mp[mat].u2_vector[1], mp[mat].u2_vector[2]);
+               terms.push_back(term);
+            }
+
+            // second order triaxial (materials with a fixed basis use the simpler form)
+            if((enable_triaxial_anisotropy || enable_triaxial_anisotropy_rotated) &&
+               (ku_triaxial_vector_x[mat] != 0.0 || ku_triaxial_vector_y[mat] != 0.0 || ku_triaxial_vector_z[mat] != 0.0)){
+               term_t term = new_term(triaxial_second_order_fixed_basis_term);
+               term.k[0] = ku_triaxial_vector_x[mat];
+               term.k[1] = ku_triaxial_vector_y[mat];
+               term.k[2] = ku_triaxial_vector_z[mat];
+               for(int i = 0; i < 3; i++) term.h[i] = 2.0*term.k[i];
+               if(!triaxial_second_order_fixed_basis[mat]){
+                  term.type = triaxial_second_order_term;
+                  set_axis(term, 0, ku_triaxial_basis1x[mat], ku_triaxial_basis1y[mat], ku_triaxial_basis1z[mat]);
+                  set_axis(term, 1, ku_triaxial_basis2x[mat], ku_triaxial_basis2y[mat], ku_triaxial_basis2z[mat]);
+                  set_axis(term, 2, ku_triaxial_basis3x[mat], ku_triaxial_basis3y[mat], ku_triaxial_basis3z[mat]);
+               }
+               terms.push_back(term);
+            }
+
+            // fourth order triaxial (materials with a fixed basis use the simpler form)
+            if((enable_triaxial_fourth_order || enable_triaxial_fourth_order_rotated) &&
+               (ku4_triaxial_vector_x[mat] != 0.0 || ku4_triaxial_vector_y[mat] != 0.0 || ku4_triaxial_vector_z[mat] != 0.0)){
+               term_t term = new_term(triaxial_fourth_order_fixed_basis_term);
+               term.k[0] = ku4_triaxial_vector_x[mat];
+               term.k[1] = ku4_triaxial_vector_y[mat];
+               term.k[2] = ku4_triaxial_vector_z[mat];
+               if(!triaxial_fourth_order_fixed_basis[mat]){
+                  term.type = triaxial_fourth_order_term;
+                  set_axis(term, 0, ku4_triaxial_basis1x[mat], ku4_triaxial_basis1y[mat], ku4_triaxial_basis1z[mat]);
+                  set_axis(term, 1, ku4_triaxial_basis2x[mat], ku4_triaxial_basis2y[mat], ku4_triaxial_basis2z[mat]);
+                  set_axis(term, 2, ku4_triaxial_basis3x[mat], ku4_triaxial_basis3y[mat], ku4_triaxial_basis3z[mat]);
+               }
+               terms.push_back(term);
+            }
+
+            // sixth order uniaxial
+            if(enable_uniaxial_sixth_order && ku6[mat] != 0.0){
+               term_t term = new_term(uniaxial_sixth_order_term);
+               term.k[0] = ku6[mat];
+               term.h[0] = oneo16 * 2.0/3.0*ku6[mat];
+               set_axis(term, 0, ku_vector[mat].x, ku_vector[mat].y, ku_vector[mat].z);
+               terms.push_back(term);
+            }
+
+            // fourth order rotational
+            if(enable_fourth_order_rotational && k4r[mat] != 0.0){
+               term_t term = new_term(rotational_fourth_order_term);
+               term.k[0] = k4r[mat];
+               term.h[0] = k4r[mat] * 8.0;
+               term.h[1] = k4r[mat] * 2.0;
+               terms.push_back(term);
+            }
+
+            // fourth order cubic
+            if(enable_cubic_fourth_order && kc4[mat] != 0.0){
+               term_t term = new_term(cubic_fourth_order_term);
+               term.k[0] = kc4[mat];
+               term.h[0] = 0.5*4.0*kc4[mat];
+               terms.push_back(term);
+            }
+
+            // fourth order cubic (rotated basis)
+            if(enable_cubic_fourth_order_rotation && kc4[mat] != 0.0){
+               term_t term = new_term(cubic_fourth_order_rotation_term);
+               term.k[0] = kc4[mat];
+               term.h[0] = 0.5*4.0*kc4[mat];
+               set_axis(term, 0, mp[mat].kc_vector1[0], mp[mat].kc_vector1[1], mp[mat].kc_vector1[2]);
+               set_axis(term, 1, mp[mat].kc_vector2[0], mp[mat].kc_vector2[1], mp[mat].kc_vector2[2]);
+               set_axis(term, 2, mp[mat].kc_vector3[0], mp[mat].kc_vector3[1], mp[mat].kc_vector3[2]);
+               terms.push_back(term);
+            }
+
+            // sixth order cubic
+            if(enable_cubic_sixth_order && kc6[mat] != 0.0){
+               term_t term = new_term(cubic_sixth_order_term);
+               term.k[0] = kc6[mat];
+               term.h[0] = -2.0*kc6[mat];
+               terms.push_back(term);
+            }
+
+            // determine key for specialised kernels
+            switch(terms.size()){
+               case 1 : plan[mat].key = plan_key(terms[0].type); break;
+               case 2 : plan[mat].key = plan_key(terms[0].type, terms[1].type); break;
+               case 3 : plan[mat].key = plan_key(terms[0].type, terms[1].type, terms[2].type); break;
+               default : plan[mat].key = -1; break;
+            }
+
+         }
+
+         //---------------------------------------------------------------------
+         // Determine ranges of consecutive atoms of the same material with
+         // anisotropy terms
+         //---------------------------------------------------------------------
+         plan_atom_ranges.clear();
+
+         for(unsigned int atom = 0; atom < num_atoms; atom++){
+            const int mat = atom_material_array[atom];
+            if(plan[mat].terms.size() == 0) continue;
+            if(plan_atom_ranges.size() > 0 && plan_atom_ranges.back().end == int(atom) && plan_atom_ranges.back().mat == mat){
+               plan_atom_ranges.back().end++;
+            }
+            else{
+               atom_range_t range;
+               range.start = atom;
+               range.end   = atom + 1;
+               range.mat   = mat;
+               plan_atom_ranges.push_back(range);
+            }
+         }
+
+         // output informative message
+         int num_terms = 0;
+         for(int mat = 0; mat < num_materials; mat++) num_terms += plan[mat].terms.size();
+         zlog << zTs() << "Anisotropy plan compiled with " << num_terms << " terms for " << num_materials << " materials and "
+              << plan_atom_ranges.size() << " ranges of atoms with anisotropy" << std::endl;
+
+         return;
+
+      }
+
+   } // end of internal namespace
+
+} // end of anisotropy namespace
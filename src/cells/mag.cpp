@@ -19,6 +19,7 @@
 #include "random.hpp"
 #include "errors.hpp"
 #include "vmpi.hpp"
+#include "vutil.hpp"
 #include "create.hpp"
 #include "micromagnetic.hpp"
 
@@ -35,6 +36,9 @@ namespace cells{
    //int mag(const double time_from_start){
    int mag(){
 
+      // time cell magnetisation calculation
+      vutil::profile::scope_t profile(vutil::profile::cells);
+
       if(micromagnetic::discretisation_type != 1){
      // check calling of routine if error checking is activated
       if(err::check==true) std::cout << "cells::mag has been called" << std::endl;
@@ -18,6 +18,7 @@
 #include "gpu.hpp"
 #include "program.hpp"
 #include "sim.hpp"
+#include "vutil.hpp"
 
 // config module headers
 #include "internal.hpp"
@@ -40,6 +41,9 @@ void output(){ // should include variables for data to be outputted, eg spins, c
    // check for data output enabled, if not no nothing
    if(config::internal::output_atoms_config == false && config::internal::output_cells_config == false) return;
 
+   // time configuration output
+   vutil::profile::scope_t profile(vutil::profile::config);
+
    // check that config module has been initialised
    if(!config::internal::initialised) config::internal::initialize();
 
@@ -0,0 +1,242 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) Richard F L Evans 2018. All rights reserved.
+//
+//   Email: richard.evans@york.ac.uk
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <cstring>
+#include <fstream>
+
+// Vampire headers
+#include "create.hpp"
+#include "errors.hpp"
+#include "exchange.hpp"
+#include "grains.hpp"
+#include "vio.hpp"
+#include "vmpi.hpp"
+
+// Internal create header
+#include "internal.hpp"
+
+namespace create{
+
+   //---------------------------------------------------------------------------
+   // Function to add a line of the input or material file to the structure
+   // cache key. Parameters which cannot change the generated structure are
+   // skipped so that scans over temperature, field or damping share a cache.
+   //---------------------------------------------------------------------------
+   void hash_input_line(std::string const key, std::string const word, std::string const value, std::string const unit, const int super_index, const int sub_index){
+
+      // simulation, output and configuration parameters do not affect structure
+      if(key == "sim" || key == "output" || key == "screen" || key == "config" || key == "montecarlo") return;
+
+      // cache file name does not affect structure
+      if(key == "create" && word == "structure-cache") return;
+
+      // dynamic material parameters do not affect structure
+      if(key == "material"){
+         if(word == "damping-constant" || word == "initial-spin-direction" ||
+            word == "temperature-rescaling-exponent" || word == "temperature-rescaling-curie-temperature") return;
+      }
+
+      internal::input_hash.add(key);
+      internal::input_hash.add(word);
+      internal::input_hash.add(value);
+      internal::input_hash.add(unit);
+      internal::input_hash.add(&super_index, sizeof(int));
+      internal::input_hash.add(&sub_index, sizeof(int));
+
+      return;
+
+   }
+
+namespace internal{
+
+   // cache file identifier and format version
+   const char cache_magic[8] = {'V','A','M','P','S','T','R','C'};
+   const uint64_t cache_version = 1;
+
+   //---------------------------------------------------------------------------
+   // Function to compute the final structure hash from the input parameters
+   // and the unit cell and interaction templates
+   //---------------------------------------------------------------------------
+   uint64_t calculate_structure_hash(){
+
+      vutil::hash_t hash = input_hash;
+
+      // file format and data layout
+      hash.add(&cache_version, sizeof(uint64_t));
+      const uint64_t sizes[3] = { sizeof(cs::catom_t), sizeof(neighbours::neighbour_t), sizeof(cs::nm_atom_t) };
+      hash.add(sizes, sizeof(sizes));
+
+      // system size and periodicity after rounding for pbc
+      hash.add(cs::system_dimensions, sizeof(cs::system_dimensions));
+      for(int i = 0; i < 3; i++){
+         const int pbc = cs::pbc[i];
+         hash.add(&pbc, sizeof(int));
+      }
+
+      // unit cell (which may be read from a separate file)
+      const uc::unit_cell_t& unit_cell = cs::unit_cell;
+      hash.add(unit_cell.dimensions, sizeof(unit_cell.dimensions));
+      hash.add(unit_cell.shape, sizeof(unit_cell.shape));
+      hash.add(&unit_cell.interaction_range, sizeof(unsigned int));
+      for(unsigned int a = 0; a < unit_cell.atom.size(); a++){
+         const uc::atom_t& atom = unit_cell.atom[a];
+         hash.add(&atom.x, sizeof(double));
+         hash.add(&atom.y, sizeof(double));
+         hash.add(&atom.z, sizeof(double));
+         const unsigned int ids[4] = { atom.mat, atom.lc, atom.hc, atom.ni };
+         hash.add(ids, sizeof(ids));
+      }
+
+      // interaction templates determining the neighbour lists
+      const int biquadratic = exchange::biquadratic;
+      hash.add(&biquadratic, sizeof(int));
+      const uc::exchange_template_t* templates[2] = { &unit_cell.bilinear, &unit_cell.biquadratic };
+      for(int t = 0; t < 2; t++){
+         for(unsigned int i = 0; i < templates[t]->interaction.size(); i++){
+            const uc::interaction_t& interaction = templates[t]->interaction[i];
+            const int ids[5] = { int(interaction.i), int(interaction.j), interaction.dx, interaction.dy, interaction.dz };
+            hash.add(ids, sizeof(ids));
+         }
+      }
+
+      return hash.value();
+
+   }
+
+   //---------------------------------------------------------------------------
+   // Helper functions to read and write vectors of plain data
+   //---------------------------------------------------------------------------
+   template <typename T>
+   void write_array(std::ofstream& ofile, const std::vector<T>& array){
+      const uint64_t size = array.size();
+      ofile.write(reinterpret_cast<const char*>(&size), sizeof(uint64_t));
+      ofile.write(reinterpret_cast<const char*>(array.data()), size*sizeof(T));
+   }
+
+   template <typename T>
+   bool read_array(std::ifstream& ifile, std::vector<T>& array, const uint64_t file_size){
+      uint64_t size = 0;
+      ifile.read(reinterpret_cast<char*>(&size), sizeof(uint64_t));
+      // check for truncated or corrupt file before allocating memory
+      if(!ifile || size > file_size/sizeof(T)) return false;
+      array.resize(size);
+      ifile.read(reinterpret_cast<char*>(array.data()), size*sizeof(T));
+      return bool(ifile);
+   }
+
+   //---------------------------------------------------------------------------
+   // Function to load generated atoms and neighbour lists from cache file.
+   // Returns true if a valid cache with a matching hash has been loaded.
+   //---------------------------------------------------------------------------
+   bool load_structure_cache(std::vector<cs::catom_t>& catom_array,
+                             neighbours::list_t& bilinear,
+                             neighbours::list_t& biquadratic){
+
+      std::ifstream ifile(create::structure_cache_file_name.c_str(), std::ios::binary | std::ios::ate);
+      if(!ifile.is_open()){
+         zlog << zTs() << "Structure cache file \"" << create::structure_cache_file_name << "\" not found, generating system" << std::endl;
+         return false;
+      }
+      const uint64_t file_size = ifile.tellg();
+      ifile.seekg(0);
+
+      // check file identifier and key
+      char magic[8];
+      uint64_t version = 0;
+      uint64_t hash = 0;
+      ifile.read(magic, sizeof(magic));
+      ifile.read(reinterpret_cast<char*>(&version), sizeof(uint64_t));
+      ifile.read(reinterpret_cast<char*>(&hash), sizeof(uint64_t));
+      if(!ifile || std::memcmp(magic, cache_magic, sizeof(magic)) != 0 || version != cache_version){
+         zlog << zTs() << "Structure cache file \"" << create::structure_cache_file_name << "\" is not a valid cache, regenerating system" << std::endl;
+         return false;
+      }
+      if(hash != create::structure_hash){
+         zlog << zTs() << "Structure cache file \"" << create::structure_cache_file_name << "\" does not match input parameters, regenerating system" << std::endl;
+         return false;
+      }
+
+      // read global variables set during system creation
+      int globals[2] = {0, 0};
+      ifile.read(reinterpret_cast<char*>(globals), sizeof(globals));
+
+      // read atoms and neighbour lists
+      bool success = bool(ifile);
+      success = success && read_array(ifile, catom_array, file_size);
+      success = success && read_array(ifile, cs::non_magnetic_atoms_array, file_size);
+      success = success && read_array(ifile, bilinear.start_index, file_size);
+      success = success && read_array(ifile, bilinear.list, file_size);
+      success = success && read_array(ifile, biquadratic.start_index, file_size);
+      success = success && read_array(ifile, biquadratic.list, file_size);
+
+      if(!success){
+         zlog << zTs() << "Structure cache file \"" << create::structure_cache_file_name << "\" is truncated, regenerating system" << std::endl;
+         std::vector<cs::catom_t> zerov;
+         catom_array.swap(zerov);
+         cs::non_magnetic_atoms_array.clear();
+         bilinear.clear();
+         biquadratic.clear();
+         return false;
+      }
+
+      create::num_total_atoms_non_filler = globals[0];
+      grains::num_grains = globals[1];
+
+      std::cout << "Loaded system structure from cache file \"" << create::structure_cache_file_name << "\"" << std::endl;
+      zlog << zTs() << "Loaded system structure with " << catom_array.size() << " atoms and " << bilinear.list.size()
+           << " interactions from cache file \"" << create::structure_cache_file_name << "\"" << std::endl;
+      zlog << zTs() << "Note: grain vertex and alloy profile files are not regenerated when loading from cache" << std::endl;
+
+      return true;
+
+   }
+
+   //---------------------------------------------------------------------------
+   // Function to save generated atoms and neighbour lists to cache file
+   //---------------------------------------------------------------------------
+   void save_structure_cache(std::vector<cs::catom_t>& catom_array,
+                             neighbours::list_t& bilinear,
+                             neighbours::list_t& biquadratic){
+
+      std::ofstream ofile(create::structure_cache_file_name.c_str(), std::ios::binary | std::ios::trunc);
+      if(!ofile.is_open()){
+         terminaltextcolor(YELLOW);
+         std::cerr << "Warning: Unable to open structure cache file \"" << create::structure_cache_file_name << "\" for writing. Continuing without cache." << std::endl;
+         terminaltextcolor(WHITE);
+         zlog << zTs() << "Warning: Unable to open structure cache file \"" << create::structure_cache_file_name << "\" for writing. Continuing without cache." << std::endl;
+         return;
+      }
+
+      ofile.write(cache_magic, sizeof(cache_magic));
+      ofile.write(reinterpret_cast<const char*>(&cache_version), sizeof(uint64_t));
+      ofile.write(reinterpret_cast<const char*>(&create::structure_hash), sizeof(uint64_t));
+
+      const int globals[2] = { create::num_total_atoms_non_filler, grains::num_grains };
+      ofile.write(reinterpret_cast<const char*>(globals), sizeof(globals));
+
+      write_array(ofile, catom_array);
+      write_array(ofile, cs::non_magnetic_atoms_array);
+      write_array(ofile, bilinear.start_index);
+      write_array(ofile, bilinear.list);
+      write_array(ofile, biquadratic.start_index);
+      write_array(ofile, biquadratic.list);
+
+      zlog << zTs() << "Saved system structure to cache file \"" << create::structure_cache_file_name << "\"" << std::endl;
+
+      return;
+
+   }
+
+} // end of internal namespace
+
+} // end of create namespace
@@ -30,6 +30,7 @@
 #include "vio.hpp"
 #include "vmath.hpp"
 #include "vmpi.hpp"
+#include "vutil.hpp"
 
 // Internal create header
 #include "internal.hpp"
@@ -99,6 +100,10 @@ int create(){
    // initialise create module parameters
    create::initialize();
 
+   // timer for system creation stages
+   vutil::vtimer_t timer;
+   timer.start();
+
 	// Atom creation array
 	std::vector<cs::catom_t> catom_array;
 
@@ -127,31 +132,62 @@ int create(){
 		if(vmpi::mpi_mode==0) vmpi::geometric_decomposition(vmpi::num_processors,cs::system_dimensions);
 	#endif
 
-	// Create block of crystal of desired size
-	cs::create_crystal_structure(catom_array);
+   // bilinear and biquadratic exchange neighbour lists
+   neighbours::list_t bilinear;
+   neighbours::list_t biquadratic;
 
-	// Cut system to the correct type, species etc
-	create::create_system_type(catom_array);
+   // structure cache is currently only supported in serial
+   #ifdef MPICF
+      if(create::structure_cache){
+         zlog << zTs() << "Warning: Structure cache is not supported in parallel mode and has been disabled" << std::endl;
+         create::structure_cache = false;
+      }
+   #endif
 
-	// Copy atoms for interprocessor communications
-	#ifdef MPICF
-	if(vmpi::mpi_mode==0){
-		create::internal::copy_halo_atoms(catom_array);
+   // attempt to load previously generated structure from cache
+   bool loaded_from_cache = false;
+   if(create::structure_cache){
+      create::structure_hash = create::internal::calculate_structure_hash();
+      loaded_from_cache = create::internal::load_structure_cache(catom_array, bilinear, biquadratic);
+      if(loaded_from_cache) create::internal::log_creation_stage("Loading structure cache", timer, catom_array.size());
    }
-	#endif
 
-   //---------------------------------------------
-	// Create Neighbour lists for system
-   //---------------------------------------------
-   neighbours::list_t bilinear; // bilinear exchange list
-   neighbours::list_t biquadratic; // biquadratic exchange list
+   if(!loaded_from_cache){
+
+   	// Create block of crystal of desired size
+   	cs::create_crystal_structure(catom_array);
+
+      create::internal::log_creation_stage("Crystal generation", timer, catom_array.size());
+
+   	// Cut system to the correct type, species etc
+   	create::create_system_type(catom_array);
+
+      create::internal::log_creation_stage("System type creation", timer, catom_array.size());
+
+   	// Copy atoms for interprocessor communications
+   	#ifdef MPICF
+   	if(vmpi::mpi_mode==0){
+   		create::internal::copy_halo_atoms(catom_array);
+      }
+   	#endif
+
+      //---------------------------------------------
+   	// Create Neighbour lists for system
+      //---------------------------------------------
+
+      // generate bilinear exchange list
+      bilinear.generate(catom_array, cs::unit_cell.bilinear, na, ucx, ucy, ucz);
 
-   // generate bilinear exchange list
-   bilinear.generate(catom_array, cs::unit_cell.bilinear, na, ucx, ucy, ucz);
+      // optionally create a biquadratic neighbour list
+      if(exchange::biquadratic){
+         biquadratic.generate(catom_array, cs::unit_cell.biquadratic, na, ucx, ucy, ucz);
+      }
+
+      create::internal::log_creation_stage("Neighbour list generation", timer, catom_array.size());
+
+      // save generated structure for subsequent runs
+      if(create::structure_cache) create::internal::save_structure_cache(catom_array, bilinear, biquadratic);
 
-   // optionally create a biquadratic neighbour list
-   if(exchange::biquadratic){
-      biquadratic.generate(catom_array, cs::unit_cell.biquadratic, na, ucx, ucy, ucz);
    }
 
 	#ifdef MPICF
@@ -174,6 +210,8 @@ int create(){
 
 	create::internal::set_atom_vars(catom_array, bilinear, biquadratic);
 
+   create::internal::log_creation_stage("Copying to simulation arrays", timer, atoms::num_atoms);
+
    // Determine number of local atoms
    #ifdef MPICF
    #else
@@ -204,4 +242,25 @@ int create(){
 	return EXIT_SUCCESS;
 }
 
+} // end of cs namespace
+
+namespace create{
+namespace internal{
+
+   //---------------------------------------------------------------------------
+   // Function to output time and peak memory of a system creation stage
+   //---------------------------------------------------------------------------
+   void log_creation_stage(const std::string stage, vutil::vtimer_t& timer, const uint64_t num_atoms){
+
+      timer.stop();
+      zlog << zTs() << stage << " completed on rank " << vmpi::my_rank << " in " << timer.elapsed_time() << " s with "
+           << num_atoms << " atoms, peak memory usage " << vutil::peak_memory_usage() << " MB" << std::endl;
+      timer.start();
+
+      return;
+
+   }
+
+} // end of internal namespace
+
 } // end of create namespace
@@ -128,28 +128,30 @@ void set_atom_vars(std::vector<cs::catom_t> & catom_array,
    //---------------------------------------------------------------------------
    // Identify surface atoms and initialise anisotropy data
    //---------------------------------------------------------------------------
-   anisotropy::identify_surface_atoms(catom_array, bilinear.list);
+   anisotropy::identify_surface_atoms(catom_array, bilinear);
+
+   // Atom creation data is no longer needed, so free memory before allocating exchange data
+   std::vector<cs::catom_t> zerov;
+   catom_array.swap(zerov);
 
 	//===========================================================
 	// Create 1-D neighbourlist
 	//===========================================================
 
 	zlog << zTs() << "Memory required for creation of 1D neighbour list on rank " << vmpi::my_rank << ": ";
-	zlog << (2.0*double(atoms::num_atoms)+2.0*double(atoms::total_num_neighbours))*8.0/1.0e6 << " MB RAM"<< std::endl;
+	zlog << (2.0*double(atoms::num_atoms)+2.0*double(bilinear.list.size()))*8.0/1.0e6 << " MB RAM"<< std::endl;
 
    //-------------------------------------------------
 	//	Initialise exchange calculation
 	//-------------------------------------------------
-   exchange::initialize(bilinear.list, biquadratic.list);
+   exchange::initialize(bilinear, biquadratic);
 
    // Save number of atoms in unit cell first
    cells::num_atoms_in_unit_cell = cs::unit_cell.atom.size();
 
    // Now nuke generation vectors to free memory NOW
-   std::vector<cs::catom_t> zerov;
-   std::vector<std::vector <neighbours::neighbour_t> > zerovv;
-   catom_array.swap(zerov);
-   bilinear.list.swap(zerovv);
+   bilinear.clear();
+   biquadratic.clear();
 
    return;
 
@@ -22,6 +22,10 @@ namespace create{
    //---------------------------------------------------------------------------
    int num_total_atoms_non_filler = 0;
 
+   bool structure_cache = false;                           // flag to enable reading/writing of structure cache
+   std::string structure_cache_file_name = "vampire.cache"; // name of structure cache file
+   uint64_t structure_hash = 0;                            // hash of structure-relevant input parameters
+
       namespace internal{
 
          //----------------------------------------------------------------------------
@@ -56,6 +60,8 @@ namespace create{
          bool select_material_by_z_height = false;	// Toggle overwriting of material id by z-height
          bool output_gv_file = true; // toggle output of grain positions to file
 
+         vutil::hash_t input_hash; // hash of structure-relevant input file lines
+
       } // end of internal namespace
 
 } // end of create namespace
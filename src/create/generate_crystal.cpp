@@ -71,14 +71,6 @@ int create_crystal_structure(std::vector<cs::catom_t> & catom_array){
 	cs::local_num_unit_cells[1]=max_bounds[1]-min_bounds[1];
 	cs::local_num_unit_cells[2]=max_bounds[2]-min_bounds[2];
 
-	int num_atoms=cs::local_num_unit_cells[0]*cs::local_num_unit_cells[1]*cs::local_num_unit_cells[2]*unit_cell.atom.size();
-
-	// set catom_array size
-	catom_array.reserve(num_atoms);
-
-	// Initialise atoms number
-	int atom=0;
-
    // find maximum height lh_category
    unsigned int maxlh=0;
    for(unsigned int uca=0;uca<unit_cell.atom.size();uca++) if(unit_cell.atom[uca].hc > maxlh) maxlh = unit_cell.atom[uca].hc;
@@ -88,82 +80,81 @@ int create_crystal_structure(std::vector<cs::catom_t> & catom_array){
 	std::vector<bool> inc_uc_atom(mp::max_materials, false);
 	for( auto m : create::internal::mp) inc_uc_atom[m.unit_cell_category] = true;
 
-	// Duplicate unit cell
-	for(int z=min_bounds[2];z<max_bounds[2];z++){
-		for(int y=min_bounds[1];y<max_bounds[1];y++){
-			for(int x=min_bounds[0];x<max_bounds[0];x++){
-
-				// need to change this to accept non-orthogonal lattices
-				// Loop over atoms in unit cell
-				for(unsigned int uca=0;uca<unit_cell.atom.size();uca++){
-					double cx = (double(x)+unit_cell.atom[uca].x)*unit_cell.dimensions[0];
-					double cy = (double(y)+unit_cell.atom[uca].y)*unit_cell.dimensions[1];
-					double cz = (double(z)+unit_cell.atom[uca].z)*unit_cell.dimensions[2];
-					#ifdef MPICF
-						if(vmpi::mpi_mode==0){
-							// only generate atoms within allowed dimensions
-                     if(   (cx>=vmpi::min_dimensions[0] && cx<vmpi::max_dimensions[0]) &&
-                           (cy>=vmpi::min_dimensions[1] && cy<vmpi::max_dimensions[1]) &&
-                           (cz>=vmpi::min_dimensions[2] && cz<vmpi::max_dimensions[2])){
-						#endif
-							if(inc_uc_atom[unit_cell.atom[uca].mat] &&
-								cx < cs::system_dimensions[0] &&
-								cy < cs::system_dimensions[1] &&
-								cz < cs::system_dimensions[2]
-							){
-							catom_array.push_back(cs::catom_t());
-							catom_array[atom].x=cx;
-							catom_array[atom].y=cy;
-							catom_array[atom].z=cz;
-							//std::cout << atom << "\t" << cx << "\t" << cy <<"\t" << cz << std::endl;
-							catom_array[atom].material=unit_cell.atom[uca].mat;
-							catom_array[atom].uc_id=uca;
-							catom_array[atom].lh_category=unit_cell.atom[uca].hc+z*maxlh;
-							catom_array[atom].uc_category=unit_cell.atom[uca].mat; // determine initial material (uc_category) for unit cell
-							catom_array[atom].scx=x;
-							catom_array[atom].scy=y;
-							catom_array[atom].scz=z;
-							atom++;
-							}
-						#ifdef MPICF
-							}
-						}
-						else{
-							if((cx<cs::system_dimensions[0]) && (cy<cs::system_dimensions[1]) && (cz<cs::system_dimensions[2])){
-							catom_array.push_back(cs::catom_t());
-							catom_array[atom].x=cx;
-							catom_array[atom].y=cy;
-							catom_array[atom].z=cz;
-							catom_array[atom].material=unit_cell.atom[uca].mat;
-							catom_array[atom].uc_id=uca;
-							catom_array[atom].lh_category=unit_cell.atom[uca].hc+z*maxlh;
-							catom_array[atom].uc_category=unit_cell.atom[uca].mat; // determine initial material (uc_category) for unit cell
-							catom_array[atom].scx=x;
-							catom_array[atom].scy=y;
-							catom_array[atom].scz=z;
-							catom_array[atom].include=false; // assume no atoms until classification complete
-							atom++;
-							}
-						}
-						#endif
-					}
-				}
-			}
-		}
-
-	// Check to see if actual and expected number of atoms agree, if not trim the excess
-	if(atom!=num_atoms){
-		std::vector<cs::catom_t> tmp_catom_array(num_atoms);
-		tmp_catom_array=catom_array;
-		catom_array.resize(atom);
-		for(int a=0;a<atom;a++){
-			catom_array[a]=tmp_catom_array[a];
-		}
-		tmp_catom_array.resize(0);
-	}
+   //---------------------------------------------------------------------------
+   // Function to determine if an atom in the unit cell should be generated
+   //---------------------------------------------------------------------------
+   auto generate_atom = [&](const unsigned int uca, const double cx, const double cy, const double cz) -> bool {
+      #ifdef MPICF
+         if(vmpi::mpi_mode==0){
+            // only generate atoms within allowed dimensions
+            if( !( (cx>=vmpi::min_dimensions[0] && cx<vmpi::max_dimensions[0]) &&
+                   (cy>=vmpi::min_dimensions[1] && cy<vmpi::max_dimensions[1]) &&
+                   (cz>=vmpi::min_dimensions[2] && cz<vmpi::max_dimensions[2]) ) ) return false;
+         }
+         else{
+            return (cx<cs::system_dimensions[0]) && (cy<cs::system_dimensions[1]) && (cz<cs::system_dimensions[2]);
+         }
+      #endif
+      return inc_uc_atom[unit_cell.atom[uca].mat] &&
+             cx < cs::system_dimensions[0] &&
+             cy < cs::system_dimensions[1] &&
+             cz < cs::system_dimensions[2];
+   };
+
+   //---------------------------------------------------------------------------
+   // Duplicate unit cell in two passes, first counting the number of atoms to
+   // be generated and then filling an exactly sized array. This avoids
+   // reserving the full bounding box of atoms and copying the array to trim
+   // the excess, which previously needed up to three times the final memory.
+   //---------------------------------------------------------------------------
+   for(int pass = 0; pass < 2; pass++){
+
+      // Initialise atoms number
+      uint64_t atom=0;
+
+      // Duplicate unit cell
+      for(int z=min_bounds[2];z<max_bounds[2];z++){
+         for(int y=min_bounds[1];y<max_bounds[1];y++){
+            for(int x=min_bounds[0];x<max_bounds[0];x++){
+
+               // need to change this to accept non-orthogonal lattices
+               // Loop over atoms in unit cell
+               for(unsigned int uca=0;uca<unit_cell.atom.size();uca++){
+                  double cx = (double(x)+unit_cell.atom[uca].x)*unit_cell.dimensions[0];
+                  double cy = (double(y)+unit_cell.atom[uca].y)*unit_cell.dimensions[1];
+                  double cz = (double(z)+unit_cell.atom[uca].z)*unit_cell.dimensions[2];
+                  if(!generate_atom(uca, cx, cy, cz)) continue;
+                  if(pass == 1){
+                     cs::catom_t& catom = catom_array[atom];
+                     catom.x=cx;
+                     catom.y=cy;
+                     catom.z=cz;
+                     catom.material=unit_cell.atom[uca].mat;
+                     catom.uc_id=uca;
+                     catom.lh_category=unit_cell.atom[uca].hc+z*maxlh;
+                     catom.uc_category=unit_cell.atom[uca].mat; // determine initial material (uc_category) for unit cell
+                     catom.scx=x;
+                     catom.scy=y;
+                     catom.scz=z;
+                     catom.include=false; // assume no atoms until classification complete
+                  }
+                  atom++;
+               }
+            }
+         }
+      }
+
+      // allocate exact number of atoms after first pass
+      if(pass == 0){
+         std::vector<cs::catom_t>(atom).swap(catom_array);
+         zlog << zTs() << "Memory required for crystal generation on rank " << vmpi::my_rank << ": " <<
+                 double(atom)*double(sizeof(cs::catom_t))/1.0e6 << " MB for " << atom << " atoms" << std::endl;
+      }
+
+   }
 
 	// Check to see if any atoms have been generated
-	if(atom==0){
+	if(catom_array.size()==0){
 		terminaltextcolor(RED);
 		std::cout << "Error - no atoms have been generated, increase system dimensions!" << std::endl;
 		terminaltextcolor(WHITE);
@@ -171,11 +162,6 @@ int create_crystal_structure(std::vector<cs::catom_t> & catom_array){
 		err::vexit();
 	}
 
-	// Now unselect all atoms by default for particle shape cutting
-	for(unsigned int atom=0;atom<catom_array.size();atom++){
-		catom_array[atom].include=false;
-	}
-
 	return EXIT_SUCCESS;
 }
 
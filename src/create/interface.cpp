@@ -8,6 +8,7 @@
 //-----------------------------------------------------------------------------
 
 // C++ standard library headers
+#include <algorithm>
 
 // Vampire headers
 #include "errors.hpp"
@@ -536,6 +537,16 @@ namespace create{
          create::internal::spin_init_seed = sirs;
          return true;
       }
+      //--------------------------------------------------------------------
+      test="structure-cache";
+      if(word==test){
+         create::structure_cache = true;
+         // optionally set cache file name
+         std::string cache_file = value;
+         cache_file.erase(remove(cache_file.begin(), cache_file.end(), '\"'), cache_file.end());
+         if(cache_file != "") create::structure_cache_file_name = cache_file;
+         return true;
+      }
       /*std::string test="slonczewski-spin-polarization-unit-vector";
       if(word==test){
          std::vector<double> u(3);
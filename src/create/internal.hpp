@@ -22,6 +22,7 @@
 // Vampire headers
 #include "material.hpp"
 #include "mtrand.hpp"
+#include "vutil.hpp"
 
 namespace create{
    namespace internal{
@@ -145,6 +146,8 @@ namespace create{
       extern bool select_material_by_z_height;
       extern bool output_gv_file; // toggle output of grain positions to file
 
+      extern vutil::hash_t input_hash; // hash of structure-relevant input file lines
+
       //-----------------------------------------------------------------------------
       // Internal functions for create module
       //-----------------------------------------------------------------------------
@@ -174,6 +177,12 @@ namespace create{
       extern void centre_particle_on_atom(std::vector<double>& particle_origin, std::vector<cs::catom_t>& catom_array);
       extern void sort_atoms_by_grain(std::vector<cs::catom_t> & catom_array);
       extern void clear_atoms(std::vector<cs::catom_t> &);
+      void log_creation_stage(const std::string stage, vutil::vtimer_t& timer, const uint64_t num_atoms);
+
+      // structure cache functions
+      uint64_t calculate_structure_hash();
+      bool load_structure_cache(std::vector<cs::catom_t>& catom_array, neighbours::list_t& bilinear, neighbours::list_t& biquadratic);
+      void save_structure_cache(std::vector<cs::catom_t>& catom_array, neighbours::list_t& bilinear, neighbours::list_t& biquadratic);
 
       extern void voronoi_substructure(std::vector<cs::catom_t> & catom_array);
 
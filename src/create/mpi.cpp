@@ -546,10 +546,10 @@ namespace create{
             const int my_mpi_type = catom_array[atom].mpi_type;
 
             // loop over all neighbours for atom
-            for( unsigned int nn = 0; nn < cneighbourlist.list[atom].size(); nn++ ){
+            for( unsigned int nn = 0; nn < cneighbourlist[atom].size(); nn++ ){
 
                // identify neighbour atom
-               const uint64_t natom = cneighbourlist.list[atom][nn].nn;
+               const uint64_t natom = cneighbourlist[atom][nn].nn;
 
                // define nearest neighbour MPI type
                int nn_mpi_type = catom_array[natom].mpi_type;
@@ -606,6 +606,45 @@ namespace create{
          else return false;
       }
 
+      //------------------------------------------------------------------------
+      // Reorder CSR neighbour list for new atom numbers, ignoring all halo-x
+      // interactions (but not x-halo)
+      //------------------------------------------------------------------------
+      void reorder_neighbour_list(neighbours::list_t& nlist,
+                                  const std::vector<data_t>& mpi_type_vec,
+                                  const std::vector<int>& inv_mpi_type_vec,
+                                  const unsigned int new_num_atoms){
+
+         // count neighbours for each new atom
+         std::vector<uint64_t> tmp_start_index(new_num_atoms+1, 0);
+         for(unsigned int atom = 0; atom < new_num_atoms; atom++){
+            if(mpi_type_vec[atom].mpi_type == 2) tmp_start_index[atom+1] = tmp_start_index[atom];
+            else tmp_start_index[atom+1] = tmp_start_index[atom] + nlist[mpi_type_vec[atom].atom_number].size();
+         }
+
+         std::vector<neighbours::neighbour_t> tmp_list(tmp_start_index[new_num_atoms]);
+
+         // Copy neighbourlist using new atom numbers
+         for(unsigned int atom = 0; atom < new_num_atoms; atom++){
+            if(mpi_type_vec[atom].mpi_type == 2) continue;
+            neighbours::row_t old_row = nlist[mpi_type_vec[atom].atom_number];
+            uint64_t index = tmp_start_index[atom];
+            for(unsigned int nn = 0; nn < old_row.size(); nn++){
+               tmp_list[index] = old_row[nn];
+               // Actual neighbours stay the same so simply copy separation vectors
+               tmp_list[index].nn = inv_mpi_type_vec[old_row[nn].nn];
+               index++;
+            }
+         }
+
+         // Swap tmp data over old data
+         nlist.start_index.swap(tmp_start_index);
+         nlist.list.swap(tmp_list);
+
+         return;
+
+      }
+
       //------------------------------------------------------------------------
       // Sort atoms accoriding to order core | boundary | halo
       //------------------------------------------------------------------------
@@ -684,100 +723,22 @@ namespace create{
          zlog << zTs() << "Number of local atoms: " << vmpi::num_core_atoms +vmpi::num_bdry_atoms << std::endl;
          zlog << zTs() << "Number of total atoms: " << vmpi::num_core_atoms +vmpi::num_bdry_atoms + vmpi::num_halo_atoms << std::endl;
 
-         // create temporary catom and cneighbourlist arrays for copying data
+         // create temporary catom array for copying data
          std::vector <cs::catom_t> tmp_catom_array(new_num_atoms);
-         std::vector <std::vector <neighbours::neighbour_t> > tmp_bilinear(new_num_atoms);
-         std::vector <std::vector <neighbours::neighbour_t> > tmp_biquadratic(new_num_atoms);
 
          // Populate tmp arrays (assuming all mpi_type=3 atoms are at the end of the array?)
          for (unsigned int atom=0;atom<new_num_atoms;atom++){ // new atom number
             unsigned int old_atom_num = mpi_type_vec[atom].atom_number;
             tmp_catom_array[atom]=catom_array[old_atom_num];
             tmp_catom_array[atom].mpi_old_atom_number=old_atom_num; // Store old atom numbers for translation after sorting
-            //---//tmp_cneighbourlist[atom].reserve(cneighbourlist[old_atom_num].size());
-
-            //Copy neighbourlist using new atom numbers
-            //if(vmpi::my_rank==0) std::cout << vmpi::my_rank << " old " << old_atom_num << " nn: ";
-            /*for(unsigned int nn=0;nn<cneighbourlist[old_atom_num].size();nn++){
-               unsigned int old_nn_number = cneighbourlist[old_atom_num][nn].nn;
-               unsigned int interaction_id= cneighbourlist[old_atom_num][nn].i;
-               unsigned int new_nn_number = inv_mpi_type_vec[old_nn_number];
-               cs::neighbour_t temp_nt;
-               temp_nt.nn=new_nn_number;
-               temp_nt.i=interaction_id;
-               // Actual neighbours stay the same so simply copy separation vectors
-               temp_nt.vx=cneighbourlist[old_atom_num][nn].vx;
-               temp_nt.vy=cneighbourlist[old_atom_num][nn].vy;
-               temp_nt.vz=cneighbourlist[old_atom_num][nn].vz;
-               // ignore all halo-x interactions but not x-halo
-               //if(!((mpi_type_vec[atom].mpi_type==2) && (mpi_type_vec[new_nn_number].mpi_type==2)))
-               if(!(mpi_type_vec[atom].mpi_type==2))
-               tmp_cneighbourlist[atom].push_back(temp_nt);
-               //else std::cerr << "ignoring interaction " << atom << "\t" << new_nn_number << " on " << vmpi::my_rank << std::endl;
-               //if(vmpi::my_rank==0) std::cout << cneighbourlist[old_atom_num][nn].nn << "\t";
-            }*/
-
-            tmp_bilinear[atom].reserve(bilinear.list[old_atom_num].size());
-
-            // Copy bilinear neighbourlist using new atom numbers
-            for(unsigned int nn = 0; nn < bilinear.list[old_atom_num].size(); nn++){
-
-               unsigned int old_nn_number = bilinear.list[old_atom_num][nn].nn;
-               unsigned int interaction_id= bilinear.list[old_atom_num][nn].i;
-               unsigned int new_nn_number = inv_mpi_type_vec[old_nn_number];
-
-               neighbours::neighbour_t temp_nt;
-
-               temp_nt.nn=new_nn_number;
-               temp_nt.i=interaction_id;
-
-               // Actual neighbours stay the same so simply copy separation vectors
-               temp_nt.vx=bilinear.list[old_atom_num][nn].vx;
-               temp_nt.vy=bilinear.list[old_atom_num][nn].vy;
-               temp_nt.vz=bilinear.list[old_atom_num][nn].vz;
-
-               // ignore all halo-x interactions but not x-halo
-               if(!(mpi_type_vec[atom].mpi_type==2)) tmp_bilinear[atom].push_back(temp_nt);
-
-            }
-
-            // optionally replace biquadratic list
-            if(exchange::biquadratic){
-               tmp_biquadratic[atom].reserve(biquadratic.list[old_atom_num].size());
-
-               // Copy bilinear neighbourlist using new atom numbers
-               for(unsigned int nn = 0; nn < biquadratic.list[old_atom_num].size();nn++){
-
-                  unsigned int old_nn_number = biquadratic.list[old_atom_num][nn].nn;
-                  unsigned int interaction_id= biquadratic.list[old_atom_num][nn].i;
-                  unsigned int new_nn_number = inv_mpi_type_vec[old_nn_number];
-
-                  neighbours::neighbour_t temp_nt;
-
-                  temp_nt.nn = new_nn_number;
-                  temp_nt.i = interaction_id;
-
-                  // Actual neighbours stay the same so simply copy separation vectors
-                  temp_nt.vx = biquadratic.list[old_atom_num][nn].vx;
-                  temp_nt.vy = biquadratic.list[old_atom_num][nn].vy;
-                  temp_nt.vz = biquadratic.list[old_atom_num][nn].vz;
-
-                  // ignore all halo-x interactions but not x-halo
-                  if(!(mpi_type_vec[atom].mpi_type==2)) tmp_biquadratic[atom].push_back(temp_nt);
-
-               }
-            } // end of biquadratic
-
          }
 
-
-
          // Swap tmp data over old data more efficient and saves memory
          catom_array.swap(tmp_catom_array);
-         //----// cneighbourlist.swap(tmp_cneighbourlist); // This actually works(!) - COPIES both pointers and elements of pointers
 
-         bilinear.list.swap(tmp_bilinear); // This actually works(!) - COPIES both pointers and elements of pointers
-         biquadratic.list.swap(tmp_biquadratic);
+         // Reorder neighbour lists using new atom numbers
+         reorder_neighbour_list(bilinear, mpi_type_vec, inv_mpi_type_vec, new_num_atoms);
+         if(exchange::biquadratic) reorder_neighbour_list(biquadratic, mpi_type_vec, inv_mpi_type_vec, new_num_atoms);
 
          // Print out final neighbourlist
          //for (unsigned int atom=0;atom<new_num_atoms;atom++){
@@ -246,17 +246,13 @@ void clear_atoms(std::vector<cs::catom_t> & catom_array){
 
    // check if there are unneeded atoms
    if(num_atoms!=num_included){
-      // create temporary copy for atoms
-      std::vector<cs::catom_t> tmp_catom_array(num_atoms);
-      tmp_catom_array=catom_array;
-      // resize original array to new number of atoms
-      catom_array.resize(num_included);
+      // compact array in place, preserving atom order
       int atom=0;
       // loop over all existing atoms
       for(int a=0;a<num_atoms;a++){
-         // if atom is to be included and is non-magnetic copy to new array
+         // if atom is to be included and is non-magnetic copy to new position
          if(catom_array[a].include==true && mp::material[catom_array[a].material].non_magnetic != 1 ){
-            catom_array[atom]=tmp_catom_array[a];
+            if(atom != a) catom_array[atom]=catom_array[a];
             atom++;
          }
          // if atom is part of a non-magnetic material to be removed then save to nm array
@@ -266,12 +262,14 @@ void clear_atoms(std::vector<cs::catom_t> & catom_array){
          	tmp.y = catom_array[a].y;
          	tmp.z = catom_array[a].z;
          	tmp.mat = catom_array[a].material;
-            tmp.cat = catom_array[atom].lh_category;
+            tmp.cat = catom_array[a].lh_category;
          	// save atom to non-magnet array
          	cs::non_magnetic_atoms_array.push_back(tmp);
          }
       }
-      tmp_catom_array.resize(0);
+      // release memory of removed atoms
+      catom_array.resize(num_included);
+      catom_array.shrink_to_fit();
 
       zlog << zTs() << "Removed " << cs::non_magnetic_atoms_array.size() << " non-magnetic atoms from system" << std::endl;
 
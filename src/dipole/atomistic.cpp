@@ -142,18 +142,11 @@ namespace dipole{
    }
 
    //------------------------------------------------------------------------
-   // Function to calculate atomistic resolution dipole field
-   //
-   //
+   // Function to copy spin directions of all atoms to all processors
    //------------------------------------------------------------------------
-   void calculate_atomistic_dipole_field(std::vector<double>& x_spin_array, // atomic spin directions
-                                         std::vector<double>& y_spin_array,
-                                         std::vector<double>& z_spin_array){
-
-       const double prefactor = 0.9274009994; // mu_o_4pi * muB / Angstrom^3 = 1.0e-7 * 9.274009994e-24 / 1.0e-30 = 0.9274009994
-
-       // cast number of local atoms to a local constant
-       const int num_atoms_on_my_processor = dp::num_local_atoms;
+   void gather_atomistic_spins(std::vector<double>& x_spin_array, // atomic spin directions
+                               std::vector<double>& y_spin_array,
+                               std::vector<double>& z_spin_array){
 
       #ifdef MPICF
 
@@ -173,6 +166,27 @@ namespace dipole{
 
       #endif
 
+      return;
+
+   }
+
+   //------------------------------------------------------------------------
+   // Function to calculate atomistic resolution dipole field
+   //
+   //
+   //------------------------------------------------------------------------
+   void calculate_atomistic_dipole_field(std::vector<double>& x_spin_array, // atomic spin directions
+                                         std::vector<double>& y_spin_array,
+                                         std::vector<double>& z_spin_array){
+
+       const double prefactor = 0.9274009994; // mu_o_4pi * muB / Angstrom^3 = 1.0e-7 * 9.274009994e-24 / 1.0e-30 = 0.9274009994
+
+       // cast number of local atoms to a local constant
+       const int num_atoms_on_my_processor = dp::num_local_atoms;
+
+      // collate and broadcast new spin positions to all processors
+      dp::gather_atomistic_spins(x_spin_array, y_spin_array, z_spin_array);
+
       //------------------------------------------------------------------------
       // Loop over all local atoms
       //------------------------------------------------------------------------
@@ -0,0 +1,138 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) Richard F L Evans 2018. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+// Vampire headers
+#include "cells.hpp"
+#include "create.hpp"
+#include "dipole.hpp"
+#include "vio.hpp"
+#include "vutil.hpp"
+
+// dipole module headers
+#include "internal.hpp"
+
+namespace dipole{
+
+   namespace internal{
+
+      // cache file identifier and format version
+      const char tensor_cache_magic[8] = {'V','A','M','P','D','I','P','T'};
+      const uint64_t tensor_cache_version = 1;
+
+      //------------------------------------------------------------------------
+      // Function to calculate key for dipole tensor cache from the structure
+      // hash and the macrocell discretisation
+      //------------------------------------------------------------------------
+      uint64_t calculate_tensor_cache_key(const double cutoff,
+                                          const std::vector<int>& cells_num_atoms_in_cell_global,
+                                          const std::vector<double>& cells_pos_and_mom_array){
+
+         vutil::hash_t hash;
+         hash.add(&create::structure_hash, sizeof(uint64_t));
+         hash.add(&tensor_cache_version, sizeof(uint64_t));
+         hash.add(&cutoff, sizeof(double));
+         hash.add(&cells::macro_cell_size, sizeof(double));
+         hash.add(&dipole::internal::cells_num_cells, sizeof(int));
+         hash.add(&dipole::internal::cells_num_local_cells, sizeof(int));
+         hash.add(cells_num_atoms_in_cell_global.data(), cells_num_atoms_in_cell_global.size()*sizeof(int));
+         hash.add(cells_pos_and_mom_array.data(), cells_pos_and_mom_array.size()*sizeof(double));
+
+         return hash.value();
+
+      }
+
+      //------------------------------------------------------------------------
+      // Function to load precalculated dipole tensors from cache file. Returns
+      // true if tensors with a matching key have been loaded.
+      //------------------------------------------------------------------------
+      bool load_tensor_cache(const uint64_t key){
+
+         const std::string filename = create::structure_cache_file_name + ".dipole";
+
+         std::ifstream ifile(filename.c_str(), std::ios::binary);
+         if(!ifile.is_open()) return false;
+
+         char magic[8];
+         uint64_t file_key = 0;
+         ifile.read(magic, sizeof(magic));
+         ifile.read(reinterpret_cast<char*>(&file_key), sizeof(uint64_t));
+         if(!ifile || std::memcmp(magic, tensor_cache_magic, sizeof(magic)) != 0 || file_key != key){
+            zlog << zTs() << "Dipole tensor cache file \"" << filename << "\" does not match system, recalculating tensors" << std::endl;
+            return false;
+         }
+
+         std::vector < std::vector < double > >* tensors[6] = { &rij_tensor_xx, &rij_tensor_xy, &rij_tensor_xz,
+                                                                &rij_tensor_yy, &rij_tensor_yz, &rij_tensor_zz };
+
+         // read tensors directly into preallocated arrays
+         for(int t = 0; t < 6; t++){
+            for(int lc = 0; lc < dipole::internal::cells_num_local_cells; lc++){
+               std::vector<double>& row = (*tensors[t])[lc];
+               ifile.read(reinterpret_cast<char*>(row.data()), row.size()*sizeof(double));
+            }
+         }
+
+         if(!ifile){
+            zlog << zTs() << "Dipole tensor cache file \"" << filename << "\" is truncated, recalculating tensors" << std::endl;
+            for(int t = 0; t < 6; t++){
+               for(int lc = 0; lc < dipole::internal::cells_num_local_cells; lc++){
+                  std::fill((*tensors[t])[lc].begin(), (*tensors[t])[lc].end(), 0.0);
+               }
+            }
+            return false;
+         }
+
+         std::cout << "Loaded dipole tensors from cache file \"" << filename << "\"" << std::endl;
+         zlog << zTs() << "Loaded dipole tensors from cache file \"" << filename << "\"" << std::endl;
+
+         return true;
+
+      }
+
+      //------------------------------------------------------------------------
+      // Function to save precalculated dipole tensors to cache file
+      //------------------------------------------------------------------------
+      void save_tensor_cache(const uint64_t key){
+
+         const std::string filename = create::structure_cache_file_name + ".dipole";
+
+         std::ofstream ofile(filename.c_str(), std::ios::binary | std::ios::trunc);
+         if(!ofile.is_open()){
+            zlog << zTs() << "Warning: Unable to open dipole tensor cache file \"" << filename << "\" for writing. Continuing without cache." << std::endl;
+            return;
+         }
+
+         ofile.write(tensor_cache_magic, sizeof(tensor_cache_magic));
+         ofile.write(reinterpret_cast<const char*>(&key), sizeof(uint64_t));
+
+         const std::vector < std::vector < double > >* tensors[6] = { &rij_tensor_xx, &rij_tensor_xy, &rij_tensor_xz,
+                                                                      &rij_tensor_yy, &rij_tensor_yz, &rij_tensor_zz };
+
+         for(int t = 0; t < 6; t++){
+            for(int lc = 0; lc < dipole::internal::cells_num_local_cells; lc++){
+               const std::vector<double>& row = (*tensors[t])[lc];
+               ofile.write(reinterpret_cast<const char*>(row.data()), row.size()*sizeof(double));
+            }
+         }
+
+         zlog << zTs() << "Saved dipole tensors to cache file \"" << filename << "\"" << std::endl;
+
+         return;
+
+      }
+
+   } // end of namespace internal
+
+} // end of namespace dipole
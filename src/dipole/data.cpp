@@ -95,10 +95,21 @@ namespace dipole{
       std::vector <int>  cells_local_cell_array;
       std::vector <int>  cells_num_atoms_in_cell;
       std::vector < double > cells_volume_array;
+      std::vector < double > cells_self_demag_array; // self-demagnetisation factor 8pi/3V of each cell
 
       std::vector<double> cells_pos_and_mom_array;
       std::vector < int > proc_cell_index_array1D;
 
+      std::vector < int > local_cell_partition; // range of local cells calculated by each thread
+
+      // lists of cell fields sent to and received from each processor
+      bool cells_field_gather_initialised = false;
+      bool cells_field_gather_needed = false;
+      std::vector < int > cells_field_send_cells;
+      std::vector < int > cells_field_send_counts;
+      std::vector < int > cells_field_recv_cells;
+      std::vector < int > cells_field_recv_counts;
+
 
       //------------------------------------------------------------------------
       // data structures for atomistic solver
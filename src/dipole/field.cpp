@@ -51,6 +51,9 @@ namespace dipole{
       // return if dipole field not enabled
       if(!dipole::activated) return;
 
+      // time dipole field update
+      vutil::profile::scope_t profile(vutil::profile::dipole);
+
 		// prevent double calculation for split integration (MPI)
 		if(dipole::internal::update_time != static_cast<int>(sim_time)){
 
@@ -93,6 +96,10 @@ namespace dipole{
                   dipole::internal::atomistic_fft::update_field_atomistic_fft();
                   break;
 
+               case dipole::internal::fmm:
+                  dipole::internal::fast_multipole::update_field_fmm(x_spin_array, y_spin_array, z_spin_array);
+                  break;
+
 
             }
 
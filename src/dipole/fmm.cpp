@@ -0,0 +1,740 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) Richard F L Evans 2022. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+// Vampire headers
+#include "dipole.hpp"
+#include "vio.hpp"
+#include "vmpi.hpp"
+#include "vutil.hpp"
+
+// dipole module headers
+#include "internal.hpp"
+
+// alias interal dipole namespace for brevity
+namespace dp = dipole::internal;
+
+//------------------------------------------------------------------------------
+// Fast multipole method for atomistic dipole fields
+//
+// The dipole field H = -grad phi is derived from the scalar potential
+//
+//    phi(x) = sum_j m_j . (x - y_j) / |x - y_j|^3
+//
+// which is expanded in Cartesian Taylor series. Using multi-indices k and the
+// derivatives of the Coulomb kernel T_k(R) = 1/k! d^k/dR^k (1/|R|), the
+// potential of the dipoles in an octree cell centred at c is
+//
+//    phi(x) = sum_k M_k T_k(x - c),    M_k = - sum_j sum_i k_i m_ji (c - y_j)^(k - e_i)
+//
+// and the potential of far cells is collected in local expansions about the
+// centre c of the target cell
+//
+//    phi(x) = sum_n L_n (x - c)^n
+//
+// Expansions are truncated at total order p = expansion_order. Cells which are
+// not adjacent to a target cell but whose parents are adjacent to its parent
+// are translated with M2L, and adjacent leaf cells are summed directly.
+//------------------------------------------------------------------------------
+namespace dipole{
+
+   namespace internal{
+
+      namespace fast_multipole{
+
+         //------------------------------------------------------------------------
+         // Externally visible variables
+         //------------------------------------------------------------------------
+         int expansion_order = 6; // maximum order of multipole and local expansions
+         int atoms_per_cell = 32; // target number of atoms in each leaf cell of octree
+
+         //------------------------------------------------------------------------
+         // file-local storage variables
+         //------------------------------------------------------------------------
+         const int max_depth = 20; // maximum depth of octree (3 x 20 bit keys)
+
+         // multi-index coefficients k = (kx, ky, kz) with |k| <= p ordered by degree
+         int num_coefficients = 0;
+         std::vector<int> coefficient_x;
+         std::vector<int> coefficient_y;
+         std::vector<int> coefficient_z;
+         std::vector<int> coefficient_lookup; // index of coefficient (kx, ky, kz)
+         std::vector<int> power_parent; // coefficient k - e_i used to calculate power x^k
+         std::vector<int> power_axis;   // axis i used to calculate power x^k
+         std::vector<int> lower_x;      // coefficient k - e_x (-1 if kx = 0)
+         std::vector<int> lower_y;
+         std::vector<int> lower_z;
+
+         // list of translation terms (a, b, a-b or a+b, binomial coefficient)
+         struct term_t{
+            int a;
+            int b;
+            int c;
+            double coefficient;
+         };
+         std::vector<term_t> shift_terms; // M2M and L2L terms C(k,l) for l <= k
+         std::vector<term_t> m2l_terms;   // M2L terms C(n+k,n) for |n| + |k| <= p
+
+         // octree data
+         int leaf_level = 0;
+         double cube_size = 0.0;          // size of cube containing all atoms (Angstroms)
+         double cube_min[3] = {0.0, 0.0, 0.0};
+         std::vector<int> level_start;    // index of first cell at each level
+         std::vector<uint64_t> cell_key;  // morton key of cell at its level
+         std::vector<int> cell_ix;        // integer coordinates of cell at its level
+         std::vector<int> cell_iy;
+         std::vector<int> cell_iz;
+         std::vector<double> cell_cx;     // cell centre coordinates (Angstroms)
+         std::vector<double> cell_cy;
+         std::vector<double> cell_cz;
+         std::vector<int> cell_parent;
+         std::vector<int> cell_child_start;
+         std::vector<int> cell_child_end;
+         std::vector<int> cell_atom_start; // range of sorted atoms in cell
+         std::vector<int> cell_atom_end;
+         std::vector<bool> cell_target;    // cell contains atoms on this processor
+
+         // interaction lists stored in compressed row format
+         std::vector<int> m2l_start;
+         std::vector<int> m2l_source;
+         std::vector<int> m2l_offset;
+         std::vector<int> near_start;
+         std::vector<int> near_source;
+
+         // tabulated kernel derivatives T_k for each level and cell offset
+         std::vector<double> kernel_table;
+
+         // atoms sorted by octree cell
+         std::vector<int> sorted_atom;     // ID of atom in total list
+         std::vector<double> sorted_x;     // atomic coordinates
+         std::vector<double> sorted_y;
+         std::vector<double> sorted_z;
+         std::vector<double> sorted_mx;    // atomic moments (bohr magnetons)
+         std::vector<double> sorted_my;
+         std::vector<double> sorted_mz;
+
+         // multipole and local expansions of each cell
+         std::vector<double> multipole;
+         std::vector<double> local;
+
+         //------------------------------------------------------------------------
+         // Function to determine index of multi-index coefficient
+         //------------------------------------------------------------------------
+         int coefficient_index(const int kx, const int ky, const int kz){
+            const int p = expansion_order;
+            if(kx < 0 || ky < 0 || kz < 0 || kx + ky + kz > p) return -1;
+            return coefficient_lookup[(kx*(p + 1) + ky)*(p + 1) + kz];
+         }
+
+         //------------------------------------------------------------------------
+         // Function to calculate binomial coefficient
+         //------------------------------------------------------------------------
+         double binomial(const int n, const int k){
+            double result = 1.0;
+            for(int i = 1; i <= k; i++) result = result * double(n - k + i) / double(i);
+            return result;
+         }
+
+         //------------------------------------------------------------------------
+         // Function to calculate powers x^k of vector for all coefficients
+         //------------------------------------------------------------------------
+         inline void calculate_powers(const double x, const double y, const double z, double* powers){
+            const double r[3] = {x, y, z};
+            powers[0] = 1.0;
+            for(int k = 1; k < num_coefficients; k++) powers[k] = powers[power_parent[k]] * r[power_axis[k]];
+         }
+
+         //------------------------------------------------------------------------
+         // Function to calculate derivatives T_k(R) of 1/|R| for all coefficients
+         // using the recurrence relation
+         //
+         //    |R|^2 T_k + (2 - 1/|k|) sum_i R_i T_{k-e_i} + (1 - 1/|k|) sum_i T_{k-2e_i} = 0
+         //------------------------------------------------------------------------
+         void calculate_kernel(const double rx, const double ry, const double rz, double* T){
+            const double r2 = rx*rx + ry*ry + rz*rz;
+            const double ir2 = 1.0/r2;
+            T[0] = sqrt(ir2);
+            for(int k = 1; k < num_coefficients; k++){
+               const double order = coefficient_x[k] + coefficient_y[k] + coefficient_z[k];
+               const double a = 2.0 - 1.0/order;
+               const double b = 1.0 - 1.0/order;
+               double sum = 0.0;
+               if(lower_x[k] >= 0) sum += a*rx*T[lower_x[k]];
+               if(lower_y[k] >= 0) sum += a*ry*T[lower_y[k]];
+               if(lower_z[k] >= 0) sum += a*rz*T[lower_z[k]];
+               if(coefficient_x[k] > 1) sum += b*T[lower_x[lower_x[k]]];
+               if(coefficient_y[k] > 1) sum += b*T[lower_y[lower_y[k]]];
+               if(coefficient_z[k] > 1) sum += b*T[lower_z[lower_z[k]]];
+               T[k] = -sum*ir2;
+            }
+         }
+
+         //------------------------------------------------------------------------
+         // Function to interleave bits of cell coordinates to form morton key
+         //------------------------------------------------------------------------
+         uint64_t morton_key(const uint64_t ix, const uint64_t iy, const uint64_t iz, const int level){
+            uint64_t key = 0;
+            for(int bit = 0; bit < level; bit++){
+               key |= ((ix >> bit) & 1) << (3*bit + 2);
+               key |= ((iy >> bit) & 1) << (3*bit + 1);
+               key |= ((iz >> bit) & 1) << (3*bit + 0);
+            }
+            return key;
+         }
+
+         //------------------------------------------------------------------------
+         // Function to find cell with coordinates at level (-1 if not occupied)
+         //------------------------------------------------------------------------
+         int find_cell(const int ix, const int iy, const int iz, const int level){
+            const int num_cells_1D = 1 << level;
+            if(ix < 0 || iy < 0 || iz < 0 || ix >= num_cells_1D || iy >= num_cells_1D || iz >= num_cells_1D) return -1;
+            const uint64_t key = morton_key(ix, iy, iz, level);
+            std::vector<uint64_t>::iterator begin = cell_key.begin() + level_start[level];
+            std::vector<uint64_t>::iterator end = cell_key.begin() + level_start[level+1];
+            std::vector<uint64_t>::iterator it = std::lower_bound(begin, end, key);
+            if(it == end || *it != key) return -1;
+            return it - cell_key.begin();
+         }
+
+         //------------------------------------------------------------------------
+         // Function to index offset between cells at the same level
+         //------------------------------------------------------------------------
+         inline int offset_index(const int dx, const int dy, const int dz){
+            return ((dx + 3)*7 + (dy + 3))*7 + (dz + 3);
+         }
+
+         //------------------------------------------------------------------------
+         // Function to initialise multi-index coefficient and translation tables
+         //------------------------------------------------------------------------
+         void initialize_coefficients(){
+
+            const int p = expansion_order;
+
+            coefficient_x.clear();
+            coefficient_y.clear();
+            coefficient_z.clear();
+            for(int order = 0; order <= p; order++){
+               for(int kx = order; kx >= 0; kx--){
+                  for(int ky = order - kx; ky >= 0; ky--){
+                     coefficient_x.push_back(kx);
+                     coefficient_y.push_back(ky);
+                     coefficient_z.push_back(order - kx - ky);
+                  }
+               }
+            }
+            num_coefficients = coefficient_x.size();
+
+            coefficient_lookup.assign((p + 1)*(p + 1)*(p + 1), -1);
+            for(int k = 0; k < num_coefficients; k++){
+               coefficient_lookup[(coefficient_x[k]*(p + 1) + coefficient_y[k])*(p + 1) + coefficient_z[k]] = k;
+            }
+
+            power_parent.assign(num_coefficients, 0);
+            power_axis.assign(num_coefficients, 0);
+            lower_x.assign(num_coefficients, -1);
+            lower_y.assign(num_coefficients, -1);
+            lower_z.assign(num_coefficients, -1);
+            for(int k = 0; k < num_coefficients; k++){
+               const int kx = coefficient_x[k];
+               const int ky = coefficient_y[k];
+               const int kz = coefficient_z[k];
+               lower_x[k] = coefficient_index(kx - 1, ky, kz);
+               lower_y[k] = coefficient_index(kx, ky - 1, kz);
+               lower_z[k] = coefficient_index(kx, ky, kz - 1);
+               if(kx > 0){ power_parent[k] = lower_x[k]; power_axis[k] = 0; }
+               else if(ky > 0){ power_parent[k] = lower_y[k]; power_axis[k] = 1; }
+               else if(kz > 0){ power_parent[k] = lower_z[k]; power_axis[k] = 2; }
+            }
+
+            // translation terms, omitting monopole terms which are zero for dipoles
+            // and do not contribute to the field
+            shift_terms.clear();
+            m2l_terms.clear();
+            for(int a = 1; a < num_coefficients; a++){
+               for(int b = 1; b < num_coefficients; b++){
+                  const int ax = coefficient_x[a], ay = coefficient_y[a], az = coefficient_z[a];
+                  const int bx = coefficient_x[b], by = coefficient_y[b], bz = coefficient_z[b];
+                  // C(a,b) for b <= a
+                  const int difference = coefficient_index(ax - bx, ay - by, az - bz);
+                  if(difference >= 0){
+                     term_t term = {a, b, difference, binomial(ax, bx)*binomial(ay, by)*binomial(az, bz)};
+                     shift_terms.push_back(term);
+                  }
+                  // C(a+b,a) for |a| + |b| <= p
+                  const int sum = coefficient_index(ax + bx, ay + by, az + bz);
+                  if(sum >= 0){
+                     term_t term = {a, b, sum, binomial(ax + bx, ax)*binomial(ay + by, ay)*binomial(az + bz, az)};
+                     m2l_terms.push_back(term);
+                  }
+               }
+            }
+
+            return;
+
+         }
+
+         //------------------------------------------------------------------------
+         // Function to initialise fast multipole solver. Atomic positions and
+         // moments of all atoms are stored by the atomistic solver.
+         //------------------------------------------------------------------------
+         void initialize_fmm_solver(){
+
+            // instantiate timer
+            vutil::vtimer_t timer;
+            timer.start();
+
+            initialize_coefficients();
+
+            const int num_atoms = dp::total_num_atoms;
+
+            #ifdef MPICF
+               const int first_local_atom = dp::receive_displacements[vmpi::my_rank];
+            #else
+               const int first_local_atom = 0;
+            #endif
+            const int last_local_atom = first_local_atom + dp::num_local_atoms;
+
+            //----------------------------------------------------------
+            // Determine cube containing all atoms
+            //----------------------------------------------------------
+            double max_coord[3] = {-1.0e300, -1.0e300, -1.0e300};
+            cube_min[0] = 1.0e300;
+            cube_min[1] = 1.0e300;
+            cube_min[2] = 1.0e300;
+            for(int atom = 0; atom < num_atoms; atom++){
+               cube_min[0] = std::min(cube_min[0], dp::cx[atom]);
+               cube_min[1] = std::min(cube_min[1], dp::cy[atom]);
+               cube_min[2] = std::min(cube_min[2], dp::cz[atom]);
+               max_coord[0] = std::max(max_coord[0], dp::cx[atom]);
+               max_coord[1] = std::max(max_coord[1], dp::cy[atom]);
+               max_coord[2] = std::max(max_coord[2], dp::cz[atom]);
+            }
+            cube_size = std::max(max_coord[0] - cube_min[0], std::max(max_coord[1] - cube_min[1], max_coord[2] - cube_min[2]));
+            // enlarge cube slightly so that all atoms are inside
+            cube_size = cube_size*(1.0 + 1.0e-6) + 1.0e-6;
+
+            //----------------------------------------------------------
+            // Sort atoms by morton key of deepest level
+            //----------------------------------------------------------
+            const uint64_t max_cells_1D = uint64_t(1) << max_depth;
+            std::vector< std::pair<uint64_t,int> > atom_keys(num_atoms);
+            std::vector<int> atom_ix(num_atoms);
+            std::vector<int> atom_iy(num_atoms);
+            std::vector<int> atom_iz(num_atoms);
+            for(int atom = 0; atom < num_atoms; atom++){
+               atom_ix[atom] = std::min(uint64_t((dp::cx[atom] - cube_min[0])/cube_size*max_cells_1D), max_cells_1D - 1);
+               atom_iy[atom] = std::min(uint64_t((dp::cy[atom] - cube_min[1])/cube_size*max_cells_1D), max_cells_1D - 1);
+               atom_iz[atom] = std::min(uint64_t((dp::cz[atom] - cube_min[2])/cube_size*max_cells_1D), max_cells_1D - 1);
+               atom_keys[atom] = std::make_pair(morton_key(atom_ix[atom], atom_iy[atom], atom_iz[atom], max_depth), atom);
+            }
+            std::sort(atom_keys.begin(), atom_keys.end());
+
+            //----------------------------------------------------------
+            // Determine depth of octree so that the average number of
+            // atoms in occupied leaf cells is closest to the target
+            //----------------------------------------------------------
+            leaf_level = 0;
+            double atoms_per_leaf = num_atoms;
+            while(leaf_level < max_depth){
+               const int shift = 3*(max_depth - leaf_level - 1);
+               int num_occupied_cells = 0;
+               for(int i = 0; i < num_atoms; i++){
+                  if(i == 0 || (atom_keys[i].first >> shift) != (atom_keys[i-1].first >> shift)) num_occupied_cells++;
+               }
+               const double atoms_per_child = double(num_atoms)/double(num_occupied_cells);
+               // stop when next level is further from target (ratio of averages)
+               if(atoms_per_leaf*atoms_per_child <= double(atoms_per_cell)*double(atoms_per_cell)) break;
+               atoms_per_leaf = atoms_per_child;
+               leaf_level++;
+            }
+
+            //----------------------------------------------------------
+            // Create occupied cells at each level
+            //----------------------------------------------------------
+            level_start.assign(leaf_level + 2, 0);
+            cell_key.clear(); cell_ix.clear(); cell_iy.clear(); cell_iz.clear();
+            cell_atom_start.clear(); cell_atom_end.clear();
+            for(int level = 0; level <= leaf_level; level++){
+               level_start[level] = cell_key.size();
+               const int shift = 3*(max_depth - level);
+               for(int i = 0; i < num_atoms; i++){
+                  const uint64_t key = atom_keys[i].first >> shift;
+                  if(i == 0 || key != (atom_keys[i-1].first >> shift)){
+                     const int atom = atom_keys[i].second;
+                     cell_key.push_back(key);
+                     cell_ix.push_back(atom_ix[atom] >> (max_depth - level));
+                     cell_iy.push_back(atom_iy[atom] >> (max_depth - level));
+                     cell_iz.push_back(atom_iz[atom] >> (max_depth - level));
+                     cell_atom_start.push_back(i);
+                     cell_atom_end.push_back(i);
+                  }
+                  cell_atom_end.back() = i + 1;
+               }
+            }
+            level_start[leaf_level + 1] = cell_key.size();
+            const int num_cells = cell_key.size();
+
+            cell_cx.resize(num_cells);
+            cell_cy.resize(num_cells);
+            cell_cz.resize(num_cells);
+            cell_parent.assign(num_cells, -1);
+            cell_child_start.assign(num_cells, 0);
+            cell_child_end.assign(num_cells, 0);
+            for(int level = 0; level <= leaf_level; level++){
+               const double h = cube_size/double(1 << level);
+               for(int cell = level_start[level]; cell < level_start[level+1]; cell++){
+                  cell_cx[cell] = cube_min[0] + (cell_ix[cell] + 0.5)*h;
+                  cell_cy[cell] = cube_min[1] + (cell_iy[cell] + 0.5)*h;
+                  cell_cz[cell] = cube_min[2] + (cell_iz[cell] + 0.5)*h;
+                  if(level > 0){
+                     const int parent = find_cell(cell_ix[cell] >> 1, cell_iy[cell] >> 1, cell_iz[cell] >> 1, level - 1);
+                     cell_parent[cell] = parent;
+                     // children are contiguous as cells are sorted by key
+                     if(cell_child_end[parent] == 0) cell_child_start[parent] = cell;
+                     cell_child_end[parent] = cell + 1;
+                  }
+               }
+            }
+
+            //----------------------------------------------------------
+            // Store sorted atom data
+            //----------------------------------------------------------
+            sorted_atom.resize(num_atoms);
+            sorted_x.resize(num_atoms);
+            sorted_y.resize(num_atoms);
+            sorted_z.resize(num_atoms);
+            sorted_mx.resize(num_atoms);
+            sorted_my.resize(num_atoms);
+            sorted_mz.resize(num_atoms);
+            for(int i = 0; i < num_atoms; i++){
+               const int atom = atom_keys[i].second;
+               sorted_atom[i] = atom;
+               sorted_x[i] = dp::cx[atom];
+               sorted_y[i] = dp::cy[atom];
+               sorted_z[i] = dp::cz[atom];
+            }
+
+            //----------------------------------------------------------
+            // Determine cells containing atoms on this processor
+            //----------------------------------------------------------
+            cell_target.assign(num_cells, false);
+            for(int cell = level_start[leaf_level]; cell < num_cells; cell++){
+               for(int i = cell_atom_start[cell]; i < cell_atom_end[cell]; i++){
+                  if(sorted_atom[i] >= first_local_atom && sorted_atom[i] < last_local_atom){
+                     for(int c = cell; c >= 0 && !cell_target[c]; c = cell_parent[c]) cell_target[c] = true;
+                     break;
+                  }
+               }
+            }
+
+            //----------------------------------------------------------
+            // Determine interaction lists of target cells
+            //----------------------------------------------------------
+            m2l_start.assign(num_cells + 1, 0);
+            m2l_source.clear();
+            m2l_offset.clear();
+            near_start.assign(num_cells + 1, 0);
+            near_source.clear();
+            for(int level = 0; level <= leaf_level; level++){
+               for(int cell = level_start[level]; cell < level_start[level+1]; cell++){
+
+                  m2l_start[cell] = m2l_source.size();
+                  near_start[cell] = near_source.size();
+                  if(!cell_target[cell]) continue;
+
+                  // root cell only interacts with itself
+                  if(level == 0){
+                     if(leaf_level == 0) near_source.push_back(cell);
+                     continue;
+                  }
+
+                  // loop over children of cells adjacent to parent
+                  const int parent = cell_parent[cell];
+                  for(int dx = -1; dx <= 1; dx++){
+                     for(int dy = -1; dy <= 1; dy++){
+                        for(int dz = -1; dz <= 1; dz++){
+                           const int neighbour = find_cell(cell_ix[parent] + dx, cell_iy[parent] + dy, cell_iz[parent] + dz, level - 1);
+                           if(neighbour < 0) continue;
+                           for(int source = cell_child_start[neighbour]; source < cell_child_end[neighbour]; source++){
+                              const int ox = cell_ix[cell] - cell_ix[source];
+                              const int oy = cell_iy[cell] - cell_iy[source];
+                              const int oz = cell_iz[cell] - cell_iz[source];
+                              // well separated cells are included by multipole expansion
+                              if(std::abs(ox) > 1 || std::abs(oy) > 1 || std::abs(oz) > 1){
+                                 m2l_source.push_back(source);
+                                 m2l_offset.push_back(offset_index(ox, oy, oz));
+                              }
+                              // adjacent leaf cells are summed directly
+                              else if(level == leaf_level) near_source.push_back(source);
+                           }
+                        }
+                     }
+                  }
+
+               }
+            }
+            m2l_start[num_cells] = m2l_source.size();
+            near_start[num_cells] = near_source.size();
+
+            //----------------------------------------------------------
+            // Tabulate kernel derivatives for all offsets of well
+            // separated cells at each level
+            //----------------------------------------------------------
+            kernel_table.assign((leaf_level + 1)*343*num_coefficients, 0.0);
+            for(int level = 2; level <= leaf_level; level++){
+               const double h = cube_size/double(1 << level);
+               for(int ox = -3; ox <= 3; ox++){
+                  for(int oy = -3; oy <= 3; oy++){
+                     for(int oz = -3; oz <= 3; oz++){
+                        if(std::abs(ox) <= 1 && std::abs(oy) <= 1 && std::abs(oz) <= 1) continue;
+                        calculate_kernel(ox*h, oy*h, oz*h, &kernel_table[(level*343 + offset_index(ox, oy, oz))*num_coefficients]);
+                     }
+                  }
+               }
+            }
+
+            multipole.assign(num_cells*num_coefficients, 0.0);
+            local.assign(num_cells*num_coefficients, 0.0);
+
+            timer.stop();
+
+            // calculate number of direct interactions
+            uint64_t num_near_interactions = 0;
+            for(int cell = level_start[leaf_level]; cell < num_cells; cell++){
+               for(int n = near_start[cell]; n < near_start[cell+1]; n++){
+                  const int source = near_source[n];
+                  num_near_interactions += uint64_t(cell_atom_end[cell] - cell_atom_start[cell])*uint64_t(cell_atom_end[source] - cell_atom_start[source]);
+               }
+            }
+
+            const int num_leaf_cells = num_cells - level_start[leaf_level];
+            const double mem = double(num_cells)*double(num_coefficients)*2.0*sizeof(double)/1.0e6 + double(kernel_table.size())*sizeof(double)/1.0e6;
+            zlog << zTs() << "Fast multipole dipole solver initialised with expansion order " << expansion_order << ", octree of " << leaf_level + 1 << " levels and "
+                 << num_cells << " occupied cells (" << num_leaf_cells << " leaf cells with " << double(num_atoms)/double(std::max(num_leaf_cells, 1)) << " atoms on average)" << std::endl;
+            zlog << zTs() << "Fast multipole dipole solver uses " << m2l_source.size() << " cell-cell and " << num_near_interactions << " direct atom-atom interactions on this processor and requires "
+                 << mem << " MB of RAM. Time taken: " << timer.elapsed_time() << " s" << std::endl;
+            std::cout << "Fast multipole dipole solver initialised with octree of " << leaf_level + 1 << " levels and " << num_cells << " occupied cells" << std::endl;
+
+            return;
+
+         }
+
+         //------------------------------------------------------------------------
+         // Function to calculate atomistic dipole field with fast multipole method
+         //------------------------------------------------------------------------
+         void update_field_fmm(std::vector<double>& x_spin_array, // atomic spin directions
+                               std::vector<double>& y_spin_array,
+                               std::vector<double>& z_spin_array){
+
+            const double prefactor = 0.9274009994; // mu_o_4pi * muB / Angstrom^3 = 1.0e-7 * 9.274009994e-24 / 1.0e-30 = 0.9274009994
+
+            const int num_atoms = dp::total_num_atoms;
+            const int num_cells = cell_key.size();
+            const int nc = num_coefficients;
+
+            #ifdef MPICF
+               const int first_local_atom = dp::receive_displacements[vmpi::my_rank];
+            #else
+               const int first_local_atom = 0;
+            #endif
+            const int last_local_atom = first_local_atom + dp::num_local_atoms;
+
+            // collate and broadcast new spin positions to all processors
+            dp::gather_atomistic_spins(x_spin_array, y_spin_array, z_spin_array);
+
+            #pragma omp parallel
+            {
+
+            // temporary storage for powers of position vectors
+            std::vector<double> powers(nc);
+
+            //----------------------------------------------------------
+            // Sort atomic moments by octree cell
+            //----------------------------------------------------------
+            #pragma omp for schedule(static)
+            for(int i = 0; i < num_atoms; i++){
+               const int atom = sorted_atom[i];
+               const double m = dp::sm[atom];
+               sorted_mx[i] = dp::sx[atom]*m;
+               sorted_my[i] = dp::sy[atom]*m;
+               sorted_mz[i] = dp::sz[atom]*m;
+            }
+
+            //----------------------------------------------------------
+            // Multipole expansions of leaf cells (P2M)
+            //----------------------------------------------------------
+            #pragma omp for schedule(dynamic,16)
+            for(int cell = level_start[leaf_level]; cell < num_cells; cell++){
+               double* M = &multipole[cell*nc];
+               std::fill(M, M + nc, 0.0);
+               for(int i = cell_atom_start[cell]; i < cell_atom_end[cell]; i++){
+                  calculate_powers(cell_cx[cell] - sorted_x[i], cell_cy[cell] - sorted_y[i], cell_cz[cell] - sorted_z[i], &powers[0]);
+                  for(int k = 1; k < nc; k++){
+                     double sum = 0.0;
+                     if(lower_x[k] >= 0) sum += coefficient_x[k]*sorted_mx[i]*powers[lower_x[k]];
+                     if(lower_y[k] >= 0) sum += coefficient_y[k]*sorted_my[i]*powers[lower_y[k]];
+                     if(lower_z[k] >= 0) sum += coefficient_z[k]*sorted_mz[i]*powers[lower_z[k]];
+                     M[k] -= sum;
+                  }
+               }
+            }
+
+            //----------------------------------------------------------
+            // Translate multipole expansions up the tree (M2M), only
+            // needed for levels with well separated cells
+            //----------------------------------------------------------
+            for(int level = leaf_level - 1; level >= 2; level--){
+               #pragma omp for schedule(dynamic,16)
+               for(int cell = level_start[level]; cell < level_start[level+1]; cell++){
+                  double* M = &multipole[cell*nc];
+                  std::fill(M, M + nc, 0.0);
+                  for(int child = cell_child_start[cell]; child < cell_child_end[cell]; child++){
+                     const double* Mc = &multipole[child*nc];
+                     calculate_powers(cell_cx[cell] - cell_cx[child], cell_cy[cell] - cell_cy[child], cell_cz[cell] - cell_cz[child], &powers[0]);
+                     for(unsigned int t = 0; t < shift_terms.size(); t++){
+                        const term_t& term = shift_terms[t];
+                        M[term.a] += term.coefficient*powers[term.c]*Mc[term.b];
+                     }
+                  }
+               }
+            }
+
+            //----------------------------------------------------------
+            // Local expansions from well separated cells (M2L)
+            //----------------------------------------------------------
+            #pragma omp for schedule(dynamic,16)
+            for(int cell = 0; cell < num_cells; cell++){
+               double* L = &local[cell*nc];
+               std::fill(L, L + nc, 0.0);
+            }
+
+            for(int level = 2; level <= leaf_level; level++){
+               #pragma omp for schedule(dynamic,16)
+               for(int cell = level_start[level]; cell < level_start[level+1]; cell++){
+                  if(!cell_target[cell]) continue;
+                  double* L = &local[cell*nc];
+                  for(int s = m2l_start[cell]; s < m2l_start[cell+1]; s++){
+                     const double* M = &multipole[m2l_source[s]*nc];
+                     const double* T = &kernel_table[(level*343 + m2l_offset[s])*nc];
+                     for(unsigned int t = 0; t < m2l_terms.size(); t++){
+                        const term_t& term = m2l_terms[t];
+                        L[term.a] += term.coefficient*M[term.b]*T[term.c];
+                     }
+                  }
+               }
+            }
+
+            //----------------------------------------------------------
+            // Translate local expansions down the tree (L2L)
+            //----------------------------------------------------------
+            for(int level = 3; level <= leaf_level; level++){
+               #pragma omp for schedule(dynamic,16)
+               for(int cell = level_start[level]; cell < level_start[level+1]; cell++){
+                  if(!cell_target[cell]) continue;
+                  const int parent = cell_parent[cell];
+                  const double* Lp = &local[parent*nc];
+                  double* L = &local[cell*nc];
+                  calculate_powers(cell_cx[cell] - cell_cx[parent], cell_cy[cell] - cell_cy[parent], cell_cz[cell] - cell_cz[parent], &powers[0]);
+                  for(unsigned int t = 0; t < shift_terms.size(); t++){
+                     const term_t& term = shift_terms[t];
+                     L[term.b] += term.coefficient*powers[term.c]*Lp[term.a];
+                  }
+               }
+            }
+
+            //----------------------------------------------------------
+            // Evaluate local expansions (L2P) and add direct
+            // interactions with adjacent cells (P2P) for local atoms
+            //----------------------------------------------------------
+            #pragma omp for schedule(dynamic,16)
+            for(int cell = level_start[leaf_level]; cell < num_cells; cell++){
+
+               if(!cell_target[cell]) continue;
+
+               const double* L = &local[cell*nc];
+
+               for(int i = cell_atom_start[cell]; i < cell_atom_end[cell]; i++){
+
+                  const int atom = sorted_atom[i];
+                  if(atom < first_local_atom || atom >= last_local_atom) continue;
+
+                  const double xi = sorted_x[i];
+                  const double yi = sorted_y[i];
+                  const double zi = sorted_z[i];
+
+                  double bx = 0.0;
+                  double by = 0.0;
+                  double bz = 0.0;
+
+                  // field of well separated cells is -grad of local expansion
+                  calculate_powers(xi - cell_cx[cell], yi - cell_cy[cell], zi - cell_cz[cell], &powers[0]);
+                  for(int k = 1; k < nc; k++){
+                     if(lower_x[k] >= 0) bx -= coefficient_x[k]*L[k]*powers[lower_x[k]];
+                     if(lower_y[k] >= 0) by -= coefficient_y[k]*L[k]*powers[lower_y[k]];
+                     if(lower_z[k] >= 0) bz -= coefficient_z[k]*L[k]*powers[lower_z[k]];
+                  }
+
+                  for(int n = near_start[cell]; n < near_start[cell+1]; n++){
+                     const int source = near_source[n];
+                     for(int j = cell_atom_start[source]; j < cell_atom_end[source]; j++){
+
+                        if(j == i) continue;
+
+                        // calculate position vector i -> j
+                        const double rx = sorted_x[j] - xi;
+                        const double ry = sorted_y[j] - yi;
+                        const double rz = sorted_z[j] - zi;
+
+                        const double rij = 1.0/sqrt(rx*rx+ry*ry+rz*rz); //Reciprocal of the distance
+
+                        // calculate unit vector from i -> j
+                        const double ex = rx*rij;
+                        const double ey = ry*rij;
+                        const double ez = rz*rij;
+
+                        const double rij3 = ( rij * rij * rij); // Angstroms
+
+                        // calculate r . m
+                        const double rdotm = ex*sorted_mx[j] + ey*sorted_my[j] + ez*sorted_mz[j];
+
+                        bx += (3.0*ex*rdotm - sorted_mx[j]) * rij3;
+                        by += (3.0*ey*rdotm - sorted_my[j]) * rij3;
+                        bz += (3.0*ez*rdotm - sorted_mz[j]) * rij3;
+
+                     }
+                  }
+
+                  // save total dipole field to atomic field array
+                  const int local_atom = atom - first_local_atom;
+                  dipole::atom_dipolar_field_array_x[local_atom] = prefactor * bx;
+                  dipole::atom_dipolar_field_array_y[local_atom] = prefactor * by;
+                  dipole::atom_dipolar_field_array_z[local_atom] = prefactor * bz;
+
+               }
+            }
+
+            } // end of omp parallel region
+
+            if(dp::output_atomistic_dipole_field) output_atomistic_dipole_fields();
+
+            return;
+
+         }
+
+      } // end of namespace fast_multipole
+
+   } // end of namespace internal
+
+} // end of namespace dipole
@@ -0,0 +1,173 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) Andrea Meo and Richard F L Evans 2016. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <vector>
+
+// Vampire headers
+#include "cells.hpp"
+#include "dipole.hpp"
+#include "micromagnetic.hpp"
+#include "vio.hpp"
+#include "vmpi.hpp"
+
+// dipole module headers
+#include "internal.hpp"
+
+namespace dipole{
+
+   namespace internal{
+
+      //-----------------------------------------------------------------------------
+      // Function to determine which cell fields must be received from other
+      // processors. Each cell field is calculated by the processors which have
+      // the cell locally, so the lowest of these ranks owns the cell and sends
+      // its field to the processors with atoms or micromagnetic cells in the
+      // cell which do not calculate it themselves.
+      //-----------------------------------------------------------------------------
+      void initialize_cells_field_gather(){
+
+         dipole::internal::cells_field_gather_initialised = true;
+
+         dipole::internal::cells_field_send_cells.clear();
+         dipole::internal::cells_field_recv_cells.clear();
+         dipole::internal::cells_field_send_counts.assign(vmpi::num_processors, 0);
+         dipole::internal::cells_field_recv_counts.assign(vmpi::num_processors, 0);
+
+         #ifdef MPICF
+
+            const int num_cells = dipole::internal::cells_num_cells;
+
+            //----------------------------------------------------------
+            // Determine owner of each cell as lowest rank calculating it
+            //----------------------------------------------------------
+            std::vector<int> owner(num_cells, vmpi::num_processors);
+            std::vector<bool> calculated(num_cells, false);
+            for(int lc = 0; lc < dipole::internal::cells_num_local_cells; lc++){
+               const int cell = cells::cell_id_array[lc];
+               owner[cell] = vmpi::my_rank;
+               calculated[cell] = true;
+            }
+
+            MPI_Allreduce(MPI_IN_PLACE, &owner[0], num_cells, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+
+            //----------------------------------------------------------
+            // Determine cells needed by local atoms and cells
+            //----------------------------------------------------------
+            std::vector<bool> needed(num_cells, false);
+
+            const int num_local_atoms = vmpi::num_core_atoms+vmpi::num_bdry_atoms;
+            for(int atom = 0; atom < num_local_atoms; atom++){
+               const int cell = dipole::internal::atom_cell_id_array[atom];
+               if(!calculated[cell]) needed[cell] = true;
+            }
+            for(int lc = 0; lc < micromagnetic::number_of_micromagnetic_cells; lc++){
+               const int cell = micromagnetic::list_of_micromagnetic_cells[lc];
+               if(!calculated[cell]) needed[cell] = true;
+            }
+
+            std::vector<std::vector<int> > recv_lists(vmpi::num_processors);
+            for(int cell = 0; cell < num_cells; cell++){
+               // cells without owner contain no atoms and have zero field
+               if(needed[cell] && owner[cell] < vmpi::num_processors) recv_lists[owner[cell]].push_back(cell);
+            }
+            for(int p = 0; p < vmpi::num_processors; p++){
+               dipole::internal::cells_field_recv_counts[p] = recv_lists[p].size();
+               dipole::internal::cells_field_recv_cells.insert(dipole::internal::cells_field_recv_cells.end(), recv_lists[p].begin(), recv_lists[p].end());
+            }
+
+            //----------------------------------------------------------
+            // Send lists of needed cells to owners
+            //----------------------------------------------------------
+            MPI_Alltoall(&dipole::internal::cells_field_recv_counts[0], 1, MPI_INT, &dipole::internal::cells_field_send_counts[0], 1, MPI_INT, MPI_COMM_WORLD);
+
+            std::vector<int> send_displacements(vmpi::num_processors, 0);
+            std::vector<int> recv_displacements(vmpi::num_processors, 0);
+            for(int p = 1; p < vmpi::num_processors; p++){
+               send_displacements[p] = send_displacements[p-1] + dipole::internal::cells_field_send_counts[p-1];
+               recv_displacements[p] = recv_displacements[p-1] + dipole::internal::cells_field_recv_counts[p-1];
+            }
+            dipole::internal::cells_field_send_cells.resize(send_displacements.back() + dipole::internal::cells_field_send_counts.back());
+
+            MPI_Alltoallv(&dipole::internal::cells_field_recv_cells[0], &dipole::internal::cells_field_recv_counts[0], &recv_displacements[0], MPI_INT,
+                          &dipole::internal::cells_field_send_cells[0], &dipole::internal::cells_field_send_counts[0], &send_displacements[0], MPI_INT, MPI_COMM_WORLD);
+
+            // skip communication altogether if no processor needs fields from others
+            int num_exchanged_cells = dipole::internal::cells_field_recv_cells.size();
+            MPI_Allreduce(MPI_IN_PLACE, &num_exchanged_cells, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+            dipole::internal::cells_field_gather_needed = num_exchanged_cells > 0;
+
+            zlog << zTs() << "Dipole field gather initialised: sending " << dipole::internal::cells_field_send_cells.size() << " and receiving "
+                 << dipole::internal::cells_field_recv_cells.size() << " of " << num_cells << " cell fields on this processor ("
+                 << num_exchanged_cells << " on all processors)" << std::endl;
+
+         #endif
+
+         return;
+
+      }
+
+      //-----------------------------------------------------------------------------
+      // Function to send dipole fields of owned cells to processors needing them
+      //-----------------------------------------------------------------------------
+      void gather_cells_field(){
+
+         if(!dipole::internal::cells_field_gather_initialised) dipole::internal::initialize_cells_field_gather();
+
+         #ifdef MPICF
+
+            if(!dipole::internal::cells_field_gather_needed) return;
+
+            const int num_send = dipole::internal::cells_field_send_cells.size();
+            const int num_recv = dipole::internal::cells_field_recv_cells.size();
+
+            std::vector<double> send_buffer(3*num_send);
+            std::vector<double> recv_buffer(3*num_recv);
+
+            for(int i = 0; i < num_send; i++){
+               const int cell = dipole::internal::cells_field_send_cells[i];
+               send_buffer[3*i+0] = dipole::cells_field_array_x[cell];
+               send_buffer[3*i+1] = dipole::cells_field_array_y[cell];
+               send_buffer[3*i+2] = dipole::cells_field_array_z[cell];
+            }
+
+            // three components per cell
+            std::vector<int> send_counts(vmpi::num_processors);
+            std::vector<int> recv_counts(vmpi::num_processors);
+            std::vector<int> send_displacements(vmpi::num_processors, 0);
+            std::vector<int> recv_displacements(vmpi::num_processors, 0);
+            for(int p = 0; p < vmpi::num_processors; p++){
+               send_counts[p] = 3*dipole::internal::cells_field_send_counts[p];
+               recv_counts[p] = 3*dipole::internal::cells_field_recv_counts[p];
+               if(p > 0){
+                  send_displacements[p] = send_displacements[p-1] + send_counts[p-1];
+                  recv_displacements[p] = recv_displacements[p-1] + recv_counts[p-1];
+               }
+            }
+
+            MPI_Alltoallv(&send_buffer[0], &send_counts[0], &send_displacements[0], MPI_DOUBLE,
+                          &recv_buffer[0], &recv_counts[0], &recv_displacements[0], MPI_DOUBLE, MPI_COMM_WORLD);
+
+            for(int i = 0; i < num_recv; i++){
+               const int cell = dipole::internal::cells_field_recv_cells[i];
+               dipole::cells_field_array_x[cell] = recv_buffer[3*i+0];
+               dipole::cells_field_array_y[cell] = recv_buffer[3*i+1];
+               dipole::cells_field_array_z[cell] = recv_buffer[3*i+2];
+            }
+
+         #endif
+
+         return;
+
+      }
+
+   } // end of namespace internal
+
+} // end of namespace dipole
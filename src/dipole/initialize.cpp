@@ -82,6 +82,12 @@ namespace dipole{
       dipole::internal::cells_num_atoms_in_cell    = cells_num_atoms_in_cell;
       dipole::internal::cells_volume_array         = cells_volume_array;
 
+      // precompute self-demagnetisation factor 8pi/3V of each cell
+      dipole::internal::cells_self_demag_array.assign(cells_volume_array.size(), 0.0);
+      for(unsigned int i = 0; i < cells_volume_array.size(); i++){
+         if(cells_volume_array[i] > 0.0) dipole::internal::cells_self_demag_array[i] = 8.0*M_PI/(3.0*cells_volume_array[i]);
+      }
+
       dipole::internal::cells_pos_and_mom_array    = cells_pos_and_mom_array;
 
       //----------------------------------------------------------
@@ -135,6 +141,13 @@ namespace dipole{
             dipole::internal::atomistic_fft::initialize_atomistic_fft_solver();
             break;
 
+         case dipole::internal::fmm:
+            std::cout     << "Initialising dipole field calculation using fast multipole solver" << std::endl;
+            zlog << zTs() << "Initialising dipole field calculation using fast multipole solver" << std::endl;
+            dipole::internal::initialize_atomistic_solver(num_atoms, atom_coords_x, atom_coords_y, atom_coords_z, atom_moments, atom_type_array);
+            dipole::internal::fast_multipole::initialize_fmm_solver();
+            break;
+
 
       }
       // Set initialised flag
@@ -77,11 +77,23 @@ namespace dipole{
             dipole::activated=true;
             return true;
          }
+         test="fmm";
+         if(value == test){
+            dipole::internal::solver = dipole::internal::fmm;
+            // enable dipole calculation
+            dipole::activated=true;
+            return true;
+         }
          else{
             terminaltextcolor(RED);
             std::cerr << "Error: Value for \'" << prefix << ":" << word << "\' must be one of:" << std::endl;
             std::cerr << "\t\"macrocell\"" << std::endl;
             std::cerr << "\t\"tensor\"" << std::endl;
+            std::cerr << "\t\"atomistic\"" << std::endl;
+            std::cerr << "\t\"hierarchical\"" << std::endl;
+            std::cerr << "\t\"fft\"" << std::endl;
+            std::cerr << "\t\"atomistic-fft\"" << std::endl;
+            std::cerr << "\t\"fmm\"" << std::endl;
             terminaltextcolor(WHITE);
             err::vexit();
          }
@@ -102,6 +114,22 @@ namespace dipole{
          dipole::cutoff=dpur;
          return true;
       }
+      //-------------------------------------------------------------------
+      test="fmm-expansion-order";
+      if(word==test){
+         int order=atoi(value.c_str());
+         vin::check_for_valid_int(order, word, line, prefix, 2, 12,"input","2 - 12");
+         dipole::internal::fast_multipole::expansion_order=order;
+         return true;
+      }
+      //-------------------------------------------------------------------
+      test="fmm-atoms-per-cell";
+      if(word==test){
+         int apc=atoi(value.c_str());
+         vin::check_for_valid_int(apc, word, line, prefix, 1, 100000,"input","1 - 100,000");
+         dipole::internal::fast_multipole::atoms_per_cell=apc;
+         return true;
+      }
       test="atomistic-tensor-enabled";
       if(word==test){
          dipole::atomistic_tensor_enabled=true;
@@ -50,7 +50,8 @@ namespace dipole{
          hierarchical   = 3, // new macrocell with tensor including local corrections and nearfield multipole
          atomistic      = 4, // atomistic dipole dipole (too slow for anything over 1000 atoms)
          fft            = 5, // fft method wit tranlational invariance
-         atomisticfft   = 6   // atomistic dipole dipole with fft
+         atomisticfft   = 6,  // atomistic dipole dipole with fft
+         fmm            = 7   // atomistic dipole dipole with fast multipole method
       };
       extern std::vector < int > cell_dx;
       extern std::vector < int > cell_dy;
@@ -81,10 +82,21 @@ namespace dipole{
       extern std::vector <int>  cells_local_cell_array;
       extern std::vector <int>  cells_num_atoms_in_cell;
       extern std::vector < double > cells_volume_array;
+      extern std::vector < double > cells_self_demag_array; // self-demagnetisation factor 8pi/3V of each cell
 
       extern std::vector<double> cells_pos_and_mom_array;
       extern std::vector < int > proc_cell_index_array1D;
 
+      extern std::vector < int > local_cell_partition; // range of local cells calculated by each thread
+
+      // lists of cell fields sent to and received from each processor
+      extern bool cells_field_gather_initialised;
+      extern bool cells_field_gather_needed;
+      extern std::vector < int > cells_field_send_cells;
+      extern std::vector < int > cells_field_send_counts;
+      extern std::vector < int > cells_field_recv_cells;
+      extern std::vector < int > cells_field_recv_counts;
+
       //------------------------------------------------------------------------
       // data structures for atomistic solver
       // (copy of all atom positions and spins on all processors)
@@ -168,6 +180,15 @@ namespace dipole{
           void finalize_atomistic_fft_solver();
       }
 
+      namespace fast_multipole{
+          extern int expansion_order; // maximum order of multipole and local expansions
+          extern int atoms_per_cell;  // target number of atoms in each leaf cell of octree
+          void initialize_fmm_solver();
+          void update_field_fmm(std::vector<double>& x_spin_array,
+                                std::vector<double>& y_spin_array,
+                                std::vector<double>& z_spin_array);
+      }
+
 
       //-------------------------------------------------------------------------
       // Internal function declarations
@@ -175,6 +196,9 @@ namespace dipole{
       //void write_macrocell_data();
       int hierarchical_mag();
       extern void update_field();
+      void set_local_cell_partition(const std::vector<uint64_t>& num_interactions);
+      void initialize_cells_field_gather();
+      void gather_cells_field();
 
       void allocate_memory(const int cells_num_local_cells, const int cells_num_cells);
 
@@ -198,6 +222,13 @@ namespace dipole{
                                     std::vector<double>& atom_coords_z,
                                     int num_atoms);
 
+      // functions to load and save precalculated dipole tensors for structure cache
+      uint64_t calculate_tensor_cache_key(const double cutoff,
+                                          const std::vector<int>& cells_num_atoms_in_cell_global,
+                                          const std::vector<double>& cells_pos_and_mom_array);
+      bool load_tensor_cache(const uint64_t key);
+      void save_tensor_cache(const uint64_t key);
+
       // new version of inter tensor method
       void compute_inter_tensor(const int celli,                                                // global ID of cell i
                                 const int cellj,                                                // global ID of cell i
@@ -244,6 +275,10 @@ namespace dipole{
                                        std::vector<double>& moments_array, // atomistic magnetic moments (bohr magnetons)
                                        std::vector<int>& mat_id_array);    // atom material ID
 
+      void gather_atomistic_spins(std::vector<double>& x_spin_array, // atomic spin directions
+                                  std::vector<double>& y_spin_array,
+                                  std::vector<double>& z_spin_array);
+
       void calculate_atomistic_dipole_field(std::vector<double>& x_spin_array, // atomic spin directions
                                             std::vector<double>& y_spin_array,
                                             std::vector<double>& z_spin_array);
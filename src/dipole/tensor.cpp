@@ -14,6 +14,7 @@
 
 // Vampire headers
 #include "cells.hpp" // needed for cells::macrocell_size but to be removed
+#include "create.hpp"
 #include "dipole.hpp"
 #include "vio.hpp"
 #include "vutil.hpp"
@@ -93,6 +94,13 @@ namespace dipole{
             //}
          }
 
+         // attempt to load precalculated tensors from structure cache
+         uint64_t cache_key = 0;
+         if(create::structure_cache){
+            cache_key = calculate_tensor_cache_key(real_cutoff, cells_num_atoms_in_cell_global, cells_pos_and_mom_array);
+            if(load_tensor_cache(cache_key)) return;
+         }
+
          // print informative message to user
          zlog << zTs() << "Precalculating rij matrix for dipole calculation using tensor solver... " << std::endl;
          std::cout     << "Precalculating rij matrix for dipole calculation using tensor solver"     << std::flush;
@@ -180,6 +188,9 @@ namespace dipole{
          std::cout << "done! [ " << timer.elapsed_time() << " s ]" << std::endl;
          zlog << zTs() << "Precalculation of rij matrix for dipole calculation complete. Time taken: " << timer.elapsed_time() << " s"<< std::endl;
 
+         // save tensors for subsequent runs
+         if(create::structure_cache) save_tensor_cache(cache_key);
+
          return;
 
       }
@@ -24,6 +24,9 @@
 #include "cells.hpp"
 #include "sim.hpp"
 #include "errors.hpp"
+#ifdef _OPENMP
+   #include <omp.h>
+#endif
 
 // dipole module headers
 #include "internal.hpp"
@@ -48,82 +51,119 @@ namespace dipole{
       // Define constant imuB = 1/muB to normalise to unitarian values the cell magnetisation
       const double imuB = 1.0/9.27400915e-24;
 
-       for (int i = 0 ; i < cells::num_cells; i ++){
-         dipole::cells_field_array_x[i] = -100000.0;
-         dipole::cells_field_array_y[i] = -100000.0;
-         dipole::cells_field_array_z[i] = -100000.0;
-       }
+      // Multiply the cells B-field by mu_B * mu_0/(4*pi) /1e-30  <-- (9.27400915e-24 * 1e-7 / 1e30)
+      // where the last term accounts for the fact that the volume was calculated in Angstrom
+      const double muB_mu0_four_pi = 9.27400915e-01;
+
+      // Normalise the magnetisation of cells with atoms by the Bohr magneton
+      std::vector<int> occupied_cells;
+      occupied_cells.reserve(dipole::internal::cells_num_cells);
+      std::vector<double> mx(dipole::internal::cells_num_cells, 0.0);
+      std::vector<double> my(dipole::internal::cells_num_cells, 0.0);
+      std::vector<double> mz(dipole::internal::cells_num_cells, 0.0);
+      for(int j=0;j<dipole::internal::cells_num_cells;j++){
+         if(dipole::internal::cells_num_atoms_in_cell[j]>0){
+            occupied_cells.push_back(j);
+            mx[j] = cells::mag_array_x[j]*imuB;
+            my[j] = cells::mag_array_y[j]*imuB;
+            mz[j] = cells::mag_array_z[j]*imuB;
+         }
+      }
+      const int num_occupied_cells = occupied_cells.size();
+
+      // Divide local cells between threads, where each cell with atoms interacts with all others
+      if(dipole::internal::local_cell_partition.size() == 0){
+         std::vector<uint64_t> num_interactions(dipole::internal::cells_num_local_cells, 1);
+         for(int lc=0;lc<dipole::internal::cells_num_local_cells;lc++){
+            if(dipole::internal::cells_num_atoms_in_cell[cells::cell_id_array[lc]]>0) num_interactions[lc] += num_occupied_cells;
+         }
+         dipole::internal::set_local_cell_partition(num_interactions);
+      }
+      const int num_partitions = dipole::internal::local_cell_partition.size() - 1;
 
 		// loop over local cells
-    	for(int lc=0;lc<dipole::internal::cells_num_local_cells;lc++){
+      #pragma omp parallel for schedule(static,1)
+      for(int partition = 0; partition < num_partitions; partition++){
 
-         int i = cells::cell_id_array[lc];
+    	for(int lc=dipole::internal::local_cell_partition[partition];lc<dipole::internal::local_cell_partition[partition+1];lc++){
+
+         const int i = cells::cell_id_array[lc];
         	if(dipole::internal::cells_num_atoms_in_cell[i]>0){
 
             // Self demagnetisation factor multiplying m(i)
-            const double eightPI_three_cell_volume = 8.0*M_PI/(3.0*dipole::internal::cells_volume_array[i]);
-            double self_demag = eightPI_three_cell_volume;
+            const double self_demag = dipole::internal::cells_self_demag_array[i];
 
-            // Normalise cell magnetisation by the Bohr magneton
-            const double mx_i = cells::mag_array_x[i]*imuB;
-            const double my_i = cells::mag_array_y[i]*imuB;
-            const double mz_i = cells::mag_array_z[i]*imuB;
+            const double* rij_xx = &internal::rij_tensor_xx[lc][0];
+            const double* rij_xy = &internal::rij_tensor_xy[lc][0];
+            const double* rij_xz = &internal::rij_tensor_xz[lc][0];
+            const double* rij_yy = &internal::rij_tensor_yy[lc][0];
+            const double* rij_yz = &internal::rij_tensor_yz[lc][0];
+            const double* rij_zz = &internal::rij_tensor_zz[lc][0];
 
             // Add self-demagnetisation as mu_0/4_PI * 8PI*m_cell/3V
-            dipole::cells_field_array_x[i] = self_demag * mx_i;//*0.0; //*0.0
-            dipole::cells_field_array_y[i] = self_demag * my_i;//*0.0; //*0.0
-            dipole::cells_field_array_z[i] = self_demag * mz_i;//*0.0; //*0.0
-            // Add self demag to Hdemag --> To get only dipole-dipole contribution comment this and initialise to zero
-            dipole::cells_mu0Hd_field_array_x[i] = -0.5*self_demag * mx_i;
-            dipole::cells_mu0Hd_field_array_y[i] = -0.5*self_demag * my_i;
-            dipole::cells_mu0Hd_field_array_z[i] = -0.5*self_demag * mz_i;
+            double hx = self_demag * mx[i];
+            double hy = self_demag * my[i];
+            double hz = self_demag * mz[i];
 
             // Loop over all other cells to calculate contribution to local cell
-            for(int j=0;j<dipole::internal::cells_num_cells;j++){
-         	   if(dipole::internal::cells_num_atoms_in_cell[j]>0){
-
-                  // Normalise the cell magnetisation by the Bohr magneton
-         		   const double mx = cells::mag_array_x[j]*imuB;
-         		   const double my = cells::mag_array_y[j]*imuB;
-         		   const double mz = cells::mag_array_z[j]*imuB;
-					//	if (i == 0)std::cout<< i << '\t' << mx_i << '\t' << my_i << '\t' << mz_i << "\t" <<  j << '\t' << mx << '\t' << my << '\t' << mz <<std::endl;
-
-             		dipole::cells_field_array_x[i]+=(mx*internal::rij_tensor_xx[lc][j] + my*internal::rij_tensor_xy[lc][j] + mz*internal::rij_tensor_xz[lc][j]);
-             		dipole::cells_field_array_y[i]+=(mx*internal::rij_tensor_xy[lc][j] + my*internal::rij_tensor_yy[lc][j] + mz*internal::rij_tensor_yz[lc][j]);
-             		dipole::cells_field_array_z[i]+=(mx*internal::rij_tensor_xz[lc][j] + my*internal::rij_tensor_yz[lc][j] + mz*internal::rij_tensor_zz[lc][j]);
-                  // Demag field
-					//	std::cout << "DEMAG\t" << cells::mag_array_x[j] << '\t' << imuB << '\t' <<  mx << '\t' << my << '\t' << mz << '\t' << internal::rij_tensor_xx[lc][j] << '\t' << dipole::cells_field_array_x[i] << std::endl;
-                  dipole::cells_mu0Hd_field_array_x[i] +=(mx*internal::rij_tensor_xx[lc][j] + my*internal::rij_tensor_xy[lc][j] + mz*internal::rij_tensor_xz[lc][j]);
-                  dipole::cells_mu0Hd_field_array_y[i] +=(mx*internal::rij_tensor_xy[lc][j] + my*internal::rij_tensor_yy[lc][j] + mz*internal::rij_tensor_yz[lc][j]);
-                  dipole::cells_mu0Hd_field_array_z[i] +=(mx*internal::rij_tensor_xz[lc][j] + my*internal::rij_tensor_yz[lc][j] + mz*internal::rij_tensor_zz[lc][j]);
-         	   }
+            for(int c=0;c<num_occupied_cells;c++){
+               const int j = occupied_cells[c];
+               hx += (mx[j]*rij_xx[j] + my[j]*rij_xy[j] + mz[j]*rij_xz[j]);
+               hy += (mx[j]*rij_xy[j] + my[j]*rij_yy[j] + mz[j]*rij_yz[j]);
+               hz += (mx[j]*rij_xz[j] + my[j]*rij_yz[j] + mz[j]*rij_zz[j]);
             }
-            // Multiply the cells B-field by mu_B * mu_0/(4*pi) /1e-30  <-- (9.27400915e-24 * 1e-7 / 1e30)
-            // where the last term accounts for the fact that the volume was calculated in Angstrom
-            dipole::cells_field_array_x[i] = dipole::cells_field_array_x[i] * 9.27400915e-01;
-            dipole::cells_field_array_y[i] = dipole::cells_field_array_y[i] * 9.27400915e-01;
-            dipole::cells_field_array_z[i] = dipole::cells_field_array_z[i] * 9.27400915e-01;
-			 	//dp_fields << sim::time << '\t' << i << '\t' << dipole::cells_field_array_x[i] << '\t' << dipole::cells_field_array_y[i] << '\t' << dipole::cells_field_array_z[i] << '\t' << std::endl;
-				//dp_fields <<sim::time << "\t" <<  dipole::cells_field_array_x[i] << '\t' << dipole::cells_field_array_y[i] << '\t' << dipole::cells_field_array_z[i]  << "\t" << cells::pos_and_mom_array[4*i+0] << '\t' << cells_pos_and_mom_array[4*i+1] << '\t' << cells_pos_and_mom_array[4*i+2] << std::endl;
-				// Multiply Hdemg by mu_0/4pi * 1e30 * mu_B to account for normalisation
-            // of magnetisation and volume in angstrom
-            dipole::cells_mu0Hd_field_array_x[i] = dipole::cells_mu0Hd_field_array_x[i] * 9.27400915e-01;
-            dipole::cells_mu0Hd_field_array_y[i] = dipole::cells_mu0Hd_field_array_y[i] * 9.27400915e-01;
-            dipole::cells_mu0Hd_field_array_z[i] = dipole::cells_mu0Hd_field_array_z[i] * 9.27400915e-01;
+
+            dipole::cells_field_array_x[i] = hx * muB_mu0_four_pi;
+            dipole::cells_field_array_y[i] = hy * muB_mu0_four_pi;
+            dipole::cells_field_array_z[i] = hz * muB_mu0_four_pi;
+
+            // Demag field has self demagnetisation -0.5*8PI*m_cell/3V instead
+            dipole::cells_mu0Hd_field_array_x[i] = (hx - 1.5*self_demag * mx[i]) * muB_mu0_four_pi;
+            dipole::cells_mu0Hd_field_array_y[i] = (hy - 1.5*self_demag * my[i]) * muB_mu0_four_pi;
+            dipole::cells_mu0Hd_field_array_z[i] = (hz - 1.5*self_demag * mz[i]) * muB_mu0_four_pi;
      		}
     	}
 
-      #ifdef MPICF
-         MPI_Allreduce(MPI_IN_PLACE, &dipole::cells_field_array_x[0],     dipole::internal::cells_num_cells,    MPI_DOUBLE,    MPI_MAX, MPI_COMM_WORLD);
-         MPI_Allreduce(MPI_IN_PLACE, &dipole::cells_field_array_y[0],     dipole::internal::cells_num_cells,    MPI_DOUBLE,    MPI_MAX, MPI_COMM_WORLD);
-         MPI_Allreduce(MPI_IN_PLACE, &dipole::cells_field_array_z[0],     dipole::internal::cells_num_cells,    MPI_DOUBLE,    MPI_MAX, MPI_COMM_WORLD);
-      #endif
-       for (int i = 0 ; i < dipole::internal::cells_num_cells; i ++){
-         if (dipole::cells_field_array_x[i] < -1000) dipole::cells_field_array_x[i] = 0.0;
-         if (dipole::cells_field_array_y[i] < -1000) dipole::cells_field_array_y[i] = 0.0;
-         if (dipole::cells_field_array_z[i] < -1000) dipole::cells_field_array_z[i] = 0.0;
-       //  std::cout << i << '\t' << dipole::cells_field_array_x[i] << '\t' << dipole::cells_field_array_y[i] << '\t' << dipole::cells_field_array_z[i] <<std::endl;
+      } // end of loop over partitions
+
+      // Receive fields of cells calculated on other processors
+      dipole::internal::gather_cells_field();
 
-       }
 	} // end of dipole::internal::update_field() function
+
+   //-----------------------------------------------------------------------------
+   // Function to divide local cells into contiguous ranges with a similar
+   // number of cell-cell interactions, one for each available thread. All
+   // ranges are calculated whatever the number of threads in later updates.
+   //-----------------------------------------------------------------------------
+   void dipole::internal::set_local_cell_partition(const std::vector<uint64_t>& num_interactions){
+
+      int num_threads = 1;
+      #ifdef _OPENMP
+         num_threads = omp_get_max_threads();
+      #endif
+
+      const int num_local_cells = num_interactions.size();
+
+      uint64_t total_interactions = 0;
+      for(int lc = 0; lc < num_local_cells; lc++) total_interactions += num_interactions[lc];
+
+      // start thread ranges when the cumulative number of interactions reaches an equal share
+      std::vector<int>& partition = dipole::internal::local_cell_partition;
+      partition.assign(num_threads+1, num_local_cells);
+      partition[0] = 0;
+      int thread = 1;
+      uint64_t sum = 0;
+      for(int lc = 0; lc < num_local_cells; lc++){
+         while(thread < num_threads && sum*num_threads >= total_interactions*thread) partition[thread++] = lc;
+         sum += num_interactions[lc];
+      }
+
+      zlog << zTs() << "Dipole field of " << num_local_cells << " local cells with " << total_interactions
+           << " interactions divided into " << num_threads << " ranges for threads" << std::endl;
+
+      return;
+
+   }
+
 } // end of dipole namespace
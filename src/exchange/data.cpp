@@ -55,7 +55,6 @@ namespace exchange{
       bool use_material_exchange_constants = true; // flag to enable material exchange parameters
       bool use_material_biquadratic_exchange_constants = true; // flag to enable material biquadratic exchange parameters
 
-      std::vector <int> four_spin_neighbour_list_array_i; // 1D list of j neighbours
       std::vector <int> four_spin_neighbour_list_array_j; // 1D list of j neighbours
       std::vector <int> four_spin_neighbour_list_array_k; // 1D list of k neighnours
       std::vector <int> four_spin_neighbour_list_array_l; // 1D list of l neighbours
@@ -15,6 +15,7 @@
 // Vampire headers
 #include "atoms.hpp" // for exchange list type defs
 #include "exchange.hpp"
+#include "vutil.hpp"
 
 // exchange module headers
 #include "internal.hpp"
@@ -41,6 +42,9 @@ namespace exchange{
                std::vector<double>& field_array_y,
                std::vector<double>& field_array_z){
 
+      // time exchange field calculation
+      vutil::profile::scope_t profile(vutil::profile::exchange);
+
 
    	// Calculate standard (bilinear) exchange fields
       exchange::internal::exchange_fields(start_index, end_index,
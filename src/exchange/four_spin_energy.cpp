@@ -42,11 +42,14 @@ namespace exchange{
 
 double single_spin_four_spin_energy(const int atom, const double sx, const double sy, const double sz){
 
+   // check for four spin interactions
+   if(!internal::enable_fourspin) return 0.0;
+
    double energy=0.0;
 
-   const double six = atoms::x_spin_array[atom];
-   const double siy = atoms::y_spin_array[atom];
-   const double siz = atoms::z_spin_array[atom];
+   const double six = sx;
+   const double siy = sy;
+   const double siz = sz;
 
    // Loop over neighbouring spins to calculate exchange
    for(int nn = internal::four_spin_neighbour_list_start_index[atom]; nn <= internal::four_spin_neighbour_list_end_index[atom]; ++nn){
@@ -79,7 +82,7 @@ double single_spin_four_spin_energy(const int atom, const double sx, const doubl
 
     }
 
-    return 0;
+    return energy;
 }
 
 } // end of namespace
@@ -29,48 +29,70 @@ namespace exchange{
 
 namespace internal{
 
+//-----------------------------------------------------------------------------------------
+// Function to calculate four-spin exchange fields for atoms between start and end index.
+// Quartets are stored for each owning atom, so atoms are independent and the range is
+// respected for the MPI core/boundary split and for threading.
+//-----------------------------------------------------------------------------------------
 void four_spin_exchange_fields(const int start_index, // first atom for exchange interactions to be calculated
-                               const int end_index,                                 // field vectors for atoms
-                               std::vector<double>& field_array_x,
+                               const int end_index, // last +1 atom to be calculated
+                               std::vector<double>& field_array_x, // field vectors for atoms
                                std::vector<double>& field_array_y,
-                               std::vector<double>& field_array_z){ // last +1 atom to be calculated){
+                               std::vector<double>& field_array_z){
 
-   //std::vector < int > numbers(atoms::num_atoms,0);
+   // check for four spin interactions
+   if(!enable_fourspin) return;
 
-   const int num_four_spin_neighbours = four_spin_neighbour_list_array_l.size();
+   const double athird = 1.0/3.0;
 
-   // loop over all neighbours
-	for(int nn = 0; nn < num_four_spin_neighbours; ++nn){
+   const std::vector<double>& x_spin_array = atoms::x_spin_array;
+   const std::vector<double>& y_spin_array = atoms::y_spin_array;
+   const std::vector<double>& z_spin_array = atoms::z_spin_array;
 
-      // get neighbouring atom number
-   	const int atom = four_spin_neighbour_list_array_i[nn];
-   	const int natomj = four_spin_neighbour_list_array_j[nn];
-   	const int natomk = four_spin_neighbour_list_array_k[nn];
-      const int natoml = four_spin_neighbour_list_array_l[nn];
-      //const int jmaterial = atoms::type_array[natomj];
-      const double Jij = four_spin_exchange_list[nn];
+   #pragma omp parallel for schedule(static)
+   for(int atom = start_index; atom < end_index; ++atom){
 
-      const double sjx = atoms::x_spin_array[natomj];
-      const double sjy = atoms::y_spin_array[natomj];
-      const double sjz = atoms::z_spin_array[natomj];
+      double hx = 0.0;
+      double hy = 0.0;
+      double hz = 0.0;
 
-      const double skx = atoms::x_spin_array[natomk];
-      const double sky = atoms::y_spin_array[natomk];
-      const double skz = atoms::z_spin_array[natomk];
+      // loop over all quartets of atom
+      const int start = four_spin_neighbour_list_start_index[atom];
+      const int end = four_spin_neighbour_list_end_index[atom] + 1;
 
-      const double slx = atoms::x_spin_array[natoml];
-      const double sly = atoms::y_spin_array[natoml];
-      const double slz = atoms::z_spin_array[natoml];
+      for(int nn = start; nn < end; ++nn){
 
-      const double sk_dot_sl = dot_product(skx,sky,skz,slx,sly,slz);
-      const double sj_dot_sk = dot_product(skx,sky,skz,sjx,sjy,sjz);
-      const double sj_dot_sl = dot_product(sjx,sjy,sjz,slx,sly,slz);
+         // get neighbouring atom numbers
+         const int natomj = four_spin_neighbour_list_array_j[nn];
+         const int natomk = four_spin_neighbour_list_array_k[nn];
+         const int natoml = four_spin_neighbour_list_array_l[nn];
+         const double Jij = four_spin_exchange_list[nn];
 
-      double athird=1.0/3.0;
+         const double sjx = x_spin_array[natomj];
+         const double sjy = y_spin_array[natomj];
+         const double sjz = z_spin_array[natomj];
 
-      field_array_x[atom] = field_array_x[atom] + (Jij*athird)*(sjx*sk_dot_sl + skx*sj_dot_sl + slx*sj_dot_sk);
-      field_array_y[atom] = field_array_y[atom] + (Jij*athird)*(sjy*sk_dot_sl + sky*sj_dot_sl + sly*sj_dot_sk);
-      field_array_z[atom] = field_array_z[atom] + (Jij*athird)*(sjz*sk_dot_sl + skz*sj_dot_sl + slz*sj_dot_sk);
+         const double skx = x_spin_array[natomk];
+         const double sky = y_spin_array[natomk];
+         const double skz = z_spin_array[natomk];
+
+         const double slx = x_spin_array[natoml];
+         const double sly = y_spin_array[natoml];
+         const double slz = z_spin_array[natoml];
+
+         const double sk_dot_sl = Jij*dot_product(skx,sky,skz,slx,sly,slz);
+         const double sj_dot_sk = Jij*dot_product(skx,sky,skz,sjx,sjy,sjz);
+         const double sj_dot_sl = Jij*dot_product(sjx,sjy,sjz,slx,sly,slz);
+
+         hx += sjx*sk_dot_sl + skx*sj_dot_sl + slx*sj_dot_sk;
+         hy += sjy*sk_dot_sl + sky*sj_dot_sl + sly*sj_dot_sk;
+         hz += sjz*sk_dot_sl + skz*sj_dot_sl + slz*sj_dot_sk;
+
+      }
+
+      field_array_x[atom] += athird*hx;
+      field_array_y[atom] += athird*hy;
+      field_array_z[atom] += athird*hz;
 
    }
 
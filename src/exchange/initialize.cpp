@@ -50,8 +50,8 @@ namespace exchange{
    //----------------------------------------------------------------------------
    // Function to initialize exchange module
    //----------------------------------------------------------------------------
-   void initialize(std::vector<std::vector <neighbours::neighbour_t> >& bilinear,
-                   std::vector<std::vector <neighbours::neighbour_t> >& biquadratic){
+   void initialize(neighbours::list_t& bilinear,
+                   neighbours::list_t& biquadratic){
 
       zlog << zTs() << "Initialising data structures for exchange calculation." << std::endl;
 
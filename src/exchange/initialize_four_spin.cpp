@@ -11,6 +11,7 @@
 //
 
 // C++ standard library headers
+#include <cmath>
 
 // Vampire headers
 #include "errors.hpp"
@@ -25,177 +26,175 @@
 // exchange module headers
 #include "internal.hpp"
 
-// Vampire headers
-
 namespace exchange{
 
 namespace internal{
 
-   void initialize_four_spin_exchange(std::vector<std::vector <neighbours::neighbour_t> >& cneighbourlist){
+   //---------------------------------------------------------------------------
+   // Function to initialise four-spin quartets
+   //
+   // A quartet consists of a central atom i and three of its nearest
+   // neighbours (at distance four-spin-cutoff-1) which are mutually separated
+   // by four-spin-cutoff-2. The possible quartets depend only on the unit cell
+   // atom of the central atom, and so are found once for each unit cell atom
+   // from the interaction template and then replicated for all atoms using the
+   // interaction types in the neighbour list.
+   //
+   // Each quartet contributes to the field of all four atoms, and so is stored
+   // four times in compressed form, once for each owning atom, so that the
+   // interactions of atom i are stored contiguously in the range
+   //
+   //    four_spin_neighbour_list_start_index[i] ... four_spin_neighbour_list_end_index[i]
+   //
+   //---------------------------------------------------------------------------
+   void initialize_four_spin_exchange(neighbours::list_t& cneighbourlist){
 
       // if four spin exchange is not needed then do nothing
       if(!internal::enable_fourspin) return;
 
-      exchange::internal::four_spin_neighbour_list_start_index.resize(atoms::num_atoms,0);
-      exchange::internal::four_spin_neighbour_list_end_index.resize(atoms::num_atoms,0);
-
-      //distances here are for a cubic system of normalised dimension
-      double nn_distance = internal::fs_cutoff_1;
-      double nnn_distance = internal::fs_cutoff_2;
-
-      double d1,d2,d3;
-      double ucx,ucy,ucz;
-      double x_a,y_a,z_a;
-      double x_b,y_b,z_b;
-      double x_c,y_c,z_c;
-      int k1=1, k2=1,k3=1;
-      //int counter=0;
-      //int counter_sort=0;
-      //int c1,c2;
-
-      //vectors to store the nearest and next nearest neighbours
-      std::vector <int> first_neigh(0);
-      std::vector <int> start_first_neigh(0);
-      std::vector <int> end_first_neigh(0);
-
-      first_neigh.resize(20*atoms::num_atoms);
-      start_first_neigh.resize(atoms::num_atoms);
-      end_first_neigh.resize(atoms::num_atoms);
-
-      //to print out the four-spin interaction
-      std::ofstream ofile;
-      ofile.open("fourspin_quartets.txt");
-
-      ucx=1.0;
-      ucy=1.0;
-      ucz=1.0;
-
-      int counter1=0;
-
-      //this part computes the first order exchange neighbourlist and second
-      start_first_neigh[0]=0;
+      const int num_atoms = atoms::num_atoms;
+      const double tolerance = 0.01; // tolerance for matching distances (A)
+
+      const std::vector<unitcell::interaction_t>& interaction = cs::unit_cell.bilinear.interaction;
+      const unsigned int num_interactions = interaction.size();
+      const unsigned int num_uc_atoms = cs::unit_cell.atom.size();
+
+      //------------------------------------------------------------------------
+      // Determine position vector i->j of each interaction type in template
+      //------------------------------------------------------------------------
+      std::vector<double> interaction_vector(3*num_interactions, 0.0);
+      std::vector<bool> interaction_found(num_interactions, false);
+
+      for(int atom = 0; atom < num_atoms; atom++){
+         const neighbours::row_t neighbours = cneighbourlist[atom];
+         for(uint64_t nn = 0; nn < neighbours.size(); nn++){
+            const int type = neighbours[nn].i;
+            if(interaction_found[type]) continue;
+            interaction_vector[3*type + 0] = neighbours[nn].vx;
+            interaction_vector[3*type + 1] = neighbours[nn].vy;
+            interaction_vector[3*type + 2] = neighbours[nn].vz;
+            interaction_found[type] = true;
+         }
+      }
 
-      for(int i=0;i< atoms::num_atoms ;i++){
-         const int start=atoms::neighbour_list_start_index[i];
-         const int end=atoms::neighbour_list_end_index[i]+1;
-         int am=0;
-         double dist=0;
+      //------------------------------------------------------------------------
+      // Find quartets of template interactions for each unit cell atom
+      //------------------------------------------------------------------------
+      std::vector< std::vector<int> > uc_quartets(num_uc_atoms); // triplets of interaction types
 
-         for(int a=start;a<end;a++){
+      for(unsigned int uc = 0; uc < num_uc_atoms; uc++){
 
-            dist = std::sqrt(std::pow(((cneighbourlist[i][am].vx)/ucx),2)+std::pow(((cneighbourlist[i][am].vy)/ucy),2)+std::pow(((cneighbourlist[i][am].vz)/ucz),2));
+         // nearest neighbour interactions of unit cell atom
+         std::vector<int> first_neighbours;
+         for(unsigned int type = 0; type < num_interactions; type++){
+            if(interaction[type].i != uc || !interaction_found[type]) continue;
+            const double* v = &interaction_vector[3*type];
+            const double r = sqrt(v[0]*v[0] + v[1]*v[1] + v[2]*v[2]);
+            if(fabs(r - fs_cutoff_1) <= tolerance) first_neighbours.push_back(type);
+         }
 
-            if ((dist <= nn_distance+0.01) && (dist >= nn_distance-0.01)){
-               first_neigh[counter1]=cneighbourlist[i][am].nn;
-               counter1=counter1+1;
+         // returns true if interactions a and b are separated by second cutoff
+         auto separated = [&](const int a, const int b){
+            const double dx = interaction_vector[3*a + 0] - interaction_vector[3*b + 0];
+            const double dy = interaction_vector[3*a + 1] - interaction_vector[3*b + 1];
+            const double dz = interaction_vector[3*a + 2] - interaction_vector[3*b + 2];
+            return fabs(sqrt(dx*dx + dy*dy + dz*dz) - fs_cutoff_2) <= tolerance;
+         };
+
+         const unsigned int nfn = first_neighbours.size();
+         for(unsigned int a = 0; a < nfn; a++){
+            for(unsigned int b = a + 1; b < nfn; b++){
+               if(!separated(first_neighbours[a], first_neighbours[b])) continue;
+               for(unsigned int c = b + 1; c < nfn; c++){
+                  if(separated(first_neighbours[a], first_neighbours[c]) && separated(first_neighbours[b], first_neighbours[c])){
+                     uc_quartets[uc].push_back(first_neighbours[a]);
+                     uc_quartets[uc].push_back(first_neighbours[b]);
+                     uc_quartets[uc].push_back(first_neighbours[c]);
+                  }
+               }
             }
-
-            am=am+1;
-
          }
 
-         end_first_neigh[i]=counter1-1;
-         start_first_neigh[i+1]=end_first_neigh[i]+1;
-
       }
 
-      //now create the fourspin interactions
-      int n_interactions = 0;
-
-      for(int i=0;i< atoms::num_atoms ;i++){
-         const int start=start_first_neigh[i];
-         const int end=end_first_neigh[i]+1;
-         const int imaterial = atoms::type_array[i];
-         const double imus = 1.0 / mp::material[imaterial].mu_s_SI; // get inverse spin moment
-
-         four_spin_neighbour_list_start_index[i] = n_interactions;
-
-         for(int a=start;a<end;a++){
-            //const int jmaterial = atoms::type_array[a];
-            for(int b=a;b<end;b++){
-               for(int c=b;c<end;c++){
-
-                  //if system is in the first or second half of the system; this is for pbc (-1)**k1
-                  if(atoms::x_coord_array[i] <= (cs::system_dimensions[0]/2.0)) k1=1; else k1=2;
-                  if(atoms::y_coord_array[i] <= (cs::system_dimensions[1]/2.0)) k2=1; else k2=2;
-                  if(atoms::z_coord_array[i] <= (cs::system_dimensions[2]/2.0)) k3=1; else k3=2;
-
-                  //distances with pbc, this can be changed to be more simple
-                  if (abs(atoms::x_coord_array[i]-atoms::x_coord_array[first_neigh[a]])/ucx >= 1.01) x_a=atoms::x_coord_array[first_neigh[a]]+std::pow(-1,k1)*cs::system_dimensions[0];
-                  else x_a=atoms::x_coord_array[first_neigh[a]];
-
-                  if (abs(atoms::y_coord_array[i]-atoms::y_coord_array[first_neigh[a]])/ucy >= 1.01) y_a=atoms::y_coord_array[first_neigh[a]]+std::pow(-1,k2)*cs::system_dimensions[1];
-                  else y_a=atoms::y_coord_array[first_neigh[a]];
-
-                  if (abs(atoms::z_coord_array[i]-atoms::z_coord_array[first_neigh[a]])/ucz >= 1.01) z_a=atoms::z_coord_array[first_neigh[a]]+std::pow(-1,k3)*cs::system_dimensions[2];
-                  else z_a=atoms::z_coord_array[first_neigh[a]];
-
-                  if (abs(atoms::x_coord_array[i]-atoms::x_coord_array[first_neigh[b]])/ucx >= 1.01) x_b=atoms::x_coord_array[first_neigh[b]]+std::pow(-1,k1)*cs::system_dimensions[0];
-                  else x_b=atoms::x_coord_array[first_neigh[b]];
-
-                  if (abs(atoms::y_coord_array[i]-atoms::y_coord_array[first_neigh[b]])/ucy >= 1.01) y_b=atoms::y_coord_array[first_neigh[b]]+std::pow(-1,k2)*cs::system_dimensions[1];
-                  else y_b=atoms::y_coord_array[first_neigh[b]];
-
-                  if (abs(atoms::z_coord_array[i]-atoms::z_coord_array[first_neigh[b]])/ucz >= 1.01) z_b=atoms::z_coord_array[first_neigh[b]]+std::pow(-1,k3)*cs::system_dimensions[2];
-                  else z_b=atoms::z_coord_array[first_neigh[b]];
-
-                  if (abs(atoms::x_coord_array[i]-atoms::x_coord_array[first_neigh[c]])/ucx >= 1.01) x_c=atoms::x_coord_array[first_neigh[c]]+std::pow(-1,k1)*cs::system_dimensions[0];
-                  else x_c=atoms::x_coord_array[first_neigh[c]];
-
-                  if (abs(atoms::y_coord_array[i]-atoms::y_coord_array[first_neigh[c]])/ucy >= 1.01) y_c=atoms::y_coord_array[first_neigh[c]]+std::pow(-1,k2)*cs::system_dimensions[1];
-                  else y_c=atoms::y_coord_array[first_neigh[c]];
+      //------------------------------------------------------------------------
+      // Replicate template quartets for all atoms, omitting quartets with
+      // missing neighbours (at surfaces)
+      //------------------------------------------------------------------------
+      std::vector<int> quartets; // list of atoms i, j, k, l in each quartet
+      std::vector<int> neighbour_of_type(num_interactions, -1);
+
+      for(int atom = 0; atom < num_atoms; atom++){
+
+         const neighbours::row_t neighbours = cneighbourlist[atom];
+         if(neighbours.size() == 0) continue;
+
+         // unit cell atom of central atom
+         const unsigned int uc = interaction[neighbours[0].i].i;
+         const std::vector<int>& triplets = uc_quartets[uc];
+         if(triplets.size() == 0) continue;
+
+         for(uint64_t nn = 0; nn < neighbours.size(); nn++) neighbour_of_type[neighbours[nn].i] = neighbours[nn].nn;
+
+         for(unsigned int t = 0; t < triplets.size(); t += 3){
+            const int j = neighbour_of_type[triplets[t + 0]];
+            const int k = neighbour_of_type[triplets[t + 1]];
+            const int l = neighbour_of_type[triplets[t + 2]];
+            if(j < 0 || k < 0 || l < 0) continue;
+            quartets.push_back(atom);
+            quartets.push_back(j);
+            quartets.push_back(k);
+            quartets.push_back(l);
+         }
 
-                  if (abs(atoms::z_coord_array[i]-atoms::z_coord_array[first_neigh[c]])/ucz >= 1.01) z_c=atoms::z_coord_array[first_neigh[c]]+std::pow(-1,k3)*cs::system_dimensions[2];
-                  else z_c=atoms::z_coord_array[first_neigh[c]];
+         for(uint64_t nn = 0; nn < neighbours.size(); nn++) neighbour_of_type[neighbours[nn].i] = -1;
 
-                  d1=std::sqrt(std::pow(((x_a-x_b)/ucx),2)+std::pow(((y_a-y_b)/ucy),2)+std::pow(((z_a-z_b)/ucz),2));
-                  d2=std::sqrt(std::pow(((x_c-x_b)/ucx),2)+std::pow(((y_c-y_b)/ucy),2)+std::pow(((z_c-z_b)/ucz),2));
-                  d3=std::sqrt(std::pow(((x_a-x_c)/ucx),2)+std::pow(((y_a-y_c)/ucy),2)+std::pow(((z_a-z_c)/ucz),2));
+      }
 
-                  if (((d1 <= nnn_distance+0.01) && (d1 >= nnn_distance-0.01))&& ((d2 <= nnn_distance+0.01) && (d2 >= nnn_distance-0.01)) &&((d3 <= nnn_distance+0.01) && (d3 >= nnn_distance-0.01)) ){
-                     //get four spin exchange constant from material i to material j
-                     //add j k l to arrays for atom i .
-                     four_spin_neighbour_list_array_i.push_back(i);
-                     four_spin_neighbour_list_array_j.push_back(first_neigh[a]);
-                     four_spin_neighbour_list_array_k.push_back(first_neigh[b]);
-                     four_spin_neighbour_list_array_l.push_back(first_neigh[c]);
+      const uint64_t num_quartets = quartets.size()/4;
 
-                     four_spin_neighbour_list_array_i.push_back(first_neigh[a]);
-                     four_spin_neighbour_list_array_j.push_back(first_neigh[b]);
-                     four_spin_neighbour_list_array_k.push_back(first_neigh[c]);
-                     four_spin_neighbour_list_array_l.push_back(i);
+      //------------------------------------------------------------------------
+      // Store each quartet for each of its four atoms in compressed form
+      //------------------------------------------------------------------------
+      std::vector<int> count(num_atoms + 1, 0);
+      for(uint64_t q = 0; q < 4*num_quartets; q++) count[quartets[q] + 1]++;
+      for(int atom = 0; atom < num_atoms; atom++) count[atom + 1] += count[atom];
 
-                     four_spin_neighbour_list_array_i.push_back(first_neigh[b]);
-                     four_spin_neighbour_list_array_j.push_back(first_neigh[c]);
-                     four_spin_neighbour_list_array_k.push_back(i);
-                     four_spin_neighbour_list_array_l.push_back(first_neigh[a]);
+      four_spin_neighbour_list_start_index.resize(num_atoms);
+      four_spin_neighbour_list_end_index.resize(num_atoms);
+      for(int atom = 0; atom < num_atoms; atom++){
+         four_spin_neighbour_list_start_index[atom] = count[atom];
+         four_spin_neighbour_list_end_index[atom] = count[atom + 1] - 1;
+      }
 
-                     four_spin_neighbour_list_array_i.push_back(first_neigh[c]);
-                     four_spin_neighbour_list_array_j.push_back(i);
-                     four_spin_neighbour_list_array_k.push_back(first_neigh[a]);
-                     four_spin_neighbour_list_array_l.push_back(first_neigh[b]);
+      const uint64_t num_entries = 4*num_quartets;
+      four_spin_neighbour_list_array_j.resize(num_entries);
+      four_spin_neighbour_list_array_k.resize(num_entries);
+      four_spin_neighbour_list_array_l.resize(num_entries);
+      four_spin_exchange_list.resize(num_entries);
 
+      for(uint64_t q = 0; q < num_quartets; q++){
 
-                     //    four times for all the permutations
-                     double fs_value= exchange::internal::mp[atoms::type_array[i]].fs[atoms::type_array[first_neigh[a]]];
-                     four_spin_exchange_list.push_back(fs_value*imus);
-                     four_spin_exchange_list.push_back(fs_value*imus);
-                     four_spin_exchange_list.push_back(fs_value*imus);
-                     four_spin_exchange_list.push_back(fs_value*imus);
+         const int* quartet = &quartets[4*q];
 
-                     //4 interactions due to the permutations
-                     n_interactions=n_interactions+1;
+         // four spin constant between central atom and first neighbour
+         const double fs_value = exchange::internal::mp[atoms::type_array[quartet[0]]].fs[atoms::type_array[quartet[1]]];
 
-                     ofile << n_interactions << "\t" << i << "\t" <<  a << "\t" << b << "\t" << c <<"\t"<<-0.23e-21*imus<<std::endl;
-                     four_spin_neighbour_list_end_index[i] = n_interactions;
-                  }
-               }
-            }
+         // add cyclic permutations i(jkl), j(kli), k(lij), l(ijk)
+         for(int p = 0; p < 4; p++){
+            const int owner = quartet[p];
+            const int index = count[owner];
+            four_spin_neighbour_list_array_j[index] = quartet[(p + 1) % 4];
+            four_spin_neighbour_list_array_k[index] = quartet[(p + 2) % 4];
+            four_spin_neighbour_list_array_l[index] = quartet[(p + 3) % 4];
+            four_spin_exchange_list[index] = fs_value/mp::material[atoms::type_array[owner]].mu_s_SI;
+            count[owner]++;
          }
+
       }
 
-      ofile.close();
-      std::cout<<"Four-spin quartets have been initialised"<<std::endl;
+      zlog << zTs() << "Four-spin quartets initialised with " << num_quartets << " quartets" << std::endl;
+      std::cout << "Four-spin quartets have been initialised" << std::endl;
 
       return;
 
@@ -245,7 +245,6 @@ namespace exchange{
       extern std::vector <int> four_spin_neighbour_list_array_j; // 1D list of j neighbours
       extern std::vector <int> four_spin_neighbour_list_array_k; // 1D list of k neighnours
       extern std::vector <int> four_spin_neighbour_list_array_l; // 1D list of l neighbours
-      extern std::vector <int> four_spin_neighbour_list_array_i; // 1D list of l neighbours
       extern std::vector <int> four_spin_neighbour_list_start_index; // list of first four spin neighbour for atom i
       extern std::vector <int> four_spin_neighbour_list_end_index;   // list of last four spin neighbours for atom i
       extern std::vector <double> four_spin_exchange_list;   // value of fourspin
@@ -257,10 +256,10 @@ namespace exchange{
       //-------------------------------------------------------------------------
       // Internal function declarations
       //-------------------------------------------------------------------------
-      void calculate_dmi(std::vector<std::vector <neighbours::neighbour_t> >& cneighbourlist);
-      void calculate_kitaev(std::vector<std::vector <neighbours::neighbour_t> >& cneighbourlist);
-      void unroll_exchange_interactions(std::vector<std::vector <neighbours::neighbour_t> >& bilinear);
-      void unroll_normalised_exchange_interactions(std::vector<std::vector <neighbours::neighbour_t> >& bilinear);
+      void calculate_dmi(neighbours::list_t& cneighbourlist);
+      void calculate_kitaev(neighbours::list_t& cneighbourlist);
+      void unroll_exchange_interactions(neighbours::list_t& bilinear);
+      void unroll_normalised_exchange_interactions(neighbours::list_t& bilinear);
       void unroll_normalised_biquadratic_exchange_interactions();
       void exchange_fields(const int start_index, // first atom for exchange interactions to be calculated
                            const int end_index, // last +1 atom to be calculated
@@ -303,7 +302,7 @@ namespace exchange{
                                      std::vector<double>& field_array_z);
 
       void initialize_biquadratic_exchange();
-      void initialize_four_spin_exchange(std::vector<std::vector <neighbours::neighbour_t> >& cneighbourlist);
+      void initialize_four_spin_exchange(neighbours::list_t& cneighbourlist);
 
    } // end of internal namespace
 
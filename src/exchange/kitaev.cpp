@@ -39,7 +39,7 @@ namespace internal{
    // limit the interaction range to nearest neighbours.
    //
    //------------------------------------------------------------------------------
-   void calculate_kitaev(std::vector<std::vector <neighbours::neighbour_t> >& cneighbourlist){
+   void calculate_kitaev(neighbours::list_t& cneighbourlist){
 
       // if kitaev is not needed then do nothing
       if(!internal::enable_kitaev) return;
@@ -0,0 +1,192 @@
+//-----------------------------------------------------------------------------
+//
+// This source file is part of the VAMPIRE open source package under the
+// GNU GPL (version 2) licence (see licence file for details).
+//
+// (c) Andrea Meo 2022. All rights reserved.
+//
+//-----------------------------------------------------------------------------
+
+// C++ standard library headers
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+// Vampire headers
+#include "hamr.hpp"
+#include "sim.hpp"
+#include "stats.hpp"
+#include "vio.hpp"
+
+// hamr headers
+#include "internal.hpp"
+
+namespace hamr{
+   namespace internal{
+
+      //-----------------------------------------------------------------------------
+      // Function to initialise active window around the head. Only grains close
+      // to the head are hot enough to switch, so the system is divided into
+      // regions (grains, or square tiles of the laser FWHM for systems without
+      // granular structure) and only atoms of regions overlapping a window
+      // around the head are integrated. For each region the bounding box and
+      // contiguous ranges of atom indices are precomputed so that the list of
+      // active atoms can be rebuilt quickly as the head moves.
+      //-----------------------------------------------------------------------------
+      void initialize_active_window(const std::vector<int>& atom_grain_array, const int num_grains){
+
+         if(!hamr::internal::active_window) return;
+
+         const int num_atoms = hamr::internal::atom_coords_x.size();
+
+         // Window must contain the heated region, where T-Tmin > exp(-8) DeltaT, and the field box
+         hamr::internal::active_window_half_x = std::max(4.0*hamr::internal::laser_sigma_x, 0.5*hamr::internal::H_bounds_x + fabs(hamr::internal::NPS));
+         hamr::internal::active_window_half_y = std::max(4.0*hamr::internal::laser_sigma_y, 0.5*hamr::internal::H_bounds_y);
+         hamr::internal::active_window_half_x = std::max(hamr::internal::active_window_half_x, 0.5*hamr::internal::active_window_size);
+         hamr::internal::active_window_half_y = std::max(hamr::internal::active_window_half_y, 0.5*hamr::internal::active_window_size);
+
+         //-------------------------------------------------------
+         // Determine region of each atom
+         //-------------------------------------------------------
+         std::vector<int> atom_region_array(num_atoms, 0);
+         int num_regions = 0;
+
+         if(num_grains > 1){
+            num_regions = num_grains;
+            for(int atom = 0; atom < num_atoms; atom++) atom_region_array[atom] = atom_grain_array[atom];
+            zlog << zTs() << "HAMR active window divided into " << num_regions << " grains" << std::endl;
+         }
+         else{
+            const double tile_size = std::max(hamr::internal::fwhm_x, hamr::internal::fwhm_y);
+            const int num_tiles_x = int(hamr::internal::system_dimensions_x/tile_size) + 1;
+            const int num_tiles_y = int(hamr::internal::system_dimensions_y/tile_size) + 1;
+            num_regions = num_tiles_x*num_tiles_y;
+            for(int atom = 0; atom < num_atoms; atom++){
+               const int tx = std::min(std::max(int(hamr::internal::atom_coords_x[atom]/tile_size), 0), num_tiles_x - 1);
+               const int ty = std::min(std::max(int(hamr::internal::atom_coords_y[atom]/tile_size), 0), num_tiles_y - 1);
+               atom_region_array[atom] = tx + num_tiles_x*ty;
+            }
+            zlog << zTs() << "HAMR active window divided into " << num_tiles_x << " x " << num_tiles_y << " tiles of size " << tile_size << " A" << std::endl;
+         }
+
+         //-------------------------------------------------------
+         // Determine bounding box and atom ranges of each region
+         //-------------------------------------------------------
+         hamr::internal::region_bounds.resize(4*num_regions);
+         for(int region = 0; region < num_regions; region++){
+            hamr::internal::region_bounds[4*region + 0] = 1.0e300;
+            hamr::internal::region_bounds[4*region + 1] = -1.0e300;
+            hamr::internal::region_bounds[4*region + 2] = 1.0e300;
+            hamr::internal::region_bounds[4*region + 3] = -1.0e300;
+         }
+         hamr::internal::region_atom_ranges.assign(num_regions, std::vector<int>(0));
+         hamr::internal::region_active.assign(num_regions, false);
+
+         for(int atom = 0; atom < num_atoms; atom++){
+
+            const int region = atom_region_array[atom];
+            const double cx = hamr::internal::atom_coords_x[atom];
+            const double cy = hamr::internal::atom_coords_y[atom];
+            double* bounds = &hamr::internal::region_bounds[4*region];
+            bounds[0] = std::min(bounds[0], cx);
+            bounds[1] = std::max(bounds[1], cx);
+            bounds[2] = std::min(bounds[2], cy);
+            bounds[3] = std::max(bounds[3], cy);
+
+            // extend last range of region if contiguous, otherwise start new range
+            std::vector<int>& ranges = hamr::internal::region_atom_ranges[region];
+            if(ranges.size() > 0 && ranges.back() == atom) ranges.back() = atom + 1;
+            else{
+               ranges.push_back(atom);
+               ranges.push_back(atom + 1);
+            }
+
+         }
+
+         zlog << zTs() << "HAMR active window of size " << 2.0*hamr::internal::active_window_half_x << " x " << 2.0*hamr::internal::active_window_half_y
+              << " A enabled" << std::endl;
+
+         return;
+
+      }
+
+      //-----------------------------------------------------------------------------
+      // Function to update list of active atoms for the current head position.
+      // The list is only rebuilt when regions enter or leave the window, when
+      // the cached magnetisation of frozen atoms is also recalculated.
+      //-----------------------------------------------------------------------------
+      void update_active_window(){
+
+         if(!hamr::internal::active_window) return;
+
+         const double xmin = hamr::internal::head_position_x - hamr::internal::active_window_half_x;
+         const double xmax = hamr::internal::head_position_x + hamr::internal::active_window_half_x;
+         const double ymin = hamr::internal::head_position_y - hamr::internal::active_window_half_y;
+         const double ymax = hamr::internal::head_position_y + hamr::internal::active_window_half_y;
+
+         // determine regions overlapping window
+         bool changed = sim::active_atom_ranges.size() == 0;
+         const int num_regions = hamr::internal::region_active.size();
+         for(int region = 0; region < num_regions; region++){
+            const double* bounds = &hamr::internal::region_bounds[4*region];
+            const bool active = bounds[0] <= xmax && bounds[1] >= xmin && bounds[2] <= ymax && bounds[3] >= ymin;
+            if(active != hamr::internal::region_active[region]){
+               hamr::internal::region_active[region] = active;
+               changed = true;
+            }
+         }
+
+         if(!changed) return;
+
+         // collect ranges of atoms in active regions in order of atom index
+         std::vector< std::pair<int,int> > ranges;
+         for(int region = 0; region < num_regions; region++){
+            if(!hamr::internal::region_active[region]) continue;
+            const std::vector<int>& region_ranges = hamr::internal::region_atom_ranges[region];
+            for(unsigned int r = 0; r < region_ranges.size(); r += 2) ranges.push_back(std::make_pair(region_ranges[r], region_ranges[r + 1]));
+         }
+         std::sort(ranges.begin(), ranges.end());
+
+         // merge adjacent ranges
+         std::vector<int>& active_ranges = sim::active_atom_ranges;
+         active_ranges.clear();
+         for(unsigned int r = 0; r < ranges.size(); r++){
+            if(active_ranges.size() > 0 && active_ranges.back() == ranges[r].first) active_ranges.back() = ranges[r].second;
+            else{
+               active_ranges.push_back(ranges[r].first);
+               active_ranges.push_back(ranges[r].second);
+            }
+         }
+
+         // an empty range freezes all atoms if window is outside of system
+         if(active_ranges.size() == 0){
+            active_ranges.push_back(0);
+            active_ranges.push_back(0);
+         }
+
+         stats::set_active_atom_ranges(active_ranges);
+         hamr::internal::num_active_window_updates++;
+
+         return;
+
+      }
+
+      //-----------------------------------------------------------------------------
+      // Function to return to integration of all atoms
+      //-----------------------------------------------------------------------------
+      void finalize_active_window(){
+
+         if(!hamr::internal::active_window) return;
+
+         sim::active_atom_ranges.clear();
+         stats::set_active_atom_ranges(sim::active_atom_ranges);
+         hamr::internal::region_active.assign(hamr::internal::region_active.size(), false);
+
+         zlog << zTs() << "HAMR active window updated " << hamr::internal::num_active_window_updates << " times" << std::endl;
+
+         return;
+
+      }
+
+   } // end of namespace internal
+} // end of namespace hamr
@@ -70,5 +70,29 @@ namespace hamr{
       std::vector<double> atom_coords_y;
       std::vector<double> atom_coords_z;
 
+      std::vector<int> atom_column_array; // column index of each atom
+      std::vector<int> atom_row_array; // row index of each atom
+      std::vector<double> column_coords_x; // x-coordinate of each column
+      std::vector<double> row_coords_y; // y-coordinate of each row
+      std::vector<double> column_profile; // x-factor of Gaussian profile for each column
+      std::vector<double> row_profile; // y-factor of Gaussian profile for each row
+
+      double lut_temperature_min = 0.0; // temperature of first point in table
+      double lut_inverse_resolution = 0.0; // inverse temperature spacing of table points
+      int lut_num_points = 0; // number of points in table for each material
+      std::vector<double> sqrt_temperature_lut; // sqrt of rescaled temperature [material][point]
+      double profile_head_position_x = 0.0; // head position of last evaluated column and row profiles
+      double profile_head_position_y = 0.0;
+      bool profile_evaluated = false;
+
+      bool active_window = false; // flag to enable active window
+      double active_window_size = 0.0; // minimum size of active window (A)
+      double active_window_half_x = 0.0; // half size of active window in x (A)
+      double active_window_half_y = 0.0; // half size of active window in y (A)
+      std::vector<double> region_bounds; // bounding box of each region (xmin,xmax,ymin,ymax)
+      std::vector< std::vector<int> > region_atom_ranges; // contiguous ranges of atoms in each region (start,end)
+      std::vector<bool> region_active; // flag for each region inside active window
+      int num_active_window_updates = 0; // number of times active atoms were re-indexed
+
    } // end of internal namespace
 } // end of hamr namespace
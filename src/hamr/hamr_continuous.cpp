@@ -13,10 +13,12 @@
 
 // Vampire headers
 #include "errors.hpp"
+#include "gpu.hpp"
 #include "hamr.hpp"
 #include "sim.hpp"
 #include "stats.hpp"
 #include "vio.hpp"
+#include "vmpi.hpp"
 
 
 // hamr headers
@@ -85,6 +87,13 @@ namespace hamr{
 		std::cout << " Time per track: " << total_track_time*mp::dt_SI << " s" << std::endl;
 		std::cout << " New total simulation time: " << (total_time + final_time)*mp::dt_SI << " s" << std::endl;
 
+		// Active window is only supported by the serial CPU Heun integrator
+		if(hamr::internal::active_window && (sim::integrator != sim::llg_heun || gpu::acceleration || vmpi::num_processors > 1)){
+			std::cout << "Warning: hamr:active-window is only supported for the serial llg-heun integrator and is disabled" << std::endl;
+			zlog << zTs() << "Warning: hamr:active-window is only supported for the serial llg-heun integrator and is disabled" << std::endl;
+			hamr::internal::active_window = false;
+		}
+
 		//--------------------------------------------//
 		// Start hamr simulation
 		//--------------------------------------------//
@@ -117,6 +126,9 @@ namespace hamr{
 				// Update head position in downtrack
 				hamr::internal::head_position_x += Deltax;
 
+				// Update atoms to be integrated around head
+				hamr::internal::update_active_window();
+
 				// Integrate system
 				sim::integrate(sim::partial_time);
 				// Calculate magnetisation statistics
@@ -147,6 +159,9 @@ namespace hamr{
 					// Determine sign of applied field
 					sim::H_applied = H_app_abs * H_app_dir;
 
+					// Update atoms to be integrated around head
+					hamr::internal::update_active_window();
+
 					// Integrate system
 					sim::integrate(sim::partial_time);
 
@@ -179,6 +194,9 @@ namespace hamr{
 				// Update head position in downtrack
 				hamr::internal::head_position_x += Deltax;
 
+				// Update atoms to be integrated around head
+				hamr::internal::update_active_window();
+
 				// Integrate system
 				sim::integrate(sim::partial_time);
 				// Calculate magnetisation statistics
@@ -212,6 +230,9 @@ namespace hamr{
 			vout::data();
 		}
 
+		// Integrate all atoms again
+		hamr::internal::finalize_active_window();
+
       return;
    } // end of hamr_continuous
 
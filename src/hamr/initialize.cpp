@@ -39,6 +39,8 @@ namespace hamr{
                    const std::vector<double>& atom_coords_y,
                    const std::vector<double>& atom_coords_z,
                    const std::vector<int>& atom_type_array,
+                   const std::vector<int>& atom_grain_array,
+                   const int num_grains,
                    const int num_local_atoms
                   ){
 
@@ -104,6 +106,12 @@ namespace hamr{
       // Check that provided bit sequence is consistent with input data and system dimensions
       hamr::internal::check_sequence_length();
 
+      // Determine columns and rows of atoms and temperature lookup tables
+      hamr::internal::initialize_temperature_profile();
+
+      // Determine regions of atoms for active window around head
+      hamr::internal::initialize_active_window(atom_grain_array, num_grains);
+
       // Set initialised flag
       hamr::internal::initialised = true;
 
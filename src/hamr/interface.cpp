@@ -199,6 +199,26 @@ namespace hamr{
          return true;
       }
 
+      //--------------------------------------------------------------------
+      test="active-window";
+      if(word==test){
+         bool tf = vin::check_for_valid_bool(value, word, line, prefix, "input");
+         hamr::internal::active_window = tf;
+         hamr::internal::enabled = true;
+         return true;
+      }
+      //--------------------------------------------------------------------
+      test="active-window-size";
+      if(word==test){
+         double f = atof(value.c_str());
+         // Test for valid range
+         vin::check_for_valid_value(f, word, line, prefix, unit, "length", 0.0, 1.0e7,"input","0.0 Angstroms - 1 millimetre");
+         hamr::internal::active_window_size = f;
+         hamr::internal::active_window = true;
+         hamr::internal::enabled = true;
+         return true;
+      }
+
       //--------------------------------------------------------------------
       // Keyword not found
       //--------------------------------------------------------------------
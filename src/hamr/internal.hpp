@@ -33,6 +33,18 @@ namespace hamr{
 
       void apply_temperature_profile(const int start_index, const int end_index, const double Tmin, const double DeltaT);
 
+      //-----------------------------------------------------------------------------
+      // Function to initialise separable temperature profile and lookup tables
+      //-----------------------------------------------------------------------------
+      void initialize_temperature_profile();
+
+      //-----------------------------------------------------------------------------
+      // Functions to initialise and update region of active atoms around the head
+      //-----------------------------------------------------------------------------
+      void initialize_active_window(const std::vector<int>& atom_grain_array, const int num_grains);
+      void update_active_window();
+      void finalize_active_window();
+
       //-----------------------------------------------------------------------------
       // Function to calculate the external field with trapezoidal temporal profile
       //-----------------------------------------------------------------------------
@@ -106,6 +118,33 @@ namespace hamr{
       extern std::vector<double> y_field_array;
       extern std::vector<double> z_field_array;
 
+      // separable temperature profile (atoms sit in columns of equal x and rows of equal y)
+      extern std::vector<int> atom_column_array; /// column index of each atom
+      extern std::vector<int> atom_row_array; /// row index of each atom
+      extern std::vector<double> column_coords_x; /// x-coordinate of each column
+      extern std::vector<double> row_coords_y; /// y-coordinate of each row
+      extern std::vector<double> column_profile; /// x-factor of Gaussian profile for each column
+      extern std::vector<double> row_profile; /// y-factor of Gaussian profile for each row
+
+      // lookup table of sqrt of rescaled temperature between Tmin and Tmax for each material
+      extern double lut_temperature_min; /// temperature of first point in table
+      extern double lut_inverse_resolution; /// inverse temperature spacing of table points
+      extern int lut_num_points; /// number of points in table for each material
+      extern std::vector<double> sqrt_temperature_lut; /// sqrt of rescaled temperature [material][point]
+      extern double profile_head_position_x; /// head position of last evaluated column and row profiles
+      extern double profile_head_position_y;
+      extern bool profile_evaluated; /// flag set once column and row profiles have been evaluated
+
+      // active window, where only atoms in regions (grains or tiles) close to the head are integrated
+      extern bool active_window; /// flag to enable active window
+      extern double active_window_size; /// minimum size of active window (A)
+      extern double active_window_half_x; /// half size of active window in x (A)
+      extern double active_window_half_y; /// half size of active window in y (A)
+      extern std::vector<double> region_bounds; /// bounding box of each region (xmin,xmax,ymin,ymax)
+      extern std::vector< std::vector<int> > region_atom_ranges; /// contiguous ranges of atoms in each region (start,end)
+      extern std::vector<bool> region_active; /// flag for each region inside active window
+      extern int num_active_window_updates; /// number of times active atoms were re-indexed
+
    } // end of internal namespace
 } // end of hamr namespace
 
@@ -10,12 +10,15 @@
 //-----------------------------------------------------------------------------
 
 // C++ standard library headers
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 // #include "math.h"
 
 // Vampire headers
 #include "hamr.hpp"
 #include "material.hpp"
+#include "vio.hpp"
 #include "vmpi.hpp"
 
 // hamr headers
@@ -55,6 +58,21 @@ namespace hamr{
       }
 
 
+      //-----------------------------------------------------------------------------
+      // Function to calculate sqrt of the rescaled temperature T -> Tc (T/Tc)^alpha
+      // below Tc, which determines the thermal field strength
+      //-----------------------------------------------------------------------------
+      inline double sqrt_rescaled_temperature(const double temp, const double alpha, const double Tc){
+         // if T<Tc T/Tc = (T/Tc)^alpha else T = T
+         const double rescaled_temperature = temp < Tc ? Tc*pow(temp/Tc,alpha) : temp;
+         return sqrt(rescaled_temperature);
+      }
+
+      // Temperature below which sqrt(T) is evaluated directly rather than interpolated. The relative
+      // error of linear interpolation is at most h^2/(32 T^2) for table spacing h, i.e. 3e-6 at 10 K,
+      // but diverges as T -> 0 where the curvature of sqrt(T) is unbounded.
+      const double lut_minimum_temperature = 10.0;
+
 		/* ------------------------------------------------------------------  /
 		/  Continuous HAMR process                                             /
 		/  T(x,y,t) = (Tmax-Tmin)* exp( -(x-v*t)*(x-v*t)/(2*sigmax*sigmax) )   /
@@ -75,34 +93,123 @@ namespace hamr{
 			const double deny = 2.0 * laser_sigma_y2;
 			const double one_over_deny = 1.0/deny;
 
+			// Evaluate x and y factors of Gaussian profile once per column and row, only when the head has moved
+			if(!hamr::internal::profile_evaluated || px != hamr::internal::profile_head_position_x || py != hamr::internal::profile_head_position_y){
+				const int num_columns = hamr::internal::column_coords_x.size();
+				for(int c = 0; c < num_columns; c++){
+					const double dx = hamr::internal::column_coords_x[c] - px;
+					hamr::internal::column_profile[c] = exp(-dx*dx * one_over_denx);
+				}
+				const int num_rows = hamr::internal::row_coords_y.size();
+				for(int r = 0; r < num_rows; r++){
+					const double dy = hamr::internal::row_coords_y[r] - py;
+					hamr::internal::row_profile[r] = exp(-dy*dy * one_over_deny);
+				}
+				hamr::internal::profile_head_position_x = px;
+				hamr::internal::profile_head_position_y = py;
+				hamr::internal::profile_evaluated = true;
+			}
+
+			// Unroll thermal field prefactor for each material
+			const int num_materials = mp::material.size();
+			std::vector<double> H_th_sigma(num_materials);
+			for(int mat = 0; mat < num_materials; mat++) H_th_sigma[mat] = mp::material[mat].H_th_sigma;
+
+			const int last_point = hamr::internal::lut_num_points - 1;
+
 			for(int atom=start_index;atom<end_index;atom++){
 
 				const int imaterial=hamr::internal::atom_type_array[atom];
-				double alpha = mp::material[imaterial].temperature_rescaling_alpha;
-				double Tc = mp::material[imaterial].temperature_rescaling_Tc;
-
-				const double cx = hamr::internal::atom_coords_x[atom];
-				const double cy = hamr::internal::atom_coords_y[atom];
-				const double cx2 = (cx-px)*(cx-px);
-				const double cy2 = (cy-py)*(cy-py);
 
 				// Get local temperature filed from application of heat profile
-				const double exp_x =  exp(-cx2 * one_over_denx);
-				const double exp_y =  exp(-cy2 * one_over_deny);
+				const double exp_x = hamr::internal::column_profile[hamr::internal::atom_column_array[atom]];
+				const double exp_y = hamr::internal::row_profile[hamr::internal::atom_row_array[atom]];
 				const double temp = Tmin + DeltaT * exp_x * exp_y;
 
-				// if T<Tc T/Tc = (T/Tc)^alpha else T = T
-				double rescaled_temperature = temp < Tc ? Tc*pow(temp/Tc,alpha) : temp;
-				const double sqrt_T=sqrt(rescaled_temperature);
-
-				const double H_th_sigma = sqrt_T*mp::material[imaterial].H_th_sigma;
-
-				hamr::internal::x_field_array[atom] *= H_th_sigma;
-				hamr::internal::y_field_array[atom] *= H_th_sigma;
-				hamr::internal::z_field_array[atom] *= H_th_sigma;
+				// Interpolate sqrt of rescaled temperature from lookup table (evaluated directly at low temperature)
+				double sqrt_T;
+				if(temp < lut_minimum_temperature){
+					sqrt_T = sqrt_rescaled_temperature(temp, mp::material[imaterial].temperature_rescaling_alpha, mp::material[imaterial].temperature_rescaling_Tc);
+				}
+				else{
+					const double u = std::min(std::max((temp - hamr::internal::lut_temperature_min)*hamr::internal::lut_inverse_resolution, 0.0), double(last_point));
+					const int i = std::min(int(u), last_point - 1);
+					const double* lut = &hamr::internal::sqrt_temperature_lut[imaterial*hamr::internal::lut_num_points];
+					sqrt_T = lut[i] + (u - double(i))*(lut[i+1] - lut[i]);
+				}
+
+				const double H_th_sigma_T = sqrt_T*H_th_sigma[imaterial];
+
+				hamr::internal::x_field_array[atom] *= H_th_sigma_T;
+				hamr::internal::y_field_array[atom] *= H_th_sigma_T;
+				hamr::internal::z_field_array[atom] *= H_th_sigma_T;
 			}
 			return;
       } // end of apply_temperature_profile
 
+      //-----------------------------------------------------------------------------
+      // Function to initialise separable temperature profile and lookup tables.
+      // Atoms sit on a lattice, so the x and y factors of the Gaussian profile
+      // are only evaluated for each distinct column and row of atoms. The
+      // temperature dependence of the thermal field sqrt(T) (with optional
+      // rescaling T -> Tc (T/Tc)^alpha below Tc) is tabulated for each material
+      // between Tmin and Tmax and linearly interpolated, except below
+      // lut_minimum_temperature where it is evaluated directly.
+      //-----------------------------------------------------------------------------
+      void initialize_temperature_profile(){
+
+         const int num_atoms = hamr::internal::atom_coords_x.size();
+
+         // determine distinct x and y coordinates of atoms
+         hamr::internal::column_coords_x = hamr::internal::atom_coords_x;
+         hamr::internal::row_coords_y = hamr::internal::atom_coords_y;
+         std::sort(hamr::internal::column_coords_x.begin(), hamr::internal::column_coords_x.end());
+         std::sort(hamr::internal::row_coords_y.begin(), hamr::internal::row_coords_y.end());
+         hamr::internal::column_coords_x.erase(std::unique(hamr::internal::column_coords_x.begin(), hamr::internal::column_coords_x.end()), hamr::internal::column_coords_x.end());
+         hamr::internal::row_coords_y.erase(std::unique(hamr::internal::row_coords_y.begin(), hamr::internal::row_coords_y.end()), hamr::internal::row_coords_y.end());
+
+         hamr::internal::column_profile.resize(hamr::internal::column_coords_x.size(), 0.0);
+         hamr::internal::row_profile.resize(hamr::internal::row_coords_y.size(), 0.0);
+
+         // set column and row of each atom
+         hamr::internal::atom_column_array.resize(num_atoms);
+         hamr::internal::atom_row_array.resize(num_atoms);
+         for(int atom = 0; atom < num_atoms; atom++){
+            hamr::internal::atom_column_array[atom] = std::lower_bound(hamr::internal::column_coords_x.begin(), hamr::internal::column_coords_x.end(),
+                                                                       hamr::internal::atom_coords_x[atom]) - hamr::internal::column_coords_x.begin();
+            hamr::internal::atom_row_array[atom] = std::lower_bound(hamr::internal::row_coords_y.begin(), hamr::internal::row_coords_y.end(),
+                                                                    hamr::internal::atom_coords_y[atom]) - hamr::internal::row_coords_y.begin();
+         }
+
+         // determine lookup table points with 0.1 K resolution
+         const double resolution = 0.1;
+         const double Tlow = std::min(hamr::internal::Tmin, hamr::internal::Tmax);
+         const double range = std::fabs(hamr::internal::Tmax - hamr::internal::Tmin);
+         const int num_points = int(range/resolution) + 2;
+         const double dT = range/double(num_points - 1);
+
+         hamr::internal::lut_temperature_min = Tlow;
+         hamr::internal::lut_inverse_resolution = range > 0.0 ? 1.0/dT : 0.0;
+         hamr::internal::lut_num_points = num_points;
+
+         const int num_materials = mp::material.size();
+         hamr::internal::sqrt_temperature_lut.resize(num_materials*num_points);
+
+         for(int mat = 0; mat < num_materials; mat++){
+            const double alpha = mp::material[mat].temperature_rescaling_alpha;
+            const double Tc = mp::material[mat].temperature_rescaling_Tc;
+            for(int i = 0; i < num_points; i++){
+               const double temp = Tlow + dT*double(i);
+               hamr::internal::sqrt_temperature_lut[mat*num_points + i] = sqrt_rescaled_temperature(temp, alpha, Tc);
+            }
+         }
+
+         zlog << zTs() << "HAMR temperature profile evaluated on " << hamr::internal::column_coords_x.size() << " columns and "
+              << hamr::internal::row_coords_y.size() << " rows of atoms with " << num_points << " point temperature lookup tables" << std::endl;
+
+         return;
+
+      }
+
    } // end of namespace internal
 } // end of namespace hamr
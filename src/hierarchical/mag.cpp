@@ -102,7 +102,8 @@ void calculate_hierarchical_magnetisation(std::vector <double>& x_spin_array, //
       int start = ha::cells_level_start_index[level];
       int end   = ha::cells_level_end_index[level];
 
-      // loop over all cells in level L
+      // loop over all cells in level L (each cell only depends on cells of level L-1)
+      #pragma omp parallel for schedule(static)
       for (int cell = start; cell < end; cell++){
 
          // determine which lower level cells L-1 are in each higher level cell
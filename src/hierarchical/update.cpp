@@ -54,101 +54,77 @@ void update(std::vector <double>& x_spin_array, // atomic spin directions
    // start timer
    timer.start();
 
-   // initialise cell fields to a large negative number for MPI reduction
-   for (int i = 0 ; i < cells::num_cells; i ++){
-      dipole::cells_field_array_x[i] = -100000.0;
-      dipole::cells_field_array_y[i] = -100000.0;
-      dipole::cells_field_array_z[i] = -100000.0;
+   // Multiply Hdemg by mu_0/4pi * 1e30 * mu_B to account for normalisation of magnetisation and volume in angstrom
+   const double muB_mu0_four_pi = 9.27400915e-01;
+
+   // Divide local cells between threads balanced by number of hierarchical cell interactions
+   if(dipole::internal::local_cell_partition.size() == 0){
+      std::vector<uint64_t> num_interactions(dipole::internal::cells_num_local_cells);
+      for(int lc = 0; lc < dipole::internal::cells_num_local_cells; lc++){
+         num_interactions[lc] = 1 + ha::interaction_list_end_index[lc] - ha::interaction_list_start_index[lc];
+      }
+      dipole::internal::set_local_cell_partition(num_interactions);
    }
+   const int num_partitions = dipole::internal::local_cell_partition.size() - 1;
 
    // Compute dipole fields for all cells with atoms (local cells)
-	for(int lc = 0; lc < dipole::internal::cells_num_local_cells; lc++){
+   #pragma omp parallel for schedule(static,1)
+   for(int partition = 0; partition < num_partitions; partition++){
+
+	for(int lc = dipole::internal::local_cell_partition[partition]; lc < dipole::internal::local_cell_partition[partition+1]; lc++){
 
       // get global cell ID from local cell list
-      int cell_i = cells::cell_id_array[lc];
+      const int cell_i = cells::cell_id_array[lc];
 
       // Store range of hierarchical cells contributing to dipole field for lc cell
       const int start = ha::interaction_list_start_index[lc];
       const int end = ha::interaction_list_end_index[lc];
 
       // Self demagnetisation factor multiplying m(i)
-      const double V = dipole::internal::cells_volume_array[cell_i];
-      const double eightPI_three_cell_volume = 8.0*M_PI/(3.0*V);
-      const double self_demag = eightPI_three_cell_volume;
-      //std::cout << self_demag << std::endl;
+      const double self_demag = dipole::internal::cells_self_demag_array[cell_i];
 
       // Normalise cell magnetisation by the Bohr magneton
       const double mx_i = cells::mag_array_x[cell_i]*imuB;
       const double my_i = cells::mag_array_y[cell_i]*imuB;
       const double mz_i = cells::mag_array_z[cell_i]*imuB;
-      // std::cout << cell_i << '\t' << mx_i << '\t' << my_i << '\t' << mz_i << std::endl;
 
       // Add self-demagnetisation as mu_0/4_PI * 8PI*m_cell/3V
-      dipole::cells_field_array_x[cell_i] = self_demag * mx_i; //*0.0
-      dipole::cells_field_array_y[cell_i] = self_demag * my_i; //*0.0
-      dipole::cells_field_array_z[cell_i] = self_demag * mz_i; //*0.0
-
-      // Add self demag to Hdemag --> To get only dipole-dipole contribution comment this and initialise to zero
-      dipole::cells_mu0Hd_field_array_x[cell_i] = -0.5*self_demag * mx_i;
-      dipole::cells_mu0Hd_field_array_y[cell_i] = -0.5*self_demag * my_i;
-      dipole::cells_mu0Hd_field_array_z[cell_i] = -0.5*self_demag * mz_i;
+      double hx = self_demag * mx_i;
+      double hy = self_demag * my_i;
+      double hz = self_demag * mz_i;
 
       // Loop over all cells
       for(int j = start; j<end;j++){
 
          // get cell ID of neighbouring cell
-         int cell_j = ha::interaction_list[j];
-
-         const double mx = ha::mag_array_x[cell_j];//*imuB;
-         const double my = ha::mag_array_y[cell_j];//*imuB;
-         const double mz = ha::mag_array_z[cell_j];//*imuB;
+         const int cell_j = ha::interaction_list[j];
 
-         //    if (cell_i == 389)  std::cout << cell_j << '\t' << mx << '\t' << my << '\t' << mz<< "\t" << cell_i << '\t' << std::endl;
-         //if (cell_i == 0)std::cout<< cell_i << '\t' << mx_i << '\t' << my_i << '\t' << mz_i << "\t" <<  cell_j << '\t' << mx << '\t' << my << '\t' << mz <<std::endl;
+         const double mx = ha::mag_array_x[cell_j];
+         const double my = ha::mag_array_y[cell_j];
+         const double mz = ha::mag_array_z[cell_j];
 
          // Compute dipole field contribution using dipole tensor
-         dipole::cells_field_array_x[cell_i]      +=(mx*ha::rij_tensor_xx[j] + my*ha::rij_tensor_xy[j] + mz*ha::rij_tensor_xz[j]);
-         dipole::cells_field_array_y[cell_i]      +=(mx*ha::rij_tensor_xy[j] + my*ha::rij_tensor_yy[j] + mz*ha::rij_tensor_yz[j]);
-         dipole::cells_field_array_z[cell_i]      +=(mx*ha::rij_tensor_xz[j] + my*ha::rij_tensor_yz[j] + mz*ha::rij_tensor_zz[j]);
-
-         // Demag field
-         dipole::cells_mu0Hd_field_array_x[cell_i] +=(mx*ha::rij_tensor_xx[j] + my*ha::rij_tensor_xy[j] + mz*ha::rij_tensor_xz[j]);
-         dipole::cells_mu0Hd_field_array_y[cell_i] +=(mx*ha::rij_tensor_xy[j] + my*ha::rij_tensor_yy[j] + mz*ha::rij_tensor_yz[j]);
-         dipole::cells_mu0Hd_field_array_z[cell_i] +=(mx*ha::rij_tensor_xz[j] + my*ha::rij_tensor_yz[j] + mz*ha::rij_tensor_zz[j]);
-         // std::cout << rij_tensor_xx[j] << '\t' << rij_tensor_xy[j] << '\t' << rij_tensor_xz[j] << '\t' << rij_tensor_yy[j] << '\t' << rij_tensor_yz[j] << '\t' << rij_tensor_zz[j] << '\t' <<std::endl;
+         hx += (mx*ha::rij_tensor_xx[j] + my*ha::rij_tensor_xy[j] + mz*ha::rij_tensor_xz[j]);
+         hy += (mx*ha::rij_tensor_xy[j] + my*ha::rij_tensor_yy[j] + mz*ha::rij_tensor_yz[j]);
+         hz += (mx*ha::rij_tensor_xz[j] + my*ha::rij_tensor_yz[j] + mz*ha::rij_tensor_zz[j]);
 
       }
-      //   std::cout <<"D\t" << cell_i << '\t' << dipole::cells_field_array_x[cell_i] <<'\t' << dipole::cells_field_array_y[cell_i] <<'\t' << dipole::cells_field_array_z[cell_i] <<std::endl;
 
-      // Multiply Hdemg by mu_0/4pi * 1e30 * mu_B to account for normalisation of magnetisation and volume in angstrom
-      dipole::cells_field_array_x[cell_i] = dipole::cells_field_array_x[cell_i] * 9.27400915e-01;
-      dipole::cells_field_array_y[cell_i] = dipole::cells_field_array_y[cell_i] * 9.27400915e-01;
-      dipole::cells_field_array_z[cell_i] = dipole::cells_field_array_z[cell_i] * 9.27400915e-01;
-      //std::cout << sim::time << '\t' << cell_i << '\t' << dipole::cells_field_array_x[cell_i] << '\t' << dipole::cells_field_array_y[cell_i] << '\t' << dipole::cells_field_array_z[cell_i] << '\t' << std::endl;
-      //std::cout << "SP" << dipole::cells_field_array_x[cell_i] << "\t" << dipole::cells_field_array_y[cell_i] << '\t' << dipole::cells_field_array_z[cell_i]<< std::endl;
+      dipole::cells_field_array_x[cell_i] = hx * muB_mu0_four_pi;
+      dipole::cells_field_array_y[cell_i] = hy * muB_mu0_four_pi;
+      dipole::cells_field_array_z[cell_i] = hz * muB_mu0_four_pi;
 
-      // Multiply Hdemg by mu_0/4pi * 1e30 * mu_B to account for normalisation of magnetisation and volume in angstrom
-      dipole::cells_mu0Hd_field_array_x[cell_i] = dipole::cells_mu0Hd_field_array_x[cell_i] * 9.27400915e-01;
-      dipole::cells_mu0Hd_field_array_y[cell_i] = dipole::cells_mu0Hd_field_array_y[cell_i] * 9.27400915e-01;
-      dipole::cells_mu0Hd_field_array_z[cell_i] = dipole::cells_mu0Hd_field_array_z[cell_i] * 9.27400915e-01;
-      //if (cell_i == 0) std::cout << sim::time << '\t' << cell_i << '\t' <<  dipole::cells_field_array_x[cell_i] << '\t' << dipole::cells_field_array_y[cell_i] << '\t' << dipole::cells_field_array_z[cell_i] << '\t' << std::endl;
+      // Demag field has self demagnetisation -0.5*8PI*m_cell/3V instead --> To get only dipole-dipole contribution remove self_demag term
+      dipole::cells_mu0Hd_field_array_x[cell_i] = (hx - 1.5*self_demag * mx_i) * muB_mu0_four_pi;
+      dipole::cells_mu0Hd_field_array_y[cell_i] = (hy - 1.5*self_demag * my_i) * muB_mu0_four_pi;
+      dipole::cells_mu0Hd_field_array_z[cell_i] = (hz - 1.5*self_demag * mz_i) * muB_mu0_four_pi;
 
    }
 
-   #ifdef MPICF
-      // Reduce fields on all processors so all have correct field values
-      MPI_Allreduce(MPI_IN_PLACE, &dipole::cells_field_array_x[0], dipole::internal::cells_num_cells, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
-      MPI_Allreduce(MPI_IN_PLACE, &dipole::cells_field_array_y[0], dipole::internal::cells_num_cells, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
-      MPI_Allreduce(MPI_IN_PLACE, &dipole::cells_field_array_z[0], dipole::internal::cells_num_cells, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
-   #endif
-
-   // Check for cells with unrealistic fields from initialisation and zero
-   for (int i = 0 ; i < dipole::internal::cells_num_cells; i ++){
-      if (dipole::cells_field_array_x[i] < -1000) dipole::cells_field_array_x[i] = 0.0;
-      if (dipole::cells_field_array_y[i] < -1000) dipole::cells_field_array_y[i] = 0.0;
-      if (dipole::cells_field_array_z[i] < -1000) dipole::cells_field_array_z[i] = 0.0;
-      //  std::cout << i << '\t' << dipole::cells_field_array_x[i] << '\t' << dipole::cells_field_array_y[i] << '\t' << dipole::cells_field_array_z[i] <<std::endl;
-   }
+   } // end of loop over partitions
+
+   // Receive fields of cells calculated on other processors
+   dipole::internal::gather_cells_field();
 
    timer.stop();
 
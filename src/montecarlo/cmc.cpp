@@ -139,59 +139,55 @@ void polar_rot_matrix(
 
 }
 
-/// Function to rotate all spin around the z-axis
-void rotate_spins_around_z_axis(double ddz){
+//------------------------------------------------------------------------------
+// Computes the combined rotation matrix taking spins from constraint direction
+// (phi_old, theta_old) to (phi_new, theta_new) for row vectors, S' = S.R.
+// The three elementary rotations (theta_old -> 0 about z, phi_old -> phi_new
+// about x and 0 -> theta_new about z) are multiplied out once here so that
+// each spin is rotated with a single 3x3 product.
+//------------------------------------------------------------------------------
+void constraint_rotation_matrix(const double theta_old, const double phi_delta, const double theta_new, double rotation_matrix[3][3]){
 
 	std::vector< std::vector<double> > x_rotation_matrix,y_rotation_matrix,z_rotation_matrix;
+	std::vector< std::vector<double> > z_old_rotation_matrix,z_new_rotation_matrix;
 
-	// determine rotational matrices for phi, theta rotation
-	vmath::set_rotational_matrix(0.0, 0.0, ddz, x_rotation_matrix,y_rotation_matrix,z_rotation_matrix);
-
-	// loop over all spins and rotate by theta around z
-	for(int atom =0;atom<atoms::num_atoms;atom++){
+	// determine rotational matrices for each elementary rotation
+	vmath::set_rotational_matrix(0.0, 0.0, -theta_old, x_rotation_matrix,y_rotation_matrix,z_old_rotation_matrix);
+	vmath::set_rotational_matrix(0.0, 0.0, theta_new, x_rotation_matrix,y_rotation_matrix,z_new_rotation_matrix);
+	vmath::set_rotational_matrix(phi_delta, 0.0, 0.0, x_rotation_matrix,y_rotation_matrix,z_rotation_matrix);
 
-			// Load spin coordinates
-			internal::Sold[0]=atoms::x_spin_array[atom];
-			internal::Sold[1]=atoms::y_spin_array[atom];
-			internal::Sold[2]=atoms::z_spin_array[atom];
+	// combine rotations
+	std::vector< std::vector<double> > zx_rotation_matrix = vmath::matmul(z_old_rotation_matrix,x_rotation_matrix);
+	std::vector< std::vector<double> > zxz_rotation_matrix = vmath::matmul(zx_rotation_matrix,z_new_rotation_matrix);
 
-			// Calculate new spin positions
-			internal::Snew = vmath::matmul(internal::Sold,z_rotation_matrix);
-
-			// Set new spin positions
-			atoms::x_spin_array[atom]=internal::Snew[0];
-			atoms::y_spin_array[atom]=internal::Snew[1];
-			atoms::z_spin_array[atom]=internal::Snew[2];
-		}
+	for(int i=0;i<3;i++){
+		for(int j=0;j<3;j++) rotation_matrix[i][j]=zxz_rotation_matrix[i][j];
+	}
 
 	return;
 }
 
-/// Function to rotate all spin around the x-axis
-void rotate_spins_around_x_axis(double ddx){
-
-	std::vector< std::vector<double> > x_rotation_matrix,y_rotation_matrix,z_rotation_matrix;
+//------------------------------------------------------------------------------
+// Rotates all spins in list by rotation matrix (S' = S.R)
+//------------------------------------------------------------------------------
+void rotate_spins(const std::vector<int>& list, const double rotation_matrix[3][3]){
 
-	// determine rotational matrices for phi, theta rotation
-	vmath::set_rotational_matrix(ddx, 0.0, 0.0, x_rotation_matrix,y_rotation_matrix,z_rotation_matrix);
+	const int num_list_atoms = list.size();
 
-	//vmath::print_matrix(x_rotation_matrix);
+	for(int index=0;index<num_list_atoms;index++){
 
-	// loop over all spins and rotate by phi around x
-	for(int atom =0;atom<atoms::num_atoms;atom++){
+		const int atom=list[index];
 
 		// Load spin coordinates
-		internal::Sold[0]=atoms::x_spin_array[atom];
-		internal::Sold[1]=atoms::y_spin_array[atom];
-		internal::Sold[2]=atoms::z_spin_array[atom];
-
-		// Calculate new spin positions
-		internal::Snew = vmath::matmul(internal::Sold,x_rotation_matrix);
+		const double sx=atoms::x_spin_array[atom];
+		const double sy=atoms::y_spin_array[atom];
+		const double sz=atoms::z_spin_array[atom];
 
 		// Set new spin positions
-		atoms::x_spin_array[atom]=internal::Snew[0];
-		atoms::y_spin_array[atom]=internal::Snew[1];
-		atoms::z_spin_array[atom]=internal::Snew[2];
+		atoms::x_spin_array[atom]=sx*rotation_matrix[0][0]+sy*rotation_matrix[1][0]+sz*rotation_matrix[2][0];
+		atoms::y_spin_array[atom]=sx*rotation_matrix[0][1]+sy*rotation_matrix[1][1]+sz*rotation_matrix[2][1];
+		atoms::z_spin_array[atom]=sx*rotation_matrix[0][2]+sy*rotation_matrix[1][2]+sz*rotation_matrix[2][2];
+
 	}
 
 	return;
@@ -251,14 +247,14 @@ void CMCinit(){
 		if(sim::constraint_theta_changed) theta_old = sim::constraint_theta - sim::constraint_theta_delta;
 		if(sim::constraint_phi_changed) phi_old     = sim::constraint_phi   - sim::constraint_phi_delta;
 
-		// Rotate all spins from theta_old to theta = 0 (reference direction along x)
-		cmc::rotate_spins_around_z_axis(-theta_old);
+		// Rotate all spins from theta_old to theta = 0 (reference direction along x),
+		// from phi_old to phi_new and from theta = 0 to theta = theta_new in a single pass
+		double rotation_matrix[3][3];
+		cmc::constraint_rotation_matrix(theta_old, phi_new-phi_old, theta_new, rotation_matrix);
 
-		// Rotate all spins from phi_old to phi_new
-		cmc::rotate_spins_around_x_axis(phi_new-phi_old);
-
-		// Rotate all spins from theta = 0 to theta = theta_new
-		cmc::rotate_spins_around_z_axis(theta_new);
+		std::vector<int> all_atoms(atoms::num_atoms);
+		for(int atom=0;atom<atoms::num_atoms;atom++) all_atoms[atom]=atom;
+		cmc::rotate_spins(all_atoms, rotation_matrix);
 
 		// reset rotation flags
 		sim::constraint_theta_changed = false;
@@ -297,8 +293,8 @@ int cmc_step(){
 	double delta_energy2;
 	double delta_energy21;
 
-	double Eold;
-	double Enew;
+	double components1[4]; // energy change of statistics terms for each spin
+	double components2[4];
 
 	std::vector<double> spin1_initial(3);
 	std::vector<double> spin1_final(3);
@@ -384,23 +380,14 @@ int cmc_step(){
 		spin1_fin_mvd[1]=ppolar_matrix[1][0]*spin1_final[0]+ppolar_matrix[1][1]*spin1_final[1]+ppolar_matrix[1][2]*spin1_final[2];
 		spin1_fin_mvd[2]=ppolar_matrix[2][0]*spin1_final[0]+ppolar_matrix[2][1]*spin1_final[1]+ppolar_matrix[2][2]*spin1_final[2];
 
-		// Calculate Energy Difference 1
-		//call calc_one_spin_energy(delta_energy1,spin1_final,atom_number1)
-
-		// Calculate current energy
-		Eold = sim::calculate_spin_energy(atom_number1);
+		// Calculate Energy Difference 1 in Joules/mu_B
+		delta_energy1 = sim::calculate_spin_energy_difference(atom_number1, &spin1_initial[0], &spin1_final[0], components1)*mp::material[imat1].mu_s_SI*1.07828231e23; //1/9.27400915e-24
 
 		// Copy new spin position (provisionally accept move)
 		atoms::x_spin_array[atom_number1] = spin1_final[0];
 		atoms::y_spin_array[atom_number1] = spin1_final[1];
 		atoms::z_spin_array[atom_number1] = spin1_final[2];
 
-		// Calculate new energy
-		Enew = sim::calculate_spin_energy(atom_number1);
-
-		// Calculate difference in Joules/mu_B
-		delta_energy1 = (Enew-Eold)*mp::material[imat1].mu_s_SI*1.07828231e23; //1/9.27400915e-24
-
 		// Compute second move
 
 		// Randomly select spin number 2 (i/=j)
@@ -436,21 +423,14 @@ int cmc_step(){
 			// Automatically accept move for Spin1 - now before if ^^
 			//atomic_spin_array(:,atom_number1) = spin1_final(:)
 
-			//Calculate Energy Difference 2
-			// Calculate current energy
-			Eold = sim::calculate_spin_energy(atom_number2);
+			// Calculate Energy Difference 2 in Joules/mu_B (with spin 1 already moved)
+			delta_energy2 = sim::calculate_spin_energy_difference(atom_number2, spin2_initial, spin2_final, components2)*mp::material[imat2].mu_s_SI*1.07828231e23; //1/9.27400915e-24
 
 			// Copy new spin position (provisionally accept move)
 			atoms::x_spin_array[atom_number2] = spin2_final[0];
 			atoms::y_spin_array[atom_number2] = spin2_final[1];
 			atoms::z_spin_array[atom_number2] = spin2_final[2];
 
-			// Calculate new energy
-			Enew = sim::calculate_spin_energy(atom_number2);
-
-			// Calculate difference in Joules/mu_B
-			delta_energy2 = (Enew-Eold)*mp::material[imat2].mu_s_SI*1.07828231e23; //1/9.27400915e-24
-
 			// Calculate Delta E for both spins
 			delta_energy21 = delta_energy1*rescaled_material_kBTBohr[imat1] + delta_energy2*rescaled_material_kBTBohr[imat2];
 
@@ -473,6 +453,8 @@ int cmc_step(){
 					M_other[1] = M_other[1] + mu1*spin1_final[1] + mu2*spin2_final[1] - mu1*spin1_initial[1] - mu2*spin2_initial[1];
 					M_other[2] = M_other[2] + mu1*spin1_final[2] + mu2*spin2_final[2] - mu1*spin1_initial[2] - mu2*spin2_initial[2];
 					cmc::mc_success += 1.0;
+					if(internal::record_energy) internal::record_pair_energy_change(atom_number1, &spin1_initial[0], &spin1_final[0], components1,
+					                                                                atom_number2, spin2_initial, spin2_final, components2);
 				}
 				//if both p1 and p2 not allowed then
 				else{
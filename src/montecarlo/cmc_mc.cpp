@@ -137,68 +137,6 @@ void mat_polar_rot_matrix()
 
 } // end of polar rotation initialisation
 
-/// Function to rotate all spin around the z-axis
-void rotate_material_spins_around_z_axis(double ddz, int material){
-
-	std::vector< std::vector<double> > x_rotation_matrix,y_rotation_matrix,z_rotation_matrix;
-
-	// determine rotational matrices for phi, theta rotation
-	vmath::set_rotational_matrix(0.0, 0.0, ddz, x_rotation_matrix,y_rotation_matrix,z_rotation_matrix);
-
-	// loop over all spins and rotate by theta around z
-	for(int atom =0;atom<atoms::num_atoms;atom++){
-		int mat=atoms::type_array[atom];
-		if(mat==material){
-
-			// Load spin coordinates
-			internal::Sold[0]=atoms::x_spin_array[atom];
-			internal::Sold[1]=atoms::y_spin_array[atom];
-			internal::Sold[2]=atoms::z_spin_array[atom];
-
-			// Calculate new spin positions
-			internal::Snew = vmath::matmul(internal::Sold,z_rotation_matrix);
-
-			// Set new spin positions
-			atoms::x_spin_array[atom]=internal::Snew[0];
-			atoms::y_spin_array[atom]=internal::Snew[1];
-			atoms::z_spin_array[atom]=internal::Snew[2];
-		}
-	}
-
-	return;
-}
-
-/// Function to rotate all spin around the x-axis
-void rotate_material_spins_around_x_axis(double ddx, int material){
-
-	std::vector< std::vector<double> > x_rotation_matrix,y_rotation_matrix,z_rotation_matrix;
-
-	// determine rotational matrices for phi, theta rotation
-	vmath::set_rotational_matrix(ddx, 0.0, 0.0, x_rotation_matrix,y_rotation_matrix,z_rotation_matrix);
-
-	// loop over all spins and rotate by phi around x
-	for(int atom =0;atom<atoms::num_atoms;atom++){
-		int mat=atoms::type_array[atom];
-		if(mat==material){
-
-			// Load spin coordinates
-			internal::Sold[0]=atoms::x_spin_array[atom];
-			internal::Sold[1]=atoms::y_spin_array[atom];
-			internal::Sold[2]=atoms::z_spin_array[atom];
-
-			// Calculate new spin positions
-			internal::Snew = vmath::matmul(internal::Sold,x_rotation_matrix);
-
-			// Set new spin positions
-			atoms::x_spin_array[atom]=internal::Snew[0];
-			atoms::y_spin_array[atom]=internal::Snew[1];
-			atoms::z_spin_array[atom]=internal::Snew[2];
-		}
-	}
-
-	return;
-}
-
 } // end of cmc namespace
 
 //------------------------------------------------------------------------------
@@ -213,8 +151,9 @@ void CMCMCinit(){
 	// Create rotational matrices for cmc
 	cmc::mat_polar_rot_matrix();
 
-	cmc::atom_list.resize(mp::num_materials);
-	// create list of matching materials
+	// create list of atoms in each material so that rotations and pair selection
+	// only visit atoms of the material concerned
+	cmc::atom_list.assign(mp::num_materials, std::vector<int>(0));
 	for(int atom=0;atom<atoms::num_atoms;atom++){
 		int mat=atoms::type_array[atom];
 		cmc::atom_list[mat].push_back(atom);
@@ -227,15 +166,17 @@ void CMCMCinit(){
 		zlog << zTs() << "Initialising spins in all materials to new constraint directions." << std::endl;
 
 	// Initialise all spins along the constraint direction(s).
-	for(int atom =0;atom<atoms::num_atoms;atom++){
-		int imat=atoms::type_array[atom];
+	for(int imat=0;imat<mp::num_materials;imat++){
 		if(mp::material[imat].constrained==true){
-			double sx=sin(cmc::cmc_mat[imat].constraint_phi*M_PI/180.0)*cos(cmc::cmc_mat[imat].constraint_theta*M_PI/180.0);
-			double sy=sin(cmc::cmc_mat[imat].constraint_phi*M_PI/180.0)*sin(cmc::cmc_mat[imat].constraint_theta*M_PI/180.0);
-			double sz=cos(cmc::cmc_mat[imat].constraint_phi*M_PI/180.0);
-			atoms::x_spin_array[atom]=sx;
-			atoms::y_spin_array[atom]=sy;
-			atoms::z_spin_array[atom]=sz;
+			const double sx=sin(cmc::cmc_mat[imat].constraint_phi*M_PI/180.0)*cos(cmc::cmc_mat[imat].constraint_theta*M_PI/180.0);
+			const double sy=sin(cmc::cmc_mat[imat].constraint_phi*M_PI/180.0)*sin(cmc::cmc_mat[imat].constraint_theta*M_PI/180.0);
+			const double sz=cos(cmc::cmc_mat[imat].constraint_phi*M_PI/180.0);
+			for(unsigned int index=0;index<cmc::atom_list[imat].size();index++){
+				const int atom=cmc::atom_list[imat][index];
+				atoms::x_spin_array[atom]=sx;
+				atoms::y_spin_array[atom]=sy;
+				atoms::z_spin_array[atom]=sz;
+			}
 		}
 	}
 
@@ -259,14 +200,11 @@ void CMCMCinit(){
 		if(sim::constraint_theta_changed) theta_old = cmc::cmc_mat[cmc::active_material].constraint_theta - cmc::cmc_mat[cmc::active_material].constraint_theta_delta;
 		if(sim::constraint_phi_changed) phi_old     = cmc::cmc_mat[cmc::active_material].constraint_phi - cmc::cmc_mat[cmc::active_material].constraint_phi_delta;
 
-		// Rotate all spins in active material from theta_old to theta = 0 (reference direction along x)
-		cmc::rotate_material_spins_around_z_axis(-theta_old, cmc::active_material);
-
-		// Rotate all spins in active material from phi_old to phi_new
-		cmc::rotate_material_spins_around_x_axis(phi_new-phi_old, cmc::active_material);
-
-		// Rotate all spins in active material from theta = 0 to theta = theta_new
-		cmc::rotate_material_spins_around_z_axis(theta_new, cmc::active_material);
+		// Rotate all spins in active material from theta_old to theta = 0 (reference direction along x),
+		// from phi_old to phi_new and from theta = 0 to theta = theta_new in a single pass
+		double rotation_matrix[3][3];
+		cmc::constraint_rotation_matrix(theta_old, phi_new-phi_old, theta_new, rotation_matrix);
+		cmc::rotate_spins(cmc::atom_list[cmc::active_material], rotation_matrix);
 
 		// reset rotation flags
 		sim::constraint_theta_changed = false;
@@ -312,8 +250,8 @@ int cmc_mc_step(){
 	double delta_energy2;
 	double delta_energy21;
 
-	double Eold;
-	double Enew;
+	double components1[4]; // energy change of statistics terms for each spin
+	double components2[4];
 
    std::vector<double> spin1_initial(3);
 	std::vector<double> spin1_final(3);
@@ -375,28 +313,24 @@ int cmc_mc_step(){
          // Make Monte Carlo move
          montecarlo::internal::mc_move(spin1_initial, spin1_final);
 
-			// Calculate current energy
-			Eold = sim::calculate_spin_energy(atom_number1);
+			// Calculate difference in Joules/mu_B
+			delta_energy1 = sim::calculate_spin_energy_difference(atom_number1, &spin1_initial[0], &spin1_final[0], components1)*mp::material[imat1].mu_s_SI*1.07828231e23; //1/9.27400915e-24
 
 			// Copy new spin position
 			atoms::x_spin_array[atom_number1] = spin1_final[0];
 			atoms::y_spin_array[atom_number1] = spin1_final[1];
 			atoms::z_spin_array[atom_number1] = spin1_final[2];
 
-			// Calculate new energy
-			Enew = sim::calculate_spin_energy(atom_number1);
-
-			// Calculate difference in Joules/mu_B
-			delta_energy1 = (Enew-Eold)*mp::material[imat1].mu_s_SI*1.07828231e23; //1/9.27400915e-24
-
 			// Check for lower energy state and accept unconditionally
 			if(delta_energy1<0){
             cmc::mc_success += 1.0;
+            if(internal::record_energy) internal::record_energy_change(atom_number1, &spin1_initial[0], &spin1_final[0], components1);
          }
 			// Otherwise evaluate probability for move
 			else{
 				if(exp(-delta_energy1*rescaled_material_kBTBohr[imat1]) >= mtrandom::grnd()){
                cmc::mc_success += 1.0;
+               if(internal::record_energy) internal::record_energy_change(atom_number1, &spin1_initial[0], &spin1_final[0], components1);
             }
 				// If rejected reset spin coordinates and continue
 				else{
@@ -430,20 +364,14 @@ int cmc_mc_step(){
 		spin1_fin_mvd[1]=cmc::cmc_mat[imat].ppolar_matrix[1][0]*spin1_final[0]+cmc::cmc_mat[imat].ppolar_matrix[1][1]*spin1_final[1]+cmc::cmc_mat[imat].ppolar_matrix[1][2]*spin1_final[2];
 		spin1_fin_mvd[2]=cmc::cmc_mat[imat].ppolar_matrix[2][0]*spin1_final[0]+cmc::cmc_mat[imat].ppolar_matrix[2][1]*spin1_final[1]+cmc::cmc_mat[imat].ppolar_matrix[2][2]*spin1_final[2];
 
-		// Calculate current energy
-		Eold = sim::calculate_spin_energy(atom_number1);
+		// Calculate difference in Joules/mu_B
+		delta_energy1 = sim::calculate_spin_energy_difference(atom_number1, &spin1_initial[0], &spin1_final[0], components1)*mp::material[imat1].mu_s_SI*1.07828231e23; //1/9.27400915e-24
 
 		// Copy new spin position (provisionally accept move)
 		atoms::x_spin_array[atom_number1] = spin1_final[0];
 		atoms::y_spin_array[atom_number1] = spin1_final[1];
 		atoms::z_spin_array[atom_number1] = spin1_final[2];
 
-		// Calculate new energy
-		Enew = sim::calculate_spin_energy(atom_number1);
-
-		// Calculate difference in Joules/mu_B
-		delta_energy1 = (Enew-Eold)*mp::material[imat1].mu_s_SI*1.07828231e23; //1/9.27400915e-24
-
 		// Compute second move
 
 		// Randomly select spin number 2 (i/=j) of same material type
@@ -479,21 +407,14 @@ int cmc_mc_step(){
 			spin2_final[1]=cmc::cmc_mat[imat].ppolar_matrix_tp[1][0]*spin2_fin_mvd[0]+cmc::cmc_mat[imat].ppolar_matrix_tp[1][1]*spin2_fin_mvd[1]+cmc::cmc_mat[imat].ppolar_matrix_tp[1][2]*spin2_fin_mvd[2];
 			spin2_final[2]=cmc::cmc_mat[imat].ppolar_matrix_tp[2][0]*spin2_fin_mvd[0]+cmc::cmc_mat[imat].ppolar_matrix_tp[2][1]*spin2_fin_mvd[1]+cmc::cmc_mat[imat].ppolar_matrix_tp[2][2]*spin2_fin_mvd[2];
 
-			//Calculate Energy Difference 2
-			// Calculate current energy
-			Eold = sim::calculate_spin_energy(atom_number2);
+			// Calculate Energy Difference 2 in Joules/mu_B (with spin 1 already moved)
+			delta_energy2 = sim::calculate_spin_energy_difference(atom_number2, spin2_initial, spin2_final, components2)*mp::material[imat2].mu_s_SI*1.07828231e23; //1/9.27400915e-24
 
          // Copy new spin position (provisionally accept move)
 			atoms::x_spin_array[atom_number2] = spin2_final[0];
 			atoms::y_spin_array[atom_number2] = spin2_final[1];
 			atoms::z_spin_array[atom_number2] = spin2_final[2];
 
-			// Calculate new energy
-			Enew = sim::calculate_spin_energy(atom_number2);
-
-         // Calculate difference in Joules/mu_B
-			delta_energy2 = (Enew-Eold)*mp::material[imat2].mu_s_SI*1.07828231e23; //1/9.27400915e-24
-
 			// Calculate Delta E for both spins
 			delta_energy21 = delta_energy1*rescaled_material_kBTBohr[imat1] +
 			                 delta_energy2*rescaled_material_kBTBohr[imat2];
@@ -519,6 +440,8 @@ int cmc_mc_step(){
 					cmc::cmc_mat[imat].M_other[1] = cmc::cmc_mat[imat].M_other[1] + spin1_final[1] + spin2_final[1] - spin1_initial[1] - spin2_initial[1];
 					cmc::cmc_mat[imat].M_other[2] = cmc::cmc_mat[imat].M_other[2] + spin1_final[2] + spin2_final[2] - spin1_initial[2] - spin2_initial[2];
 					cmc::mc_success += 1.0;
+					if(internal::record_energy) internal::record_pair_energy_change(atom_number1, &spin1_initial[0], &spin1_final[0], components1,
+					                                                                atom_number2, spin2_initial, spin2_final, components2);
 				}
 				//if both p1 and p2 not allowed then
 				else{
@@ -30,11 +30,16 @@ namespace montecarlo{
    namespace cmc{
       bool masked_cmc = false;       // determine if generic masked constraint is required
       bool constrain_by_grain = false; // constrains by grain rather than globally
+      int num_tasks = 1;                // number of independent tasks sharing constraint angle points
+      int task_index = 0;               // index of this task in ensemble
    }
 
    // Monte Carlo update algorithm
    algorithm_t algorithm = adaptive;
 
+   // Update energy statistics from energy change of accepted moves
+   bool incremental_energy = true;
+
    namespace internal{
       //------------------------------------------------------------------------
       // Shared variables inside montecarlo module
@@ -56,6 +61,11 @@ namespace montecarlo{
       std::vector<std::vector<int> > c_octants; //Core atoms of each octant
       std::vector<std::vector<int> > b_octants; //Boundary atoms of each octant
 
+      // Incremental energy variables
+      bool record_energy = false;         // flag to record energy change of accepted moves
+      bool split_exchange_energy = false; // flag to split pair energies between materials
+      std::vector<double> delta_energy;   // energy change of each material since last statistics update [4*material+term]
+
 
    } // end of internal namespace
 
@@ -0,0 +1,200 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) Richard F L Evans 2022. All rights reserved.
+//
+//   Email: richard.evans@york.ac.uk
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <algorithm>
+
+// Vampire headers
+#include "atoms.hpp"
+#include "dipole.hpp"
+#include "exchange.hpp"
+#include "montecarlo.hpp"
+#include "stats.hpp"
+#include "vio.hpp"
+#include "vmpi.hpp"
+
+// montecarlo module headers
+#include "internal.hpp"
+
+namespace montecarlo{
+
+   //---------------------------------------------------------------------------
+   // Function to determine if the energy change of accepted moves can be used
+   // to keep the statistics energies up to date. The bookkeeping assumes that
+   // each spin's energy depends only on its own direction and its exchange
+   // neighbours, so it is disabled for dipole fields (which change on update).
+   // Exchange between atoms of different materials must be split between
+   // materials, which is only done for bilinear exchange.
+   //---------------------------------------------------------------------------
+   void internal::initialize_energy_bookkeeping(){
+
+      internal::record_energy = false;
+      internal::split_exchange_energy = false;
+      internal::delta_energy.assign(4*internal::num_materials, 0.0);
+
+      if(!montecarlo::incremental_energy) return;
+      if(!stats::calculate_system_energy && !stats::calculate_material_energy) return;
+
+      if(dipole::activated){
+         zlog << zTs() << "Incremental Monte Carlo energy statistics disabled since dipole fields are enabled" << std::endl;
+         return;
+      }
+
+      // check for exchange interactions between atoms of different materials
+      int mixed_bonds = 0;
+      for(int atom = 0; atom < atoms::num_atoms; atom++){
+         const int imat = atoms::type_array[atom];
+         for(int nn = atoms::neighbour_list_start_index[atom]; nn <= atoms::neighbour_list_end_index[atom]; ++nn){
+            if(atoms::type_array[atoms::neighbour_list_array[nn]] != imat){
+               mixed_bonds = 1;
+               break;
+            }
+         }
+         if(mixed_bonds) break;
+      }
+      #ifdef MPICF
+         MPI_Allreduce(MPI_IN_PLACE, &mixed_bonds, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+      #endif
+
+      // biquadratic interactions have a separate neighbour list, so require a single material
+      if(exchange::biquadratic && (mixed_bonds || internal::num_materials > 1)){
+         zlog << zTs() << "Incremental Monte Carlo energy statistics disabled since biquadratic exchange is used with several materials" << std::endl;
+         return;
+      }
+
+      internal::split_exchange_energy = (mixed_bonds == 1);
+      internal::record_energy = true;
+
+      zlog << zTs() << "Incremental Monte Carlo energy statistics enabled" << std::endl;
+
+      return;
+
+   }
+
+   //---------------------------------------------------------------------------
+   // Function to add the energy change of an accepted move to the running
+   // energy changes of each material. Energies match the definitions in the
+   // statistics module (energy x moment, pair energies counted once) so that
+   // the change can be added directly to the statistics energies. The spin
+   // arrays must hold the state against which the move was evaluated, apart
+   // from the moved spin itself.
+   //---------------------------------------------------------------------------
+   void internal::record_energy_change(const int atom, const double Sold[3], const double Snew[3], const double components[4]){
+
+      const int imat = atoms::type_array[atom];
+      const double mm = atoms::m_spin_array[atom];
+
+      double* dE = &internal::delta_energy[4*imat];
+
+      // single site energies
+      dE[1] += components[1]*mm;
+      dE[2] += components[2]*mm;
+      dE[3] += 0.5*components[3]*mm;
+
+      // exchange energy of pairs in the same material belongs to that material
+      if(!internal::split_exchange_energy){
+         dE[0] += components[0]*mm;
+         return;
+      }
+
+      // otherwise split each pair energy equally between the materials of the two atoms
+      // (exchange constants are normalised by the moment of atom i, so mm*Jij is symmetric)
+      const double dSx = Snew[0] - Sold[0];
+      const double dSy = Snew[1] - Sold[1];
+      const double dSz = Snew[2] - Sold[2];
+
+      const unsigned int exchange_type = exchange::get_exchange_type();
+
+      for(int nn = atoms::neighbour_list_start_index[atom]; nn <= atoms::neighbour_list_end_index[atom]; ++nn){
+
+         const int natom = atoms::neighbour_list_array[nn];
+         const int iint = atoms::neighbour_interaction_type_array[nn];
+
+         const double Sj[3] = { atoms::x_spin_array[natom], atoms::y_spin_array[natom], atoms::z_spin_array[natom] };
+
+         double pair_energy = 0.0;
+         switch(exchange_type){
+            case exchange::isotropic:
+               pair_energy = -atoms::i_exchange_list[iint].Jij*(dSx*Sj[0] + dSy*Sj[1] + dSz*Sj[2]);
+               break;
+            case exchange::vectorial:
+               pair_energy = -(atoms::v_exchange_list[iint].Jij[0]*dSx*Sj[0] +
+                               atoms::v_exchange_list[iint].Jij[1]*dSy*Sj[1] +
+                               atoms::v_exchange_list[iint].Jij[2]*dSz*Sj[2]);
+               break;
+            case exchange::tensorial:{
+               const double (&J)[3][3] = atoms::t_exchange_list[iint].Jij;
+               pair_energy = -(dSx*(J[0][0]*Sj[0] + J[0][1]*Sj[1] + J[0][2]*Sj[2]) +
+                               dSy*(J[1][0]*Sj[0] + J[1][1]*Sj[1] + J[1][2]*Sj[2]) +
+                               dSz*(J[2][0]*Sj[0] + J[2][1]*Sj[1] + J[2][2]*Sj[2]));
+               break;
+            }
+         }
+
+         dE[0] += 0.5*pair_energy*mm;
+         internal::delta_energy[4*atoms::type_array[natom]] += 0.5*pair_energy*mm;
+
+      }
+
+      return;
+
+   }
+
+   //---------------------------------------------------------------------------
+   // Function to add the energy change of an accepted pair move, where the
+   // energy change of spin 2 was evaluated after spin 1 had been moved. Both
+   // spins must already be in their final state.
+   //---------------------------------------------------------------------------
+   void internal::record_pair_energy_change(const int atom1, const double S1old[3], const double S1new[3], const double components1[4],
+                                            const int atom2, const double S2old[3], const double S2new[3], const double components2[4]){
+
+      // spin 2 moved against the final state of spin 1
+      internal::record_energy_change(atom2, S2old, S2new, components2);
+
+      // spin 1 moved against the initial state of spin 2 (only needed for split pair energies)
+      if(internal::split_exchange_energy){
+         atoms::x_spin_array[atom2] = S2old[0];
+         atoms::y_spin_array[atom2] = S2old[1];
+         atoms::z_spin_array[atom2] = S2old[2];
+      }
+
+      internal::record_energy_change(atom1, S1old, S1new, components1);
+
+      if(internal::split_exchange_energy){
+         atoms::x_spin_array[atom2] = S2new[0];
+         atoms::y_spin_array[atom2] = S2new[1];
+         atoms::z_spin_array[atom2] = S2new[2];
+      }
+
+      return;
+
+   }
+
+   //---------------------------------------------------------------------------
+   // Function to return the energy changes (exchange, anisotropy, applied
+   // field, magnetostatic) of each material accumulated on this processor
+   // since the last call. Returns false if energy changes are not being
+   // recorded.
+   //---------------------------------------------------------------------------
+   bool get_energy_change(std::vector<double>& delta_energy){
+
+      if(!internal::record_energy) return false;
+
+      delta_energy = internal::delta_energy;
+
+      std::fill(internal::delta_energy.begin(), internal::delta_energy.end(), 0.0);
+
+      return true;
+
+   }
+
+} // end of montecarlo namespace
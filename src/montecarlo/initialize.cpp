@@ -44,6 +44,9 @@ namespace montecarlo{
       internal::c_octants.resize(8);
       internal::b_octants.resize(8);
 
+      // Set up recording of energy changes for statistics
+      internal::initialize_energy_bookkeeping();
+
       //------------------------------------------------------------------------
       // Set up masked cmc with grain constraints
       //------------------------------------------------------------------------
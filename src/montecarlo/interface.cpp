@@ -11,6 +11,7 @@
 //
 
 // C++ standard library headers
+#include <cstdlib>
 #include <string>
 
 // Vampire headers
@@ -78,6 +79,52 @@ namespace montecarlo{
          cmc::constrain_by_grain = true;
          return true;
       }
+      //--------------------------------------------------------------------
+      test = "incremental-energy-statistics";
+      if( word == test ){
+         // update energy statistics from energy change of accepted moves
+         test = "";
+         if( value == test ){
+            incremental_energy = true;
+            return true;
+         }
+         test = "true";
+         if( value == test ){
+            incremental_energy = true;
+            return true;
+         }
+         test = "false";
+         if( value == test ){
+            incremental_energy = false;
+            return true;
+         }
+         else{
+            terminaltextcolor(RED);
+            std::cerr << "Error - value for \'montecarlo:" << word << "\' must be one of:" << std::endl;
+            std::cerr << "\t\"true\"" << std::endl;
+            std::cerr << "\t\"false\"" << std::endl;
+            terminaltextcolor(WHITE);
+            err::vexit();
+         }
+      }
+      //--------------------------------------------------------------------
+      test = "cmc-number-of-tasks";
+      if( word == test ){
+         // number of independent tasks sharing constraint angle points
+         int nt = atoi(value.c_str());
+         vin::check_for_valid_int(nt, word, line, prefix, 1, 1000000,"input","1 - 1,000,000");
+         cmc::num_tasks = nt;
+         return true;
+      }
+      //--------------------------------------------------------------------
+      test = "cmc-task";
+      if( word == test ){
+         // index of this task in ensemble of constraint angle points
+         int ti = atoi(value.c_str());
+         vin::check_for_valid_int(ti, word, line, prefix, 0, 999999,"input","0 - 999,999");
+         cmc::task_index = ti;
+         return true;
+      }
 
       //--------------------------------------------------------------------
       // Keyword not found
@@ -61,13 +61,32 @@ namespace montecarlo{
       //MC-MPI variables
       extern std::vector<std::vector<int> > c_octants; //Core atoms of each octant
       extern std::vector<std::vector<int> > b_octants; //Boundary atoms of each octant
+
+      // Incremental energy variables
+      extern bool record_energy;                // flag to record energy change of accepted moves
+      extern bool split_exchange_energy;        // flag to split pair energies between materials
+      extern std::vector<double> delta_energy;  // energy change of each material since last statistics update [4*material+term]
       //-------------------------------------------------------------------------
       // Internal function declarations
       //-------------------------------------------------------------------------
       void mc_move(const std::vector<double>&, std::vector<double>&);
+      void initialize_energy_bookkeeping();
+      void record_energy_change(const int atom, const double Sold[3], const double Snew[3], const double components[4]);
+      void record_pair_energy_change(const int atom1, const double S1old[3], const double S1new[3], const double components1[4],
+                                     const int atom2, const double S2old[3], const double S2new[3], const double components2[4]);
 
    } // end of internal namespace
 
+   namespace cmc{
+
+      //-------------------------------------------------------------------------
+      // Internal cmc function declarations
+      //-------------------------------------------------------------------------
+      void constraint_rotation_matrix(const double theta_old, const double phi_delta, const double theta_new, double rotation_matrix[3][3]);
+      void rotate_spins(const std::vector<int>& list, const double rotation_matrix[3][3]);
+
+   } // end of cmc namespace
+
 } // end of montecarlo namespace
 
 #endif //MONTECARLO_INTERNAL_H_
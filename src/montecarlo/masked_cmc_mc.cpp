@@ -164,7 +164,7 @@ void initialise_masked_cmc_mc(const int num_sets,                       // numbe
 	cmc::mask_polar_rot_matrix(cmc::cmc_mask);
 
 	// create lists of atoms in each constrained set
-	cmc::atom_list.resize(num_sets);
+	cmc::atom_list.assign(num_sets, std::vector<int>(0));
 	// create list of matching materials
 	for( int atom = 0; atom < atoms::num_atoms; atom++){
 		const int mask_id = cmc::mask[atom];
@@ -220,6 +220,9 @@ void cmc_mc_step_mask(){
 	double spin2_init_mvd[3];
 	double spin2_fin_mvd[3];
 
+	double components1[4]; // energy change of statistics terms for each spin
+	double components2[4];
+
 	/*double Mz_old;
 	double Mz_new;
 
@@ -287,26 +290,25 @@ void cmc_mc_step_mask(){
          // Make Monte Carlo move
          montecarlo::internal::mc_move(spin1_initial, spin1_final);
 
-			// Calculate current energy
-			const double Eold = sim::calculate_spin_energy(atom1);
+			// Calculate difference in Joules/mu_B
+			const double delta_energy1 = sim::calculate_spin_energy_difference(atom1, &spin1_initial[0], &spin1_final[0], components1)*mp::material[mat1].mu_s_SI*1.07828231e23; //1/9.27400915e-24
 
 			// Copy new spin position
 			atoms::x_spin_array[atom1] = spin1_final[0];
 			atoms::y_spin_array[atom1] = spin1_final[1];
 			atoms::z_spin_array[atom1] = spin1_final[2];
 
-			// Calculate new energy
-			const double Enew = sim::calculate_spin_energy(atom1);
-
-			// Calculate difference in Joules/mu_B
-			const double delta_energy1 = (Enew-Eold)*mp::material[mat1].mu_s_SI*1.07828231e23; //1/9.27400915e-24
-
 			// Check for lower energy state and accept unconditionally
-			if(delta_energy1 < 0.0) cmc::mc_success += 1.0;
-
+			if(delta_energy1 < 0.0){
+				cmc::mc_success += 1.0;
+				if(internal::record_energy) internal::record_energy_change(atom1, &spin1_initial[0], &spin1_final[0], components1);
+			}
 			// Otherwise evaluate probability for move
 			else{
-				if(exp(-delta_energy1*rescaled_material_kBTBohr[mat1]) >= mtrandom::grnd()) cmc::mc_success += 1.0;
+				if(exp(-delta_energy1*rescaled_material_kBTBohr[mat1]) >= mtrandom::grnd()){
+					cmc::mc_success += 1.0;
+					if(internal::record_energy) internal::record_energy_change(atom1, &spin1_initial[0], &spin1_final[0], components1);
+				}
 				// If rejected reset spin coordinates and continue
 				else{
 					atoms::x_spin_array[atom1] = spin1_initial[0];
@@ -340,20 +342,14 @@ void cmc_mc_step_mask(){
 			spin1_fin_mvd[1]=cmc::cmc_mask[mask1].ppolar_matrix[1][0]*spin1_final[0]+cmc::cmc_mask[mask1].ppolar_matrix[1][1]*spin1_final[1]+cmc::cmc_mask[mask1].ppolar_matrix[1][2]*spin1_final[2];
 			spin1_fin_mvd[2]=cmc::cmc_mask[mask1].ppolar_matrix[2][0]*spin1_final[0]+cmc::cmc_mask[mask1].ppolar_matrix[2][1]*spin1_final[1]+cmc::cmc_mask[mask1].ppolar_matrix[2][2]*spin1_final[2];
 
-			// Calculate current energy
-			const double Eold = sim::calculate_spin_energy(atom1);
+			// Calculate difference in Joules/mu_B
+			const double delta_energy1 = sim::calculate_spin_energy_difference(atom1, &spin1_initial[0], &spin1_final[0], components1)*mp::material[mat1].mu_s_SI*1.07828231e23; //1/9.27400915e-24
 
 			// Copy new spin position (provisionally accept move)
 			atoms::x_spin_array[atom1] = spin1_final[0];
 			atoms::y_spin_array[atom1] = spin1_final[1];
 			atoms::z_spin_array[atom1] = spin1_final[2];
 
-			// Calculate new energy
-			const double Enew = sim::calculate_spin_energy(atom1);
-
-			// Calculate difference in Joules/mu_B
-			const double delta_energy1 = (Enew-Eold)*mp::material[mat1].mu_s_SI*1.07828231e23; //1/9.27400915e-24
-
 			// Compute second move
 
 			// Randomly select spin number 2 (i/=j) of same material type
@@ -383,21 +379,14 @@ void cmc_mc_step_mask(){
 				spin2_final[1]=cmc::cmc_mask[mask1].ppolar_matrix_tp[1][0]*spin2_fin_mvd[0]+cmc::cmc_mask[mask1].ppolar_matrix_tp[1][1]*spin2_fin_mvd[1]+cmc::cmc_mask[mask1].ppolar_matrix_tp[1][2]*spin2_fin_mvd[2];
 				spin2_final[2]=cmc::cmc_mask[mask1].ppolar_matrix_tp[2][0]*spin2_fin_mvd[0]+cmc::cmc_mask[mask1].ppolar_matrix_tp[2][1]*spin2_fin_mvd[1]+cmc::cmc_mask[mask1].ppolar_matrix_tp[2][2]*spin2_fin_mvd[2];
 
-				//Calculate Energy Difference 2
-				// Calculate current energy
-				const double Eold = sim::calculate_spin_energy(atom2);
+				// Calculate Energy Difference 2 in Joules/mu_B (with spin 1 already moved)
+				const double delta_energy2 = sim::calculate_spin_energy_difference(atom2, spin2_initial, spin2_final, components2)*mp::material[mat2].mu_s_SI*1.07828231e23; //1/9.27400915e-24
 
 	         // Copy new spin position (provisionally accept move)
 				atoms::x_spin_array[atom2] = spin2_final[0];
 				atoms::y_spin_array[atom2] = spin2_final[1];
 				atoms::z_spin_array[atom2] = spin2_final[2];
 
-				// Calculate new energy
-				const double Enew = sim::calculate_spin_energy(atom2);
-
-	         // Calculate difference in Joules/mu_B
-				const double delta_energy2 = (Enew-Eold)*mp::material[mat2].mu_s_SI*1.07828231e23; //1/9.27400915e-24
-
 				// Calculate Delta E for both spins
 				const double delta_energy21 = delta_energy1*rescaled_material_kBTBohr[mat1] + delta_energy2*rescaled_material_kBTBohr[mat2];
 
@@ -420,6 +409,8 @@ void cmc_mc_step_mask(){
 					cmc::cmc_mask[mask1].M_other[1] = cmc::cmc_mask[mask1].M_other[1] + spin1_final[1] + spin2_final[1] - spin1_initial[1] - spin2_initial[1];
 					cmc::cmc_mask[mask1].M_other[2] = cmc::cmc_mask[mask1].M_other[2] + spin1_final[2] + spin2_final[2] - spin1_initial[2] - spin2_initial[2];
 					cmc::mc_success += 1.0;
+					if(internal::record_energy) internal::record_pair_energy_change(atom1, &spin1_initial[0], &spin1_final[0], components1,
+					                                                                atom2, spin2_initial, spin2_final, components2);
 				}
 				//if both p1 and p2 not allowed then
 				else{
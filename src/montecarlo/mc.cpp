@@ -38,9 +38,8 @@ void mc_step(std::vector<double> &x_spin_array,
 
       // Temporaries
       int atom=0;
-      double Eold=0.0;
-      double Enew=0.0;
       double DE=0.0;
+      double components[4]; // energy change of statistics terms
 
       // Material dependent temperature rescaling
       std::vector<double> rescaled_material_kBTBohr(internal::num_materials);
@@ -79,37 +78,28 @@ void mc_step(std::vector<double> &x_spin_array,
          // Make Monte Carlo move
          internal::mc_move(internal::Sold, internal::Snew);
 
-         // Calculate current energy
-         Eold = sim::calculate_spin_energy(atom);
+         // Calculate difference in Joules/mu_B
+         DE = sim::calculate_spin_energy_difference(atom, &internal::Sold[0], &internal::Snew[0], components)*internal::mu_s_SI[imaterial]*1.07828231e23; //1/9.27400915e-24
 
          // Copy new spin position
          x_spin_array[atom] = internal::Snew[0];
          y_spin_array[atom] = internal::Snew[1];
          z_spin_array[atom] = internal::Snew[2];
 
-         // Calculate new energy
-         Enew = sim::calculate_spin_energy(atom);
-         //这是计算翻转步骤的核心
-
-         //std::cout << "[MC] atom " << atom << " Eold=" << Eold << " Enew=" << Enew << " DE=" << (Enew-Eold) << std::endl;
-
-         // Calculate difference in Joules/mu_B
-         DE = (Enew-Eold)*internal::mu_s_SI[imaterial]*1.07828231e23; //1/9.27400915e-24
-
-         // Check for lower energy state and accept unconditionally
-         if(DE<0) continue;
-         // Otherwise evaluate probability for move
+         // Check for lower energy state and accept unconditionally, otherwise evaluate probability for move
+         if(DE<0 || exp(-DE*rescaled_material_kBTBohr[imaterial]) >= mtrandom::grnd()){
+            // save energy change for statistics
+            if(internal::record_energy) internal::record_energy_change(atom, &internal::Sold[0], &internal::Snew[0], components);
+            continue;
+         }
+         // If rejected reset spin coordinates and continue
          else{
-            if(exp(-DE*rescaled_material_kBTBohr[imaterial]) >= mtrandom::grnd()) continue;
-            // If rejected reset spin coordinates and continue
-            else{
-               x_spin_array[atom] = internal::Sold[0];
-               y_spin_array[atom] = internal::Sold[1];
-               z_spin_array[atom] = internal::Sold[2];
-               // add one to rejection counter
-               statistics_reject += 1.0;
-               continue;
-            }
+            x_spin_array[atom] = internal::Sold[0];
+            y_spin_array[atom] = internal::Sold[1];
+            z_spin_array[atom] = internal::Sold[2];
+            // add one to rejection counter
+            statistics_reject += 1.0;
+            continue;
          }
       }
 
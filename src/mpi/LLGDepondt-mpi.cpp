@@ -0,0 +1,223 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) Richard F L Evans 2022. All rights reserved.
+//
+//   Email: richard.evans@york.ac.uk
+//
+//------------------------------------------------------------------------------
+//
+#ifdef MPICF
+#include "atoms.hpp"
+#include "material.hpp"
+#include "errors.hpp"
+#include "LLG.hpp"
+#include "sim.hpp"
+#include "vmpi.hpp"
+
+#include <cmath>
+
+namespace sim{
+
+//------------------------------------------------------------------------------
+// Function to calculate predictor rotation for a range of atoms, storing
+// Omega in the euler array and the predicted spin in the storage array
+//------------------------------------------------------------------------------
+void depondt_predictor(const int start, const int end){
+
+	using namespace LLG_arrays;
+
+	double Omega[3];	/// Local rotation vector
+	double S_new[3];	/// New Local Spin Moment
+
+	for(int atom=start;atom<end;atom++){
+
+		const int imaterial=atoms::type_array[atom];
+		const double one_oneplusalpha_sq = material_parameters::material[imaterial].one_oneplusalpha_sq;
+		const double alpha_oneplusalpha_sq = material_parameters::material[imaterial].alpha_oneplusalpha_sq;
+
+		// Store local spin in S and local field in H
+		const double S[3] = {atoms::x_spin_array[atom],atoms::y_spin_array[atom],atoms::z_spin_array[atom]};
+		const double H[3] = {atoms::x_total_spin_field_array[atom]+atoms::x_total_external_field_array[atom],
+									atoms::y_total_spin_field_array[atom]+atoms::y_total_external_field_array[atom],
+									atoms::z_total_spin_field_array[atom]+atoms::z_total_external_field_array[atom]};
+
+		LLG_rotation::rotation_vector(S, H, one_oneplusalpha_sq, alpha_oneplusalpha_sq, Omega);
+
+		// Store Omega in euler array
+		x_euler_array[atom]=Omega[0];
+		y_euler_array[atom]=Omega[1];
+		z_euler_array[atom]=Omega[2];
+
+		LLG_rotation::rotate(S, Omega, material_parameters::dt, S_new);
+
+		//Writing of Spin Values to Storage Array
+		x_spin_storage_array[atom]=S_new[0];
+		y_spin_storage_array[atom]=S_new[1];
+		z_spin_storage_array[atom]=S_new[2];
+	}
+
+	return;
+
+}
+
+//------------------------------------------------------------------------------
+// Function to calculate corrector rotation vector for a range of atoms,
+// storing Omega in the heun array
+//------------------------------------------------------------------------------
+void depondt_corrector(const int start, const int end){
+
+	using namespace LLG_arrays;
+
+	double Omega[3];	/// Local rotation vector
+
+	for(int atom=start;atom<end;atom++){
+
+		const int imaterial=atoms::type_array[atom];
+		const double one_oneplusalpha_sq = material_parameters::material[imaterial].one_oneplusalpha_sq;
+		const double alpha_oneplusalpha_sq = material_parameters::material[imaterial].alpha_oneplusalpha_sq;
+
+		// Store local spin in S and local field in H
+		const double S[3] = {atoms::x_spin_array[atom],atoms::y_spin_array[atom],atoms::z_spin_array[atom]};
+		const double H[3] = {atoms::x_total_spin_field_array[atom]+atoms::x_total_external_field_array[atom],
+									atoms::y_total_spin_field_array[atom]+atoms::y_total_external_field_array[atom],
+									atoms::z_total_spin_field_array[atom]+atoms::z_total_external_field_array[atom]};
+
+		LLG_rotation::rotation_vector(S, H, one_oneplusalpha_sq, alpha_oneplusalpha_sq, Omega);
+
+		// Store Omega in heun array
+		x_heun_array[atom]=Omega[0];
+		y_heun_array[atom]=Omega[1];
+		z_heun_array[atom]=Omega[2];
+	}
+
+	return;
+
+}
+
+int LLG_Depondt_mpi(){
+	//======================================================
+	// Subroutine to perform a single Depondt LLG step
+	//======================================================
+
+	//----------------------------------------------------------
+	// check calling of routine if error checking is activated
+	//----------------------------------------------------------
+	if(err::check==true){std::cout << "LLG_Depondt_mpi has been called" << std::endl;}
+
+	using namespace LLG_arrays;
+
+	// Check for initialisation of LLG integration arrays
+	if(LLG_set==false) sim::LLGinit();
+
+	//----------------------------------------
+	// Local variables for system integration
+	//----------------------------------------
+	const int pre_comm_si = 0;
+	const int pre_comm_ei = vmpi::num_core_atoms;
+	const int post_comm_si = vmpi::num_core_atoms;
+	const int post_comm_ei = vmpi::num_core_atoms+vmpi::num_bdry_atoms;
+
+	double S_new[3];	/// New Local Spin Moment
+
+	//----------------------------------------
+	// Initiate halo swap
+	//----------------------------------------
+	vmpi::mpi_init_halo_swap();
+
+	//----------------------------------------
+	// Store initial spin positions (all)
+	//----------------------------------------
+	for(int atom=pre_comm_si;atom<post_comm_ei;atom++){
+		x_initial_spin_array[atom] = atoms::x_spin_array[atom];
+		y_initial_spin_array[atom] = atoms::y_spin_array[atom];
+		z_initial_spin_array[atom] = atoms::z_spin_array[atom];
+	}
+
+	//----------------------------------------
+	// Calculate fields and predictor (core)
+	//----------------------------------------
+	sim::calculate_spin_fields(pre_comm_si,pre_comm_ei);
+	sim::calculate_external_fields(pre_comm_si,pre_comm_ei);
+	depondt_predictor(pre_comm_si,pre_comm_ei);
+
+	//----------------------------------------
+	// Complete halo swap
+	//----------------------------------------
+	vmpi::mpi_complete_halo_swap();
+
+	//----------------------------------------
+	// Calculate fields and predictor (boundary)
+	//----------------------------------------
+	sim::calculate_spin_fields(post_comm_si,post_comm_ei);
+	sim::calculate_external_fields(post_comm_si,post_comm_ei);
+	depondt_predictor(post_comm_si,post_comm_ei);
+
+	//----------------------------------------
+	// Copy new spins to spin array (all)
+	//----------------------------------------
+	for(int atom=pre_comm_si;atom<post_comm_ei;atom++){
+		atoms::x_spin_array[atom]=x_spin_storage_array[atom];
+		atoms::y_spin_array[atom]=y_spin_storage_array[atom];
+		atoms::z_spin_array[atom]=z_spin_storage_array[atom];
+	}
+
+	//------------------------------------------
+	// Initiate second halo swap
+	//------------------------------------------
+	vmpi::mpi_init_halo_swap();
+
+	//------------------------------------------
+	// Recalculate spin dependent fields and corrector (core)
+	//------------------------------------------
+	sim::calculate_spin_fields(pre_comm_si,pre_comm_ei);
+	depondt_corrector(pre_comm_si,pre_comm_ei);
+
+	//------------------------------------------
+	// Complete second halo swap
+	//------------------------------------------
+	vmpi::mpi_complete_halo_swap();
+
+	//------------------------------------------
+	// Recalculate spin dependent fields and corrector (boundary)
+	//------------------------------------------
+	sim::calculate_spin_fields(post_comm_si,post_comm_ei);
+	depondt_corrector(post_comm_si,post_comm_ei);
+
+	//----------------------------------------
+	// Rotate initial spins by mean rotation vector
+	//----------------------------------------
+	for(int atom=pre_comm_si;atom<post_comm_ei;atom++){
+
+		const double Omega_mean[3] = { 0.5*(x_euler_array[atom] + x_heun_array[atom]),
+		                               0.5*(y_euler_array[atom] + y_heun_array[atom]),
+		                               0.5*(z_euler_array[atom] + z_heun_array[atom]) };
+
+		const double S0[3] = {x_initial_spin_array[atom],y_initial_spin_array[atom],z_initial_spin_array[atom]};
+
+		LLG_rotation::rotate(S0, Omega_mean, material_parameters::dt, S_new);
+
+		//----------------------------------------
+		// Copy new spins to spin array
+		//----------------------------------------
+		atoms::x_spin_array[atom]=S_new[0];
+		atoms::y_spin_array[atom]=S_new[1];
+		atoms::z_spin_array[atom]=S_new[2];
+	}
+
+	// Swap timers compute -> wait
+	vmpi::TotalComputeTime+=vmpi::SwapTimer(vmpi::ComputeTime, vmpi::WaitTime);
+
+	// Wait for other processors
+	vmpi::barrier();
+
+	// Swap timers wait -> compute
+	vmpi::TotalWaitTime+=vmpi::SwapTimer(vmpi::WaitTime, vmpi::ComputeTime);
+
+	return EXIT_SUCCESS;
+}
+
+} // end of namespace sim
+#endif
@@ -38,6 +38,7 @@
 #include "atoms.hpp"
 #include "errors.hpp"
 #include "vmpi.hpp"
+#include "vutil.hpp"
 #include <iostream>
 
 namespace vmpi{
@@ -67,6 +68,9 @@ void mpi_init_halo_swap(){
 		std::cout << vmpi::my_rank << std::endl;
 	}
 
+	// time halo swap
+	vutil::profile::scope_t profile(vutil::profile::halo_swap);
+
 	//----------------------------------------------------------
 	// Pack spins for sending
 	//----------------------------------------------------------
@@ -135,6 +139,9 @@ void mpi_complete_halo_swap(){
 		std::cout << vmpi::my_rank << std::endl;
 	}
 
+	// time halo swap
+	vutil::profile::scope_t profile(vutil::profile::halo_swap);
+
 	// Swap timers compute -> wait
 	vmpi::TotalComputeTime+=vmpi::SwapTimer(vmpi::ComputeTime, vmpi::WaitTime);
 
@@ -25,11 +25,13 @@ void list_t::clear(){
    // force deallocation by making main object data go out of scope
    // Everybody who loves C++ scoping rules say woo!
 
-   // a simple unallocated array of neighbours
-   std::vector< std::vector <neighbours::neighbour_t> > tmp;
+   // simple unallocated arrays of neighbours and indices
+   std::vector<neighbours::neighbour_t> tmp;
+   std::vector<uint64_t> tmp_index;
 
    // swap the pointers
    tmp.swap(list);
+   tmp_index.swap(start_index);
 
    // leaving unloved memory behind
    return;
@@ -11,6 +11,7 @@
 //
 
 // C++ standard library headers
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 
@@ -21,6 +22,7 @@
 #include "vio.hpp"
 #include "vmath.hpp"
 #include "vmpi.hpp"
+#include "vutil.hpp"
 
 //-----------------------------------
 // Fix for horrible windows compiler
@@ -33,10 +35,84 @@
 
 namespace neighbours{
 
+//----------------------------------------------------------------------------------
+// Simple class storing a flat cell-linked list of atoms. Atoms are sorted by
+// supercell and then by unit cell id, so that the atoms in cell c are
+//
+//          atom_index[ cell_offset[c] ] ... atom_index[ cell_offset[c+1] - 1 ]
+//
+// Memory required is one int per atom and one int per cell, compared with
+// na ints per cell and three ints per cell for a 4D supercell array.
+//----------------------------------------------------------------------------------
+class cell_list_t{
+public:
+
+   std::vector<int> cell_offset; // prefix sum of number of atoms in each cell
+   std::vector<int> atom_index;  // list of atom ids sorted by cell and unit cell id
+
+   //-------------------------------------------------------------------------------
+   // Function to find the atom with unit cell id uc in cell (returns -1 if empty)
+   //-------------------------------------------------------------------------------
+   inline int find(const std::vector<cs::catom_t>& atom_array, const uint64_t cell, const uint64_t uc,
+                   const uint64_t num_atoms_in_unit_cell) const {
+
+      const int first = cell_offset[cell];
+      const int last  = cell_offset[cell+1];
+
+      // fast path for fully populated cells (unit cell ids are unique and sorted)
+      if( uint64_t(last - first) == num_atoms_in_unit_cell ) return atom_index[first + uc];
+
+      // otherwise binary search partially filled cell for unit cell id
+      int lo = first;
+      int hi = last;
+      while(lo < hi){
+         const int mid = lo + (hi - lo)/2;
+         if(atom_array[atom_index[mid]].uc_id < uc) lo = mid + 1;
+         else hi = mid;
+      }
+      if(lo < last && atom_array[atom_index[lo]].uc_id == uc) return atom_index[lo];
+
+      return -1;
+
+   }
+
+};
+
+//----------------------------------------------------------------------------------
+// Function to print diagnostic information for atoms outside the supercell range
+//----------------------------------------------------------------------------------
+void supercell_range_error(const std::vector<cs::catom_t>& atom_array, const int atom,
+                           const int64_t* scc, const int64_t* min, const int64_t* max,
+                           const int64_t* d, const int64_t* offset,
+                           const double ucdx, const double ucdy, const double ucdz){
+
+   terminaltextcolor(RED);
+   std::cerr << "Error - atom out of supercell range in neighbourlist calculation!" << std::endl;
+   #ifdef MPICF
+   std::cerr << "\tCPU Rank: " << vmpi::my_rank << std::endl;
+   #endif
+   std::cerr << "\tAtom number:      " << atom << std::endl;
+   std::cerr << "\tAtom coordinates: " << atom_array[atom].x << "\t" << atom_array[atom].y << "\t" << atom_array[atom].z << "\t" << std::endl;
+   std::cerr << "\tmin coordinates:  " << min[0] << "\t" << min[1] << "\t" << min[2] << "\t" << std::endl;
+   std::cerr << "\tmax coordinates:  " << max[0] << "\t" << max[1] << "\t" << max[2] << "\t" << std::endl;
+   std::cerr << "\tCell coordinates: " << scc[0] << "\t" << scc[1] << "\t" << scc[2] << "\t" << std::endl;
+   std::cerr << "\tCell maxima:      " << d[0] << "\t" << d[1] << "\t" << d[2] << std::endl;
+   std::cerr << "\tCell offset:      " << offset[0] << "\t" << offset[1] << "\t" << offset[2] << std::endl;
+   std::cerr << "\tCell offest (dp): " << offset[0]*ucdx << "\t" << offset[1]*ucdy << "\t" << offset[2]*ucdz << std::endl;
+   terminaltextcolor(WHITE);
+   err::vexit();
+
+}
+
 //----------------------------------------------------------------------------------
 // @brief Generate atomic neighbourlist for a generalised exchange template
 //
-// Assigns atoms to unit cells and then calculates all interactions between cells
+// Assigns atoms to a flat cell-linked list and then calculates all interactions
+// for each atom using the part of the exchange template for its unit cell id.
+// Neighbours are written directly into compressed sparse row form in two
+// passes: the first counts the number of neighbours for each atom and the
+// second fills the list. Both passes are independent for each atom and so are
+// threaded over atoms when compiled with OpenMP.
 //
 // Partial cells can exist so ensure enough cells are generated
 //
@@ -54,21 +130,13 @@ void list_t::generate( std::vector<cs::catom_t>& atom_array,    // array of atom
                const double ucdz
              ){
 
+   // start timer for neighbour list generation
+   vutil::vtimer_t timer;
+   timer.start();
+
 	// put number of atoms into temporary variable
 	const int num_atoms = atom_array.size();
 
-	// Reserve space for num_atoms
-	list.reserve(num_atoms);
-
-	// estimate number of interactions per atom
-	const int64_t max_nn = int64_t( 1.1*( double(exchange.interaction.size()) / double(num_atoms_in_unit_cell) ) );
-
-	// Reserve space for each atom in neighbour list according to material type
-	for(int atom=0; atom < num_atoms; atom++){
-		list.push_back(std::vector<neighbour_t>());
-		list[atom].reserve(max_nn);
-	}
-
    // Calculate system dimensions and number of supercells
    const int64_t max_val=1000000000000;
    int64_t min[3] = {max_val,max_val,max_val}; // lowest cell id
@@ -111,69 +179,25 @@ void list_t::generate( std::vector<cs::catom_t>& atom_array,    // array of atom
                           ( max_cell[1] - offset[1] + 1 ),
                           ( max_cell[2] - offset[2] + 1 )};
 
-	// Declare temporary array for 3D supercell array
-	std::vector<std::vector<std::vector<std::vector<int> > > > supercell_array;
+   // total number of cells (allowing for empty atom lists)
+	const uint64_t num_cells = num_atoms > 0 ? uint64_t(d[0])*uint64_t(d[1])*uint64_t(d[2]) : 0;
 
-   // calculate total number of neighbours and inform user of memory needed
-   double num_neighbours = double(d[0]) * double(d[1]) * double(d[2]) * double(num_atoms_in_unit_cell);
-   #ifdef MPICF
-      // calculate total interactions for entire system
-      double total_neighbours = 0.0;
-      MPI_Allreduce(&total_neighbours, &num_neighbours, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-      if(vmpi::master){
-         zlog << zTs() << "Memory required for neighbourlist calculation (each cpu):" <<
-         8.0*total_neighbours/(vmpi::num_processors * 1.0e6) << " MB" << std::endl;
-         zlog << zTs() << "Memory required for neighbourlist calculation (all cpus):" <<
-         8.0*total_neighbours/1.0e6 << " MB" << std::endl;
-      }
-   #else
-      zlog << zTs() << "Memory required for neighbourlist calculation:" <<
-      8.0*num_neighbours/1.0e6 << " MB" << std::endl;
-   #endif
+   // inform user of memory needed for cell list
+   zlog << zTs() << "Memory required for neighbourlist cell list on rank " << vmpi::my_rank << ": " <<
+           double(sizeof(int))*(double(num_cells) + 1.0 + double(num_atoms))/1.0e6 << " MB" << std::endl;
 
-   // Inform user that neighbour list calculation is beginning
-   zlog << zTs() << "Allocating memory for supercell array in neighbourlist calculation" << std::endl;
-
-   // Allocate supercell array to list all atoms
-	supercell_array.resize(d[0]);
-	for(unsigned int i=0; i < d[0] ; i++){
-		supercell_array[i].resize(d[1]);
-		for(unsigned int j=0; j<d[1] ; j++){
-			supercell_array[i][j].resize(d[2]);
-			for(unsigned int k=0; k<d[2] ; k++){
-				supercell_array[i][j][k].resize(num_atoms_in_unit_cell,-1);
-			}
-		}
-	}
-   zlog << zTs() << "\tAllocating memory done"<< std::endl;
-
-	// declare 1D cell array to loop over
-	const uint64_t num_cells = d[0]*d[1]*d[2];
-	std::vector< std::vector <int> > cell_coord_array;
-	cell_coord_array.reserve(num_cells);
-	for(uint64_t i=0; i < num_cells; i++){
-		cell_coord_array.push_back(std::vector<int>());
-		cell_coord_array[i].resize(3);
-	}
+   //-------------------------------------------------------------------------------
+   // Assign atoms to flat cell-linked list using a counting sort by cell
+   //-------------------------------------------------------------------------------
+   zlog << zTs() << "Populating cell list for neighbourlist calculation..."<< std::endl;
 
-	// Initialise cell_array
-	uint64_t cell=0; // cell counter
-	for(unsigned int x=0;x<d[0];x++){
-		for(unsigned int y=0;y<d[1];y++){
-			for(unsigned int z=0;z<d[2];z++){
-				//save cell coordinates
-				cell_coord_array[cell][0]=x;
-				cell_coord_array[cell][1]=y;
-				cell_coord_array[cell][2]=z;
-				cell++;
-			}
-		}
-	}
+   cell_list_t cells;
+   cells.cell_offset.assign(num_cells + 1, 0);
+   cells.atom_index.resize(num_atoms);
 
-   // Inform user of time intensive process
-   zlog << zTs() << "Populating supercell array for neighbourlist calculation..."<< std::endl;
+   // temporary array storing cell id of each atom
+   std::vector<uint64_t> atom_cell(num_atoms);
 
-	// Populate supercell array with atom numbers
 	for(int atom=0; atom < num_atoms; atom++){
 
       // get supercell coordinates
@@ -181,201 +205,223 @@ void list_t::generate( std::vector<cs::catom_t>& atom_array,    // array of atom
                        atom_array[atom].scy - offset[1],
                        atom_array[atom].scz - offset[2] };
 
-      // get atom real position coordinates
-		double c[3]={atom_array[atom].x, atom_array[atom].y, atom_array[atom].z};
-
       // check that atom is within valid range of supercell coordinates
 		for(int i=0;i<3;i++){
-			// Always check cell in range
-         if( scc[i] >= d[i] ){
-            terminaltextcolor(RED);
-				std::cerr << "Error - atom out of supercell range in neighbourlist calculation!" << std::endl;
-            terminaltextcolor(WHITE);
-				#ifdef MPICF
-				terminaltextcolor(RED);
-				std::cerr << "\tCPU Rank: " << vmpi::my_rank << std::endl;
-				terminaltextcolor(WHITE);
-				#endif
-				terminaltextcolor(RED);
-				std::cerr << "\tAtom number:      " << atom << std::endl;
-				std::cerr << "\tAtom coordinates: " << c[0] << "\t" << c[1] << "\t" << c[2] << "\t" << std::endl;
-				std::cerr << "\tmin coordinates:  " << min[0] << "\t" << min[1] << "\t" << min[2] << "\t" << std::endl;
-				std::cerr << "\tmax coordinates:  " << max[0] << "\t" << max[1] << "\t" << max[2] << "\t" << std::endl;
-				std::cerr << "\tCell coordinates: " << scc[0] << "\t" << scc[1] << "\t" << scc[2] << "\t" << std::endl;
-				std::cerr << "\tCell maxima:      " << d[0] << "\t" << d[1] << "\t" << d[2] << std::endl;
-				std::cerr << "\tCell offset:      " << offset[0] << "\t" << offset[1] << "\t" << offset[2] << std::endl;
-				std::cerr << "\tCell offest (dp): " << offset[0]*ucdx << "\t" << offset[1]*ucdy << "\t" << offset[2]*ucdz << std::endl;
-				terminaltextcolor(WHITE);
-				err::vexit();
-			}
+         if( scc[i] >= d[i] ) supercell_range_error(atom_array, atom, scc, min, max, d, offset, ucdx, ucdy, ucdz);
 		}
+
 		// Check for atoms greater than max_atoms_per_supercell
-		if(atom_array[atom].uc_id < num_atoms_in_unit_cell){
-			// Add atom to supercell
-			supercell_array[scc[0]][scc[1]][scc[2]][atom_array[atom].uc_id]=atom;
-		}
-		else{
+		if(atom_array[atom].uc_id >= num_atoms_in_unit_cell){
 			terminaltextcolor(RED);
 			std::cerr << "Error, number of atoms per supercell exceeded" << std::endl;
 			std::cerr << "\tAtom number:      " << atom << std::endl;
-			std::cerr << "\tAtom coordinates: " << c[0] << "\t" << c[1] << "\t" << c[2] << "\t" << std::endl;
+			std::cerr << "\tAtom coordinates: " << atom_array[atom].x << "\t" << atom_array[atom].y << "\t" << atom_array[atom].z << "\t" << std::endl;
+			std::cerr << "\tUnit cell id:     " << atom_array[atom].uc_id << "\t(max " << num_atoms_in_unit_cell << ")" << std::endl;
 			std::cerr << "\tCell coordinates: " << scc[0] << "\t" << scc[1] << "\t" << scc[2] << "\t" << std::endl;
 			std::cerr << "\tCell maxima:      " << d[0] << "\t" << d[1] << "\t" << d[2] << std::endl;
 			std::cerr << "\tCell offset:      " << offset[0] << "\t" << offset[1] << "\t" << offset[2] << std::endl;
-			std::cerr << "\tAtoms in Current Cell:" << std::endl;
-			for(unsigned int ix=0;ix<supercell_array[scc[0]][scc[1]][scc[2]].size();ix++){
-				const int ixatom=supercell_array[scc[0]][scc[1]][scc[2]][ix];
-				std::cerr << "\t\t [id x y z] "<< ix << "\t" << ixatom << "\t" << atom_array[ixatom].x << "\t" << atom_array[ixatom].y << "\t" << atom_array[ixatom].z << std::endl;
-			}
 			terminaltextcolor(WHITE);
 			err::vexit();
 		}
-	}
-
-   // Inform user of progress
-   zlog << zTs() << "\tPopulating supercell array completed"<< std::endl;
 
-   // calculate total number of neighbours and inform user of memory needed
-   num_neighbours = double(num_cells)*double(exchange.interaction.size());
-   #ifdef MPICF
-      // calculate total interactions for entire system
-      total_neighbours = 0.0;
-      MPI_Allreduce(&total_neighbours, &num_neighbours, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-      if(vmpi::master){
-         zlog << zTs() << "Memory required for neighbour list (each cpu):" <<
-         8.0*total_neighbours/(vmpi::num_processors * 1.0e6) << " MB" << std::endl;
-         zlog << zTs() << "Memory required for neighbour list (all cpus):" <<
-         8.0*total_neighbours/1.0e6 << " MB" << std::endl;
-      }
-   #else
-      zlog << zTs() << "Memory required for neighbour list:" <<
-      8.0*num_neighbours/1.0e6 << " MB" << std::endl;
-   #endif
+      // calculate 1D cell id (z fastest)
+      const uint64_t cell = (uint64_t(scc[0])*uint64_t(d[1]) + uint64_t(scc[1]))*uint64_t(d[2]) + uint64_t(scc[2]);
+      atom_cell[atom] = cell;
+      cells.cell_offset[cell+1]++;
 
-	// Generate neighbour list and inform user
-	std::cout <<"Generating neighbour list"<< std::flush;
-   zlog << zTs() << "Generating neighbour list..."<< std::endl;
+	}
 
-   // temporary neighour to simplify memory management
-	neighbour_t tmp_nt;
+   // calculate prefix sum of atoms in each cell
+   for(uint64_t cell = 0; cell < num_cells; cell++) cells.cell_offset[cell+1] += cells.cell_offset[cell];
 
-   // copy number of interactions to temporary constant
-   const unsigned int num_interactions = exchange.interaction.size();
+   // fill cell list (stable, so atoms in each cell are in ascending atom order)
+   {
+      std::vector<int> fill(cells.cell_offset.begin(), cells.cell_offset.end());
+      for(int atom = 0; atom < num_atoms; atom++){
+         cells.atom_index[fill[atom_cell[atom]]++] = atom;
+      }
+   }
 
-	// Loop over all cells
-	for(uint64_t cell = 0; cell < num_cells; cell++){
+   // release temporary cell array
+   std::vector<uint64_t>().swap(atom_cell);
+
+   //-------------------------------------------------------------------------------
+   // Sort atoms in each cell by unit cell id. Where more than one atom has the
+   // same unit cell id in a cell, only the last atom is kept (and the others
+   // have no interactions), consistent with previous versions of the code.
+   //-------------------------------------------------------------------------------
+   int write = 0;
+   for(uint64_t cell = 0; cell < num_cells; cell++){
+
+      const int first = cells.cell_offset[cell];
+      const int last  = cells.cell_offset[cell+1];
+
+      // update start of cell for compacted list
+      cells.cell_offset[cell] = write;
+
+      // sort by unit cell id and then atom number
+      std::sort(cells.atom_index.begin() + first, cells.atom_index.begin() + last,
+         [&atom_array](const int a, const int b){
+            if(atom_array[a].uc_id != atom_array[b].uc_id) return atom_array[a].uc_id < atom_array[b].uc_id;
+            return a < b;
+         });
+
+      // copy unique unit cell ids to compacted list
+      for(int idx = first; idx < last; idx++){
+         const int atom = cells.atom_index[idx];
+         if( idx + 1 < last && atom_array[cells.atom_index[idx+1]].uc_id == atom_array[atom].uc_id ) continue;
+         cells.atom_index[write] = atom;
+         write++;
+      }
 
-      // Print out progress indicator to user
-		if( cell % ( num_cells / 10 + 1 ) == 0 ){
-			std::cout << "." << std::flush;
-		}
+   }
+   if(num_cells > 0) cells.cell_offset[num_cells] = write;
+   cells.atom_index.resize(write);
 
-      // get supercell coordinates of cell
-		int scc[3]={ cell_coord_array[cell][0],
-                   cell_coord_array[cell][1],
-                   cell_coord_array[cell][2]};
+   // Inform user of progress
+   zlog << zTs() << "\tPopulating cell list completed"<< std::endl;
 
-		// Loop over all interactions in exchange template
-		for(unsigned int i = 0; i < num_interactions; i++){
+   //-------------------------------------------------------------------------------
+   // Arrange exchange template by unit cell atom id (preserving interaction order)
+   //-------------------------------------------------------------------------------
+   const unsigned int num_interactions = exchange.interaction.size();
+   std::vector<int> template_start(num_atoms_in_unit_cell + 1, 0);
+   std::vector<int> template_list(num_interactions);
+   for(unsigned int i = 0; i < num_interactions; i++){
+      if(exchange.interaction[i].i < num_atoms_in_unit_cell) template_start[exchange.interaction[i].i+1]++;
+   }
+   for(unsigned int uc = 0; uc < num_atoms_in_unit_cell; uc++) template_start[uc+1] += template_start[uc];
+   {
+      std::vector<int> fill(template_start.begin(), template_start.end());
+      for(unsigned int i = 0; i < num_interactions; i++){
+         const unsigned int uc = exchange.interaction[i].i;
+         if(uc < num_atoms_in_unit_cell) template_list[fill[uc]++] = i;
+      }
+   }
 
-			const int atom=exchange.interaction[i].i;
-			const int natom=exchange.interaction[i].j;
+   //-------------------------------------------------------------------------------
+   // Function to determine neighbour cell and periodic image vector for an
+   // interaction, returning false if the neighbouring cell is out of range
+   //-------------------------------------------------------------------------------
+   const bool pbc[3] = { cs::pbc[0], cs::pbc[1], cs::pbc[2] };
+   const double ucd[3] = { ucdx, ucdy, ucdz };
 
-			int nx = exchange.interaction[i].dx + scc[0];
-			int ny = exchange.interaction[i].dy + scc[1];
-			int nz = exchange.interaction[i].dz + scc[2];
+   auto neighbour_cell = [&](const int64_t* scc, const unitcell::interaction_t& interaction,
+                             uint64_t& ncell, double* v) -> bool {
 
-         // vector from i->j
-         double vx=0.0;
-         double vy=0.0;
-         double vz=0.0;
+      int64_t n[3] = { interaction.dx + scc[0],
+                       interaction.dy + scc[1],
+                       interaction.dz + scc[2] };
 
-         #ifdef MPICF
-           // Parallel periodic boundaries are handled explicitly during the
-           // halo region setup
-         #else
+      for(int i = 0; i < 3; i++){
+         v[i] = 0.0;
+         #ifndef MPICF
          // Wrap around for periodic boundaries
          // Consider virtual atom position for position vector
-         if(cs::pbc[0]==true){
-            if(nx>=int(d[0])){
-               nx=nx-d[0];
-               vx=vx+d[0]*ucdx;
-            }
-            else if(nx<0){
-               nx=nx+d[0];
-               vx=vx-d[0]*ucdx;
-            }
-         }
-         if(cs::pbc[1]==true){
-            if(ny>=int(d[1])){
-               ny=ny-d[1];
-               vy=vy+d[1]*ucdy;
+         // (Parallel periodic boundaries are handled explicitly during the
+         // halo region setup)
+         if(pbc[i]){
+            if(n[i] >= d[i]){
+               n[i] -= d[i];
+               v[i] += d[i]*ucd[i];
             }
-            else if(ny<0){
-               ny=ny+d[1];
-               vy=vy-d[1]*ucdy;
-            }
-         }
-         if(cs::pbc[2]==true){
-            if(nz>=int(d[2])){
-               nz=nz-d[2];
-               vz=vz+d[2]*ucdz;
-            }
-            else if(nz<0){
-               nz=nz+d[2];
-               vz=vz-d[2]*ucdz;
+            else if(n[i] < 0){
+               n[i] += d[i];
+               v[i] -= d[i]*ucd[i];
             }
          }
          #endif
          // check for out-of-bounds access
-         if( (nx >= 0 && static_cast<int64_t>(nx) < d[0] ) &&
-             (ny >= 0 && static_cast<int64_t>(ny) < d[1] ) &&
-             (nz >= 0 && static_cast<int64_t>(nz) < d[2] ) ){
-            // check for missing atoms
-            if((supercell_array[scc[0]][scc[1]][scc[2]][atom]!=-1) && (supercell_array[nx][ny][nz][natom]!=-1)){
-
-               // need actual atom numbers...
-               int atomi = supercell_array[scc[0]][scc[1]][scc[2]][atom];
-               int atomj = supercell_array[nx][ny][nz][natom];
-
-               //std::cout << "int_id: " << i << "\tatom i: " << atomi << "\tatom j: " << atomj << "\tuc_i: " << atom << "\tuc_j: " << natom << std::endl;
-
-               // Load atom positions
-               double ix = atom_array[atomi].x; // Already in A
-               double iy = atom_array[atomi].y;
-               double iz = atom_array[atomi].z;
-               double jx = atom_array[atomj].x;
-               double jy = atom_array[atomj].y;
-               double jz = atom_array[atomj].z;
-
-               //std::cout << "\tpi:    " << ix << "\t" << iy << "\t" << iz << std::endl;
-               //std::cout << "\tpj:    " << jx << "\t" << jy << "\t" << jz << std::endl;
-               //std::cout << "\tv_uc:  " << vx << "\t" << vy << "\t" << vz << std::endl;
-
-               vx += jx-ix;
-               vy += jy-iy;
-               vz += jz-iz;
-
-               //std::cout << "\tv:     " << jx-ix << "\t" << jy-iy << "\t" << jz-iz << std::endl;
-               //std::cout << "\tv_eff: " << vx << "\t" << vy << "\t" << vz << std::endl;
-
-               // get current index
-               // int index = list[supercell_array[scc[0]][scc[1]][scc[2]][atom]].size(); // unused variable
-
-               // set neighbour data
-               tmp_nt.nn = supercell_array[nx][ny][nz][natom]; // atom ID of neighbour
-               tmp_nt.i = i;                                   // interaction type
-               tmp_nt.vx = vx;                                 // position vector i->j
-               tmp_nt.vy = vy;
-               tmp_nt.vz = vz;
-
-               // push back array of class
-               list[supercell_array[scc[0]][scc[1]][scc[2]][atom]].push_back(tmp_nt);
+         if( n[i] < 0 || n[i] >= d[i] ) return false;
+      }
 
-            }
-			}
-		}
-	}
+      ncell = (uint64_t(n[0])*uint64_t(d[1]) + uint64_t(n[1]))*uint64_t(d[2]) + uint64_t(n[2]);
+      return true;
+
+   };
+
+   //-------------------------------------------------------------------------------
+   // Pass 1: count neighbours for each atom
+   //-------------------------------------------------------------------------------
+	std::cout <<"Generating neighbour list"<< std::flush;
+   zlog << zTs() << "Generating neighbour list..."<< std::endl;
+
+   start_index.assign(num_atoms + 1, 0);
+
+   #pragma omp parallel for schedule(static)
+   for(int atom = 0; atom < num_atoms; atom++){
+
+      const uint64_t uc = atom_array[atom].uc_id;
+      const int64_t scc[3] = { atom_array[atom].scx - offset[0],
+                               atom_array[atom].scy - offset[1],
+                               atom_array[atom].scz - offset[2] };
+      const uint64_t cell = (uint64_t(scc[0])*uint64_t(d[1]) + uint64_t(scc[1]))*uint64_t(d[2]) + uint64_t(scc[2]);
+
+      // skip duplicate atoms which are not in the cell list
+      if(cells.find(atom_array, cell, uc, num_atoms_in_unit_cell) != atom) continue;
+
+      uint64_t count = 0;
+      for(int t = template_start[uc]; t < template_start[uc+1]; t++){
+         uint64_t ncell;
+         double v[3];
+         if(!neighbour_cell(scc, exchange.interaction[template_list[t]], ncell, v)) continue;
+         if(cells.find(atom_array, ncell, exchange.interaction[template_list[t]].j, num_atoms_in_unit_cell) != -1) count++;
+      }
+      start_index[atom+1] = count;
+
+   }
+
+   std::cout << "." << std::flush;
+
+   // calculate prefix sum to determine start index of each atom
+   for(int atom = 0; atom < num_atoms; atom++) start_index[atom+1] += start_index[atom];
+
+   // allocate neighbour list with exact size
+   const uint64_t total_num_neighbours = start_index[num_atoms];
+   std::vector<neighbours::neighbour_t>(total_num_neighbours).swap(list);
+
+   zlog << zTs() << "Memory required for neighbour list on rank " << vmpi::my_rank << ": " <<
+           (double(sizeof(neighbours::neighbour_t))*double(total_num_neighbours) + 8.0*double(num_atoms + 1))/1.0e6 << " MB" << std::endl;
+
+   //-------------------------------------------------------------------------------
+   // Pass 2: fill neighbour list
+   //-------------------------------------------------------------------------------
+   #pragma omp parallel for schedule(static)
+   for(int atom = 0; atom < num_atoms; atom++){
+
+      // skip atoms without neighbours
+      if(start_index[atom+1] == start_index[atom]) continue;
+
+      const uint64_t uc = atom_array[atom].uc_id;
+      const int64_t scc[3] = { atom_array[atom].scx - offset[0],
+                               atom_array[atom].scy - offset[1],
+                               atom_array[atom].scz - offset[2] };
+
+      uint64_t index = start_index[atom];
+      for(int t = template_start[uc]; t < template_start[uc+1]; t++){
+
+         const int i = template_list[t];
+
+         uint64_t ncell;
+         double v[3];
+         if(!neighbour_cell(scc, exchange.interaction[i], ncell, v)) continue;
+
+         const int natom = cells.find(atom_array, ncell, exchange.interaction[i].j, num_atoms_in_unit_cell);
+         if(natom == -1) continue;
+
+         // set neighbour data
+         neighbours::neighbour_t& nt = list[index];
+         nt.nn = natom; // atom ID of neighbour
+         nt.i  = i;     // interaction type
+         nt.vx = v[0] + atom_array[natom].x - atom_array[atom].x; // position vector i->j
+         nt.vy = v[1] + atom_array[natom].y - atom_array[atom].y;
+         nt.vz = v[2] + atom_array[natom].z - atom_array[atom].z;
+
+         index++;
+
+      }
+
+   }
 
    // Inform user neighbour list calculation is complete
 	if(vmpi::my_rank == 0){
@@ -383,22 +429,12 @@ void list_t::generate( std::vector<cs::catom_t>& atom_array,    // array of atom
 		std::cout << "done!" << std::endl;
 		terminaltextcolor(WHITE);
 	}
-   zlog << zTs() << "\tNeighbour list calculation complete"<< std::endl;
-
-	// Deallocate supercell array
-   zlog << zTs() << "Deallocating supercell array for neighbour list calculation" << std::endl;
-	for(unsigned int i=0; i<d[0] ; i++){
-		for(unsigned int j=0; j<d[1] ;j++){
-			for(unsigned int k=0; k<d[2] ;k++){
-				supercell_array[i][j][k].resize(0);
-				}
-				supercell_array[i][j].resize(0);
-			}
-			supercell_array[i].resize(0);
-		}
-	supercell_array.resize(0);
 
-   zlog << zTs() << "\tSupercell array deallocated" << std::endl;
+   timer.stop();
+   zlog << zTs() << "\tNeighbour list calculation complete with " << total_num_neighbours << " interactions in "
+                 << timer.elapsed_time() << " s" << std::endl;
+   zlog << zTs() << "\tPeak memory usage after neighbour list calculation on rank " << vmpi::my_rank << ": "
+                 << vutil::peak_memory_usage() << " MB" << std::endl;
 
 	return;
 }
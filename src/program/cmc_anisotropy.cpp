@@ -94,6 +94,17 @@ void cmc_anisotropy(){
 		err::zexit("Program CMC-anisotropy requires Constrained Monte Carlo as the integrator. Check input file.");
 	}
 
+	// Check task index is valid for ensemble of independent angle points
+	if(montecarlo::cmc::task_index >= montecarlo::cmc::num_tasks){
+		err::zexit("Program CMC-anisotropy requires montecarlo:cmc-task to be less than montecarlo:cmc-number-of-tasks. Check input file.");
+	}
+	if(montecarlo::cmc::num_tasks > 1){
+		zlog << zTs() << "Computing constraint angle points " << montecarlo::cmc::task_index << " + n x " << montecarlo::cmc::num_tasks << " as independent task" << std::endl;
+	}
+
+	// number of azimuthal angle points in each sweep, used to index angle points
+	const int num_phi_points = int((sim::constraint_phi_max - sim::constraint_phi_min)/sim::constraint_phi_delta + 1.0e-6) + 1;
+
 	// set minimum rotational angle
    // if checkpoint is loaded, then update minimum values of temperature and constrained angles
 	if(sim::load_checkpoint_flag && sim::load_checkpoint_continue_flag && sim::checkpoint_loaded_flag==true){
@@ -114,6 +125,20 @@ void cmc_anisotropy(){
 		// perform azimuthal angle sweep
 		while(sim::constraint_phi<=sim::constraint_phi_max){
 
+			// Determine if this angle point is computed by another task in the ensemble
+			if(montecarlo::cmc::num_tasks > 1){
+				const int theta_point = int((sim::constraint_theta - sim::constraint_theta_min)/sim::constraint_theta_delta + 0.5);
+				const int phi_point   = int((sim::constraint_phi - sim::constraint_phi_min)/sim::constraint_phi_delta + 0.5);
+				const int angle_point = theta_point*num_phi_points + phi_point;
+				if(angle_point % montecarlo::cmc::num_tasks != montecarlo::cmc::task_index){
+					sim::constraint_phi+=sim::constraint_phi_delta;
+					continue;
+				}
+				// previous point belongs to another task, so initialise spins along constraint rather than rotating
+				sim::constraint_theta_changed=false;
+				sim::constraint_phi_changed=false;
+			}
+
 			// Re-initialise spin moments for CMC
 			montecarlo::CMCinit();
 
@@ -267,8 +267,10 @@ void exchange_stiffness(){
 		// initialise temperature
 		sim::temperature=sim::Tmin;
 
-		// equilibrate ground state structure at zero kelvin
-		for(int ztime = 0; ztime < 500; ztime++) sim::integrate(1);
+		// relax ground state structure at zero kelvin with constrained planes held fixed
+		std::vector<bool> fixed_spins(constraint_mask.size(), false);
+		for(size_t atom = 0; atom < constraint_mask.size(); atom++) fixed_spins[atom] = constraint_mask[atom] != 2;
+		sim::minimise(10000, fixed_spins);
 
 		// reset temperature array
 		temperatures.resize(0);
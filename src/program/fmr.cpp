@@ -36,6 +36,7 @@
 #include "program.hpp"
 #include "random.hpp"
 #include "sim.hpp"
+#include "spectrum.hpp"
 #include "stats.hpp"
 #include "vio.hpp"
 #include "vmath.hpp"
@@ -102,6 +103,9 @@ void fmr(){
 	// enable fmr fields
 	sim::enable_fmr = true;
 
+	// start accumulation of spectra for remaining time steps
+	spectrum::start((sim::equilibration_time+sim::total_time-sim::time)/sim::partial_time, sim::partial_time*mp::dt_SI);
+
 	// Initialize direction along z if not already set
 	if(sim::fmr_field_unit_vector.size() != 3){
 		sim::fmr_field_unit_vector.resize(3,0.0);
@@ -117,11 +121,17 @@ void fmr(){
       // Calculate magnetisation statistics
       stats::update();
 
+      // Add magnetisation to spectra
+      spectrum::update(atoms::x_spin_array, atoms::y_spin_array, atoms::z_spin_array, sim::fmr_field);
+
       // Output data
       vout::data();
 
 	}
 
+	// Output spectra
+	spectrum::output();
+
 }
 
 }//end of namespace program
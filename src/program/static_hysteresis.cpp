@@ -66,6 +66,7 @@ int static_hysteresis(){
 
 	// Initialise sim::integrate only if it not a checkpoint
 	if(sim::load_checkpoint_flag && sim::load_checkpoint_continue_flag){}
+	else if(sim::integrator == sim::minimiser) sim::minimise(sim::equilibration_time);
 	else sim::integrate(sim::equilibration_time);
 
    // Hinc must be positive
@@ -108,8 +109,13 @@ int static_hysteresis(){
 			// Reset mean magnetisation counters
 			stats::reset();
 
-			// Integrate system
-			while(sim::time<sim::loop_time+start_time){
+			// Minimise energy directly to converged torque
+			if(sim::integrator == sim::minimiser){
+				sim::minimise(sim::loop_time);
+				stats::update();
+			}
+			// Otherwise integrate system until torque is small
+			else while(sim::time<sim::loop_time+start_time){
 
 				// Integrate system
 				sim::integrate(sim::partial_time);
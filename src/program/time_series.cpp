@@ -18,6 +18,7 @@
 #include "program.hpp"
 #include "random.hpp"
 #include "sim.hpp"
+#include "spectrum.hpp"
 #include "stats.hpp"
 #include "vio.hpp"
 #include "vmath.hpp"
@@ -69,6 +70,9 @@ void time_series(){
 
    }
 
+	// start accumulation of spectra for remaining time steps
+	spectrum::start((sim::equilibration_time+sim::total_time-sim::time)/sim::partial_time, sim::partial_time*mp::dt_SI);
+
 	// Perform Time Series
 	while(sim::time<sim::equilibration_time+sim::total_time){
 
@@ -78,11 +82,17 @@ void time_series(){
 		// Calculate magnetisation statistics
 		stats::update();
 
+		// Add magnetisation to spectra
+		spectrum::update(atoms::x_spin_array, atoms::y_spin_array, atoms::z_spin_array, 0.0);
+
 		// Output data
 		vout::data();
 
 	}
 
+	// Output spectra
+	spectrum::output();
+
 }
 
 }//end of namespace program
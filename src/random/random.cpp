@@ -271,5 +271,35 @@ double gaussianc(MTRand& grnd){
   return  sign ? x : -x;
 }
 
+/// Overloaded gaussian function taking independent standard generator, for
+/// separate streams of random numbers used by different threads
+double gaussianc(std::mt19937& grnd){
+  unsigned long  U, sign, i, j;
+  double  x, y;
+  const double inv_2_32 = 1.0/4294967296.0;
+
+  while (1) {
+    U = grnd();
+    i = U & 0x0000007F;		/* 7 bit to choose the step */
+    sign = U & 0x00000080;	/* 1 bit for the sign */
+    j = U>>8;			/* 24 bit for the x-value */
+
+    x = j*wtab[i];
+    if (j < ktab[i])  break;
+
+    if (i<127) {
+      double  y0, y1;
+      y0 = ytab[i];
+      y1 = ytab[i+1];
+      y = y1+(y0-y1)*grnd()*inv_2_32;
+    } else {
+      x = PARAM_R - log(1.0-grnd()*inv_2_32)/PARAM_R;
+      y = exp(-PARAM_R*(x-0.5*PARAM_R))*grnd()*inv_2_32;
+    }
+    if (y < exp(-0.5*x*x))  break;
+  }
+  return  sign ? x : -x;
+}
+
 } // end of namespace random
 
@@ -0,0 +1,145 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) Richard F L Evans 2022. All rights reserved.
+//
+//   Email: richard.evans@york.ac.uk
+//
+//------------------------------------------------------------------------------
+//
+
+// Standard Libraries
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+// Vampire Header files
+#include "atoms.hpp"
+#include "errors.hpp"
+#include "LLG.hpp"
+#include "material.hpp"
+#include "sim.hpp"
+
+namespace sim{
+
+/// @brief LLG Depondt Integrator
+///
+/// @details Integrates the system using the rotation based Heun scheme of
+/// Depondt and Mertens, J. Phys.: Condens. Matter 21, 336005 (2009). The
+/// LLG equation is written dS/dt = Omega x S and each spin is rotated about
+/// Omega rather than displaced and renormalised, so that the spin length is
+/// preserved exactly and larger time steps remain stable. The predictor
+/// rotates by Omega(S) and the corrector rotates the initial spin by the
+/// mean of Omega(S) and Omega(S'). Thermal and external fields are computed
+/// once per step as for the Heun integrator.
+///
+/// @return EXIT_SUCCESS
+///
+int LLG_Depondt(){
+
+	// check calling of routine if error checking is activated
+	if(err::check==true){std::cout << "sim::LLG_Depondt has been called" << std::endl;}
+
+	using namespace LLG_arrays;
+
+	// Check for initialisation of LLG integration arrays
+	if(LLG_set==false) sim::LLGinit();
+
+	// Local variables for system integration
+	const int num_atoms=atoms::num_atoms;
+	double Omega[3];	// Local rotation vector
+	double S_new[3];	// New Local Spin Moment
+
+	// Store initial spin positions
+	for(int atom=0;atom<num_atoms;atom++){
+		x_initial_spin_array[atom] = atoms::x_spin_array[atom];
+		y_initial_spin_array[atom] = atoms::y_spin_array[atom];
+		z_initial_spin_array[atom] = atoms::z_spin_array[atom];
+	}
+
+	// Calculate fields
+	calculate_spin_fields(0,num_atoms);
+	calculate_external_fields(0,num_atoms);
+
+	// Calculate predictor rotation
+	for(int atom=0;atom<num_atoms;atom++){
+
+		const int imaterial=atoms::type_array[atom];
+		const double one_oneplusalpha_sq = mp::material[imaterial].one_oneplusalpha_sq; // material specific alpha and gamma
+		const double alpha_oneplusalpha_sq = mp::material[imaterial].alpha_oneplusalpha_sq;
+
+		// Store local spin in S and local field in H
+		const double S[3] = {atoms::x_spin_array[atom],atoms::y_spin_array[atom],atoms::z_spin_array[atom]};
+		const double H[3] = {atoms::x_total_spin_field_array[atom]+atoms::x_total_external_field_array[atom],
+									atoms::y_total_spin_field_array[atom]+atoms::y_total_external_field_array[atom],
+									atoms::z_total_spin_field_array[atom]+atoms::z_total_external_field_array[atom]};
+
+		LLG_rotation::rotation_vector(S, H, one_oneplusalpha_sq, alpha_oneplusalpha_sq, Omega);
+
+		// Store Omega in euler array
+		x_euler_array[atom]=Omega[0];
+		y_euler_array[atom]=Omega[1];
+		z_euler_array[atom]=Omega[2];
+
+		// Rotate spin
+		LLG_rotation::rotate(S, Omega, mp::dt, S_new);
+
+		//Writing of Spin Values to Storage Array
+		x_spin_storage_array[atom]=S_new[0];
+		y_spin_storage_array[atom]=S_new[1];
+		z_spin_storage_array[atom]=S_new[2];
+	}
+
+	// Copy new spins to spin array
+	for(int atom=0;atom<num_atoms;atom++){
+		atoms::x_spin_array[atom]=x_spin_storage_array[atom];
+		atoms::y_spin_array[atom]=y_spin_storage_array[atom];
+		atoms::z_spin_array[atom]=z_spin_storage_array[atom];
+	}
+
+	// Recalculate spin dependent fields
+	calculate_spin_fields(0,num_atoms);
+
+	// Calculate corrector rotation from initial spin
+	for(int atom=0;atom<num_atoms;atom++){
+
+		const int imaterial=atoms::type_array[atom];
+		const double one_oneplusalpha_sq = mp::material[imaterial].one_oneplusalpha_sq;
+		const double alpha_oneplusalpha_sq = mp::material[imaterial].alpha_oneplusalpha_sq;
+
+		// Store local spin in S and local field in H
+		const double S[3] = {atoms::x_spin_array[atom],atoms::y_spin_array[atom],atoms::z_spin_array[atom]};
+		const double H[3] = {atoms::x_total_spin_field_array[atom]+atoms::x_total_external_field_array[atom],
+									atoms::y_total_spin_field_array[atom]+atoms::y_total_external_field_array[atom],
+									atoms::z_total_spin_field_array[atom]+atoms::z_total_external_field_array[atom]};
+
+		LLG_rotation::rotation_vector(S, H, one_oneplusalpha_sq, alpha_oneplusalpha_sq, Omega);
+
+		// average rotation vector over predictor and corrector
+		const double Omega_mean[3] = { 0.5*(x_euler_array[atom] + Omega[0]),
+		                               0.5*(y_euler_array[atom] + Omega[1]),
+		                               0.5*(z_euler_array[atom] + Omega[2]) };
+
+		const double S0[3] = {x_initial_spin_array[atom],y_initial_spin_array[atom],z_initial_spin_array[atom]};
+
+		LLG_rotation::rotate(S0, Omega_mean, mp::dt, S_new);
+
+		x_spin_storage_array[atom]=S_new[0];
+		y_spin_storage_array[atom]=S_new[1];
+		z_spin_storage_array[atom]=S_new[2];
+	}
+
+	// Copy new spins to spin array
+	for(int atom=0;atom<num_atoms;atom++){
+		atoms::x_spin_array[atom]=x_spin_storage_array[atom];
+		atoms::y_spin_array[atom]=y_spin_storage_array[atom];
+		atoms::z_spin_array[atom]=z_spin_storage_array[atom];
+	}
+
+	return EXIT_SUCCESS;
+
+}
+
+} // end of namespace sim
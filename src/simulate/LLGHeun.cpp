@@ -58,6 +58,9 @@
 #include "material.hpp"
 #include "sim.hpp"
 
+// sim module headers
+#include "internal.hpp"
+
 namespace LLG_arrays{
 
 	// Local arrays for LLG integration
@@ -166,23 +169,46 @@ int LLG_Heun(){
 
 	// Local variables for system integration
 	const int num_atoms=atoms::num_atoms;
-	double xyz[3];		// Local Delta Spin Components
-	double S_new[3];	// New Local Spin Moment
-	double mod_S;		// magnitude of spin moment
 
-	// Store initial spin positions
-	for(int atom=0;atom<num_atoms;atom++){
-		x_initial_spin_array[atom] = atoms::x_spin_array[atom];
-		y_initial_spin_array[atom] = atoms::y_spin_array[atom];
-		z_initial_spin_array[atom] = atoms::z_spin_array[atom];
-	}
+	// Determine ranges of atoms to be integrated, all atoms unless restricted to an active region
+	const int all_atoms[2] = {0, num_atoms};
+	const bool restricted = sim::active_atom_ranges.size() > 0;
+	const int* ranges = restricted ? &sim::active_atom_ranges[0] : all_atoms;
+	const int num_ranges = restricted ? sim::active_atom_ranges.size()/2 : 1;
 
 	// Calculate fields
-	calculate_spin_fields(0,num_atoms);
-	calculate_external_fields(0,num_atoms);
+	for(int r=0;r<num_ranges;r++){
+		calculate_spin_fields(ranges[2*r],ranges[2*r+1]);
+		calculate_external_fields(ranges[2*r],ranges[2*r+1]);
+	}
 
 	// Calculate Euler Step
-	for(int atom=0;atom<num_atoms;atom++){
+	for(int r=0;r<num_ranges;r++) sim::internal::llg_heun_predictor_step(ranges[2*r],ranges[2*r+1]);
+
+	// Recalculate spin dependent fields
+	for(int r=0;r<num_ranges;r++) calculate_spin_fields(ranges[2*r],ranges[2*r+1]);
+
+	// Calculate Heun Step
+	for(int r=0;r<num_ranges;r++) sim::internal::llg_heun_corrector_step(ranges[2*r],ranges[2*r+1]);
+
+	return EXIT_SUCCESS;
+}
+
+namespace internal{
+
+//-----------------------------------------------------------------------------
+// Function to calculate the Euler (predictor) step of the Heun scheme for a
+// range of atoms, using spin and external fields already calculated
+//-----------------------------------------------------------------------------
+void llg_heun_predictor_step(const int start_index, const int end_index){
+
+	using namespace LLG_arrays;
+
+	double xyz[3];		// Local Delta Spin Components
+	double S_new[3];	// New Local Spin Moment
+	double mod_S;		// magnitude of spin moment
+
+	for(int atom=start_index;atom<end_index;atom++){
 
 		const int imaterial=atoms::type_array[atom];
 		const double one_oneplusalpha_sq = mp::material[imaterial].one_oneplusalpha_sq; // material specific alpha and gamma
@@ -194,6 +220,11 @@ int LLG_Heun(){
 									atoms::y_total_spin_field_array[atom]+atoms::y_total_external_field_array[atom],
 									atoms::z_total_spin_field_array[atom]+atoms::z_total_external_field_array[atom]};
 
+		// Store initial spin positions
+		x_initial_spin_array[atom] = S[0];
+		y_initial_spin_array[atom] = S[1];
+		z_initial_spin_array[atom] = S[2];
+
 		// Calculate Delta S
 		xyz[0]=(one_oneplusalpha_sq)*(S[1]*H[2]-S[2]*H[1]) + (alpha_oneplusalpha_sq)*(S[1]*(S[0]*H[1]-S[1]*H[0])-S[2]*(S[2]*H[0]-S[0]*H[2]));
 		xyz[1]=(one_oneplusalpha_sq)*(S[2]*H[0]-S[0]*H[2]) + (alpha_oneplusalpha_sq)*(S[2]*(S[1]*H[2]-S[2]*H[1])-S[0]*(S[0]*H[1]-S[1]*H[0]));
@@ -212,28 +243,29 @@ int LLG_Heun(){
 		// Normalise Spin Length
 		mod_S = 1.0/sqrt(S_new[0]*S_new[0] + S_new[1]*S_new[1] + S_new[2]*S_new[2]);
 
-		S_new[0]=S_new[0]*mod_S;
-		S_new[1]=S_new[1]*mod_S;
-		S_new[2]=S_new[2]*mod_S;
-
-		//Writing of Spin Values to Storage Array
-		x_spin_storage_array[atom]=S_new[0];
-		y_spin_storage_array[atom]=S_new[1];
-		z_spin_storage_array[atom]=S_new[2];
- 	}
-
-	// Copy new spins to spin array
-	for(int atom=0;atom<num_atoms;atom++){
-		atoms::x_spin_array[atom]=x_spin_storage_array[atom];
-		atoms::y_spin_array[atom]=y_spin_storage_array[atom];
-		atoms::z_spin_array[atom]=z_spin_storage_array[atom];
+		// Copy new spins to spin array (fields of all atoms were calculated before the step)
+		atoms::x_spin_array[atom]=S_new[0]*mod_S;
+		atoms::y_spin_array[atom]=S_new[1]*mod_S;
+		atoms::z_spin_array[atom]=S_new[2]*mod_S;
 	}
 
-	// Recalculate spin dependent fields
-	calculate_spin_fields(0,num_atoms);
+	return;
+
+}
+
+//-----------------------------------------------------------------------------
+// Function to calculate the Heun (corrector) step for a range of atoms from
+// the recalculated spin fields
+//-----------------------------------------------------------------------------
+void llg_heun_corrector_step(const int start_index, const int end_index){
+
+	using namespace LLG_arrays;
 
-	// Calculate Heun Gradients
-	for(int atom=0;atom<num_atoms;atom++){
+	double xyz[3];		// Local Delta Spin Components
+	double S_new[3];	// New Local Spin Moment
+	double mod_S;		// magnitude of spin moment
+
+	for(int atom=start_index;atom<end_index;atom++){
 
 		const int imaterial=atoms::type_array[atom];;
 		const double one_oneplusalpha_sq = mp::material[imaterial].one_oneplusalpha_sq;
@@ -250,34 +282,26 @@ int LLG_Heun(){
 		xyz[1]=(one_oneplusalpha_sq)*(S[2]*H[0]-S[0]*H[2]) + (alpha_oneplusalpha_sq)*(S[2]*(S[1]*H[2]-S[2]*H[1])-S[0]*(S[0]*H[1]-S[1]*H[0]));
 		xyz[2]=(one_oneplusalpha_sq)*(S[0]*H[1]-S[1]*H[0]) + (alpha_oneplusalpha_sq)*(S[0]*(S[2]*H[0]-S[0]*H[2])-S[1]*(S[1]*H[2]-S[2]*H[1]));
 
-		// Store dS in heun array
-		x_heun_array[atom]=xyz[0];
-		y_heun_array[atom]=xyz[1];
-		z_heun_array[atom]=xyz[2];
-	}
-
-	// Calculate Heun Step
-	for(int atom=0;atom<num_atoms;atom++){
-		S_new[0]=x_initial_spin_array[atom]+mp::half_dt*(x_euler_array[atom]+x_heun_array[atom]);
-		S_new[1]=y_initial_spin_array[atom]+mp::half_dt*(y_euler_array[atom]+y_heun_array[atom]);
-		S_new[2]=z_initial_spin_array[atom]+mp::half_dt*(z_euler_array[atom]+z_heun_array[atom]);
+		// Calculate Heun Step
+		S_new[0]=x_initial_spin_array[atom]+mp::half_dt*(x_euler_array[atom]+xyz[0]);
+		S_new[1]=y_initial_spin_array[atom]+mp::half_dt*(y_euler_array[atom]+xyz[1]);
+		S_new[2]=z_initial_spin_array[atom]+mp::half_dt*(z_euler_array[atom]+xyz[2]);
 
 		// Normalise Spin Length
 		mod_S = 1.0/sqrt(S_new[0]*S_new[0] + S_new[1]*S_new[1] + S_new[2]*S_new[2]);
 
-		S_new[0]=S_new[0]*mod_S;
-		S_new[1]=S_new[1]*mod_S;
-		S_new[2]=S_new[2]*mod_S;
-
-		// Copy new spins to spin array
-		atoms::x_spin_array[atom]=S_new[0];
-		atoms::y_spin_array[atom]=S_new[1];
-		atoms::z_spin_array[atom]=S_new[2];
+		// Copy new spins to spin array (spin fields of all atoms were recalculated before the step)
+		atoms::x_spin_array[atom]=S_new[0]*mod_S;
+		atoms::y_spin_array[atom]=S_new[1]*mod_S;
+		atoms::z_spin_array[atom]=S_new[2]*mod_S;
 	}
 
-	return EXIT_SUCCESS;
+	return;
+
 }
 
+} // end of internal namespace
+
 /// @brief LLG Heun Integrator (CUDA)
 ///
 /// @callgraph
@@ -20,6 +20,12 @@ namespace sim{
    // Shared variables used with main vampire code
    //---------------------------------------------------------------------------
    integrator_t integrator = llg_heun; // variable to specify integrator
+   minimiser_t minimiser_algorithm = fire; // algorithm used for zero temperature energy minimisation
+   double minimiser_torque_tolerance = 1.0e-6; // maximum torque on any spin for minimisation to be converged (T)
+   double adaptive_tolerance = 1.0e-5; // maximum local error in spin direction per adaptive time step
+   double adaptive_min_dt_SI = 1.0e-19; // minimum adaptive time step (s)
+   double adaptive_max_dt_SI = 1.0e-12; // maximum adaptive time step (s)
+   std::vector<int> active_atom_ranges; // list of (start,end) ranges of atoms integrated with llg-heun (all atoms if empty)
 
 
    std::vector < double > track_field_x;
@@ -79,6 +85,7 @@ namespace sim{
       //----------------------------------------------------------------------------
       bool enable_spin_torque_fields = false; // flag to enable spin torque fields
       bool enable_vcma_fields        = false; // flag to enable voltage-controlled anisotropy fields
+      bool grain_tasks               = false; // flag to integrate exchange-decoupled grains as independent tasks
 
       std::vector<sim::internal::mp_t> mp; // array of material properties
 
@@ -245,4 +245,73 @@ namespace sim
         return energy; // Tesla
     }
 
+
+    /// @brief Calculates the energy change of a single spin moved from Sold to Snew.
+    ///
+    /// @details Exchange, applied, local and magnetostatic energies are linear in
+    /// the local spin, so their change is evaluated once from the local fields
+    /// acting on the spin displacement Snew-Sold. Only the non-linear terms
+    /// (biquadratic, four spin, anisotropy and vcma) are evaluated for both spin
+    /// directions. The spin arrays are not read for the local atom, so the
+    /// result is independent of whether the move has been provisionally applied.
+    ///
+    /// @param[in] atom atom number
+    /// @param[in] Sold initial spin direction
+    /// @param[in] Snew trial spin direction
+    /// @param[out] components energy changes in the statistics energy terms
+    ///             (exchange, anisotropy, applied field, magnetostatic)
+    /// @return energy difference Enew-Eold (Tesla)
+    ///
+    double calculate_spin_energy_difference(const int atom, const double Sold[3], const double Snew[3], double components[4])
+    {
+
+        // Spin displacement for linear terms
+        const double dSx = Snew[0] - Sold[0];
+        const double dSy = Snew[1] - Sold[1];
+        const double dSz = Snew[2] - Sold[2];
+
+        // Determine local material
+        const int imaterial = atoms::type_array[atom];
+
+        // terms included in energy statistics
+        components[0] = exchange::single_spin_energy(atom, dSx, dSy, dSz) +
+                        exchange::single_spin_biquadratic_energy(atom, Snew[0], Snew[1], Snew[2]) -
+                        exchange::single_spin_biquadratic_energy(atom, Sold[0], Sold[1], Sold[2]);
+        components[1] = anisotropy::single_spin_energy(atom, imaterial, Snew[0], Snew[1], Snew[2], sim::temperature) -
+                        anisotropy::single_spin_energy(atom, imaterial, Sold[0], Sold[1], Sold[2], sim::temperature);
+        components[2] = spin_applied_field_energy(dSx, dSy, dSz);
+        components[3] = spin_magnetostatic_energy(atom, dSx, dSy, dSz);
+
+        double delta_energy = components[0] + components[1] + components[2] + components[3];
+
+        // four spin exchange
+        delta_energy += exchange::single_spin_four_spin_energy(atom, Snew[0], Snew[1], Snew[2]) - exchange::single_spin_four_spin_energy(atom, Sold[0], Sold[1], Sold[2]);
+
+        // local applied fields
+        if (sim::local_applied_field)
+        {
+            delta_energy += spin_cell_local_field_energy(atom, dSx, dSy, dSz);
+            delta_energy += spin_local_applied_field_energy(imaterial, dSx, dSy, dSz);
+        }
+
+        // vcma energy
+        const double vcma = program::fractional_electric_field_strength * spin_transport::get_voltage() * sim::internal::vcmak[imaterial];
+        delta_energy -= vcma * (Snew[2] * Snew[2] - Sold[2] * Sold[2]);
+
+        return delta_energy; // Tesla
+    }
+
+    /// @brief Calculates the energy change of a single spin moved from Sold to Snew.
+    ///
+    /// @param[in] atom atom number
+    /// @param[in] Sold initial spin direction
+    /// @param[in] Snew trial spin direction
+    /// @return energy difference Enew-Eold (Tesla)
+    ///
+    double calculate_spin_energy_difference(const int atom, const double Sold[3], const double Snew[3])
+    {
+        double components[4];
+        return calculate_spin_energy_difference(atom, Sold, Snew, components);
+    }
+
 } // end of namespace sim
@@ -47,6 +47,7 @@
 #include "spintransport.hpp"
 #include "stats.hpp"
 #include "vmpi.hpp"
+#include "vutil.hpp"
 #include "../micromagnetic/internal.hpp"
 
 #include "cells.hpp" // 唐愈涵加的，目的是在进行磁滞回线模拟的时候使用局部场
@@ -218,6 +219,9 @@ int calculate_applied_fields(const int start_index,const int end_index){
 	// check calling of routine if error checking is activated
 	if(err::check==true){std::cout << "calculate_applied_fields has been called" << std::endl;}
 
+	// time applied field calculation
+	vutil::profile::scope_t profile(vutil::profile::applied_field);
+
 	// Declare constant temporaries for global field
 	const double Hx=sim::H_vec[0]*sim::H_applied;
 	const double Hy=sim::H_vec[1]*sim::H_applied;
@@ -308,6 +312,9 @@ int calculate_thermal_fields(const int start_index,const int end_index){
    // check calling of routine if error checking is activated
    if(err::check==true){std::cout << "calculate_thermal_fields has been called" << std::endl;}
 
+   // time thermal field calculation
+   vutil::profile::scope_t profile(vutil::profile::thermal);
+
    // unroll sigma for speed
    std::vector<double> sigma_prefactor(0);
    sigma_prefactor.reserve(mp::material.size());
@@ -17,9 +17,11 @@
 #include "cells.hpp"
 #include "create.hpp"
 #include "dipole.hpp"
+#include "grains.hpp"
 #include "hamr.hpp"
 #include "ltmp.hpp"
 #include "sim.hpp"
+#include "spectrum.hpp"
 #include "spintorque.hpp"
 #include "spintransport.hpp"
 #include "unitcell.hpp"
@@ -138,6 +140,24 @@ void initialize_modules(){
                               is_magnetic_material,
                               cs::non_magnetic_atoms_array);
 
+   //---------------------------------------------------------------------------
+   // Spectrum module
+   //---------------------------------------------------------------------------
+   spectrum::initialize(mp::num_materials,
+                        cells::num_cells,
+                        num_local_atoms,
+                        atoms::type_array,
+                        atoms::cell_array,
+                        atoms::m_spin_array,
+                        is_magnetic_material,
+                        cells::pos_and_mom_array,
+                        atoms::x_coord_array,
+                        atoms::y_coord_array,
+                        atoms::z_coord_array,
+                        cs::unit_cell.dimensions[0],
+                        cs::unit_cell.dimensions[1],
+                        cs::unit_cell.dimensions[2]);
+
    //----------------------------------------
    // Initialise hamr module 
    //----------------------------------------
@@ -152,6 +172,8 @@ void initialize_modules(){
 				      atoms::y_coord_array,
 				      atoms::z_coord_array,
 				      atoms::type_array,
+				      atoms::grain_array,
+				      grains::num_grains,
 				      atoms::num_atoms
 					   );
 
@@ -14,6 +14,7 @@
 #include "errors.hpp"
 #include "sim.hpp"
 #include "vio.hpp"
+#include "vutil.hpp"
 
 // Internal sim header
 #include "internal.hpp"
@@ -115,6 +116,12 @@ namespace sim{
             return true;
          }
          //--------------------------------------------------------------------
+         test="llg-depondt";
+         if( value == test ){
+            sim::integrator = sim::llg_depondt;
+            return true;
+         }
+         //--------------------------------------------------------------------
          test="monte-carlo";
          if( value == test ){
             sim::integrator = sim::monte_carlo;
@@ -145,19 +152,83 @@ namespace sim{
             return true;
          }
          //--------------------------------------------------------------------
+         test="llg-adaptive";
+         if( value == test ){
+            sim::integrator = sim::llg_adaptive;
+            return true;
+         }
+         //--------------------------------------------------------------------
+         test="fire";
+         if( value == test ){
+            sim::integrator = sim::minimiser;
+            sim::minimiser_algorithm = sim::fire;
+            return true;
+         }
+         //--------------------------------------------------------------------
+         test="conjugate-gradient";
+         if( value == test ){
+            sim::integrator = sim::minimiser;
+            sim::minimiser_algorithm = sim::conjugate_gradient;
+            return true;
+         }
+         //--------------------------------------------------------------------
          else{
             terminaltextcolor(RED);
                std::cerr << "Error - value for \'sim:" << word << "\' must be one of:" << std::endl;
                std::cerr << "\t\"llg-heun\"" << std::endl;
                std::cerr << "\t\"llg-midpoint\"" << std::endl;
+               std::cerr << "\t\"llg-depondt\"" << std::endl;
                std::cerr << "\t\"llg-quantum\"" << std::endl;
+               std::cerr << "\t\"llg-adaptive\"" << std::endl;
                std::cerr << "\t\"monte-carlo\"" << std::endl;
                std::cerr << "\t\"constrained-monte-carlo\"" << std::endl;
+               std::cerr << "\t\"hybrid-constrained-monte-carlo\"" << std::endl;
+               std::cerr << "\t\"fire\"" << std::endl;
+               std::cerr << "\t\"conjugate-gradient\"" << std::endl;
             terminaltextcolor(WHITE);
             err::vexit();
           }
       }
       //--------------------------------------------------------------------
+      test="minimiser-torque-tolerance";
+      if(word==test){
+         double tt = atof(value.c_str());
+         vin::check_for_valid_value(tt, word, line, prefix, unit, "field", 1.0e-12, 1.0,"input","1.0e-12 - 1 T");
+         sim::minimiser_torque_tolerance = tt;
+         return true;
+      }
+      //--------------------------------------------------------------------
+      test="adaptive-tolerance";
+      if(word==test){
+         double tt = atof(value.c_str());
+         vin::check_for_valid_value(tt, word, line, prefix, unit, "none", 1.0e-12, 1.0e-1,"input","1.0e-12 - 0.1");
+         sim::adaptive_tolerance = tt;
+         return true;
+      }
+      //--------------------------------------------------------------------
+      test="minimum-adaptive-time-step";
+      if(word==test){
+         double dt = atof(value.c_str());
+         vin::check_for_valid_value(dt, word, line, prefix, unit, "time", 1.0e-22, 1.0e-9,"input","0.0001 attosecond - 1 nanosecond");
+         sim::adaptive_min_dt_SI = dt;
+         return true;
+      }
+      //--------------------------------------------------------------------
+      test="maximum-adaptive-time-step";
+      if(word==test){
+         double dt = atof(value.c_str());
+         vin::check_for_valid_value(dt, word, line, prefix, unit, "time", 1.0e-22, 1.0e-9,"input","0.0001 attosecond - 1 nanosecond");
+         sim::adaptive_max_dt_SI = dt;
+         return true;
+      }
+      //--------------------------------------------------------------------
+      test="grain-tasks";
+      if(word==test){
+         bool tf = vin::check_for_valid_bool(value, word, line, prefix, "input");
+         sim::internal::grain_tasks = tf;
+         return true;
+      }
+      //--------------------------------------------------------------------
       test="domain-wall-axis";
       if(word==test){
          //vin::check_for_valid_int(tt, word, line, prefix, 0, max_time,"input","0 - "+max_time_str);
@@ -222,6 +293,34 @@ namespace sim{
          return true;
       }
       //--------------------------------------------------------------------
+      test="profile";
+      if(word==test){
+         test="";
+         if(value==test){
+            vutil::profile::enabled = true;
+            return true;
+         }
+         test="true";
+         if(value==test){
+            vutil::profile::enabled = true;
+            return true;
+         }
+         // default
+         test="false";
+         if(value==test){
+            vutil::profile::enabled = false;
+            return true;
+         }
+         else{
+            terminaltextcolor(RED);
+            std::cerr << "Error: Value for \'" << prefix << ":" << word << "\' must be one of:" << std::endl;
+            std::cerr << "\t\"true\"" << std::endl;
+            std::cerr << "\t\"false\"" << std::endl;
+            terminaltextcolor(WHITE);
+            err::vexit();
+         }
+      }
+      //--------------------------------------------------------------------
       // input parameter not found here
       return false;
    }
@@ -1,7 +1,8 @@
 #ifndef SIM_INTERNAL_H_
 #define SIM_INTERNAL_H_
 
-#include <vector> 
+#include <stdint.h>
+#include <vector>
 //-----------------------------------------------------------------------------
 //
 // This header file is part of the VAMPIRE open source package under the
@@ -64,6 +65,7 @@ namespace sim{
       //-----------------------------------------------------------------------------
       extern bool enable_spin_torque_fields; // flag to enable spin torque fields
       extern bool enable_vcma_fields;        // flag to enable voltage-controlled anisotropy fields
+      extern bool grain_tasks;               // flag to integrate exchange-decoupled grains as independent tasks
 
       extern std::vector<sim::internal::mp_t> mp; // array of material properties
 
@@ -81,6 +83,12 @@ namespace sim{
 
       // shared Functions
       void llg_quantum_step();
+      void minimiser_step();
+      void llg_adaptive_steps(const uint64_t n_steps);
+      void llg_heun_predictor_step(const int start_index, const int end_index);
+      void llg_heun_corrector_step(const int start_index, const int end_index);
+      bool grain_tasks_available();
+      void llg_heun_grain_steps(const uint64_t n_steps);
 
       //-------------------------------------------------------------------------
       // Internal function declarations
@@ -0,0 +1,289 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) Richard F L Evans 2022. All rights reserved.
+//
+//   Email: richard.evans@york.ac.uk
+//
+//------------------------------------------------------------------------------
+//
+
+// Standard Libraries
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+// Vampire Header files
+#include "atoms.hpp"
+#include "errors.hpp"
+#include "material.hpp"
+#include "sim.hpp"
+#include "vio.hpp"
+#include "vmpi.hpp"
+
+// sim module headers
+#include "internal.hpp"
+
+namespace LLG_adaptive_arrays{
+
+   // spin directions at start of step
+   std::vector <double> x_initial_spin_array;
+   std::vector <double> y_initial_spin_array;
+   std::vector <double> z_initial_spin_array;
+
+   // Bogacki-Shampine stage derivatives dS/dt
+   std::vector <double> x_k1_array, y_k1_array, z_k1_array;
+   std::vector <double> x_k2_array, y_k2_array, z_k2_array;
+   std::vector <double> x_k3_array, y_k3_array, z_k3_array;
+   std::vector <double> x_k4_array, y_k4_array, z_k4_array;
+
+   double dt = 0.0;            // current adaptive time step (reduced units)
+   bool warning_issued = false; // flag to only warn once when minimum step is too large
+
+   bool LLG_set = false; ///< Flag to define state of adaptive LLG arrays (initialised/uninitialised)
+
+}
+
+namespace sim{
+
+namespace internal{
+
+//-----------------------------------------------------------------------------
+// Function to allocate arrays for adaptive LLG integrator
+//-----------------------------------------------------------------------------
+void llg_adaptive_init(){
+
+   using namespace LLG_adaptive_arrays;
+
+   x_initial_spin_array.resize(atoms::num_atoms, 0.0);
+   y_initial_spin_array.resize(atoms::num_atoms, 0.0);
+   z_initial_spin_array.resize(atoms::num_atoms, 0.0);
+
+   x_k1_array.resize(atoms::num_atoms, 0.0); y_k1_array.resize(atoms::num_atoms, 0.0); z_k1_array.resize(atoms::num_atoms, 0.0);
+   x_k2_array.resize(atoms::num_atoms, 0.0); y_k2_array.resize(atoms::num_atoms, 0.0); z_k2_array.resize(atoms::num_atoms, 0.0);
+   x_k3_array.resize(atoms::num_atoms, 0.0); y_k3_array.resize(atoms::num_atoms, 0.0); z_k3_array.resize(atoms::num_atoms, 0.0);
+   x_k4_array.resize(atoms::num_atoms, 0.0); y_k4_array.resize(atoms::num_atoms, 0.0); z_k4_array.resize(atoms::num_atoms, 0.0);
+
+   // start from nominal time step
+   dt = mp::dt;
+
+   LLG_set = true;
+
+   return;
+
+}
+
+//-----------------------------------------------------------------------------
+// Function to calculate the deterministic LLG derivative dS/dt for the
+// current spin configuration
+//-----------------------------------------------------------------------------
+void llg_derivative(const int num_atoms, std::vector<double>& dSx, std::vector<double>& dSy, std::vector<double>& dSz){
+
+   // update spins in halo region before calculating fields
+   #ifdef MPICF
+      vmpi::mpi_init_halo_swap();
+      vmpi::mpi_complete_halo_swap();
+   #endif
+
+   sim::calculate_spin_fields(0, num_atoms);
+   sim::calculate_external_fields(0, num_atoms);
+
+   for(int atom = 0; atom < num_atoms; atom++){
+
+      const int imaterial = atoms::type_array[atom];
+      const double one_oneplusalpha_sq = mp::material[imaterial].one_oneplusalpha_sq; // material specific alpha and gamma
+      const double alpha_oneplusalpha_sq = mp::material[imaterial].alpha_oneplusalpha_sq;
+
+      // Store local spin in S and local field in H
+      const double S[3] = {atoms::x_spin_array[atom],atoms::y_spin_array[atom],atoms::z_spin_array[atom]};
+      const double H[3] = {atoms::x_total_spin_field_array[atom]+atoms::x_total_external_field_array[atom],
+                           atoms::y_total_spin_field_array[atom]+atoms::y_total_external_field_array[atom],
+                           atoms::z_total_spin_field_array[atom]+atoms::z_total_external_field_array[atom]};
+
+      // Calculate Delta S
+      dSx[atom] = (one_oneplusalpha_sq)*(S[1]*H[2]-S[2]*H[1]) + (alpha_oneplusalpha_sq)*(S[1]*(S[0]*H[1]-S[1]*H[0])-S[2]*(S[2]*H[0]-S[0]*H[2]));
+      dSy[atom] = (one_oneplusalpha_sq)*(S[2]*H[0]-S[0]*H[2]) + (alpha_oneplusalpha_sq)*(S[2]*(S[1]*H[2]-S[2]*H[1])-S[0]*(S[0]*H[1]-S[1]*H[0]));
+      dSz[atom] = (one_oneplusalpha_sq)*(S[0]*H[1]-S[1]*H[0]) + (alpha_oneplusalpha_sq)*(S[0]*(S[2]*H[0]-S[0]*H[2])-S[1]*(S[1]*H[2]-S[2]*H[1]));
+
+   }
+
+   return;
+
+}
+
+//-----------------------------------------------------------------------------
+// Function to set spins to normalised S0 + h * sum_i c_i k_i
+//-----------------------------------------------------------------------------
+void set_stage_spins(const int num_atoms, const double h,
+                     const double c1, const double c2, const double c3){
+
+   using namespace LLG_adaptive_arrays;
+
+   for(int atom = 0; atom < num_atoms; atom++){
+
+      const double S[3] = { x_initial_spin_array[atom] + h*(c1*x_k1_array[atom] + c2*x_k2_array[atom] + c3*x_k3_array[atom]),
+                            y_initial_spin_array[atom] + h*(c1*y_k1_array[atom] + c2*y_k2_array[atom] + c3*y_k3_array[atom]),
+                            z_initial_spin_array[atom] + h*(c1*z_k1_array[atom] + c2*z_k2_array[atom] + c3*z_k3_array[atom]) };
+
+      const double inv_mod_S = 1.0/sqrt(S[0]*S[0] + S[1]*S[1] + S[2]*S[2]);
+
+      atoms::x_spin_array[atom] = S[0]*inv_mod_S;
+      atoms::y_spin_array[atom] = S[1]*inv_mod_S;
+      atoms::z_spin_array[atom] = S[2]*inv_mod_S;
+
+   }
+
+   return;
+
+}
+
+//-----------------------------------------------------------------------------
+// Function to attempt a single Bogacki-Shampine 3(2) step of length h,
+// returning the maximum embedded error estimate on any spin. The first
+// derivative k1 must be valid for the initial spins on entry.
+//-----------------------------------------------------------------------------
+double bogacki_shampine_step(const int num_atoms, const double h){
+
+   using namespace LLG_adaptive_arrays;
+
+   // k2 = f(S0 + h/2 k1)
+   set_stage_spins(num_atoms, h, 0.5, 0.0, 0.0);
+   llg_derivative(num_atoms, x_k2_array, y_k2_array, z_k2_array);
+
+   // k3 = f(S0 + 3h/4 k2)
+   set_stage_spins(num_atoms, h, 0.0, 0.75, 0.0);
+   llg_derivative(num_atoms, x_k3_array, y_k3_array, z_k3_array);
+
+   // third order solution S1 = S0 + h (2/9 k1 + 1/3 k2 + 4/9 k3)
+   set_stage_spins(num_atoms, h, 2.0/9.0, 1.0/3.0, 4.0/9.0);
+
+   // k4 = f(S1), reused as k1 of next step if accepted
+   llg_derivative(num_atoms, x_k4_array, y_k4_array, z_k4_array);
+
+   // embedded error estimate h (-5/72 k1 + 1/12 k2 + 1/9 k3 - 1/8 k4)
+   double max_error_sq = 0.0;
+   for(int atom = 0; atom < num_atoms; atom++){
+      const double ex = -5.0/72.0*x_k1_array[atom] + 1.0/12.0*x_k2_array[atom] + 1.0/9.0*x_k3_array[atom] - 0.125*x_k4_array[atom];
+      const double ey = -5.0/72.0*y_k1_array[atom] + 1.0/12.0*y_k2_array[atom] + 1.0/9.0*y_k3_array[atom] - 0.125*y_k4_array[atom];
+      const double ez = -5.0/72.0*z_k1_array[atom] + 1.0/12.0*z_k2_array[atom] + 1.0/9.0*z_k3_array[atom] - 0.125*z_k4_array[atom];
+      max_error_sq = std::max(max_error_sq, ex*ex + ey*ey + ez*ez);
+   }
+
+   #ifdef MPICF
+      MPI_Allreduce(MPI_IN_PLACE, &max_error_sq, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+   #endif
+
+   return h*sqrt(max_error_sq);
+
+}
+
+//-----------------------------------------------------------------------------
+// Function to integrate the deterministic LLG equation over n_steps nominal
+// time steps of mp::dt using adaptive Bogacki-Shampine steps. Each call ends
+// exactly at sim::time + n_steps so that sim::time * mp::dt_SI remains the
+// physical time and outputs occur at the same physical times as for fixed
+// step integrators. Adaptive steps larger than mp::dt advance the time
+// counter by several nominal steps for a single set of field evaluations.
+//-----------------------------------------------------------------------------
+void llg_adaptive_steps(const uint64_t n_steps){
+
+   // check calling of routine if error checking is activated
+   if(err::check==true){std::cout << "sim::internal::llg_adaptive_steps has been called" << std::endl;}
+
+   using namespace LLG_adaptive_arrays;
+
+   if(n_steps == 0) return;
+
+   // Check for initialisation of adaptive LLG integration arrays
+   if(LLG_set == false) llg_adaptive_init();
+
+   // only update local spins, halo spins are updated by communication
+   #ifdef MPICF
+      const int num_atoms = vmpi::num_core_atoms + vmpi::num_bdry_atoms;
+   #else
+      const int num_atoms = atoms::num_atoms;
+   #endif
+
+   // adaptive integration is deterministic
+   const int thermal_flag = sim::hamiltonian_simulation_flags[3];
+   sim::hamiltonian_simulation_flags[3] = 0;
+
+   // time step limits in reduced units
+   const double SI_to_reduced = mp::dt/mp::dt_SI;
+   const double min_dt = sim::adaptive_min_dt_SI*SI_to_reduced;
+   const double max_dt = sim::adaptive_max_dt_SI*SI_to_reduced;
+   dt = std::max(min_dt, std::min(dt, max_dt));
+
+   // first derivative at start of interval (fields may have changed since last call)
+   llg_derivative(num_atoms, x_k1_array, y_k1_array, z_k1_array);
+
+   const double total_time = double(n_steps); // length of interval in nominal time steps
+   double elapsed = 0.0;                      // time integrated in nominal time steps
+   uint64_t steps_done = 0;                   // number of nominal steps completed
+
+   while(steps_done < n_steps){
+
+      // store initial spin positions
+      for(int atom = 0; atom < num_atoms; atom++){
+         x_initial_spin_array[atom] = atoms::x_spin_array[atom];
+         y_initial_spin_array[atom] = atoms::y_spin_array[atom];
+         z_initial_spin_array[atom] = atoms::z_spin_array[atom];
+      }
+
+      // truncate step to land exactly on end of interval
+      const double remaining = (total_time - elapsed)*mp::dt;
+      const bool last_step = dt >= remaining;
+      const double h = last_step ? remaining : dt;
+
+      const double error = bogacki_shampine_step(num_atoms, h);
+
+      // optimal step size for third order method with safety factor
+      const double scale = error > 0.0 ? 0.9*pow(sim::adaptive_tolerance/error, 1.0/3.0) : 5.0;
+
+      // reject step, restore spins and retry with smaller step
+      if(error > sim::adaptive_tolerance && h > min_dt){
+         for(int atom = 0; atom < num_atoms; atom++){
+            atoms::x_spin_array[atom] = x_initial_spin_array[atom];
+            atoms::y_spin_array[atom] = y_initial_spin_array[atom];
+            atoms::z_spin_array[atom] = z_initial_spin_array[atom];
+         }
+         dt = std::max(min_dt, h*std::max(0.2, scale));
+         continue;
+      }
+
+      if(error > sim::adaptive_tolerance && warning_issued == false){
+         zlog << zTs() << "Warning: adaptive LLG error of " << error << " exceeds tolerance at minimum time step of " << sim::adaptive_min_dt_SI << " s" << std::endl;
+         warning_issued = true;
+      }
+
+      // accept step, k4 at new spins becomes k1 of next step
+      x_k1_array.swap(x_k4_array);
+      y_k1_array.swap(y_k4_array);
+      z_k1_array.swap(z_k4_array);
+
+      // update step size, keeping longer step if last step was truncated
+      const double new_dt = std::max(min_dt, std::min(max_dt, h*std::min(5.0, std::max(0.2, scale))));
+      if(last_step) dt = std::max(dt, new_dt);
+      else dt = new_dt;
+
+      // increment time counter for each nominal step completed
+      elapsed = last_step ? total_time : elapsed + h/mp::dt;
+      const uint64_t completed = last_step ? n_steps : std::min(n_steps, uint64_t(elapsed + 1.0e-9));
+      while(steps_done < completed){
+         sim::internal::increment_time();
+         steps_done++;
+      }
+
+   }
+
+   sim::hamiltonian_simulation_flags[3] = thermal_flag;
+
+   return;
+
+}
+
+} // end of internal namespace
+
+} // end of sim namespace
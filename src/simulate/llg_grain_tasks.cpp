@@ -0,0 +1,305 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) Richard F L Evans 2022. All rights reserved.
+//
+//   Email: richard.evans@york.ac.uk
+//
+//------------------------------------------------------------------------------
+//
+
+// Standard Libraries
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#ifdef _OPENMP
+   #include <omp.h>
+#endif
+
+// Vampire Header files
+#include "atoms.hpp"
+#include "dipole.hpp"
+#include "environment.hpp"
+#include "exchange.hpp"
+#include "gpu.hpp"
+#include "grains.hpp"
+#include "LLG.hpp"
+#include "material.hpp"
+#include "program.hpp"
+#include "random.hpp"
+#include "sim.hpp"
+#include "spintorque.hpp"
+#include "spintransport.hpp"
+#include "vio.hpp"
+#include "vutil.hpp"
+
+// sim module headers
+#include "internal.hpp"
+
+// field functions defined in fields.cpp
+int calculate_applied_fields(const int,const int);
+int calculate_dipolar_fields(const int,const int);
+
+namespace LLG_grain_task_arrays{
+
+   bool initialised = false; // flag to show that grains have been checked for exchange coupling
+   bool available = false;   // flag to show that grains can be integrated as independent tasks
+
+   // range of atoms of each task, ordered by decreasing grain size
+   std::vector <int> task_start_index;
+   std::vector <int> task_end_index;
+
+   // independent random number stream for thermal fields of each task
+   std::vector <std::mt19937> task_generator;
+
+   std::vector <double> sigma_prefactor; // width of thermal field for each material
+
+}
+
+namespace sim{
+
+namespace internal{
+
+//-----------------------------------------------------------------------------
+// Function to determine if grains can be integrated as independent tasks.
+// This requires that grains are only coupled by the dipole field, so that
+// between dipole updates each grain evolves independently. Grains must be
+// contiguous in memory (as generated by the voronoi, hexagonal and square
+// grain structures) and have no exchange interactions with other grains.
+//-----------------------------------------------------------------------------
+bool grain_tasks_available(){
+
+   using namespace LLG_grain_task_arrays;
+
+   if(!sim::internal::grain_tasks) return false;
+
+   // only check system once
+   if(initialised) return available;
+   initialised = true;
+
+   const int num_atoms = atoms::num_atoms;
+   const int num_grains = grains::num_grains;
+
+   //-------------------------------------------------------
+   // Check that there are no global or time dependent fields
+   //-------------------------------------------------------
+   std::string reason = "";
+   if(gpu::acceleration) reason = "GPU acceleration is enabled";
+   else if(program::program == 7 || program::program == 13) reason = "localised heating programs are not supported";
+   else if(environment::enabled) reason = "environment module is enabled";
+   else if(sim::lagrange_multiplier) reason = "Lagrange multiplier is enabled";
+   else if(sim::internal::enable_spin_torque_fields || sim::internal::enable_vcma_fields) reason = "spin torque or vcma fields are enabled";
+   else if(st::is_enabled() || spin_transport::is_enabled()) reason = "spin torque or spin transport module is enabled";
+   else if(sim::enable_fmr) reason = "fmr fields are enabled";
+   else if(sim::ext_demag) reason = "external demagnetising field is enabled";
+   else if(exchange::biquadratic) reason = "biquadratic exchange is enabled";
+   else if(num_grains < 2) reason = "system has less than two grains";
+
+   //-------------------------------------------------------
+   // Determine range of atoms of each grain
+   //-------------------------------------------------------
+   std::vector<int> grain_start(num_grains, num_atoms);
+   std::vector<int> grain_end(num_grains, 0);
+   std::vector<int> grain_num_atoms(num_grains, 0);
+
+   if(reason == ""){
+      for(int atom = 0; atom < num_atoms; atom++){
+         const int grain = atoms::grain_array[atom];
+         if(grain < 0 || grain >= num_grains){
+            reason = "atoms outside of grains";
+            break;
+         }
+         grain_start[grain] = std::min(grain_start[grain], atom);
+         grain_end[grain] = std::max(grain_end[grain], atom + 1);
+         grain_num_atoms[grain]++;
+      }
+   }
+
+   if(reason == ""){
+      for(int grain = 0; grain < num_grains; grain++){
+         if(grain_num_atoms[grain] > 0 && grain_end[grain] - grain_start[grain] != grain_num_atoms[grain]){
+            reason = "atoms are not ordered by grain";
+            break;
+         }
+      }
+   }
+
+   //-------------------------------------------------------
+   // Check for exchange interactions between grains (four spin
+   // quartets are formed from the same neighbours)
+   //-------------------------------------------------------
+   if(reason == ""){
+      for(int atom = 0; atom < num_atoms && reason == ""; atom++){
+         const int grain = atoms::grain_array[atom];
+         for(int nn = atoms::neighbour_list_start_index[atom]; nn <= atoms::neighbour_list_end_index[atom]; nn++){
+            if(atoms::grain_array[atoms::neighbour_list_array[nn]] != grain){
+               reason = "grains are exchange coupled";
+               break;
+            }
+         }
+      }
+   }
+
+   if(reason != ""){
+      std::cout << "Warning - grains cannot be integrated as independent tasks (" << reason << "). Using standard integration." << std::endl;
+      zlog << zTs() << "Warning - grains cannot be integrated as independent tasks (" << reason << "). Using standard integration." << std::endl;
+      return false;
+   }
+
+   //-------------------------------------------------------
+   // Set up tasks, largest grains first for load balancing
+   //-------------------------------------------------------
+   std::vector< std::pair<int,int> > task_order; // (-size, grain)
+   for(int grain = 0; grain < num_grains; grain++){
+      if(grain_num_atoms[grain] > 0) task_order.push_back(std::make_pair(-grain_num_atoms[grain], grain));
+   }
+   std::sort(task_order.begin(), task_order.end());
+
+   const int num_tasks = task_order.size();
+   task_start_index.resize(num_tasks);
+   task_end_index.resize(num_tasks);
+   task_generator.resize(num_tasks);
+
+   for(int task = 0; task < num_tasks; task++){
+      const int grain = task_order[task].second;
+      task_start_index[task] = grain_start[grain];
+      task_end_index[task] = grain_end[grain];
+      // seed stream from integration seed and grain so that results are independent of the number of threads
+      std::seed_seq seed{ static_cast<unsigned int>(mtrandom::integration_seed), static_cast<unsigned int>(grain) };
+      task_generator[task].seed(seed);
+   }
+
+   available = true;
+
+   int num_threads = 1;
+   #ifdef _OPENMP
+      num_threads = omp_get_max_threads();
+   #endif
+
+   zlog << zTs() << "Integrating " << num_tasks << " exchange-decoupled grains as independent tasks on " << num_threads
+        << " threads (largest grain " << -task_order.front().first << " atoms, smallest grain " << -task_order.back().first << " atoms)" << std::endl;
+
+   return true;
+
+}
+
+//-----------------------------------------------------------------------------
+// Function to integrate a single grain for one time step with the Heun scheme
+//-----------------------------------------------------------------------------
+void llg_heun_grain_step(const int task){
+
+   using namespace LLG_grain_task_arrays;
+
+   const int start_index = task_start_index[task];
+   const int end_index = task_end_index[task];
+
+   // Calculate spin fields
+   sim::calculate_spin_fields(start_index, end_index);
+
+   // Calculate external fields with thermal field from the stream of this grain
+   std::fill(atoms::x_total_external_field_array.begin()+start_index, atoms::x_total_external_field_array.begin()+end_index, 0.0);
+   std::fill(atoms::y_total_external_field_array.begin()+start_index, atoms::y_total_external_field_array.begin()+end_index, 0.0);
+   std::fill(atoms::z_total_external_field_array.begin()+start_index, atoms::z_total_external_field_array.begin()+end_index, 0.0);
+
+   if(sim::hamiltonian_simulation_flags[3] == 1){
+
+      // time thermal field calculation
+      vutil::profile::scope_t profile(vutil::profile::thermal);
+
+      std::mt19937& generator = task_generator[task];
+
+      for(int atom = start_index; atom < end_index; atom++) atoms::x_total_external_field_array[atom] = mtrandom::gaussianc(generator);
+      for(int atom = start_index; atom < end_index; atom++) atoms::y_total_external_field_array[atom] = mtrandom::gaussianc(generator);
+      for(int atom = start_index; atom < end_index; atom++) atoms::z_total_external_field_array[atom] = mtrandom::gaussianc(generator);
+
+      for(int atom = start_index; atom < end_index; atom++){
+         const double H_th_sigma = sigma_prefactor[atoms::type_array[atom]];
+         atoms::x_total_external_field_array[atom] *= H_th_sigma;
+         atoms::y_total_external_field_array[atom] *= H_th_sigma;
+         atoms::z_total_external_field_array[atom] *= H_th_sigma;
+      }
+
+   }
+
+   if(sim::hamiltonian_simulation_flags[2] == 1) calculate_applied_fields(start_index, end_index);
+   calculate_dipolar_fields(start_index, end_index);
+
+   // Calculate Euler step
+   sim::internal::llg_heun_predictor_step(start_index, end_index);
+
+   // Recalculate spin dependent fields
+   sim::calculate_spin_fields(start_index, end_index);
+
+   // Calculate Heun step
+   sim::internal::llg_heun_corrector_step(start_index, end_index);
+
+   return;
+
+}
+
+//-----------------------------------------------------------------------------
+// Function to integrate exchange-decoupled grains as independent tasks. The
+// grains are only coupled through the dipole field, so each task integrates
+// its grain up to the next dipole update where all grains are synchronised.
+// Tasks are dynamically scheduled on available threads, largest first.
+//-----------------------------------------------------------------------------
+void llg_heun_grain_steps(const uint64_t n_steps){
+
+   using namespace LLG_grain_task_arrays;
+
+   // Check for initialisation of LLG integration arrays
+   if(LLG_arrays::LLG_set == false) sim::LLGinit();
+
+   // Calculate width of thermal field for each material (temperature is constant during integration)
+   sigma_prefactor.resize(mp::material.size());
+   for(unsigned int mat = 0; mat < mp::material.size(); mat++){
+      double temperature = sim::temperature;
+      // Check for localised temperature
+      if(sim::local_temperature) temperature = mp::material[mat].temperature;
+      // Calculate temperature rescaling
+      const double alpha = mp::material[mat].temperature_rescaling_alpha;
+      const double Tc = mp::material[mat].temperature_rescaling_Tc;
+      // if T<Tc T/Tc = (T/Tc)^alpha else T = T
+      const double rescaled_temperature = temperature < Tc ? Tc*pow(temperature/Tc,alpha) : temperature;
+      sigma_prefactor[mat] = sqrt(rescaled_temperature)*mp::material[mat].H_th_sigma;
+   }
+
+   // Update temperature dependent module data before fields are calculated by several threads
+   sim::calculate_spin_fields(0, 0);
+
+   const int num_tasks = task_start_index.size();
+
+   uint64_t step = 0;
+   while(step < n_steps){
+
+      // number of steps to next dipole field update
+      uint64_t num_block_steps = n_steps - step;
+      if(dipole::activated){
+         const uint64_t update_rate = dipole::update_rate;
+         num_block_steps = std::min(num_block_steps, update_rate - sim::time % update_rate);
+      }
+
+      #pragma omp parallel for schedule(dynamic,1)
+      for(int task = 0; task < num_tasks; task++){
+         for(uint64_t ti = 0; ti < num_block_steps; ti++) llg_heun_grain_step(task);
+      }
+
+      // Increment time to end of block, updating dipole field
+      sim::time += num_block_steps - 1;
+      sim::internal::increment_time();
+
+      step += num_block_steps;
+
+   }
+
+   return;
+
+}
+
+} // end of internal namespace
+
+} // end of sim namespace
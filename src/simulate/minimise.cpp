@@ -0,0 +1,468 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) Richard F L Evans 2022. All rights reserved.
+//
+//   Email: richard.evans@york.ac.uk
+//
+//------------------------------------------------------------------------------
+//
+
+// Standard Libraries
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+// Vampire Header files
+#include "atoms.hpp"
+#include "errors.hpp"
+#include "sim.hpp"
+#include "vio.hpp"
+#include "vmpi.hpp"
+
+// sim module headers
+#include "internal.hpp"
+
+namespace minimiser_arrays{
+
+   // Effective force on each spin (component of field perpendicular to spin, T)
+   std::vector <double> x_force_array;
+   std::vector <double> y_force_array;
+   std::vector <double> z_force_array;
+
+   // Force from previous iteration (conjugate gradient only)
+   std::vector <double> x_old_force_array;
+   std::vector <double> y_old_force_array;
+   std::vector <double> z_old_force_array;
+
+   // FIRE velocity or conjugate gradient search direction
+   std::vector <double> x_direction_array;
+   std::vector <double> y_direction_array;
+   std::vector <double> z_direction_array;
+
+   std::vector <bool> fixed; // optional mask of spins excluded from minimisation
+
+   // FIRE parameters (Bitzek et al, Phys. Rev. Lett. 97, 170201 (2006))
+   const double fire_alpha_start = 0.1;  // initial mixing of velocity and force
+   const double fire_f_alpha = 0.99;     // decrease of mixing on successful step
+   const double fire_f_inc = 1.1;        // increase of time step on successful step
+   const double fire_f_dec = 0.5;        // decrease of time step when moving uphill
+   const int fire_n_min = 5;             // number of successful steps before time step increases
+
+   const double max_rotation = 0.2; // maximum rotation of any spin in a single step (radians)
+
+   // Minimiser state
+   double step = 0.0;       // FIRE time step or conjugate gradient step length
+   double max_step = 0.0;   // maximum FIRE time step
+   double alpha = 0.0;      // FIRE mixing parameter
+   int n_positive = 0;      // number of successive downhill FIRE steps
+   double last_slope = 0.0; // directional derivative along search direction before last step
+   bool restart = true;     // flag to restart from steepest descent
+   bool converged = false;  // flag to indicate last step was converged
+
+   bool minimiser_set = false; ///< Flag to define state of minimiser arrays (initialised/uninitialised)
+
+}
+
+namespace sim{
+
+namespace internal{
+
+//-----------------------------------------------------------------------------
+// Function to reset minimiser to initial state
+//-----------------------------------------------------------------------------
+void reset_minimiser(){
+
+   using namespace minimiser_arrays;
+
+   x_force_array.assign(atoms::num_atoms, 0.0);
+   y_force_array.assign(atoms::num_atoms, 0.0);
+   z_force_array.assign(atoms::num_atoms, 0.0);
+
+   x_old_force_array.assign(atoms::num_atoms, 0.0);
+   y_old_force_array.assign(atoms::num_atoms, 0.0);
+   z_old_force_array.assign(atoms::num_atoms, 0.0);
+
+   x_direction_array.assign(atoms::num_atoms, 0.0);
+   y_direction_array.assign(atoms::num_atoms, 0.0);
+   z_direction_array.assign(atoms::num_atoms, 0.0);
+
+   // step sizes are set from field scale on first step
+   step = 0.0;
+   max_step = 0.0;
+   alpha = fire_alpha_start;
+   n_positive = 0;
+   last_slope = 0.0;
+   restart = true;
+   converged = false;
+
+   minimiser_set = true;
+
+   return;
+
+}
+
+//-----------------------------------------------------------------------------
+// Function to calculate the force on each spin F = H - (S.H)S, the negative
+// energy gradient on the unit sphere, returning the maximum torque |S x H| = |F|
+// and the maximum field magnitude on any spin
+//-----------------------------------------------------------------------------
+double calculate_minimiser_forces(const int num_atoms, double& max_field){
+
+   using namespace minimiser_arrays;
+
+   // minimisation is always at zero temperature
+   const int thermal_flag = sim::hamiltonian_simulation_flags[3];
+   sim::hamiltonian_simulation_flags[3] = 0;
+
+   // update spins in halo region before calculating fields
+   #ifdef MPICF
+      vmpi::mpi_init_halo_swap();
+      vmpi::mpi_complete_halo_swap();
+   #endif
+
+   sim::calculate_spin_fields(0, num_atoms);
+   sim::calculate_external_fields(0, num_atoms);
+
+   sim::hamiltonian_simulation_flags[3] = thermal_flag;
+
+   const bool use_mask = fixed.size() > 0;
+
+   double max_torque_sq = 0.0;
+   double max_field_sq = 0.0;
+
+   for(int atom = 0; atom < num_atoms; atom++){
+
+      if(use_mask && fixed[atom]){
+         x_force_array[atom] = 0.0;
+         y_force_array[atom] = 0.0;
+         z_force_array[atom] = 0.0;
+         continue;
+      }
+
+      const double S[3] = {atoms::x_spin_array[atom],atoms::y_spin_array[atom],atoms::z_spin_array[atom]};
+      const double H[3] = {atoms::x_total_spin_field_array[atom]+atoms::x_total_external_field_array[atom],
+                           atoms::y_total_spin_field_array[atom]+atoms::y_total_external_field_array[atom],
+                           atoms::z_total_spin_field_array[atom]+atoms::z_total_external_field_array[atom]};
+
+      const double SdotH = S[0]*H[0] + S[1]*H[1] + S[2]*H[2];
+
+      const double F[3] = { H[0] - SdotH*S[0], H[1] - SdotH*S[1], H[2] - SdotH*S[2] };
+
+      x_force_array[atom] = F[0];
+      y_force_array[atom] = F[1];
+      z_force_array[atom] = F[2];
+
+      max_torque_sq = std::max(max_torque_sq, F[0]*F[0] + F[1]*F[1] + F[2]*F[2]);
+      max_field_sq  = std::max(max_field_sq,  H[0]*H[0] + H[1]*H[1] + H[2]*H[2]);
+
+   }
+
+   double maxima[2] = { max_torque_sq, max_field_sq };
+   #ifdef MPICF
+      MPI_Allreduce(MPI_IN_PLACE, maxima, 2, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+   #endif
+
+   max_field = sqrt(maxima[1]);
+   return sqrt(maxima[0]);
+
+}
+
+//-----------------------------------------------------------------------------
+// Function to rotate spins by step*direction, limiting the rotation of each
+// spin to max_rotation and renormalising the spin length
+//-----------------------------------------------------------------------------
+void rotate_spins(const int num_atoms, const double step_size){
+
+   using namespace minimiser_arrays;
+
+   const double max_rotation_sq = max_rotation*max_rotation;
+
+   for(int atom = 0; atom < num_atoms; atom++){
+
+      double dS[3] = { step_size*x_direction_array[atom], step_size*y_direction_array[atom], step_size*z_direction_array[atom] };
+
+      const double dS_sq = dS[0]*dS[0] + dS[1]*dS[1] + dS[2]*dS[2];
+      if(dS_sq > max_rotation_sq){
+         const double scale = max_rotation/sqrt(dS_sq);
+         dS[0] *= scale;
+         dS[1] *= scale;
+         dS[2] *= scale;
+      }
+
+      const double S_new[3] = { atoms::x_spin_array[atom] + dS[0],
+                                atoms::y_spin_array[atom] + dS[1],
+                                atoms::z_spin_array[atom] + dS[2] };
+
+      const double inv_mod_S = 1.0/sqrt(S_new[0]*S_new[0] + S_new[1]*S_new[1] + S_new[2]*S_new[2]);
+
+      atoms::x_spin_array[atom] = S_new[0]*inv_mod_S;
+      atoms::y_spin_array[atom] = S_new[1]*inv_mod_S;
+      atoms::z_spin_array[atom] = S_new[2]*inv_mod_S;
+
+   }
+
+   return;
+
+}
+
+//-----------------------------------------------------------------------------
+// Function to project direction vectors onto the tangent plane of each spin
+//-----------------------------------------------------------------------------
+void project_directions(const int num_atoms){
+
+   using namespace minimiser_arrays;
+
+   for(int atom = 0; atom < num_atoms; atom++){
+      const double S[3] = {atoms::x_spin_array[atom],atoms::y_spin_array[atom],atoms::z_spin_array[atom]};
+      const double SdotD = S[0]*x_direction_array[atom] + S[1]*y_direction_array[atom] + S[2]*z_direction_array[atom];
+      x_direction_array[atom] -= SdotD*S[0];
+      y_direction_array[atom] -= SdotD*S[1];
+      z_direction_array[atom] -= SdotD*S[2];
+   }
+
+   return;
+
+}
+
+//-----------------------------------------------------------------------------
+// Function to perform a single FIRE step treating spin directions as
+// particle positions on the unit sphere with the force F = H - (S.H)S
+//-----------------------------------------------------------------------------
+void fire_step(const int num_atoms, const double max_field){
+
+   using namespace minimiser_arrays;
+
+   // set initial and maximum time step from the stiffest field in the system
+   if(step == 0.0){
+      max_step = 1.0/sqrt(max_field);
+      step = 0.1*max_step;
+   }
+
+   // calculate power P = F.v and norms of force and velocity
+   double sums[3] = {0.0, 0.0, 0.0};
+   for(int atom = 0; atom < num_atoms; atom++){
+      const double F[3] = {x_force_array[atom], y_force_array[atom], z_force_array[atom]};
+      const double v[3] = {x_direction_array[atom], y_direction_array[atom], z_direction_array[atom]};
+      sums[0] += F[0]*v[0] + F[1]*v[1] + F[2]*v[2];
+      sums[1] += F[0]*F[0] + F[1]*F[1] + F[2]*F[2];
+      sums[2] += v[0]*v[0] + v[1]*v[1] + v[2]*v[2];
+   }
+   #ifdef MPICF
+      MPI_Allreduce(MPI_IN_PLACE, sums, 3, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+   #endif
+
+   const double power = sums[0];
+
+   // moving downhill: mix velocity towards force direction and accelerate
+   if(power > 0.0){
+      const double mix = alpha*sqrt(sums[2]/sums[1]);
+      for(int atom = 0; atom < num_atoms; atom++){
+         x_direction_array[atom] = (1.0 - alpha)*x_direction_array[atom] + mix*x_force_array[atom];
+         y_direction_array[atom] = (1.0 - alpha)*y_direction_array[atom] + mix*y_force_array[atom];
+         z_direction_array[atom] = (1.0 - alpha)*z_direction_array[atom] + mix*z_force_array[atom];
+      }
+      n_positive++;
+      if(n_positive > fire_n_min){
+         step = std::min(step*fire_f_inc, max_step);
+         alpha *= fire_f_alpha;
+      }
+   }
+   // moving uphill: stop and decrease time step
+   else{
+      std::fill(x_direction_array.begin(), x_direction_array.end(), 0.0);
+      std::fill(y_direction_array.begin(), y_direction_array.end(), 0.0);
+      std::fill(z_direction_array.begin(), z_direction_array.end(), 0.0);
+      step *= fire_f_dec;
+      alpha = fire_alpha_start;
+      n_positive = 0;
+   }
+
+   // semi-implicit Euler update of velocity and spin direction
+   for(int atom = 0; atom < num_atoms; atom++){
+      x_direction_array[atom] += step*x_force_array[atom];
+      y_direction_array[atom] += step*y_force_array[atom];
+      z_direction_array[atom] += step*z_force_array[atom];
+   }
+
+   rotate_spins(num_atoms, step);
+
+   // keep velocity in tangent plane of new spin directions
+   project_directions(num_atoms);
+
+   return;
+
+}
+
+//-----------------------------------------------------------------------------
+// Function to perform a single nonlinear conjugate gradient step on the unit
+// sphere using the Polak-Ribiere+ update. The step length is adapted from the
+// change in directional derivative along the previous search direction
+// (secant estimate of the line minimum) to need one field evaluation per step
+//-----------------------------------------------------------------------------
+void conjugate_gradient_step(const int num_atoms, const double max_field){
+
+   using namespace minimiser_arrays;
+
+   // initial step length from the stiffest field in the system
+   if(step == 0.0) step = 0.5/max_field;
+
+   // sums for F.d_old, F.F, F.F_old and F_old.F_old
+   double sums[4] = {0.0, 0.0, 0.0, 0.0};
+   for(int atom = 0; atom < num_atoms; atom++){
+      const double F[3]  = {x_force_array[atom], y_force_array[atom], z_force_array[atom]};
+      const double Fo[3] = {x_old_force_array[atom], y_old_force_array[atom], z_old_force_array[atom]};
+      sums[0] += F[0]*x_direction_array[atom] + F[1]*y_direction_array[atom] + F[2]*z_direction_array[atom];
+      sums[1] += F[0]*F[0] + F[1]*F[1] + F[2]*F[2];
+      sums[2] += F[0]*Fo[0] + F[1]*Fo[1] + F[2]*Fo[2];
+      sums[3] += Fo[0]*Fo[0] + Fo[1]*Fo[1] + Fo[2]*Fo[2];
+   }
+   #ifdef MPICF
+      MPI_Allreduce(MPI_IN_PLACE, sums, 4, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+   #endif
+
+   double beta = 0.0;
+
+   if(!restart){
+
+      // secant estimate of line minimum from directional derivatives before and after last step
+      const double slope = sums[0];
+      const double curvature = last_slope - slope;
+      if(curvature > 0.0) step = std::max(0.25*step, std::min(4.0*step, step*last_slope/curvature));
+      else step = 2.0*step;
+
+      // Polak-Ribiere+ conjugacy
+      if(sums[3] > 0.0) beta = std::max(0.0, (sums[1] - sums[2])/sums[3]);
+
+   }
+
+   // new search direction d = F + beta d_old, transported to tangent plane of current spins
+   for(int atom = 0; atom < num_atoms; atom++){
+      x_direction_array[atom] = x_force_array[atom] + beta*x_direction_array[atom];
+      y_direction_array[atom] = y_force_array[atom] + beta*y_direction_array[atom];
+      z_direction_array[atom] = z_force_array[atom] + beta*z_direction_array[atom];
+   }
+   if(beta > 0.0) project_directions(num_atoms);
+
+   // directional derivative along new search direction
+   double slope = 0.0;
+   for(int atom = 0; atom < num_atoms; atom++){
+      slope += x_force_array[atom]*x_direction_array[atom] + y_force_array[atom]*y_direction_array[atom] + z_force_array[atom]*z_direction_array[atom];
+   }
+   #ifdef MPICF
+      MPI_Allreduce(MPI_IN_PLACE, &slope, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+   #endif
+
+   // restart with steepest descent if not a descent direction
+   if(slope <= 0.0){
+      x_direction_array = x_force_array;
+      y_direction_array = y_force_array;
+      z_direction_array = z_force_array;
+      slope = sums[1];
+   }
+
+   last_slope = slope;
+   restart = false;
+
+   x_old_force_array = x_force_array;
+   y_old_force_array = y_force_array;
+   z_old_force_array = z_force_array;
+
+   rotate_spins(num_atoms, step);
+
+   return;
+
+}
+
+//-----------------------------------------------------------------------------
+// Function to perform a single step of the zero temperature energy minimiser
+//-----------------------------------------------------------------------------
+void minimiser_step(){
+
+   // check calling of routine if error checking is activated
+   if(err::check==true){std::cout << "sim::internal::minimiser_step has been called" << std::endl;}
+
+   using namespace minimiser_arrays;
+
+   if(minimiser_set == false) reset_minimiser();
+
+   // only update local spins, halo spins are updated by communication
+   #ifdef MPICF
+      const int num_atoms = vmpi::num_core_atoms + vmpi::num_bdry_atoms;
+   #else
+      const int num_atoms = atoms::num_atoms;
+   #endif
+
+   double max_field = 0.0;
+   const double max_torque = calculate_minimiser_forces(num_atoms, max_field);
+
+   // do not move spins once converged, but keep checking in case fields change
+   converged = max_torque < sim::minimiser_torque_tolerance;
+   if(converged){
+      restart = true;
+      n_positive = 0;
+      alpha = fire_alpha_start;
+      std::fill(x_direction_array.begin(), x_direction_array.end(), 0.0);
+      std::fill(y_direction_array.begin(), y_direction_array.end(), 0.0);
+      std::fill(z_direction_array.begin(), z_direction_array.end(), 0.0);
+      return;
+   }
+
+   switch(sim::minimiser_algorithm){
+      case sim::fire:
+         fire_step(num_atoms, max_field);
+         break;
+      case sim::conjugate_gradient:
+         conjugate_gradient_step(num_atoms, max_field);
+         break;
+   }
+
+   return;
+
+}
+
+} // end of internal namespace
+
+//-----------------------------------------------------------------------------
+// Function to minimise the energy of the system at zero temperature until the
+// maximum torque is below sim::minimiser_torque_tolerance, returning the
+// number of iterations taken. Spins with fixed[atom] = true are not moved.
+//-----------------------------------------------------------------------------
+uint64_t minimise(const uint64_t max_iterations, const std::vector<bool>& fixed){
+
+   // check calling of routine if error checking is activated
+   if(err::check==true){std::cout << "sim::minimise has been called" << std::endl;}
+
+   minimiser_arrays::fixed = fixed;
+   sim::internal::reset_minimiser();
+
+   uint64_t iteration = 0;
+   for(iteration = 0; iteration < max_iterations; iteration++){
+      sim::internal::minimiser_step();
+      if(minimiser_arrays::converged) break;
+      sim::internal::increment_time();
+   }
+
+   if(minimiser_arrays::converged){
+      zlog << zTs() << "Energy minimisation converged in " << iteration << " iterations" << std::endl;
+   }
+   else{
+      zlog << zTs() << "Warning: Energy minimisation not converged to torque of " << sim::minimiser_torque_tolerance << " T after " << iteration << " iterations" << std::endl;
+   }
+
+   // clear mask of fixed spins so that it does not affect later calls to integrator
+   minimiser_arrays::fixed.clear();
+   sim::internal::reset_minimiser();
+
+   return iteration;
+
+}
+
+uint64_t minimise(const uint64_t max_iterations){
+   const std::vector<bool> none;
+   return minimise(max_iterations, none);
+}
+
+} // end of sim namespace
@@ -597,9 +597,15 @@ namespace sim
 		}
 		}
 
+		// complete reduction of last statistics update
+		stats::internal::complete_reduction();
+
 		std::cout << "Simulation run time [s]: " << stopwatch.elapsed_seconds() << std::endl;
 		zlog << zTs() << "Simulation run time [s]: " << stopwatch.elapsed_seconds() << std::endl;
 
+		// output performance profile if enabled
+		vutil::profile::output(stopwatch.elapsed_seconds());
+
 		//------------------------------------------------
 		// Output Monte Carlo statistics if applicable
 		//------------------------------------------------
@@ -672,6 +678,9 @@ namespace sim
 		if (err::check == true)
 			std::cout << "sim::integrate has been called" << std::endl;
 
+		// time integration including all field and statistics calculations
+		vutil::profile::scope_t profile(vutil::profile::integrate);
+
 // Call serial or parallell depending at compile time
 #ifdef MPICF
 		sim::integrate_mpi(n_steps);
@@ -726,6 +735,12 @@ namespace sim
 			{
 
 			case 0: // LLG Heun
+				// Optionally integrate exchange-decoupled grains as independent tasks (increments time internally)
+				if (sim::internal::grain_tasks_available())
+				{
+					sim::internal::llg_heun_grain_steps(n_steps);
+					break;
+				}
 				for (uint64_t ti = 0; ti < n_steps; ti++)
 				{
 					// Optionally select GPU accelerated version
@@ -768,6 +783,15 @@ namespace sim
 				}
 				break;
 
+			case sim::llg_depondt: // LLG Depondt rotation integrator
+				for (uint64_t ti = 0; ti < n_steps; ti++)
+				{
+					sim::LLG_Depondt();
+					// increment time
+					sim::internal::increment_time();
+				}
+				break;
+
 			case 3: // Constrained Monte Carlo
 				for (uint64_t ti = 0; ti < n_steps; ti++)
 				{
@@ -795,6 +819,19 @@ namespace sim
 				}
 				break;
 
+			case sim::minimiser: // Zero temperature energy minimisation
+				for (uint64_t ti = 0; ti < n_steps; ti++)
+				{
+					sim::internal::minimiser_step();
+					// increment time
+					sim::internal::increment_time();
+				}
+				break;
+
+			case sim::llg_adaptive: // Adaptive time step LLG (increments time internally)
+				sim::internal::llg_adaptive_steps(n_steps);
+				break;
+
 			default:
 			{
 				std::cerr << "Unknown integrator type " << sim::integrator << " requested, exiting" << std::endl;
@@ -899,6 +936,17 @@ namespace sim
 #else
 					sim::LLG_Midpoint_mpi();
 #endif
+#endif
+					// increment time
+					sim::internal::increment_time();
+				}
+				break;
+
+			case sim::llg_depondt: // LLG Depondt rotation integrator
+				for (uint64_t ti = 0; ti < n_steps; ti++)
+				{
+#ifdef MPICF
+					sim::LLG_Depondt_mpi();
 #endif
 					// increment time
 					sim::internal::increment_time();
@@ -917,6 +965,19 @@ namespace sim
 				}
 				break;
 
+			case sim::minimiser: // Zero temperature energy minimisation
+				for (uint64_t ti = 0; ti < n_steps; ti++)
+				{
+					sim::internal::minimiser_step();
+					// increment time
+					sim::internal::increment_time();
+				}
+				break;
+
+			case sim::llg_adaptive: // Adaptive time step LLG (increments time internally)
+				sim::internal::llg_adaptive_steps(n_steps);
+				break;
+
 			default:
 			{
 				terminaltextcolor(RED);
@@ -0,0 +1,83 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) Richard F L Evans 2022. All rights reserved.
+//
+//   Email: richard.evans@york.ac.uk
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+
+// Vampire headers
+#include "spectrum.hpp"
+
+// spectrum module headers
+#include "internal.hpp"
+
+namespace spectrum{
+
+   //------------------------------------------------------------------------------
+   // Externally visible variables
+   //------------------------------------------------------------------------------
+
+   namespace internal{
+
+      //------------------------------------------------------------------------
+      // Shared variables inside spectrum module
+      //------------------------------------------------------------------------
+      bool enabled = false; // flag to enable spectra
+      bool system_spectrum = false; // flag to calculate spectrum of system magnetisation
+      bool material_spectrum = false; // flag to calculate spectrum of material magnetisation
+      bool cell_spectrum = false; // flag to calculate spectrum of cell magnetisation
+      bool structure_factor = false; // flag to calculate dynamic structure factor S(q,w)
+
+      window_t window = hann; // window function applied to time series
+
+      std::vector<double> frequencies(0); // list of frequencies (Hz)
+      double minimum_frequency = 0.0; // minimum frequency of uniform grid (Hz)
+      double maximum_frequency = 0.0; // maximum frequency of uniform grid (Hz)
+      unsigned int num_frequency_points = 0; // number of points in uniform grid
+
+      std::vector<double> q_path(0); // vertices of path in reciprocal space (h,k,l in units of 2pi/a)
+      unsigned int q_path_points = 1; // number of q-points per segment of path
+      std::vector<double> q_hkl(0); // list of q-points (h,k,l in units of 2pi/a)
+      std::vector<double> q_vectors(0); // list of q-vectors (1/A)
+      std::vector<double> q_distance(0); // distance of q-points along path (1/A)
+
+      int num_materials = 0; // number of materials
+      int num_cells = 0; // number of macrocells
+      uint64_t num_atoms = 0; // number of local atoms
+
+      std::vector<int> atom_type_array; // material types of atoms
+      std::vector<int> atom_cell_array; // macrocell of atoms
+      std::vector<double> atom_moment_array; // moments of magnetic atoms (zero for non-magnetic atoms, muB)
+      std::vector<double> cell_position_array; // positions of cells (x,y,z,m)
+      std::vector<double> atom_cos_qr_array; // cos(q.r) of atoms [q-point][atom]
+      std::vector<double> atom_sin_qr_array; // sin(q.r) of atoms [q-point][atom]
+
+      std::vector<double> material_moment; // total moment of each material (muB)
+      std::vector<double> cell_moment; // total moment of each cell (muB)
+
+      bool started = false; // flag to indicate accumulation has started
+      uint64_t num_samples = 0; // expected number of samples
+      uint64_t sample = 0; // number of samples taken
+      double sample_interval = 0.0; // time between samples (s)
+      double weight_sum = 0.0; // sum of window weights
+      double weight_sq_sum = 0.0; // sum of squared window weights
+
+      std::vector<double> cos_wt; // cos(w t) for each frequency at current sample
+      std::vector<double> sin_wt; // sin(w t) for each frequency at current sample
+      std::vector<double> signal; // current values of all signals
+
+      dft_bank_t magnetisation_dft; // transforms of system and material magnetisation
+      dft_bank_t cell_dft; // transforms of cell magnetisation
+      dft_bank_t field_dft; // transforms of driving field and window function
+      dft_bank_t structure_factor_dft; // transforms of spin projections m(q) [q-point][Re mx,my,mz,Im mx,my,mz]
+
+   } // end of internal namespace
+
+} // end of spectrum namespace
@@ -0,0 +1,133 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) Richard F L Evans 2022. All rights reserved.
+//
+//   Email: richard.evans@york.ac.uk
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <algorithm>
+
+// Vampire headers
+#include "spectrum.hpp"
+#include "errors.hpp"
+#include "vio.hpp"
+#include "vmpi.hpp"
+
+// spectrum module headers
+#include "internal.hpp"
+
+namespace spectrum{
+
+   //----------------------------------------------------------------------------
+   // Function to initialize spectrum module
+   //----------------------------------------------------------------------------
+   void initialize(const int num_materials,    // number of materials
+                   const int num_cells,        // number of macrocells
+                   const uint64_t num_atoms,   // number of local atoms
+                   const std::vector<int>& atoms_type_array, // material types of atoms
+                   const std::vector<int>& atoms_cell_array, // macrocell of atoms
+                   const std::vector<double>& atoms_m_spin_array, // moments of atoms (muB)
+                   const std::vector<bool>& is_magnetic_material, // array of size num_mat to state whether material is magnetic (true) or not (false)
+                   const std::vector<double>& cell_position_array, // positions and moments of cells (x,y,z,m)
+                   const std::vector<double>& atoms_x_coord_array, // x-coordinates of atoms (A)
+                   const std::vector<double>& atoms_y_coord_array, // y-coordinates of atoms (A)
+                   const std::vector<double>& atoms_z_coord_array, // z-coordinates of atoms (A)
+                   const double unit_cell_size_x, // unit cell size in x (A)
+                   const double unit_cell_size_y, // unit cell size in y (A)
+                   const double unit_cell_size_z  // unit cell size in z (A)
+   ){
+
+      // do nothing if no spectra requested
+      if(!internal::system_spectrum && !internal::material_spectrum && !internal::cell_spectrum && !internal::structure_factor) return;
+
+      //-------------------------------------------------------------------------
+      // Determine list of frequencies from explicit list and uniform grid
+      //-------------------------------------------------------------------------
+      if(internal::num_frequency_points > 0){
+         if(internal::maximum_frequency <= internal::minimum_frequency && internal::num_frequency_points > 1){
+            terminaltextcolor(RED);
+            std::cerr << "Error - spectrum:maximum-frequency must be larger than spectrum:minimum-frequency for a range of frequencies" << std::endl;
+            terminaltextcolor(WHITE);
+            zlog << zTs() << "Error - spectrum:maximum-frequency must be larger than spectrum:minimum-frequency for a range of frequencies" << std::endl;
+            err::vexit();
+         }
+         const unsigned int n = internal::num_frequency_points;
+         const double df = n > 1 ? (internal::maximum_frequency - internal::minimum_frequency)/double(n - 1) : 0.0;
+         for(unsigned int i = 0; i < n; i++) internal::frequencies.push_back(internal::minimum_frequency + df*double(i));
+      }
+
+      std::sort(internal::frequencies.begin(), internal::frequencies.end());
+      internal::frequencies.erase(std::unique(internal::frequencies.begin(), internal::frequencies.end()), internal::frequencies.end());
+
+      if(internal::frequencies.size() == 0){
+         terminaltextcolor(RED);
+         std::cerr << "Error - no frequencies specified for spectrum calculation. Use spectrum:frequencies or spectrum:frequency-points" << std::endl;
+         terminaltextcolor(WHITE);
+         zlog << zTs() << "Error - no frequencies specified for spectrum calculation. Use spectrum:frequencies or spectrum:frequency-points" << std::endl;
+         err::vexit();
+      }
+
+      //-------------------------------------------------------------------------
+      // Save atom data, setting moments of non-magnetic atoms to zero
+      //-------------------------------------------------------------------------
+      internal::num_materials = num_materials;
+      internal::num_cells = num_cells;
+      internal::num_atoms = num_atoms;
+
+      internal::atom_type_array.assign(atoms_type_array.begin(), atoms_type_array.begin() + num_atoms);
+      internal::atom_cell_array.assign(atoms_cell_array.begin(), atoms_cell_array.begin() + num_atoms);
+      internal::atom_moment_array.resize(num_atoms);
+      internal::cell_position_array = cell_position_array;
+
+      internal::material_moment.assign(num_materials, 0.0);
+      internal::cell_moment.assign(internal::cell_spectrum ? num_cells : 0, 0.0);
+
+      for(uint64_t atom = 0; atom < num_atoms; atom++){
+         const int mat = atoms_type_array[atom];
+         const double mm = is_magnetic_material[mat] ? atoms_m_spin_array[atom] : 0.0;
+         internal::atom_moment_array[atom] = mm;
+         internal::material_moment[mat] += mm;
+         if(internal::cell_spectrum) internal::cell_moment[atoms_cell_array[atom]] += mm;
+      }
+
+      #ifdef MPICF
+         MPI_Allreduce(MPI_IN_PLACE, &internal::material_moment[0], num_materials, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+         if(internal::cell_spectrum) MPI_Allreduce(MPI_IN_PLACE, &internal::cell_moment[0], num_cells, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+      #endif
+
+      // q-points and phase factors for dynamic structure factor
+      if(internal::structure_factor){
+         internal::initialize_q_points(atoms_x_coord_array, atoms_y_coord_array, atoms_z_coord_array,
+                                       unit_cell_size_x, unit_cell_size_y, unit_cell_size_z);
+      }
+
+      //-------------------------------------------------------------------------
+      // Allocate transforms (system and all materials are always accumulated
+      // together as they are calculated in the same loop)
+      //-------------------------------------------------------------------------
+      const unsigned int num_frequencies = internal::frequencies.size();
+
+      internal::magnetisation_dft.initialize(3 + 3*num_materials, num_frequencies);
+      if(internal::cell_spectrum) internal::cell_dft.initialize(3*num_cells, num_frequencies);
+      internal::field_dft.initialize(2, num_frequencies);
+      if(internal::structure_factor) internal::structure_factor_dft.initialize(6*internal::q_distance.size(), num_frequencies);
+
+      internal::cos_wt.resize(num_frequencies);
+      internal::sin_wt.resize(num_frequencies);
+
+      internal::enabled = true;
+
+      zlog << zTs() << "Spectrum calculation enabled for " << num_frequencies << " frequencies between "
+           << internal::frequencies.front() << " Hz and " << internal::frequencies.back() << " Hz" << std::endl;
+
+      return;
+
+   }
+
+} // end of spectrum namespace
@@ -0,0 +1,140 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) Richard F L Evans 2022. All rights reserved.
+//
+//   Email: richard.evans@york.ac.uk
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <string>
+
+// Vampire headers
+#include "spectrum.hpp"
+#include "errors.hpp"
+#include "vio.hpp"
+
+// spectrum module headers
+#include "internal.hpp"
+
+namespace spectrum{
+
+   //---------------------------------------------------------------------------
+   // Function to process input file parameters for spectrum module
+   //---------------------------------------------------------------------------
+   bool match_input_parameter(std::string const key, std::string const word, std::string const value, std::string const unit, int const line){
+
+      // Check for valid key, if no match return false
+      std::string prefix="spectrum";
+      if(key!=prefix) return false;
+
+      //-------------------------------------------------------------------
+      std::string test="system-magnetisation";
+      if(word==test){
+         internal::system_spectrum = true;
+         return true;
+      }
+      //-------------------------------------------------------------------
+      test="material-magnetisation";
+      if(word==test){
+         internal::material_spectrum = true;
+         return true;
+      }
+      //-------------------------------------------------------------------
+      test="cell-magnetisation";
+      if(word==test){
+         internal::cell_spectrum = true;
+         return true;
+      }
+      //-------------------------------------------------------------------
+      test="frequencies";
+      if(word==test){
+         std::vector<double> f = vin::doubles_from_string(value);
+         for(unsigned int i = 0; i < f.size(); i++){
+            vin::check_for_valid_value(f[i], word, line, prefix, unit, "frequency", 0.0, 1.0e15,"input","0 - 1 PHz");
+         }
+         internal::frequencies = f;
+         return true;
+      }
+      //-------------------------------------------------------------------
+      test="minimum-frequency";
+      if(word==test){
+         double f=atof(value.c_str());
+         vin::check_for_valid_value(f, word, line, prefix, unit, "frequency", 0.0, 1.0e15,"input","0 - 1 PHz");
+         internal::minimum_frequency = f;
+         return true;
+      }
+      //-------------------------------------------------------------------
+      test="maximum-frequency";
+      if(word==test){
+         double f=atof(value.c_str());
+         vin::check_for_valid_value(f, word, line, prefix, unit, "frequency", 0.0, 1.0e15,"input","0 - 1 PHz");
+         internal::maximum_frequency = f;
+         return true;
+      }
+      //-------------------------------------------------------------------
+      test="frequency-points";
+      if(word==test){
+         int n=atoi(value.c_str());
+         vin::check_for_valid_int(n, word, line, prefix, 1, 100000,"input","1 - 100,000");
+         internal::num_frequency_points = n;
+         return true;
+      }
+      //-------------------------------------------------------------------
+      test="q-point";
+      if(word==test){
+         std::vector<double> q = vin::doubles_from_string(value);
+         if(q.size() != 3){
+            terminaltextcolor(RED);
+            std::cerr << "Error - value for \'spectrum:" << word << "\' on line " << line << " must be three numbers h, k, l" << std::endl;
+            terminaltextcolor(WHITE);
+            zlog << zTs() << "Error - value for \'spectrum:" << word << "\' on line " << line << " must be three numbers h, k, l" << std::endl;
+            err::vexit();
+         }
+         for(int i = 0; i < 3; i++) internal::q_path.push_back(q[i]);
+         internal::structure_factor = true;
+         return true;
+      }
+      //-------------------------------------------------------------------
+      test="q-path-points";
+      if(word==test){
+         int n=atoi(value.c_str());
+         vin::check_for_valid_int(n, word, line, prefix, 1, 10000,"input","1 - 10,000");
+         internal::q_path_points = n;
+         return true;
+      }
+      //-------------------------------------------------------------------
+      test="window";
+      if(word==test){
+         test="rectangular";
+         if(value==test){
+            internal::window = internal::rectangular;
+            return true;
+         }
+         test="hann";
+         if(value==test){
+            internal::window = internal::hann;
+            return true;
+         }
+         terminaltextcolor(RED);
+         std::cerr << "Error - value for \'spectrum:" << word << "\' must be one of:" << std::endl;
+         std::cerr << "\t\"rectangular\"" << std::endl;
+         std::cerr << "\t\"hann\"" << std::endl;
+         terminaltextcolor(WHITE);
+         zlog << zTs() << "Error - value for \'spectrum:" << word << "\' must be one of:" << std::endl;
+         zlog << zTs() << "\t\"rectangular\"" << std::endl;
+         zlog << zTs() << "\t\"hann\"" << std::endl;
+         err::vexit();
+      }
+      //--------------------------------------------------------------------
+      // Keyword not found
+      //--------------------------------------------------------------------
+      return false;
+
+   }
+
+} // end of spectrum namespace
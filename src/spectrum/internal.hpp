@@ -0,0 +1,131 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) Richard F L Evans 2022. All rights reserved.
+//
+//   Email: richard.evans@york.ac.uk
+//
+//------------------------------------------------------------------------------
+//
+
+#ifndef SPECTRUM_INTERNAL_H_
+#define SPECTRUM_INTERNAL_H_
+//
+//---------------------------------------------------------------------
+// This header file defines shared internal data structures and
+// functions for the spectrum module. These functions and
+// variables should not be accessed outside of this module.
+//---------------------------------------------------------------------
+
+// C++ standard library headers
+
+// Vampire headers
+#include "spectrum.hpp"
+
+// spectrum module headers
+#include "internal.hpp"
+
+namespace spectrum{
+
+   namespace internal{
+
+      //-------------------------------------------------------------------------
+      // Internal data type definitions
+      //-------------------------------------------------------------------------
+      enum window_t { rectangular, hann };
+
+      //-------------------------------------------------------------------------
+      // Class to accumulate windowed discrete Fourier transforms of a set of
+      // real signals at a set of frequencies. Transforms are accumulated
+      // locally and are linear in the signals, so partial transforms of
+      // local contributions on each processor are summed once at the end.
+      //-------------------------------------------------------------------------
+      class dft_bank_t{
+
+         public:
+
+            unsigned int num_signals; // number of signals
+            unsigned int num_frequencies; // number of frequencies
+
+            std::vector<double> re; // real part of transforms [frequency][signal]
+            std::vector<double> im; // imaginary part of transforms [frequency][signal]
+            std::vector<double> sum; // time sum of each signal (for removal of mean)
+
+            dft_bank_t(): num_signals(0), num_frequencies(0) {}
+
+            void initialize(const unsigned int signals, const unsigned int frequencies);
+            void add(const std::vector<double>& signal, const std::vector<double>& cos_wt, const std::vector<double>& sin_wt, const double weight);
+            void reduce();
+
+      };
+
+      //-------------------------------------------------------------------------
+      // Internal shared variables
+      //-------------------------------------------------------------------------
+      extern bool enabled; // flag to enable spectra
+      extern bool system_spectrum; // flag to calculate spectrum of system magnetisation
+      extern bool material_spectrum; // flag to calculate spectrum of material magnetisation
+      extern bool cell_spectrum; // flag to calculate spectrum of cell magnetisation
+      extern bool structure_factor; // flag to calculate dynamic structure factor S(q,w)
+
+      extern window_t window; // window function applied to time series
+
+      extern std::vector<double> frequencies; // list of frequencies (Hz)
+      extern double minimum_frequency; // minimum frequency of uniform grid (Hz)
+      extern double maximum_frequency; // maximum frequency of uniform grid (Hz)
+      extern unsigned int num_frequency_points; // number of points in uniform grid
+
+      extern std::vector<double> q_path; // vertices of path in reciprocal space (h,k,l in units of 2pi/a)
+      extern unsigned int q_path_points; // number of q-points per segment of path
+      extern std::vector<double> q_hkl; // list of q-points (h,k,l in units of 2pi/a)
+      extern std::vector<double> q_vectors; // list of q-vectors (1/A)
+      extern std::vector<double> q_distance; // distance of q-points along path (1/A)
+
+      extern int num_materials; // number of materials
+      extern int num_cells; // number of macrocells
+      extern uint64_t num_atoms; // number of local atoms
+
+      extern std::vector<int> atom_type_array; // material types of atoms
+      extern std::vector<int> atom_cell_array; // macrocell of atoms
+      extern std::vector<double> atom_moment_array; // moments of magnetic atoms (zero for non-magnetic atoms, muB)
+      extern std::vector<double> cell_position_array; // positions of cells (x,y,z,m)
+      extern std::vector<double> atom_cos_qr_array; // cos(q.r) of atoms [q-point][atom]
+      extern std::vector<double> atom_sin_qr_array; // sin(q.r) of atoms [q-point][atom]
+
+      extern std::vector<double> material_moment; // total moment of each material (muB)
+      extern std::vector<double> cell_moment; // total moment of each cell (muB)
+
+      extern bool started; // flag to indicate accumulation has started
+      extern uint64_t num_samples; // expected number of samples
+      extern uint64_t sample; // number of samples taken
+      extern double sample_interval; // time between samples (s)
+      extern double weight_sum; // sum of window weights
+      extern double weight_sq_sum; // sum of squared window weights
+
+      extern std::vector<double> cos_wt; // cos(w t) for each frequency at current sample
+      extern std::vector<double> sin_wt; // sin(w t) for each frequency at current sample
+      extern std::vector<double> signal; // current values of all signals
+
+      extern dft_bank_t magnetisation_dft; // transforms of system and material magnetisation
+      extern dft_bank_t cell_dft; // transforms of cell magnetisation
+      extern dft_bank_t field_dft; // transforms of driving field and window function
+      extern dft_bank_t structure_factor_dft; // transforms of spin projections m(q) [q-point][Re mx,my,mz,Im mx,my,mz]
+
+      //-------------------------------------------------------------------------
+      // Internal function declarations
+      //-------------------------------------------------------------------------
+      double window_weight(const uint64_t sample, const uint64_t num_samples);
+      void transform(const dft_bank_t& bank, const unsigned int k, const unsigned int i, const double normalisation, double& re, double& im);
+      void initialize_q_points(const std::vector<double>& x_coord_array, const std::vector<double>& y_coord_array, const std::vector<double>& z_coord_array,
+                               const double a, const double b, const double c);
+      void update_structure_factor(const std::vector<double>& x_spin_array, const std::vector<double>& y_spin_array, const std::vector<double>& z_spin_array,
+                                   const double weight);
+      void output_structure_factor(const double psd_norm);
+
+   } // end of internal namespace
+
+} // end of spectrum namespace
+
+#endif //SPECTRUM_INTERNAL_H_
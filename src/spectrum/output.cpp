@@ -0,0 +1,204 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) Richard F L Evans 2022. All rights reserved.
+//
+//   Email: richard.evans@york.ac.uk
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <fstream>
+#include <iomanip>
+
+// Vampire headers
+#include "spectrum.hpp"
+#include "vio.hpp"
+#include "vmpi.hpp"
+
+// spectrum module headers
+#include "internal.hpp"
+
+namespace spectrum{
+
+   namespace internal{
+
+      //-------------------------------------------------------------------------
+      // Function to calculate transform of a signal with the (weighted) mean
+      // value removed, X'(w) = X(w) - <x> W(w), where W is the transform of
+      // the window. This removes leakage of the static magnetisation into
+      // low frequencies.
+      //-------------------------------------------------------------------------
+      void transform(const dft_bank_t& bank, const unsigned int k, const unsigned int i, const double normalisation, double& re, double& im){
+
+         const double mean = weight_sum > 0.0 ? bank.sum[i]/weight_sum : 0.0;
+
+         re = (bank.re[k*bank.num_signals + i] - mean*field_dft.re[k*2 + 1])*normalisation;
+         im = (bank.im[k*bank.num_signals + i] - mean*field_dft.im[k*2 + 1])*normalisation;
+
+         return;
+
+      }
+
+   } // end of internal namespace
+
+   //----------------------------------------------------------------------------
+   // Function to write spectra to disk. The power spectral density of each
+   // component of the reduced magnetisation m = M/Ms is given by
+   //
+   //    S(f) = |X(f)|^2 dt / sum(w^2)
+   //
+   // where X(f) is the windowed transform with the mean value removed. When a
+   // driving field h(t) is applied the dynamic susceptibility is given by
+   // chi(f) = X_m(f) / X_h(f) (1/T).
+   //----------------------------------------------------------------------------
+   void output(){
+
+      if(!internal::enabled || !internal::started || internal::sample == 0) return;
+
+      // sum partial transforms on all processors
+      internal::magnetisation_dft.reduce();
+      if(internal::cell_spectrum) internal::cell_dft.reduce();
+      internal::field_dft.reduce();
+      if(internal::structure_factor) internal::structure_factor_dft.reduce();
+
+      if(vmpi::my_rank != 0) return;
+
+      const double psd_norm = internal::weight_sq_sum > 0.0 ? internal::sample_interval/internal::weight_sq_sum : 0.0;
+      const unsigned int num_frequencies = internal::frequencies.size();
+
+      // determine if a driving field is present
+      bool driven = false;
+      for(unsigned int k = 0; k < num_frequencies; k++){
+         double hre, him;
+         internal::transform(internal::field_dft, k, 0, 1.0, hre, him);
+         if(hre*hre + him*him > 0.0) driven = true;
+      }
+
+      //-------------------------------------------------------------------------
+      // System and material spectra
+      //-------------------------------------------------------------------------
+      if(internal::system_spectrum || internal::material_spectrum){
+
+         // list of signal groups (0 = system, 1+ = materials) and their moments
+         std::vector<int> groups;
+         std::vector<double> moments;
+         double total_moment = 0.0;
+         for(int mat = 0; mat < internal::num_materials; mat++) total_moment += internal::material_moment[mat];
+         if(internal::system_spectrum){
+            groups.push_back(0);
+            moments.push_back(total_moment);
+         }
+         if(internal::material_spectrum){
+            for(int mat = 0; mat < internal::num_materials; mat++){
+               groups.push_back(mat + 1);
+               moments.push_back(internal::material_moment[mat]);
+            }
+         }
+
+         std::ofstream ofile("spectrum.txt");
+
+         ofile << "# Power spectral density S (1/Hz) of reduced magnetisation";
+         if(driven) ofile << " and dynamic susceptibility chi (1/T)";
+         ofile << "\n# frequency(Hz)";
+         const char* component[3] = { "x", "y", "z" };
+         for(unsigned int g = 0; g < groups.size(); g++){
+            const std::string name = groups[g] == 0 ? "system" : "material" + std::to_string(groups[g] - 1);
+            for(int c = 0; c < 3; c++) ofile << " " << name << "_S_m" << component[c];
+            if(driven) for(int c = 0; c < 3; c++) ofile << " " << name << "_Re_chi_" << component[c] << " " << name << "_Im_chi_" << component[c];
+         }
+         ofile << "\n";
+
+         ofile << std::setprecision(10);
+         for(unsigned int k = 0; k < num_frequencies; k++){
+
+            double hre = 0.0, him = 0.0;
+            internal::transform(internal::field_dft, k, 0, 1.0, hre, him);
+            const double h2 = hre*hre + him*him;
+
+            ofile << internal::frequencies[k];
+
+            for(unsigned int g = 0; g < groups.size(); g++){
+
+               const double norm = moments[g] > 0.0 ? 1.0/moments[g] : 0.0;
+               double mre[3], mim[3];
+               for(int c = 0; c < 3; c++){
+                  internal::transform(internal::magnetisation_dft, k, 3*groups[g] + c, norm, mre[c], mim[c]);
+                  ofile << "\t" << (mre[c]*mre[c] + mim[c]*mim[c])*psd_norm;
+               }
+
+               // chi = X_m / X_h
+               if(driven){
+                  for(int c = 0; c < 3; c++){
+                     const double chi_re = h2 > 0.0 ? (mre[c]*hre + mim[c]*him)/h2 : 0.0;
+                     const double chi_im = h2 > 0.0 ? (mim[c]*hre - mre[c]*him)/h2 : 0.0;
+                     ofile << "\t" << chi_re << "\t" << chi_im;
+                  }
+               }
+
+            }
+
+            ofile << "\n";
+
+         }
+
+         ofile.close();
+
+         zlog << zTs() << "Spectra of system and material magnetisation written to file spectrum.txt" << std::endl;
+
+      }
+
+      //-------------------------------------------------------------------------
+      // Cell spectra, written as blocks of cells for each frequency
+      //-------------------------------------------------------------------------
+      if(internal::cell_spectrum){
+
+         std::ofstream ofile("cell-spectrum.txt");
+
+         ofile << "# Power spectral density S (1/Hz) of reduced cell magnetisation\n";
+         ofile << "# frequency(Hz) cell x(A) y(A) z(A) S_mx S_my S_mz\n";
+
+         ofile << std::setprecision(10);
+         for(unsigned int k = 0; k < num_frequencies; k++){
+            for(int cell = 0; cell < internal::num_cells; cell++){
+
+               if(internal::cell_moment[cell] <= 0.0) continue;
+
+               const double norm = 1.0/internal::cell_moment[cell];
+
+               ofile << internal::frequencies[k] << "\t" << cell;
+               if(internal::cell_position_array.size() >= 4*unsigned(internal::num_cells)){
+                  ofile << "\t" << internal::cell_position_array[4*cell + 0]
+                        << "\t" << internal::cell_position_array[4*cell + 1]
+                        << "\t" << internal::cell_position_array[4*cell + 2];
+               }
+               for(int c = 0; c < 3; c++){
+                  double re, im;
+                  internal::transform(internal::cell_dft, k, 3*cell + c, norm, re, im);
+                  ofile << "\t" << (re*re + im*im)*psd_norm;
+               }
+               ofile << "\n";
+
+            }
+            ofile << "\n";
+         }
+
+         ofile.close();
+
+         zlog << zTs() << "Spectra of cell magnetisation written to file cell-spectrum.txt" << std::endl;
+
+      }
+
+      //-------------------------------------------------------------------------
+      // Dynamic structure factor
+      //-------------------------------------------------------------------------
+      if(internal::structure_factor) internal::output_structure_factor(psd_norm);
+
+      return;
+
+   }
+
+} // end of spectrum namespace
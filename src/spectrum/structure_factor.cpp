@@ -0,0 +1,205 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) Richard F L Evans 2022. All rights reserved.
+//
+//   Email: richard.evans@york.ac.uk
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+
+// Vampire headers
+#include "spectrum.hpp"
+#include "vio.hpp"
+
+// spectrum module headers
+#include "internal.hpp"
+
+namespace spectrum{
+
+   namespace internal{
+
+      //-------------------------------------------------------------------------
+      // Function to generate list of q-points along path and precompute
+      // moment weighted phase factors mu_i exp(-i q.r_i) for all local atoms
+      //-------------------------------------------------------------------------
+      void initialize_q_points(const std::vector<double>& x_coord_array, // x-coordinates of atoms (A)
+                               const std::vector<double>& y_coord_array, // y-coordinates of atoms (A)
+                               const std::vector<double>& z_coord_array, // z-coordinates of atoms (A)
+                               const double a, // unit cell size in x (A)
+                               const double b, // unit cell size in y (A)
+                               const double c){ // unit cell size in z (A)
+
+         //----------------------------------------------------------------------
+         // Interpolate path between vertices (h,k,l), including end points
+         //----------------------------------------------------------------------
+         const unsigned int num_vertices = q_path.size()/3;
+
+         q_hkl.resize(0);
+         for(unsigned int v = 0; v + 1 < num_vertices; v++){
+            for(unsigned int p = 0; p < q_path_points; p++){
+               const double f = double(p)/double(q_path_points);
+               for(int i = 0; i < 3; i++) q_hkl.push_back(q_path[3*v + i] + f*(q_path[3*(v + 1) + i] - q_path[3*v + i]));
+            }
+         }
+         for(int i = 0; i < 3; i++) q_hkl.push_back(q_path[3*(num_vertices - 1) + i]);
+
+         // convert to q-vectors in 1/A and calculate distance along path
+         const unsigned int num_q = q_hkl.size()/3;
+         const double two_pi = 2.0*M_PI;
+
+         q_vectors.resize(3*num_q);
+         q_distance.resize(num_q);
+         for(unsigned int q = 0; q < num_q; q++){
+            q_vectors[3*q + 0] = two_pi*q_hkl[3*q + 0]/a;
+            q_vectors[3*q + 1] = two_pi*q_hkl[3*q + 1]/b;
+            q_vectors[3*q + 2] = two_pi*q_hkl[3*q + 2]/c;
+            if(q == 0) q_distance[q] = 0.0;
+            else{
+               const double dqx = q_vectors[3*q + 0] - q_vectors[3*q - 3];
+               const double dqy = q_vectors[3*q + 1] - q_vectors[3*q - 2];
+               const double dqz = q_vectors[3*q + 2] - q_vectors[3*q - 1];
+               q_distance[q] = q_distance[q - 1] + sqrt(dqx*dqx + dqy*dqy + dqz*dqz);
+            }
+         }
+
+         //----------------------------------------------------------------------
+         // Precompute phase factors, weighted by atomic moments so that
+         // non-magnetic atoms do not contribute
+         //----------------------------------------------------------------------
+         atom_cos_qr_array.resize(uint64_t(num_q)*num_atoms);
+         atom_sin_qr_array.resize(uint64_t(num_q)*num_atoms);
+
+         for(unsigned int q = 0; q < num_q; q++){
+            const double qx = q_vectors[3*q + 0];
+            const double qy = q_vectors[3*q + 1];
+            const double qz = q_vectors[3*q + 2];
+            double* const cos_qr = &atom_cos_qr_array[uint64_t(q)*num_atoms];
+            double* const sin_qr = &atom_sin_qr_array[uint64_t(q)*num_atoms];
+            for(uint64_t atom = 0; atom < num_atoms; atom++){
+               const double qr = qx*x_coord_array[atom] + qy*y_coord_array[atom] + qz*z_coord_array[atom];
+               const double mm = atom_moment_array[atom];
+               cos_qr[atom] = mm*cos(qr);
+               sin_qr[atom] = mm*sin(qr);
+            }
+         }
+
+         zlog << zTs() << "Dynamic structure factor enabled for " << num_q << " q-points along a path of " << num_vertices
+              << " vertices, using " << 2.0*8.0*double(num_q)*double(num_atoms)/1.0e6 << " MB for phase factors" << std::endl;
+
+         return;
+
+      }
+
+      //-------------------------------------------------------------------------
+      // Function to add spin projections m(q) = sum_i mu_i S_i exp(-i q.r_i) of
+      // local atoms to transforms. Each q-point is independent, and so q-points
+      // are distributed between threads.
+      //-------------------------------------------------------------------------
+      void update_structure_factor(const std::vector<double>& x_spin_array, // x-spin vector of atoms
+                                   const std::vector<double>& y_spin_array, // y-spin vector of atoms
+                                   const std::vector<double>& z_spin_array, // z-spin vector of atoms
+                                   const double weight){ // window weight for this sample
+
+         const int num_q = q_vectors.size()/3;
+
+         signal.resize(6*num_q);
+
+         #pragma omp parallel for schedule(static)
+         for(int q = 0; q < num_q; q++){
+
+            const double* const cos_qr = &atom_cos_qr_array[uint64_t(q)*num_atoms];
+            const double* const sin_qr = &atom_sin_qr_array[uint64_t(q)*num_atoms];
+
+            double re_x = 0.0, re_y = 0.0, re_z = 0.0;
+            double im_x = 0.0, im_y = 0.0, im_z = 0.0;
+
+            for(uint64_t atom = 0; atom < num_atoms; atom++){
+               const double sx = x_spin_array[atom];
+               const double sy = y_spin_array[atom];
+               const double sz = z_spin_array[atom];
+               re_x += sx*cos_qr[atom];
+               re_y += sy*cos_qr[atom];
+               re_z += sz*cos_qr[atom];
+               im_x -= sx*sin_qr[atom];
+               im_y -= sy*sin_qr[atom];
+               im_z -= sz*sin_qr[atom];
+            }
+
+            signal[6*q + 0] = re_x;
+            signal[6*q + 1] = re_y;
+            signal[6*q + 2] = re_z;
+            signal[6*q + 3] = im_x;
+            signal[6*q + 4] = im_y;
+            signal[6*q + 5] = im_z;
+
+         }
+
+         structure_factor_dft.add(signal, cos_wt, sin_wt, weight);
+
+         return;
+
+      }
+
+      //-------------------------------------------------------------------------
+      // Function to write dynamic structure factor to disk. The real and
+      // imaginary parts of m(q,t) are transformed separately, so that
+      //
+      //    m(q,w) = X_re(w) + i X_im(w)
+      //
+      // and S_aa(q,w) = |m_a(q,w)|^2 dt / sum(w^2) / M^2, where M is the total
+      // moment of the system.
+      //-------------------------------------------------------------------------
+      void output_structure_factor(const double psd_norm){
+
+         double total_moment = 0.0;
+         for(int mat = 0; mat < num_materials; mat++) total_moment += material_moment[mat];
+         const double norm = total_moment > 0.0 ? 1.0/total_moment : 0.0;
+
+         const unsigned int num_q = q_vectors.size()/3;
+         const unsigned int num_frequencies = frequencies.size();
+
+         std::ofstream ofile("structure-factor.txt");
+
+         ofile << "# Dynamic structure factor S(q,f) (1/Hz) of reduced magnetisation, written as a block of frequencies for each q-point\n";
+         ofile << "# q-point h k l distance(1/A) frequency(Hz) S_xx S_yy S_zz\n";
+
+         ofile << std::setprecision(10);
+         for(unsigned int q = 0; q < num_q; q++){
+            for(unsigned int k = 0; k < num_frequencies; k++){
+
+               ofile << q << "\t" << q_hkl[3*q + 0] << "\t" << q_hkl[3*q + 1] << "\t" << q_hkl[3*q + 2] << "\t"
+                     << q_distance[q] << "\t" << frequencies[k];
+
+               for(int c = 0; c < 3; c++){
+                  double re_re, re_im, im_re, im_im;
+                  transform(structure_factor_dft, k, 6*q + c,     norm, re_re, re_im);
+                  transform(structure_factor_dft, k, 6*q + 3 + c, norm, im_re, im_im);
+                  const double mre = re_re - im_im;
+                  const double mim = re_im + im_re;
+                  ofile << "\t" << (mre*mre + mim*mim)*psd_norm;
+               }
+               ofile << "\n";
+
+            }
+            ofile << "\n";
+         }
+
+         ofile.close();
+
+         zlog << zTs() << "Dynamic structure factor written to file structure-factor.txt" << std::endl;
+
+         return;
+
+      }
+
+   } // end of internal namespace
+
+} // end of spectrum namespace
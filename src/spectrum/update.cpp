@@ -0,0 +1,220 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) Richard F L Evans 2022. All rights reserved.
+//
+//   Email: richard.evans@york.ac.uk
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <cmath>
+
+// Vampire headers
+#include "spectrum.hpp"
+#include "vio.hpp"
+#include "vmpi.hpp"
+
+// spectrum module headers
+#include "internal.hpp"
+
+namespace spectrum{
+
+   //----------------------------------------------------------------------------
+   // Function to start accumulation of spectra for a time series
+   //----------------------------------------------------------------------------
+   void start(const uint64_t num_samples, const double sample_interval){
+
+      if(!internal::enabled) return;
+
+      internal::num_samples = num_samples;
+      internal::sample_interval = sample_interval;
+      internal::sample = 0;
+      internal::weight_sum = 0.0;
+      internal::weight_sq_sum = 0.0;
+
+      const unsigned int num_frequencies = internal::frequencies.size();
+      internal::magnetisation_dft.initialize(internal::magnetisation_dft.num_signals, num_frequencies);
+      internal::cell_dft.initialize(internal::cell_dft.num_signals, num_frequencies);
+      internal::field_dft.initialize(internal::field_dft.num_signals, num_frequencies);
+      internal::structure_factor_dft.initialize(internal::structure_factor_dft.num_signals, num_frequencies);
+
+      internal::started = true;
+
+      // check for frequencies above Nyquist frequency
+      const double nyquist_frequency = 0.5/sample_interval;
+      if(internal::frequencies.back() > nyquist_frequency){
+         zlog << zTs() << "Warning - spectrum frequencies above the Nyquist frequency of " << nyquist_frequency
+              << " Hz are aliased. Reduce sim:time-steps-increment to sample more frequently." << std::endl;
+      }
+
+      zlog << zTs() << "Starting spectrum accumulation for " << num_samples << " samples at intervals of " << sample_interval << " s" << std::endl;
+
+      return;
+
+   }
+
+   //----------------------------------------------------------------------------
+   // Function to add current magnetisation to spectra
+   //----------------------------------------------------------------------------
+   void update(const std::vector<double>& atoms_x_spin_array, // x-spin vector of atoms
+               const std::vector<double>& atoms_y_spin_array, // y-spin vector of atoms
+               const std::vector<double>& atoms_z_spin_array, // z-spin-vector of atoms
+               const double driving_field){ // instantaneous driving field strength (T)
+
+      if(!internal::enabled || !internal::started) return;
+
+      // window weight and phase factors for this sample
+      const double weight = internal::window_weight(internal::sample, internal::num_samples);
+      const double time = double(internal::sample)*internal::sample_interval;
+
+      const unsigned int num_frequencies = internal::frequencies.size();
+      for(unsigned int k = 0; k < num_frequencies; k++){
+         const double phase = 2.0*M_PI*internal::frequencies[k]*time;
+         internal::cos_wt[k] = cos(phase);
+         internal::sin_wt[k] = sin(phase);
+      }
+
+      //-------------------------------------------------------------------------
+      // System and material moments on this processor
+      //-------------------------------------------------------------------------
+      std::vector<double>& signal = internal::signal;
+      signal.assign(internal::magnetisation_dft.num_signals, 0.0);
+
+      for(uint64_t atom = 0; atom < internal::num_atoms; atom++){
+         const double mm = internal::atom_moment_array[atom];
+         const int index = 3 + 3*internal::atom_type_array[atom];
+         signal[index + 0] += atoms_x_spin_array[atom]*mm;
+         signal[index + 1] += atoms_y_spin_array[atom]*mm;
+         signal[index + 2] += atoms_z_spin_array[atom]*mm;
+      }
+
+      // system moment is the sum of material moments
+      for(int mat = 0; mat < internal::num_materials; mat++){
+         signal[0] += signal[3 + 3*mat + 0];
+         signal[1] += signal[3 + 3*mat + 1];
+         signal[2] += signal[3 + 3*mat + 2];
+      }
+
+      internal::magnetisation_dft.add(signal, internal::cos_wt, internal::sin_wt, weight);
+
+      //-------------------------------------------------------------------------
+      // Cell moments on this processor
+      //-------------------------------------------------------------------------
+      if(internal::cell_spectrum){
+
+         signal.assign(internal::cell_dft.num_signals, 0.0);
+
+         for(uint64_t atom = 0; atom < internal::num_atoms; atom++){
+            const double mm = internal::atom_moment_array[atom];
+            const int index = 3*internal::atom_cell_array[atom];
+            signal[index + 0] += atoms_x_spin_array[atom]*mm;
+            signal[index + 1] += atoms_y_spin_array[atom]*mm;
+            signal[index + 2] += atoms_z_spin_array[atom]*mm;
+         }
+
+         internal::cell_dft.add(signal, internal::cos_wt, internal::sin_wt, weight);
+
+      }
+
+      //-------------------------------------------------------------------------
+      // Projections of spins onto q-points on this processor
+      //-------------------------------------------------------------------------
+      if(internal::structure_factor){
+         internal::update_structure_factor(atoms_x_spin_array, atoms_y_spin_array, atoms_z_spin_array, weight);
+      }
+
+      //-------------------------------------------------------------------------
+      // Driving field is the same on all processors, so is only added on root,
+      // together with the transform of the window for removal of mean values
+      //-------------------------------------------------------------------------
+      if(vmpi::my_rank == 0){
+         signal.assign(2, 1.0);
+         signal[0] = driving_field;
+         internal::field_dft.add(signal, internal::cos_wt, internal::sin_wt, weight);
+      }
+
+      internal::weight_sum += weight;
+      internal::weight_sq_sum += weight*weight;
+      internal::sample++;
+
+      return;
+
+   }
+
+   namespace internal{
+
+      //-------------------------------------------------------------------------
+      // Function to calculate window weight for a sample
+      //-------------------------------------------------------------------------
+      double window_weight(const uint64_t sample, const uint64_t num_samples){
+
+         if(window == rectangular || num_samples < 2) return 1.0;
+
+         // samples beyond the expected length are not weighted
+         if(sample >= num_samples) return 0.0;
+
+         return 0.5*(1.0 - cos(2.0*M_PI*double(sample)/double(num_samples - 1)));
+
+      }
+
+      //-------------------------------------------------------------------------
+      // Function to allocate and zero transforms
+      //-------------------------------------------------------------------------
+      void dft_bank_t::initialize(const unsigned int signals, const unsigned int frequencies){
+
+         num_signals = signals;
+         num_frequencies = frequencies;
+
+         re.assign(num_signals*num_frequencies, 0.0);
+         im.assign(num_signals*num_frequencies, 0.0);
+         sum.assign(num_signals, 0.0);
+
+         return;
+
+      }
+
+      //-------------------------------------------------------------------------
+      // Function to add weighted signals to transforms, X(w) += w x exp(-iwt)
+      //-------------------------------------------------------------------------
+      void dft_bank_t::add(const std::vector<double>& signal, const std::vector<double>& cos_wt, const std::vector<double>& sin_wt, const double weight){
+
+         for(unsigned int i = 0; i < num_signals; i++) sum[i] += weight*signal[i];
+
+         for(unsigned int k = 0; k < num_frequencies; k++){
+            const double c = weight*cos_wt[k];
+            const double s = weight*sin_wt[k];
+            double* const rek = &re[k*num_signals];
+            double* const imk = &im[k*num_signals];
+            for(unsigned int i = 0; i < num_signals; i++){
+               rek[i] += c*signal[i];
+               imk[i] -= s*signal[i];
+            }
+         }
+
+         return;
+
+      }
+
+      //-------------------------------------------------------------------------
+      // Function to sum partial transforms on all processors
+      //-------------------------------------------------------------------------
+      void dft_bank_t::reduce(){
+
+         #ifdef MPICF
+            if(num_signals == 0) return;
+            MPI_Allreduce(MPI_IN_PLACE, &re[0], re.size(), MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+            MPI_Allreduce(MPI_IN_PLACE, &im[0], im.size(), MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+            MPI_Allreduce(MPI_IN_PLACE, &sum[0], sum.size(), MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+         #endif
+
+         return;
+
+      }
+
+   } // end of internal namespace
+
+} // end of spectrum namespace
@@ -55,6 +55,14 @@ namespace st{
       std::vector<double> initial_m(3);
 
       std::vector<int> stack_index; // start of stack in microcell arrays
+      std::vector<int> local_stacks; // stacks calculated on this processor
+      std::vector<bool> local_stack; // flag to show that stack is calculated on this processor
+
+      // lists of cells for exchange of spin torque between processors
+      std::vector<int> send_cells; // local cells needed by other processors (ordered by processor)
+      std::vector<int> send_counts; // number of cells to send to each processor
+      std::vector<int> recv_cells; // cells calculated on other processors needed by local atoms
+      std::vector<int> recv_counts; // number of cells to receive from each processor
 
       std::vector<double> beta_cond; /// spin polarisation (conductivity) Beta B
       std::vector<double> beta_diff; /// spin polarisation (diffusion) Beta' Bp
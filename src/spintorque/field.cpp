@@ -73,4 +73,11 @@ namespace st{
       return;
    }
 
+   //-----------------------------------------------------------------------------
+   // Function to check if spin torque calculation is enabled
+   //-----------------------------------------------------------------------------
+   bool is_enabled(){
+      return st::internal::enabled;
+   }
+
 } // end of st namespace
@@ -226,6 +226,11 @@ void initialise(const double system_dimensions_x,
    st::internal::y_field_array.resize(num_local_atoms);
    st::internal::z_field_array.resize(num_local_atoms);
 
+   //-------------------------------------------------------
+   // Distribute stacks between processors
+   //-------------------------------------------------------
+   st::internal::set_stack_ownership();
+
    // optionally output base microcell data
    st::internal::output_base_microcell_data();
 
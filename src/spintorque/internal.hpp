@@ -53,6 +53,14 @@ namespace st{
 
 
       extern std::vector<int> stack_index; // start of stack in microcell arrays
+      extern std::vector<int> local_stacks; // stacks calculated on this processor
+      extern std::vector<bool> local_stack; // flag to show that stack is calculated on this processor
+
+      // lists of cells for exchange of spin torque between processors
+      extern std::vector<int> send_cells; // local cells needed by other processors (ordered by processor)
+      extern std::vector<int> send_counts; // number of cells to send to each processor
+      extern std::vector<int> recv_cells; // cells calculated on other processors needed by local atoms
+      extern std::vector<int> recv_counts; // number of cells to receive from each processor
 
       extern std::vector<double> beta_cond; /// spin polarisation (conductivity)
       extern std::vector<double> beta_diff; /// spin polarisation (diffusion)
@@ -140,9 +148,15 @@ namespace st{
                                      const std::vector<int>& atom_type_array,
                                      const std::vector<double>& mu_s_array);
 
-      void set_inverse_transformation_matrix(const st::internal::three_vector_t& reference_vector, st::internal::matrix_t& itm);
-      st::internal::three_vector_t transform_vector(const st::internal::three_vector_t& rv, const st::internal::matrix_t& tm);
-      st::internal::three_vector_t gaussian_elimination(st::internal::matrix_t& M, st::internal::three_vector_t& V);
+      void calculate_stack_spin_accumulation(const int stack, const double je);
+      void set_stack_ownership();
+      void exchange_spin_torque();
+      void gather_microcell_data();
+
+      void set_local_basis(const st::internal::three_vector_t& m,
+                           st::internal::three_vector_t& b1,
+                           st::internal::three_vector_t& b2,
+                           st::internal::three_vector_t& b3);
 
 
    } // end of iternal namespace
@@ -74,6 +74,9 @@ namespace st{
 
          const int num_cells = m.size()/3;
 
+         // collect data of stacks calculated on other processors
+         if(sim::time%(ST_output_rate) ==0) st::internal::gather_microcell_data();
+
          // only output on root process
          if(vmpi::my_rank==0){
 
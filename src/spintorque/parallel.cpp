@@ -0,0 +1,210 @@
+//-----------------------------------------------------------------------------
+//
+// This source file is part of the VAMPIRE open source package under the
+// GNU GPL (version 2) licence (see licence file for details).
+//
+// (c) R F L Evans 2022. All rights reserved.
+//
+//-----------------------------------------------------------------------------
+
+// C++ standard library headers
+#include <algorithm>
+
+// Vampire headers
+#include "spintorque.hpp"
+#include "vio.hpp"
+#include "vmpi.hpp"
+
+// Spin Torque headers
+#include "internal.hpp"
+
+namespace st{
+   namespace internal{
+
+      //-----------------------------------------------------------------------------
+      // Function to distribute stacks between processors. Stacks are independent,
+      // so each stack is calculated only on the processor which has most of its
+      // atoms, and lists of the cells needed by the atoms on other processors are
+      // determined so that only these spin torques are exchanged.
+      //-----------------------------------------------------------------------------
+      void set_stack_ownership(){
+
+         st::internal::local_stack.assign(st::internal::num_stacks, true);
+         st::internal::send_cells.clear();
+         st::internal::recv_cells.clear();
+         st::internal::send_counts.assign(vmpi::num_processors, 0);
+         st::internal::recv_counts.assign(vmpi::num_processors, 0);
+
+         #ifdef MPICF
+
+            // stacks are stored contiguously, stack = cell / num_microcells_per_stack
+            const int ncz = st::internal::num_microcells_per_stack;
+
+            //----------------------------------------------------------
+            // Determine processor with most atoms in each stack
+            //----------------------------------------------------------
+            std::vector<int> stack_owner(2*st::internal::num_stacks, 0); // (number of atoms, rank) pairs
+            for(int stack = 0; stack < st::internal::num_stacks; ++stack) stack_owner[2*stack+1] = vmpi::my_rank;
+            for(int atom = 0; atom < st::internal::num_local_atoms; ++atom) stack_owner[2*(st::internal::atom_st_index[atom]/ncz)]++;
+
+            MPI_Allreduce(MPI_IN_PLACE, &stack_owner[0], st::internal::num_stacks, MPI_2INT, MPI_MAXLOC, MPI_COMM_WORLD);
+
+            // empty stacks are shared evenly between processors
+            for(int stack = 0; stack < st::internal::num_stacks; ++stack){
+               const int owner = stack_owner[2*stack] > 0 ? stack_owner[2*stack+1] : stack % vmpi::num_processors;
+               stack_owner[2*stack+1] = owner;
+               st::internal::local_stack[stack] = (owner == vmpi::my_rank);
+            }
+
+            //----------------------------------------------------------
+            // Determine cells on other processors needed by local atoms
+            //----------------------------------------------------------
+            const int num_cells = st::internal::num_stacks*ncz;
+            std::vector<bool> needed(num_cells, false);
+            for(int atom = 0; atom < st::internal::num_local_atoms; ++atom){
+               const int cell = st::internal::atom_st_index[atom];
+               if(!st::internal::local_stack[cell/ncz]) needed[cell] = true;
+            }
+
+            std::vector<std::vector<int> > recv_lists(vmpi::num_processors);
+            for(int cell = 0; cell < num_cells; ++cell){
+               if(needed[cell]) recv_lists[stack_owner[2*(cell/ncz)+1]].push_back(cell);
+            }
+            for(int p = 0; p < vmpi::num_processors; ++p){
+               st::internal::recv_counts[p] = recv_lists[p].size();
+               st::internal::recv_cells.insert(st::internal::recv_cells.end(), recv_lists[p].begin(), recv_lists[p].end());
+            }
+
+            //----------------------------------------------------------
+            // Send lists of needed cells to processors calculating them
+            //----------------------------------------------------------
+            MPI_Alltoall(&st::internal::recv_counts[0], 1, MPI_INT, &st::internal::send_counts[0], 1, MPI_INT, MPI_COMM_WORLD);
+
+            std::vector<int> send_displacements(vmpi::num_processors, 0);
+            std::vector<int> recv_displacements(vmpi::num_processors, 0);
+            for(int p = 1; p < vmpi::num_processors; ++p){
+               send_displacements[p] = send_displacements[p-1] + st::internal::send_counts[p-1];
+               recv_displacements[p] = recv_displacements[p-1] + st::internal::recv_counts[p-1];
+            }
+            const int num_send_cells = send_displacements.back() + st::internal::send_counts.back();
+            st::internal::send_cells.resize(num_send_cells);
+
+            MPI_Alltoallv(&st::internal::recv_cells[0], &st::internal::recv_counts[0], &recv_displacements[0], MPI_INT,
+                          &st::internal::send_cells[0], &st::internal::send_counts[0], &send_displacements[0], MPI_INT, MPI_COMM_WORLD);
+
+         #endif
+
+         st::internal::local_stacks.clear();
+         for(int stack = 0; stack < st::internal::num_stacks; ++stack){
+            if(st::internal::local_stack[stack]) st::internal::local_stacks.push_back(stack);
+         }
+
+         zlog << zTs() << "Spin accumulation calculated for " << st::internal::local_stacks.size() << " of " << st::internal::num_stacks
+              << " stacks on this processor, exchanging spin torque of " << st::internal::send_cells.size() << " sent and "
+              << st::internal::recv_cells.size() << " received cells" << std::endl;
+
+         return;
+
+      }
+
+      //-----------------------------------------------------------------------------
+      // Function to send spin torques of local cells to processors whose atoms
+      // are in the cell
+      //-----------------------------------------------------------------------------
+      void exchange_spin_torque(){
+
+         #ifdef MPICF
+
+            if(vmpi::num_processors == 1) return;
+
+            const int num_send = st::internal::send_cells.size();
+            const int num_recv = st::internal::recv_cells.size();
+
+            std::vector<double> send_buffer(3*num_send);
+            std::vector<double> recv_buffer(3*num_recv);
+
+            for(int i = 0; i < num_send; ++i){
+               const int cell = st::internal::send_cells[i];
+               send_buffer[3*i+0] = st::internal::spin_torque[3*cell+0];
+               send_buffer[3*i+1] = st::internal::spin_torque[3*cell+1];
+               send_buffer[3*i+2] = st::internal::spin_torque[3*cell+2];
+            }
+
+            // three components per cell
+            std::vector<int> send_counts(vmpi::num_processors);
+            std::vector<int> recv_counts(vmpi::num_processors);
+            std::vector<int> send_displacements(vmpi::num_processors, 0);
+            std::vector<int> recv_displacements(vmpi::num_processors, 0);
+            for(int p = 0; p < vmpi::num_processors; ++p){
+               send_counts[p] = 3*st::internal::send_counts[p];
+               recv_counts[p] = 3*st::internal::recv_counts[p];
+               if(p > 0){
+                  send_displacements[p] = send_displacements[p-1] + send_counts[p-1];
+                  recv_displacements[p] = recv_displacements[p-1] + recv_counts[p-1];
+               }
+            }
+
+            MPI_Alltoallv(&send_buffer[0], &send_counts[0], &send_displacements[0], MPI_DOUBLE,
+                          &recv_buffer[0], &recv_counts[0], &recv_displacements[0], MPI_DOUBLE, MPI_COMM_WORLD);
+
+            for(int i = 0; i < num_recv; ++i){
+               const int cell = st::internal::recv_cells[i];
+               st::internal::spin_torque[3*cell+0] = recv_buffer[3*i+0];
+               st::internal::spin_torque[3*cell+1] = recv_buffer[3*i+1];
+               st::internal::spin_torque[3*cell+2] = recv_buffer[3*i+2];
+            }
+
+         #endif
+
+         return;
+
+      }
+
+      #ifdef MPICF
+      //-----------------------------------------------------------------------------
+      // Function to sum array of microcell data on root process, where cells of
+      // stacks calculated on other processors are set to zero
+      //-----------------------------------------------------------------------------
+      void reduce_microcell_array(std::vector<double>& array){
+
+         const int ncz = st::internal::num_microcells_per_stack;
+         const int size = array.size()/(st::internal::num_stacks*ncz); // number of components
+
+         for(int stack = 0; stack < st::internal::num_stacks; ++stack){
+            if(st::internal::local_stack[stack]) continue;
+            std::fill(array.begin() + size*stack*ncz, array.begin() + size*(stack+1)*ncz, 0.0);
+         }
+
+         if(vmpi::my_rank == 0) MPI_Reduce(MPI_IN_PLACE, &array[0], array.size(), MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+         else MPI_Reduce(&array[0], NULL, array.size(), MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+
+         return;
+
+      }
+      #endif
+
+      //-----------------------------------------------------------------------------
+      // Function to collect microcell data of all stacks on root process for output
+      //-----------------------------------------------------------------------------
+      void gather_microcell_data(){
+
+         #ifdef MPICF
+
+            if(vmpi::num_processors == 1) return;
+
+            reduce_microcell_array(st::internal::sa);
+            reduce_microcell_array(st::internal::j);
+            reduce_microcell_array(st::internal::coeff_ast);
+            reduce_microcell_array(st::internal::coeff_nast);
+            reduce_microcell_array(st::internal::ast);
+            reduce_microcell_array(st::internal::nast);
+            reduce_microcell_array(st::internal::total_ST);
+
+         #endif
+
+         return;
+
+      }
+
+   } // end of internal namespace
+} // end of st namespace
@@ -60,6 +60,20 @@ namespace spin_transport{
       unsigned int first_stack = 0; // first stack on local processor
       unsigned int last_stack = 0;  // last stack on local processor
 
+      // Compressed list of magnetic cells (links) in each stack along the current direction
+      std::vector <unsigned int> stack_link_start_index; // start of stack in 1D list of links (num_stacks+1)
+      std::vector <unsigned int> link_cell;              // magnetic cell at end of link
+      std::vector <unsigned int> link_previous_cell;     // previous magnetic cell (or first cell) in stack
+      std::vector <double> link_spin_resistance;         // spin resistance between previous cell and cell
+      std::vector <double> link_resistance;              // magnetoresistance of link 0.5 Rsp (1 - mi.mj)
+      std::vector <double> link_field;                   // 3N spin torque field of link cells (without current factor)
+      std::vector <double> stack_base_resistance;        // spin-independent resistance of each stack
+      std::vector <double> stack_spin_resistance;        // sum of link magnetoresistances in each stack
+      std::vector <unsigned int> stack_num_incremental_updates; // incremental updates of stack_spin_resistance since last full sum
+
+      double magnetization_tolerance = 0.0; // change in reduced cell magnetization needed to update resistances
+      std::vector <double> cell_reduced_magnetization; // 3N reduced magnetization at last update of resistances
+
       // arrays to store average resistance and spin resistance in each cell
       std::vector <double> cell_resistance;
       std::vector <double> cell_spin_resistance;
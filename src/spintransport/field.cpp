@@ -53,4 +53,11 @@ namespace spin_transport{
 
    }
 
+   //---------------------------------------------------------------------------
+   // Function to check if spin transport calculation is enabled
+   //---------------------------------------------------------------------------
+   bool is_enabled(){
+      return spin_transport::internal::enabled;
+   }
+
 }
@@ -532,6 +532,11 @@ namespace spin_transport{
       st::internal::cell_magnetization.resize(3*st::internal::total_num_cells, 0.0);
       st::internal::cell_spin_torque_fields.resize(3*st::internal::total_num_cells, 0.0);
 
+      //------------------------------------------------------------------------
+      // determine compressed list of magnetic cells in each stack
+      //------------------------------------------------------------------------
+      st::internal::initialize_stack_links();
+
       if( vmpi::my_rank == 0 ){
          std::ofstream ofile("data.txt");
          for(uint64_t i =0; i< st::internal::total_num_cells; i++){
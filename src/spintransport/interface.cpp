@@ -174,6 +174,15 @@ namespace spin_transport{
           st::internal::time_counter = ur;
           return true;
       }
+      //------------------------------------------------------------------------
+      test = "magnetisation-tolerance";
+      if( word == test ){
+          // Set change in reduced cell magnetisation needed to recalculate resistances
+          double tol = vin::str_to_double(value);
+          vin::check_for_valid_value(tol, word, line, prefix, unit, "none", 0.0, 1.0,"input","0 - 1");
+          st::internal::magnetization_tolerance = tol;
+          return true;
+      }
       // channel length
       //--------------------------------------------------------------------
       // Keyword not found
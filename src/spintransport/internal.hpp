@@ -121,6 +121,21 @@ namespace spin_transport{
       extern unsigned int first_stack; // first stack on local processor
       extern unsigned int last_stack;  // last stack on local processor
 
+      // Compressed list of magnetic cells (links) in each stack along the current direction. The resistances of
+      // non-magnetic cells are included in the spin resistance of the link to the next magnetic cell.
+      extern std::vector <unsigned int> stack_link_start_index; // start of stack in 1D list of links (num_stacks+1)
+      extern std::vector <unsigned int> link_cell;              // magnetic cell at end of link
+      extern std::vector <unsigned int> link_previous_cell;     // previous magnetic cell (or first cell) in stack
+      extern std::vector <double> link_spin_resistance;         // spin resistance between previous cell and cell
+      extern std::vector <double> link_resistance;              // magnetoresistance of link 0.5 Rsp (1 - mi.mj)
+      extern std::vector <double> link_field;                   // 3N spin torque field of link cells (without current factor)
+      extern std::vector <double> stack_base_resistance;        // spin-independent resistance of each stack
+      extern std::vector <double> stack_spin_resistance;        // sum of link magnetoresistances in each stack
+      extern std::vector <unsigned int> stack_num_incremental_updates; // incremental updates of stack_spin_resistance since last full sum
+
+      extern double magnetization_tolerance; // change in reduced cell magnetization needed to update resistances
+      extern std::vector <double> cell_reduced_magnetization; // 3N reduced magnetization at last update of resistances
+
       // arrays to store average resistance and spin resistance in each cell
       extern std::vector <double> cell_resistance;
       extern std::vector <double> cell_spin_resistance;
@@ -148,7 +163,9 @@ namespace spin_transport{
                                         const std::vector<double>& atoms_m_spin_array  // moment of atoms
       );
 
+      void initialize_stack_links();
       void calculate_magnetoresistance();
+      bool update_stack_magnetoresistance(const unsigned int stack, const double tolerance_sq);
 
       void calculate_field(const unsigned int num_local_atoms,            // number of local atoms
                            std::vector<double>& atoms_x_field_array,      // x-field of atoms
@@ -11,11 +11,13 @@
 //
 
 // C++ standard library headers
+#include <algorithm>
 #include <iostream>
 
 // Vampire headers
 #include "program.hpp"
 #include "spintransport.hpp"
+#include "vio.hpp"
 #include "vmpi.hpp"
 
 // spintransport module headers
@@ -25,130 +27,238 @@ namespace spin_transport{
 namespace internal{
 
 //---------------------------------------------------------------------------------------------------------
-// Function to calculate stack resistances
+// Function to determine compressed list of magnetic cells (links) in each stack. The stack resistance is
+//
+//    R = sum_cells Rep + sum_links 0.5 Rsp (1 - mi.mj)
+//
+// where mi and mj are the reduced magnetizations of consecutive magnetic cells and Rsp the accumulated spin
+// resistance of cell i and any non-magnetic cells between them. Link data are initialised for zero
+// magnetization, consistent with the initial values of the reduced magnetization.
 //---------------------------------------------------------------------------------------------------------
-void calculate_magnetoresistance(){
+void initialize_stack_links(){
 
-   // variable to compute sum of inverse resistances
-   double sum_inv_resistance = 0.0;
+   const unsigned int num_stacks = st::internal::num_stacks;
 
-   //---------------------------------------------------------------------------------------------------------
-   // Zero spin torque arrray for parallel version to allow reduction
-   //---------------------------------------------------------------------------------------------------------
-   #ifdef MPICF
-      std::fill(st::internal::cell_spin_torque_fields.begin(), st::internal::cell_spin_torque_fields.end(), 0.0);
-      //std::fill(st::internal::stack_resistance.begin(), st::internal::stack_resistance.end(), 0.0); // needed for data output only
-      //std::fill(st::internal::stack_current.begin(),    st::internal::stack_current.end(),    0.0);
-   #endif
+   st::internal::stack_link_start_index.assign(num_stacks+1, 0);
+   st::internal::stack_base_resistance.assign(num_stacks, 0.0);
+   st::internal::stack_spin_resistance.assign(num_stacks, 0.0);
+   st::internal::stack_num_incremental_updates.assign(num_stacks, 0);
+   st::internal::link_cell.clear();
+   st::internal::link_previous_cell.clear();
+   st::internal::link_spin_resistance.clear();
+   st::internal::link_resistance.clear();
 
-   // TODO need to parallelise stack loop
-   //---------------------------------------------------------------------------------------------------------
-   // loop over all stacks to calculate stack resistance (can OpenMP this loop)
-   //---------------------------------------------------------------------------------------------------------
-   for(uint64_t stack = st::internal::first_stack; stack < st::internal::last_stack; stack++){
+   for(unsigned int stack = 0; stack < num_stacks; stack++){
 
       const unsigned int start = stack_start_index[stack];
       const unsigned int end   = stack_final_index[stack];
-      const double isat = st::internal::cell_isaturation[start]; // saturation magnetization for cell i
-
-      double total_stack_resistance = 0.0;
 
-      // load first cell reduced magnetization
-      double mix = st::internal::cell_magnetization[3*start+0] * isat;
-      double miy = st::internal::cell_magnetization[3*start+1] * isat;
-      double miz = st::internal::cell_magnetization[3*start+2] * isat;
+      double base_resistance = st::internal::cell_resistance[start];
+      double spin_resistance = 0.0;
 
-      // load first cell resistances for P and AP states
-      double Rep = st::internal::cell_resistance[start];      // electron-phonon scattering resistance
-      double Rsp = st::internal::cell_spin_resistance[start]; // electron-spin scattering resistance
+      unsigned int previous = start; // previous magnetic cell
+      double Rsp = st::internal::cell_spin_resistance[start]; // accumulated spin resistance
 
-      //------------------------------------------------------------------------------------------------------
-      // loop over all other cells in stack starting at cell start+1
-      //------------------------------------------------------------------------------------------------------
       for(unsigned int cell = start+1 ; cell < end ; cell++){
 
+         base_resistance += st::internal::cell_resistance[cell];
+
          if(st::internal::magnetic[cell]){
-            // calculate next cell reduced magnetization
-            const double jsat = st::internal::cell_isaturation[cell];
-            const double mjx = st::internal::cell_magnetization[3*cell+0] * jsat;
-            const double mjy = st::internal::cell_magnetization[3*cell+1] * jsat;
-            const double mjz = st::internal::cell_magnetization[3*cell+2] * jsat;
-            const double alpha = st::internal::cell_alpha[cell];
-            const double mi_dot_mj = ( mix*mjx + miy*mjy + miz*mjz );
-
-            // calculate resistance (need to include T dependence of Rep here)
-            total_stack_resistance += Rep + 0.5*Rsp*(1.0 - mi_dot_mj);
-
-            // calculate relavtive contributions of adiabatic and non-adiabatic spin torque
-            const double strj = st::internal::cell_relaxation_torque_rj[cell];
-            const double stpj = st::internal::cell_precession_torque_pj[cell];
-
-            // calculate field without current based on relative magnetization orientations
-            const double hx = (strj-alpha*stpj)*(mjy*miz - mjz*miy) + (stpj+alpha*strj)*mix;
-            const double hy = (strj-alpha*stpj)*(mjz*mix - mjx*miz) + (stpj+alpha*strj)*miy;
-            const double hz = (strj-alpha*stpj)*(mjx*miy - mjy*mix) + (stpj+alpha*strj)*miz;
-
-            // save field (without current factor)
-            st::internal::cell_spin_torque_fields[3*cell+0] = hx;
-            st::internal::cell_spin_torque_fields[3*cell+1] = hy;
-            st::internal::cell_spin_torque_fields[3*cell+2] = hz;
-
-            // update cell resistances and magnetization
-            mix = mjx;
-            miy = mjy;
-            miz = mjz;
-
-            Rep = st::internal::cell_resistance[cell];
+            st::internal::link_cell.push_back(cell);
+            st::internal::link_previous_cell.push_back(previous);
+            st::internal::link_spin_resistance.push_back(Rsp);
+            st::internal::link_resistance.push_back(0.5*Rsp);
+            spin_resistance += 0.5*Rsp;
+            previous = cell;
             Rsp = st::internal::cell_spin_resistance[cell];
-
          }
          else{
-
-            // update cell resistances and defer spin resistance to later by accumulating
-            Rep += st::internal::cell_resistance[cell];
             Rsp += st::internal::cell_spin_resistance[cell]; // The += is significant!
-
          }
 
       }
 
-      //-----------------------------------------------------
-      // add final non-spin resistance to stack
-      //-----------------------------------------------------
-      total_stack_resistance += Rep;
+      st::internal::stack_link_start_index[stack+1] = st::internal::link_cell.size();
+      st::internal::stack_base_resistance[stack] = base_resistance;
+      st::internal::stack_spin_resistance[stack] = spin_resistance;
+      st::internal::stack_resistance[stack] = base_resistance + spin_resistance;
+
+   }
+
+   st::internal::link_field.assign(3*st::internal::link_cell.size(), 0.0);
+   st::internal::cell_reduced_magnetization.assign(3*st::internal::total_num_cells, 0.0);
+
+   zlog << zTs() << "Spin transport network of " << st::internal::total_num_cells << " cells compressed to "
+        << st::internal::link_cell.size() << " magnetic links in " << num_stacks << " stacks" << std::endl;
+
+   return;
+
+}
+
+//---------------------------------------------------------------------------------------------------------
+// Function to update reduced magnetization of a cell if changed by more than the tolerance
+//---------------------------------------------------------------------------------------------------------
+inline bool update_reduced_magnetization(const unsigned int cell, const double tolerance_sq){
+
+   const double isat = st::internal::cell_isaturation[cell]; // saturation magnetization for cell
+
+   const double mx = st::internal::cell_magnetization[3*cell+0] * isat;
+   const double my = st::internal::cell_magnetization[3*cell+1] * isat;
+   const double mz = st::internal::cell_magnetization[3*cell+2] * isat;
+
+   const double dx = mx - st::internal::cell_reduced_magnetization[3*cell+0];
+   const double dy = my - st::internal::cell_reduced_magnetization[3*cell+1];
+   const double dz = mz - st::internal::cell_reduced_magnetization[3*cell+2];
+
+   if(dx*dx + dy*dy + dz*dz <= tolerance_sq) return false;
+
+   st::internal::cell_reduced_magnetization[3*cell+0] = mx;
+   st::internal::cell_reduced_magnetization[3*cell+1] = my;
+   st::internal::cell_reduced_magnetization[3*cell+2] = mz;
+
+   return true;
+
+}
+
+//---------------------------------------------------------------------------------------------------------
+// Function to update magnetoresistance and spin torque fields (without current factor) of links in a stack
+// where either cell has changed magnetization. Returns true if stack resistance has changed. The spin
+// resistance of the stack is updated from the change in link resistances and summed in full periodically
+// to remove accumulated rounding errors.
+//---------------------------------------------------------------------------------------------------------
+bool update_stack_magnetoresistance(const unsigned int stack, const double tolerance_sq){
+
+   // maximum number of incremental updates between full sums of link resistances
+   const unsigned int max_incremental_resistance_updates = 100;
+
+   bool changed = false;
+
+   // links are ordered along stack, so that previous cell of each link is the cell of the last link
+   bool previous_changed = update_reduced_magnetization(stack_start_index[stack], tolerance_sq);
+
+   for(unsigned int link = stack_link_start_index[stack]; link < stack_link_start_index[stack+1]; link++){
 
-      // accumulate total inverse resistance
-      sum_inv_resistance += 1.0 / total_stack_resistance;
+      const unsigned int cell = st::internal::link_cell[link];
+      const bool cell_changed = update_reduced_magnetization(cell, tolerance_sq);
+
+      if(cell_changed || previous_changed){
+
+         const unsigned int pcell = st::internal::link_previous_cell[link];
+
+         // load reduced magnetizations of previous and current cell
+         const double mix = st::internal::cell_reduced_magnetization[3*pcell+0];
+         const double miy = st::internal::cell_reduced_magnetization[3*pcell+1];
+         const double miz = st::internal::cell_reduced_magnetization[3*pcell+2];
+
+         const double mjx = st::internal::cell_reduced_magnetization[3*cell+0];
+         const double mjy = st::internal::cell_reduced_magnetization[3*cell+1];
+         const double mjz = st::internal::cell_reduced_magnetization[3*cell+2];
+
+         const double alpha = st::internal::cell_alpha[cell];
+         const double mi_dot_mj = ( mix*mjx + miy*mjy + miz*mjz );
+
+         // calculate resistance (need to include T dependence of Rep here) and update partial sum for stack
+         const double resistance = 0.5*st::internal::link_spin_resistance[link]*(1.0 - mi_dot_mj);
+         st::internal::stack_spin_resistance[stack] += resistance - st::internal::link_resistance[link];
+         st::internal::link_resistance[link] = resistance;
+
+         // calculate relavtive contributions of adiabatic and non-adiabatic spin torque
+         const double strj = st::internal::cell_relaxation_torque_rj[cell];
+         const double stpj = st::internal::cell_precession_torque_pj[cell];
+
+         // calculate field without current based on relative magnetization orientations
+         st::internal::link_field[3*link+0] = (strj-alpha*stpj)*(mjy*miz - mjz*miy) + (stpj+alpha*strj)*mix;
+         st::internal::link_field[3*link+1] = (strj-alpha*stpj)*(mjz*mix - mjx*miz) + (stpj+alpha*strj)*miy;
+         st::internal::link_field[3*link+2] = (strj-alpha*stpj)*(mjx*miy - mjy*mix) + (stpj+alpha*strj)*miz;
+
+         changed = true;
+
+      }
+
+      previous_changed = cell_changed;
+
+   }
+
+   if(!changed) return false;
+
+   st::internal::stack_num_incremental_updates[stack]++;
+   if(st::internal::stack_num_incremental_updates[stack] >= max_incremental_resistance_updates){
+      double spin_resistance = 0.0;
+      for(unsigned int link = stack_link_start_index[stack]; link < stack_link_start_index[stack+1]; link++){
+         spin_resistance += st::internal::link_resistance[link];
+      }
+      st::internal::stack_spin_resistance[stack] = spin_resistance;
+      st::internal::stack_num_incremental_updates[stack] = 0;
+   }
+
+   st::internal::stack_resistance[stack] = st::internal::stack_base_resistance[stack] + st::internal::stack_spin_resistance[stack];
+
+   return true;
+
+}
+
+//---------------------------------------------------------------------------------------------------------
+// Function to calculate stack resistances. Only links with a cell whose reduced magnetization has changed
+// by more than the tolerance are recalculated, and spin torque fields are only rescaled in stacks where
+// the current has changed.
+//---------------------------------------------------------------------------------------------------------
+void calculate_magnetoresistance(){
+
+   const double tolerance_sq = st::internal::magnetization_tolerance * st::internal::magnetization_tolerance;
+   const double applied_voltage = st::internal::voltage * program::fractional_electric_field_strength;
+
+   //---------------------------------------------------------------------------------------------------------
+   // Zero spin torque fields of stacks on other processors to allow reduction
+   //---------------------------------------------------------------------------------------------------------
+   #ifdef MPICF
+      if(st::internal::first_stack < st::internal::last_stack){
+         std::fill(st::internal::cell_spin_torque_fields.begin(), st::internal::cell_spin_torque_fields.begin() + 3*stack_start_index[st::internal::first_stack], 0.0);
+         std::fill(st::internal::cell_spin_torque_fields.begin() + 3*stack_final_index[st::internal::last_stack-1], st::internal::cell_spin_torque_fields.end(), 0.0);
+      }
+      else std::fill(st::internal::cell_spin_torque_fields.begin(), st::internal::cell_spin_torque_fields.end(), 0.0);
+   #endif
+
+   //---------------------------------------------------------------------------------------------------------
+   // loop over all local stacks to update stack resistance and current (in parallel)
+   //---------------------------------------------------------------------------------------------------------
+   const int first_stack = st::internal::first_stack;
+   const int last_stack = st::internal::last_stack;
+
+   #pragma omp parallel for schedule(static)
+   for(int stack = first_stack; stack < last_stack; stack++){
+
+      const bool changed = update_stack_magnetoresistance(stack, tolerance_sq);
 
       //-----------------------------------------------------
       // Compute stack current
       //-----------------------------------------------------
-      const double je = st::internal::voltage * program::fractional_electric_field_strength / total_stack_resistance;
+      const double je = applied_voltage / st::internal::stack_resistance[stack];
+
+      if(!changed && je == st::internal::stack_current[stack]) continue;
 
       //---------------------------------------------------------
       // Compute cell spin torque fields based on stack currents
       //---------------------------------------------------------
-      // loop over all other cells in stack starting at cell start+1
-      for(unsigned int cell = start+1 ; cell < end ; cell++){
-         st::internal::cell_spin_torque_fields[3*cell+0] *= je;
-         st::internal::cell_spin_torque_fields[3*cell+1] *= je;
-         st::internal::cell_spin_torque_fields[3*cell+2] *= je;
+      for(unsigned int link = stack_link_start_index[stack]; link < stack_link_start_index[stack+1]; link++){
+         const unsigned int cell = st::internal::link_cell[link];
+         st::internal::cell_spin_torque_fields[3*cell+0] = st::internal::link_field[3*link+0] * je;
+         st::internal::cell_spin_torque_fields[3*cell+1] = st::internal::link_field[3*link+1] * je;
+         st::internal::cell_spin_torque_fields[3*cell+2] = st::internal::link_field[3*link+2] * je;
       }
 
-      //-----------------------------------------------------
-      // save stack resistance and current to arrays
-      //-----------------------------------------------------
-      st::internal::stack_resistance[stack] = total_stack_resistance;
-      st::internal::stack_current[stack]    = je;
+      st::internal::stack_current[stack] = je;
 
    } // end of stack loop
 
+   // accumulate total inverse resistance
+   double sum_inv_resistance = 0.0;
+   for(int stack = first_stack; stack < last_stack; stack++) sum_inv_resistance += 1.0 / st::internal::stack_resistance[stack];
+
    //------------------------------------------------------------------------------------------
    // Reduce cell spin trorque fields and stack currents and resistances on all processors
    //------------------------------------------------------------------------------------------
    #ifdef MPICF
       MPI_Allreduce(MPI_IN_PLACE, &st::internal::cell_spin_torque_fields[0], 3*st::internal::total_num_cells, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-      //MPI_Allreduce(MPI_IN_PLACE, &st::internal::stack_resistance[0],        st::internal::num_stacks,        MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
       MPI_Allreduce(MPI_IN_PLACE, &sum_inv_resistance,                       1,                               MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
    #endif
 
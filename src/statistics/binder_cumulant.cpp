@@ -92,6 +92,8 @@ void binder_cumulant_statistic_t::calculate(const std::vector<double>& magnetiza
 //------------------------------------------------------------------------------------------------------
 void binder_cumulant_statistic_t::reset_averages(){
 
+   internal::complete_reduction();
+
    // reinitialise mean magnetization to zero
    std::fill(binder_cumulant_squared.begin(),binder_cumulant_squared.end(),0.0);
    std::fill(binder_cumulant_fourth_power.begin(),binder_cumulant_fourth_power.end(),0.0);
@@ -108,6 +110,8 @@ void binder_cumulant_statistic_t::reset_averages(){
 //------------------------------------------------------------------------------------------------------
 std::string binder_cumulant_statistic_t::output_binder_cumulant(bool header){
 
+   internal::complete_reduction();
+
    // result string stream
    std::ostringstream res;
 
@@ -87,5 +87,18 @@ namespace stats{
    //-----------------------------------------------------------------------------
    namespace internal{
 
+      // state of incremental energy updates from Monte Carlo moves
+      bool exact_energy_required = true; // flag to force exact calculation of energies at next update
+      int num_incremental_energy_updates = 0; // number of incremental updates since last exact calculation
+      double last_energy_temperature = 0.0; // temperature and applied field at last exact calculation
+      double last_energy_applied_field[4] = {0.0, 0.0, 0.0, 0.0};
+
+      std::vector<energy_statistic_t*> exact_energy_statistics;
+      std::vector<energy_statistic_t*> incremental_energy_statistics;
+      std::vector<double> energy_change; // energy change of each material from Monte Carlo moves
+
+      std::vector<int> active_atom_ranges; // ranges of atoms updated in magnetization statistics (all atoms if empty)
+      int active_atom_ranges_id = 0; // counter of changes to active atom ranges
+
    } // end of internal namespace
 } // end of stats namespace
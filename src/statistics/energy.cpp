@@ -67,6 +67,7 @@ void energy_statistic_t::set_mask(const int in_mask_size, const std::vector<int>
    mask_size = in_mask_size - 1; // last element contains energy for non-magnetic atoms
    mean_counter = 0.0;
    mask = in_mask; // copy contents of vector
+   material_mask.clear();
 
    // resize arrays to correct mask size (one value per mask) and set to zero
    total_energy.resize(in_mask_size, 0.0);
@@ -136,121 +137,127 @@ void energy_statistic_t::get_mask(std::vector<int>& out_mask, std::vector<double
 }
 
 //------------------------------------------------------------------------------------------------------
-// Function to calculate spin energy given a mask and place result in energy array
+// Function to calculate the energies on this processor of several energy statistics together. The
+// energy terms of each atom are evaluated once and added to the mask of every statistic. The partial
+// sums are added to the statistics reduction and finalised in finalize_energies().
 //------------------------------------------------------------------------------------------------------
-void energy_statistic_t::calculate(const std::vector<double>& sx,  // spin unit vector
-                                   const std::vector<double>& sy,
-                                   const std::vector<double>& sz,
-                                   const std::vector<double>& mm,  // magnetic moment (Tesla)
-                                   const std::vector<int>& mat, // material id
-                                   const double temperature){
+void internal::sum_energies(const std::vector<energy_statistic_t*>& statistics,
+                                  const std::vector<double>& sx,  // spin unit vector
+                                  const std::vector<double>& sy,
+                                  const std::vector<double>& sz,
+                                  const std::vector<double>& mm,  // magnetic moment (Tesla)
+                                  const std::vector<int>& mat, // material id
+                                  const double temperature){
+
+   const unsigned int num_statistics = statistics.size();
+   if(num_statistics == 0) return;
 
    // initialise energies to zero
-   std::fill(         total_energy.begin(),         total_energy.end(), 0.0 );
-   std::fill(      exchange_energy.begin(),      exchange_energy.end(), 0.0 );
-   std::fill(    anisotropy_energy.begin(),    anisotropy_energy.end(), 0.0 );
-   std::fill( applied_field_energy.begin(), applied_field_energy.end(), 0.0 );
-   std::fill( magnetostatic_energy.begin(), magnetostatic_energy.end(), 0.0 );
+   for(unsigned int s = 0; s < num_statistics; ++s){
+      energy_statistic_t& stat = *statistics[s];
+      std::fill(         stat.total_energy.begin(),         stat.total_energy.end(), 0.0 );
+      std::fill(      stat.exchange_energy.begin(),      stat.exchange_energy.end(), 0.0 );
+      std::fill(    stat.anisotropy_energy.begin(),    stat.anisotropy_energy.end(), 0.0 );
+      std::fill( stat.applied_field_energy.begin(), stat.applied_field_energy.end(), 0.0 );
+      std::fill( stat.magnetostatic_energy.begin(), stat.magnetostatic_energy.end(), 0.0 );
+   }
 
    //---------------------------------------------------------------------------
-   // Calculate exchange energy (in Tesla)
+   // Calculate exchange, anisotropy, applied field and magnetostatic energies
+   // (in Tesla) of each atom and add to the mask of each statistic
    //---------------------------------------------------------------------------
+   const int num_atoms = statistics[0]->num_atoms;
 
-   // loop over all atoms in mask
    for( int atom = 0; atom < num_atoms; ++atom ){
-      const int mask_id = mask[atom]; // get mask id
-      exchange_energy[mask_id] += exchange::single_spin_energy(atom, sx[atom], sy[atom], sz[atom]) * mm[atom];
-   }
 
-   // Optionally calculate biquadratic exchange energy
-   if(exchange::biquadratic){
+      double exchange_energy = exchange::single_spin_energy(atom, sx[atom], sy[atom], sz[atom]) * mm[atom];
 
-      // loop over all atoms in mask
-      for( int atom = 0; atom < num_atoms; ++atom ){
-         const int mask_id = mask[atom]; // get mask id
-         exchange_energy[mask_id] += exchange::single_spin_biquadratic_energy(atom, sx[atom], sy[atom], sz[atom]) * mm[atom];
-      }
+      // Optionally calculate biquadratic exchange energy
+      if(exchange::biquadratic) exchange_energy += exchange::single_spin_biquadratic_energy(atom, sx[atom], sy[atom], sz[atom]) * mm[atom];
 
-   }
+      const double anisotropy_energy    = anisotropy::single_spin_energy(atom, mat[atom], sx[atom], sy[atom], sz[atom], temperature) * mm[atom];
+      const double applied_field_energy = sim::spin_applied_field_energy(sx[atom], sy[atom], sz[atom]) * mm[atom];
+      const double magnetostatic_energy = dipole::spin_magnetostatic_energy(atom, sx[atom], sy[atom], sz[atom]) * mm[atom];
 
-   // save total energy accounting for factor 1/2 in double summation
-   for( int mask_id = 0; mask_id < mask_size; ++mask_id ){
-      exchange_energy[mask_id] = 0.5 * exchange_energy[mask_id];
-   }
+      for(unsigned int s = 0; s < num_statistics; ++s){
+         energy_statistic_t& stat = *statistics[s];
+         const int mask_id = stat.mask[atom]; // get mask id
+         stat.exchange_energy[mask_id]      += exchange_energy;
+         stat.anisotropy_energy[mask_id]    += anisotropy_energy;
+         stat.applied_field_energy[mask_id] += applied_field_energy;
+         stat.magnetostatic_energy[mask_id] += magnetostatic_energy;
+      }
 
-   //---------------------------------------------------------------------------
-   // Calculate anisotropy energy (in Tesla)
-   //---------------------------------------------------------------------------
-   for( int atom = 0; atom < num_atoms; ++atom ){
-      const int mask_id = mask[atom]; // get mask id
-      anisotropy_energy[mask_id] += anisotropy::single_spin_energy(atom, mat[atom], sx[atom], sy[atom], sz[atom], temperature) * mm[atom];
    }
 
    //---------------------------------------------------------------------------
-   // Calculate applied field energy (in Tesla)
+   // Calculate total energy (in Tesla), accounting for factor 1/2 in double
+   // summation of exchange and magnetostatic energies
    //---------------------------------------------------------------------------
-   for( int atom = 0; atom < num_atoms; ++atom ){
-      const int mask_id = mask[atom]; // get mask id
-      applied_field_energy[mask_id] += sim::spin_applied_field_energy(sx[atom], sy[atom], sz[atom]) * mm[atom];
+   for(unsigned int s = 0; s < num_statistics; ++s){
+      energy_statistic_t& stat = *statistics[s];
+      for( int mask_id = 0; mask_id < stat.mask_size; ++mask_id ){
+         stat.exchange_energy[mask_id]      = 0.5 * stat.exchange_energy[mask_id];
+         stat.magnetostatic_energy[mask_id] = 0.5 * stat.magnetostatic_energy[mask_id];
+         stat.total_energy[mask_id] = stat.exchange_energy[mask_id] +
+                                      stat.anisotropy_energy[mask_id] +
+                                      stat.applied_field_energy[mask_id] +
+                                      stat.magnetostatic_energy[mask_id];
+      }
    }
 
    //---------------------------------------------------------------------------
-   // Calculate magnetostatic field energy (in Tesla)
+   // Reduce on all CPUS
    //---------------------------------------------------------------------------
-   for( int atom = 0; atom < num_atoms; ++atom ){
-      const int mask_id = mask[atom]; // get mask id
-      magnetostatic_energy[mask_id] += dipole::spin_magnetostatic_energy(atom, sx[atom], sy[atom], sz[atom]) * mm[atom];
+   for(unsigned int s = 0; s < num_statistics; ++s){
+      energy_statistic_t& stat = *statistics[s];
+      internal::add_to_reduction(stat.total_energy,         stat.mask_size);
+      internal::add_to_reduction(stat.exchange_energy,      stat.mask_size);
+      internal::add_to_reduction(stat.anisotropy_energy,    stat.mask_size);
+      internal::add_to_reduction(stat.applied_field_energy, stat.mask_size);
+      internal::add_to_reduction(stat.magnetostatic_energy, stat.mask_size);
    }
 
-   // save energy accounting for factor 1/2 in double summation
-   for( int mask_id = 0; mask_id < mask_size; ++mask_id ){
-      magnetostatic_energy[mask_id] = 0.5 * magnetostatic_energy[mask_id];
-   }
+   return;
 
-   //---------------------------------------------------------------------------
-   // Calculate total energy (in Tesla)
-   //---------------------------------------------------------------------------
-   for( int mask_id = 0; mask_id < mask_size; ++mask_id ){
-      total_energy[mask_id] = exchange_energy[mask_id] +
-                              anisotropy_energy[mask_id] +
-                              applied_field_energy[mask_id] +
-                              magnetostatic_energy[mask_id];
-   }
+}
 
-   //---------------------------------------------------------------------------
-   // Reduce on all CPUS
-   //---------------------------------------------------------------------------
-   #ifdef MPICF
-      MPI_Allreduce(MPI_IN_PLACE,      &exchange_energy[0], mask_size, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-      MPI_Allreduce(MPI_IN_PLACE,    &anisotropy_energy[0], mask_size, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-      MPI_Allreduce(MPI_IN_PLACE, &applied_field_energy[0], mask_size, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-      MPI_Allreduce(MPI_IN_PLACE, &magnetostatic_energy[0], mask_size, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-      MPI_Allreduce(MPI_IN_PLACE,         &total_energy[0], mask_size, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-   #endif
+//------------------------------------------------------------------------------------------------------
+// Function to add reduced energies of several energy statistics to mean energies
+//------------------------------------------------------------------------------------------------------
+void internal::finalize_energies(const std::vector<energy_statistic_t*>& statistics){
 
-   //---------------------------------------------------------------------------
-   // Add energies to mean energies
-   //---------------------------------------------------------------------------
-   for(int mask_id=0; mask_id<mask_size; ++mask_id ){
-      mean_total_energy[mask_id]         += total_energy[mask_id];
-      mean_exchange_energy[mask_id]      += exchange_energy[mask_id];
-      mean_anisotropy_energy[mask_id]    += anisotropy_energy[mask_id];
-      mean_applied_field_energy[mask_id] += applied_field_energy[mask_id];
-      mean_magnetostatic_energy[mask_id] += magnetostatic_energy[mask_id];
-   }
+   const unsigned int num_statistics = statistics.size();
 
-   // increment mean counter
-   mean_counter += 1.0;
+   for(unsigned int s = 0; s < num_statistics; ++s){
+
+      energy_statistic_t& stat = *statistics[s];
+
+      //---------------------------------------------------------------------------
+      // Add energies to mean energies
+      //---------------------------------------------------------------------------
+      for(int mask_id=0; mask_id<stat.mask_size; ++mask_id ){
+         stat.mean_total_energy[mask_id]         += stat.total_energy[mask_id];
+         stat.mean_exchange_energy[mask_id]      += stat.exchange_energy[mask_id];
+         stat.mean_anisotropy_energy[mask_id]    += stat.anisotropy_energy[mask_id];
+         stat.mean_applied_field_energy[mask_id] += stat.applied_field_energy[mask_id];
+         stat.mean_magnetostatic_energy[mask_id] += stat.magnetostatic_energy[mask_id];
+      }
+
+      // increment mean counter
+      stat.mean_counter += 1.0;
+
+      //---------------------------------------------------------------------------
+      // Zero empty mask id's
+      //---------------------------------------------------------------------------
+      for( unsigned int id=0; id < stat.zero_list.size(); ++id ){
+                 stat.total_energy[ stat.zero_list[id] ] = 0.0;
+              stat.exchange_energy[ stat.zero_list[id] ] = 0.0;
+            stat.anisotropy_energy[ stat.zero_list[id] ] = 0.0;
+         stat.applied_field_energy[ stat.zero_list[id] ] = 0.0;
+         stat.magnetostatic_energy[ stat.zero_list[id] ] = 0.0;
+      }
 
-   //---------------------------------------------------------------------------
-   // Zero empty mask id's
-   //---------------------------------------------------------------------------
-   for( unsigned int id=0; id < zero_list.size(); ++id ){
-              total_energy[ zero_list[id] ] = 0.0;
-           exchange_energy[ zero_list[id] ] = 0.0;
-         anisotropy_energy[ zero_list[id] ] = 0.0;
-      applied_field_energy[ zero_list[id] ] = 0.0;
-      magnetostatic_energy[ zero_list[id] ] = 0.0;
    }
 
    return;
@@ -262,6 +269,8 @@ void energy_statistic_t::calculate(const std::vector<double>& sx,  // spin unit
 //------------------------------------------------------------------------------------------------------
 const std::vector<double>& energy_statistic_t::get_total_energy(){
 
+   internal::complete_reduction();
+
    return total_energy;
 
 }
@@ -271,6 +280,8 @@ const std::vector<double>& energy_statistic_t::get_total_energy(){
 //------------------------------------------------------------------------------------------------------
 const std::vector<double>& energy_statistic_t::get_exchange_energy(){
 
+   internal::complete_reduction();
+
    return exchange_energy;
 
 }
@@ -280,6 +291,8 @@ const std::vector<double>& energy_statistic_t::get_exchange_energy(){
 //------------------------------------------------------------------------------------------------------
 const std::vector<double>& energy_statistic_t::get_anisotropy_energy(){
 
+   internal::complete_reduction();
+
    return anisotropy_energy;
 
 }
@@ -289,6 +302,8 @@ const std::vector<double>& energy_statistic_t::get_anisotropy_energy(){
 //------------------------------------------------------------------------------------------------------
 const std::vector<double>& energy_statistic_t::get_applied_field_energy(){
 
+   internal::complete_reduction();
+
    return applied_field_energy;
 
 }
@@ -298,6 +313,8 @@ const std::vector<double>& energy_statistic_t::get_applied_field_energy(){
 //------------------------------------------------------------------------------------------------------
 const std::vector<double>& energy_statistic_t::get_magnetostatic_energy(){
 
+   internal::complete_reduction();
+
    return magnetostatic_energy;
 
 }
@@ -307,6 +324,8 @@ const std::vector<double>& energy_statistic_t::get_magnetostatic_energy(){
 //------------------------------------------------------------------------------------------------------
 void energy_statistic_t::set_total_energy(std::vector<double>& new_energy, std::vector<double>& new_mean_energy){
 
+   internal::complete_reduction();
+
    // copy energy vector
    total_energy = new_energy;
 
@@ -322,6 +341,8 @@ void energy_statistic_t::set_total_energy(std::vector<double>& new_energy, std::
 //------------------------------------------------------------------------------------------------------
 void energy_statistic_t::set_exchange_energy(std::vector<double>& new_energy, std::vector<double>& new_mean_energy){
 
+   internal::complete_reduction();
+
    // copy energy vector
    exchange_energy = new_energy;
 
@@ -337,6 +358,8 @@ void energy_statistic_t::set_exchange_energy(std::vector<double>& new_energy, st
 //------------------------------------------------------------------------------------------------------
 void energy_statistic_t::set_anisotropy_energy(std::vector<double>& new_energy, std::vector<double>& new_mean_energy){
 
+   internal::complete_reduction();
+
    // copy energy vector
    anisotropy_energy = new_energy;
 
@@ -352,6 +375,8 @@ void energy_statistic_t::set_anisotropy_energy(std::vector<double>& new_energy,
 //------------------------------------------------------------------------------------------------------
 void energy_statistic_t::set_applied_field_energy(std::vector<double>& new_energy, std::vector<double>& new_mean_energy){
 
+   internal::complete_reduction();
+
    // copy energy vector
    applied_field_energy = new_energy;
 
@@ -367,6 +392,8 @@ void energy_statistic_t::set_applied_field_energy(std::vector<double>& new_energ
 //------------------------------------------------------------------------------------------------------
 void energy_statistic_t::set_magnetostatic_energy(std::vector<double>& new_energy, std::vector<double>& new_mean_energy){
 
+   internal::complete_reduction();
+
    // copy energy vector
    magnetostatic_energy = new_energy;
 
@@ -377,11 +404,109 @@ void energy_statistic_t::set_magnetostatic_energy(std::vector<double>& new_energ
 
 }
 
+//------------------------------------------------------------------------------------------------------
+// Function to determine if the mask maps each material onto a single mask id, so that the energies
+// can be updated from the energy change of each material. Otherwise the energies must be calculated
+// in full.
+//------------------------------------------------------------------------------------------------------
+bool energy_statistic_t::has_material_mask(const int num_materials, const std::vector<int>& mat){
+
+   // determine mask id of each material on first call
+   if(material_mask.size() != static_cast<unsigned int>(num_materials)){
+
+      material_mask.assign(num_materials, -1);
+
+      for(int atom=0; atom<num_atoms; ++atom){
+         const int imat = mat[atom];
+         if(imat < num_materials && material_mask[imat] < mask[atom]) material_mask[imat] = mask[atom];
+      }
+
+      #ifdef MPICF
+         MPI_Allreduce(MPI_IN_PLACE, &material_mask[0], num_materials, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+      #endif
+
+      // materials without atoms never change energy
+      for(int imat=0; imat<num_materials; ++imat){
+         if(material_mask[imat] < 0) material_mask[imat] = mask_size;
+      }
+
+      // check that all atoms of each material share the same mask id
+      std::vector<int> unique(num_materials, 1);
+      for(int atom=0; atom<num_atoms; ++atom){
+         const int imat = mat[atom];
+         if(imat < num_materials && material_mask[imat] != mask[atom]) unique[imat] = 0;
+      }
+
+      #ifdef MPICF
+         MPI_Allreduce(MPI_IN_PLACE, &unique[0], num_materials, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+      #endif
+
+      for(int imat=0; imat<num_materials; ++imat){
+         if(unique[imat] == 0){
+            material_mask.assign(num_materials, -1);
+            break;
+         }
+      }
+
+   }
+
+   // check that incremental updates are possible
+   for(int imat=0; imat<num_materials; ++imat){
+      if(material_mask[imat] < 0) return false;
+   }
+
+   return true;
+
+}
+
+//------------------------------------------------------------------------------------------------------
+// Function to update energies from the change in exchange, anisotropy, applied and magnetostatic
+// energy of each material (in Tesla, summed over all CPUs) since the last update
+//------------------------------------------------------------------------------------------------------
+void energy_statistic_t::add_energy_change(const std::vector<double>& delta_energy){
+
+   const int num_materials = material_mask.size();
+
+   // add energy changes to mask energies
+   for(int imat=0; imat<num_materials; ++imat){
+      const int mask_id = material_mask[imat];
+      if(mask_id >= mask_size) continue; // non-magnetic materials are not output
+      exchange_energy[mask_id]      += delta_energy[4*imat+0];
+      anisotropy_energy[mask_id]    += delta_energy[4*imat+1];
+      applied_field_energy[mask_id] += delta_energy[4*imat+2];
+      magnetostatic_energy[mask_id] += delta_energy[4*imat+3];
+   }
+
+   for( int mask_id = 0; mask_id < mask_size; ++mask_id ){
+      total_energy[mask_id] = exchange_energy[mask_id] +
+                              anisotropy_energy[mask_id] +
+                              applied_field_energy[mask_id] +
+                              magnetostatic_energy[mask_id];
+   }
+
+   // add energies to mean energies
+   for(int mask_id=0; mask_id<mask_size; ++mask_id ){
+      mean_total_energy[mask_id]         += total_energy[mask_id];
+      mean_exchange_energy[mask_id]      += exchange_energy[mask_id];
+      mean_anisotropy_energy[mask_id]    += anisotropy_energy[mask_id];
+      mean_applied_field_energy[mask_id] += applied_field_energy[mask_id];
+      mean_magnetostatic_energy[mask_id] += magnetostatic_energy[mask_id];
+   }
+
+   // increment mean counter
+   mean_counter += 1.0;
+
+   return;
+
+}
+
 //------------------------------------------------------------------------------------------------------
 // Function to update mean counter
 //------------------------------------------------------------------------------------------------------
 void energy_statistic_t::update_mean_counter(long counter){
 
+   internal::complete_reduction();
+
    // update counter
    mean_counter += double(counter);
 
@@ -394,6 +519,8 @@ void energy_statistic_t::update_mean_counter(long counter){
 //------------------------------------------------------------------------------------------------------
 void energy_statistic_t::reset_averages(){
 
+   internal::complete_reduction();
+
    // reinitialise mean energies to zero
    std::fill(        mean_total_energy.begin(),         mean_total_energy.end(), 0.0);
    std::fill(     mean_exchange_energy.begin(),      mean_exchange_energy.end(), 0.0);
@@ -413,6 +540,8 @@ void energy_statistic_t::reset_averages(){
 //------------------------------------------------------------------------------------------------------
 std::string energy_statistic_t::output_energy(enum energy_t energy_type,bool header){
 
+   internal::complete_reduction();
+
    // result string stream
    std::ostringstream res;
    vout::fixed_width_output result(res,vout::fw_size);
@@ -467,6 +596,8 @@ std::string energy_statistic_t::output_energy(enum energy_t energy_type,bool hea
 //------------------------------------------------------------------------------------------------------
 std::string energy_statistic_t::output_mean_energy(enum energy_t energy_type,bool header){
 
+   internal::complete_reduction();
+
    // result string stream
    std::ostringstream res;
    vout::fixed_width_output result(res,vout::fw_size);
@@ -148,29 +148,77 @@ void magnetization_statistic_t::get_mask(std::vector<int>& out_mask, std::vector
 }
 
 //------------------------------------------------------------------------------------------------------
-// Function to calculate magnetisation of spins given a mask and place result in a magnetization array
+// Function to calculate magnetisation of spins on this processor given a mask and place result in a
+// magnetization array. The partial sums are added to the statistics reduction and the magnetization
+// is normalised in finalize_magnetization() once the reduction is complete.
 //------------------------------------------------------------------------------------------------------
-void magnetization_statistic_t::calculate_magnetization(const std::vector<double>& sx, // spin unit vector
-                                                        const std::vector<double>& sy,
-                                                        const std::vector<double>& sz,
-                                                        const std::vector<double>& mm){
+void magnetization_statistic_t::sum_magnetization(const std::vector<double>& sx, // spin unit vector
+                                                  const std::vector<double>& sy,
+                                                  const std::vector<double>& sz,
+                                                  const std::vector<double>& mm){
 
-   // initialise magnetization to zero [.end() seems to be optimised away by the compiler...]
-   std::fill(magnetization.begin(),magnetization.end(),0.0);
+   const std::vector<int>& ranges = stats::internal::active_atom_ranges;
+
+   if(ranges.size() == 0){
+
+      // initialise magnetization to zero [.end() seems to be optimised away by the compiler...]
+      std::fill(magnetization.begin(),magnetization.end(),0.0);
+
+      // calculate contributions of spins to each magetization category
+      for(int atom=0; atom<num_atoms; ++atom){
+         const int mask_id = mask[atom]; // get mask id
+         magnetization[4*mask_id + 0] += sx[atom]*mm[atom];
+         magnetization[4*mask_id + 1] += sy[atom]*mm[atom];
+         magnetization[4*mask_id + 2] += sz[atom]*mm[atom];
+         magnetization[4*mask_id + 3] += mm[atom];
+      }
+
+   }
+   else{
+
+      // calculate contributions of frozen spins outside active ranges only when ranges change
+      if(frozen_ranges_id != stats::internal::active_atom_ranges_id){
+         frozen_magnetization.assign(magnetization.size(), 0.0);
+         int start = 0;
+         for(unsigned int r = 0; r <= ranges.size(); r += 2){
+            const int end = r < ranges.size() ? ranges[r] : num_atoms;
+            for(int atom=start; atom<end; ++atom){
+               const int mask_id = mask[atom];
+               frozen_magnetization[4*mask_id + 0] += sx[atom]*mm[atom];
+               frozen_magnetization[4*mask_id + 1] += sy[atom]*mm[atom];
+               frozen_magnetization[4*mask_id + 2] += sz[atom]*mm[atom];
+               frozen_magnetization[4*mask_id + 3] += mm[atom];
+            }
+            if(r < ranges.size()) start = ranges[r + 1];
+         }
+         frozen_ranges_id = stats::internal::active_atom_ranges_id;
+      }
+
+      // add contributions of active spins
+      std::copy(frozen_magnetization.begin(), frozen_magnetization.end(), magnetization.begin());
+      for(unsigned int r = 0; r < ranges.size(); r += 2){
+         for(int atom=ranges[r]; atom<ranges[r + 1]; ++atom){
+            const int mask_id = mask[atom];
+            magnetization[4*mask_id + 0] += sx[atom]*mm[atom];
+            magnetization[4*mask_id + 1] += sy[atom]*mm[atom];
+            magnetization[4*mask_id + 2] += sz[atom]*mm[atom];
+            magnetization[4*mask_id + 3] += mm[atom];
+         }
+      }
 
-   // calculate contributions of spins to each magetization category
-   for(int atom=0; atom<num_atoms; ++atom){
-      const int mask_id = mask[atom]; // get mask id
-      magnetization[4*mask_id + 0] += sx[atom]*mm[atom];
-      magnetization[4*mask_id + 1] += sy[atom]*mm[atom];
-      magnetization[4*mask_id + 2] += sz[atom]*mm[atom];
-      magnetization[4*mask_id + 3] += mm[atom];
    }
 
    // Reduce on all CPUS
-   #ifdef MPICF
-      MPI_Allreduce(MPI_IN_PLACE, &magnetization[0], 4*mask_size, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-   #endif
+   stats::internal::add_to_reduction(magnetization, 4*mask_size);
+
+   return;
+
+}
+
+//------------------------------------------------------------------------------------------------------
+// Function to normalise reduced magnetisation and add to mean
+//------------------------------------------------------------------------------------------------------
+void magnetization_statistic_t::finalize_magnetization(){
 
    // Calculate magnetisation length and normalize
    for(int mask_id=0; mask_id<mask_size; ++mask_id){
@@ -203,6 +251,8 @@ void magnetization_statistic_t::calculate_magnetization(const std::vector<double
 //------------------------------------------------------------------------------------------------------
 const std::vector<double>& magnetization_statistic_t::get_magnetization(){
 
+   internal::complete_reduction();
+
    return magnetization;
 
 }
@@ -212,6 +262,8 @@ const std::vector<double>& magnetization_statistic_t::get_magnetization(){
 //------------------------------------------------------------------------------------------------------
 void magnetization_statistic_t::save_checkpoint(std::ofstream& chkfile){
 
+   internal::complete_reduction();
+
    const uint64_t num_elements = mean_magnetization.size();
 
    chkfile.write(reinterpret_cast<const char*>(&num_elements),sizeof(uint64_t));
@@ -226,6 +278,8 @@ void magnetization_statistic_t::save_checkpoint(std::ofstream& chkfile){
 //------------------------------------------------------------------------------------------------------
 void magnetization_statistic_t::load_checkpoint(std::ifstream& chkfile, bool chk_continue){
 
+   internal::complete_reduction();
+
    // load number of elements to see how much data to read
    uint64_t num_elements = 0;
    chkfile.read((char*)&num_elements,sizeof(uint64_t));
@@ -265,6 +319,8 @@ void magnetization_statistic_t::load_checkpoint(std::ifstream& chkfile, bool chk
 //------------------------------------------------------------------------------------------------------
 void magnetization_statistic_t::set_magnetization(std::vector<double>& new_magnetization, std::vector<double>& new_mean_magnetization, long counter){
 
+   internal::complete_reduction();
+
    // copy magnetization vector
    magnetization = new_magnetization;
    //magnetisation.swap(new_magnetization); fatsre but too dangerous?
@@ -284,6 +340,8 @@ void magnetization_statistic_t::set_magnetization(std::vector<double>& new_magne
 //------------------------------------------------------------------------------------------------------
 void magnetization_statistic_t::reset_magnetization_averages(){
 
+   internal::complete_reduction();
+
    // reinitialise mean magnetization to zero
    std::fill(mean_magnetization.begin(),mean_magnetization.end(),0.0);
 
@@ -299,6 +357,8 @@ void magnetization_statistic_t::reset_magnetization_averages(){
 //------------------------------------------------------------------------------------------------------
 std::string magnetization_statistic_t::output_normalized_magnetization(bool header){
 
+   internal::complete_reduction();
+
    // result string stream
    std::ostringstream res;
    // set custom precision if enabled
@@ -332,6 +392,8 @@ std::string magnetization_statistic_t::output_normalized_magnetization(bool head
 //------------------------------------------------------------------------------------------------------
 std::string magnetization_statistic_t::output_magnetization(bool header){
 
+   internal::complete_reduction();
+
    // result string stream
    std::ostringstream res;
 
@@ -367,6 +429,8 @@ std::string magnetization_statistic_t::output_magnetization(bool header){
 //------------------------------------------------------------------------------------------------------
 std::string magnetization_statistic_t::output_normalized_magnetization_length(bool header){
 
+   internal::complete_reduction();
+
    // result string stream
    std::ostringstream res;
 
@@ -397,6 +461,8 @@ std::string magnetization_statistic_t::output_normalized_magnetization_length(bo
 //------------------------------------------------------------------------------------------------------
 std::string magnetization_statistic_t::output_normalized_mean_magnetization(bool header){
 
+   internal::complete_reduction();
+
    // result string stream
    std::ostringstream res;
 
@@ -435,6 +501,8 @@ std::string magnetization_statistic_t::output_normalized_mean_magnetization(bool
 //------------------------------------------------------------------------------------------------------
 std::string magnetization_statistic_t::output_normalized_mean_magnetization_length(bool header){
 
+   internal::complete_reduction();
+
    // result string stream
    std::ostringstream res;
 
@@ -466,6 +534,8 @@ std::string magnetization_statistic_t::output_normalized_mean_magnetization_leng
 //------------------------------------------------------------------------------------------------------
 std::string magnetization_statistic_t::output_normalized_magnetization_dot_product(const std::vector<double>& vec,bool header){
 
+   internal::complete_reduction();
+
    // result string stream
    std::ostringstream res;
 
@@ -508,6 +578,8 @@ std::string magnetization_statistic_t::output_normalized_magnetization_dot_produ
 //------------------------------------------------------------------------------------------------------
 std::string magnetization_statistic_t::output_mean_magnetization_length(bool header){
 
+   internal::complete_reduction();
+
    // result string stream
    std::ostringstream res;
 
@@ -536,6 +608,8 @@ std::string magnetization_statistic_t::output_mean_magnetization_length(bool hea
 //------------------------------------------------------------------------------------------------------
 std::string magnetization_statistic_t::output_mean_magnetization(bool header){
 
+   internal::complete_reduction();
+
    // result string stream
    std::ostringstream res;
 
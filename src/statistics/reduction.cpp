@@ -0,0 +1,125 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) Richard F L Evans 2022. All rights reserved.
+//
+//   Email: richard.evans@york.ac.uk
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <algorithm>
+
+// Vampire headers
+#include "stats.hpp"
+#include "vmpi.hpp"
+
+namespace stats{
+
+   namespace internal{
+
+      //------------------------------------------------------------------------
+      // Partial sums of all statistics in the current update, reduced together
+      //------------------------------------------------------------------------
+      std::vector<double*> reduction_data; // location of partial sums
+      std::vector<int> reduction_size; // number of values in each partial sum
+      std::vector<double> reduction_buffer; // packed partial sums
+      bool reduction_pending = false; // flag to indicate update is not yet finalised
+
+      #ifdef MPICF
+         MPI_Request reduction_request = MPI_REQUEST_NULL;
+      #endif
+
+      //------------------------------------------------------------------------
+      // Function to add partial sums on this processor to the reduction
+      //------------------------------------------------------------------------
+      void add_to_reduction(std::vector<double>& data, const int size){
+
+         if(size <= 0) return;
+
+         reduction_data.push_back(&data[0]);
+         reduction_size.push_back(size);
+
+         return;
+
+      }
+
+      //------------------------------------------------------------------------
+      // Function to start reduction of all partial sums on all processors.
+      // Partial sums are packed into a single buffer and reduced with a single
+      // non-blocking collective, so that the reduction overlaps with the
+      // following integration. The update is finalised when the results are
+      // first needed. In serial the update is finalised immediately.
+      //------------------------------------------------------------------------
+      void start_reduction(){
+
+         reduction_pending = true;
+
+         #ifdef MPICF
+
+            // pack partial sums into buffer
+            reduction_buffer.clear();
+            for(unsigned int i = 0; i < reduction_data.size(); ++i){
+               reduction_buffer.insert(reduction_buffer.end(), reduction_data[i], reduction_data[i] + reduction_size[i]);
+            }
+
+            if(reduction_buffer.size() > 0){
+               #if MPI_VERSION >= 3
+                  MPI_Iallreduce(MPI_IN_PLACE, &reduction_buffer[0], reduction_buffer.size(), MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD, &reduction_request);
+               #else
+                  MPI_Allreduce(MPI_IN_PLACE, &reduction_buffer[0], reduction_buffer.size(), MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+               #endif
+            }
+
+         #else
+
+            internal::complete_reduction();
+
+         #endif
+
+         return;
+
+      }
+
+      //------------------------------------------------------------------------
+      // Function to wait for reduction of partial sums and finalise statistics.
+      // Called by all functions accessing statistics data, so that results are
+      // only waited for when they are needed.
+      //------------------------------------------------------------------------
+      void complete_reduction(){
+
+         if(!reduction_pending) return;
+
+         // unset flag first as finalising reads statistics data
+         reduction_pending = false;
+
+         #ifdef MPICF
+
+            #if MPI_VERSION >= 3
+               MPI_Wait(&reduction_request, MPI_STATUS_IGNORE);
+            #endif
+
+            // unpack reduced sums
+            std::vector<double>::const_iterator it = reduction_buffer.begin();
+            for(unsigned int i = 0; i < reduction_data.size(); ++i){
+               std::copy(it, it + reduction_size[i], reduction_data[i]);
+               it += reduction_size[i];
+            }
+
+         #endif
+
+         reduction_data.clear();
+         reduction_size.clear();
+
+         internal::finalize_update();
+
+         return;
+
+      }
+
+   } // end of internal namespace
+
+} // end of stats namespace
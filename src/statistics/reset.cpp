@@ -28,6 +28,9 @@ namespace stats{
          gpu::stats::reset();
       }
       else{
+         // calculate energies exactly at next update
+         stats::internal::exact_energy_required = true;
+
          // reset energy statistics
          if(stats::calculate_system_energy)                 stats::system_energy.reset_averages();
          if(stats::calculate_grain_energy)                  stats::grain_energy.reset_averages();
@@ -110,6 +110,8 @@ void specific_heat_statistic_t::calculate(const std::vector<double>& energy){
 //------------------------------------------------------------------------------------------------------
 void specific_heat_statistic_t::save_checkpoint(std::ofstream& chkfile){
 
+   internal::complete_reduction();
+
    const uint64_t num_elements = mean_specific_heat.size();
 
    chkfile.write(reinterpret_cast<const char*>(&num_elements),sizeof(uint64_t));
@@ -126,6 +128,8 @@ void specific_heat_statistic_t::save_checkpoint(std::ofstream& chkfile){
 //------------------------------------------------------------------------------------------------------
 void specific_heat_statistic_t::load_checkpoint(std::ifstream& chkfile, bool chk_continue){
 
+   internal::complete_reduction();
+
    // load number of elements to see how much data to read
    uint64_t num_elements = 0;
    chkfile.read((char*)&num_elements,sizeof(uint64_t));
@@ -168,6 +172,8 @@ void specific_heat_statistic_t::load_checkpoint(std::ifstream& chkfile, bool chk
 //------------------------------------------------------------------------------------------------------
 void specific_heat_statistic_t::reset_averages(){
 
+   internal::complete_reduction();
+
    // reinitialise mean magnetization to zero
    std::fill(mean_specific_heat.begin(),mean_specific_heat.end(),0.0);
    std::fill(mean_specific_heat_squared.begin(),mean_specific_heat_squared.end(),0.0);
@@ -184,15 +190,20 @@ void specific_heat_statistic_t::reset_averages(){
 //------------------------------------------------------------------------------------------------------
 std::string specific_heat_statistic_t::output_mean_specific_heat(const double temperature,bool header){
 
+   internal::complete_reduction();
+
    // result string stream
-   std::ostringstream result;
+   std::ostringstream res;
 
    // set custom precision if enabled
    if(vout::custom_precision){
-      result.precision(vout::precision);
-      if(vout::fixed) result.setf( std::ios::fixed, std::ios::floatfield );
+      res.precision(vout::precision);
+      if(vout::fixed) res.setf( std::ios::fixed, std::ios::floatfield );
    }
 
+   // columns are tab separated without fixed width
+   vout::fixed_width_output result(res,0);
+
    // determine inverse temperature mu_B/(kB T) (flushing to zero for very low temperatures to avoid NaN)
    const double itemp2 = temperature < 1.e-300 ? +0.0 : constants::muB / ( constants::kB * temperature * temperature );
 
@@ -207,9 +218,9 @@ std::string specific_heat_statistic_t::output_mean_specific_heat(const double te
       const double sh = prefactor * ( ( mean_specific_heat_squared[id] * imean_counter ) - ( mean_specific_heat[id] * mean_specific_heat[id] * imean_counter_sq) );
 
       if(header){
-          result<<name<<id<<"_spec_heat"<<"\t";
+          result << name + std::to_string(id) + "_spec_heat";
       }else{
-          result << sh << "\t";
+          result << sh;
       }
 
    }
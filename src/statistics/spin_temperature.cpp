@@ -101,7 +101,7 @@ void spin_temp_statistic_t::get_mask(std::vector<int>& out_mask){
 
 //------------------------------------------------------------------------------------------------------
 //------------------------------------------------------------------------------------------------------
-void spin_temp_statistic_t::calculate_spin_temp(const std::vector<double>& sx, // spin unit vector
+void spin_temp_statistic_t::sum_spin_temp(const std::vector<double>& sx, // spin unit vector
                                           const std::vector<double>& sy,
                                           const std::vector<double>& sz,
                                           const std::vector<double>& bxs, // spin fields (tesla)
@@ -146,9 +146,16 @@ void spin_temp_statistic_t::calculate_spin_temp(const std::vector<double>& sx, /
    // spin_temp[mask_id]=0.5* mu /constants::kB * SxH2 / SH;
 
    // Reduce on all CPUS
-   #ifdef MPICF
-      MPI_Allreduce(MPI_IN_PLACE, &spin_temp[0], mask_size, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-   #endif
+   stats::internal::add_to_reduction(spin_temp, mask_size);
+
+   return;
+
+}
+
+//------------------------------------------------------------------------------------------------------
+// Function to add reduced spin temperature to mean
+//------------------------------------------------------------------------------------------------------
+void spin_temp_statistic_t::finalize_spin_temp(){
 
    // Zero empty mask id's
    for(unsigned int id=0; id<zero_list.size(); ++id) spin_temp[zero_list[id]]=0.0;
@@ -165,6 +172,8 @@ void spin_temp_statistic_t::calculate_spin_temp(const std::vector<double>& sx, /
 //------------------------------------------------------------------------------------------------------
 const std::vector<double>& spin_temp_statistic_t::get_spin_temp(){
 
+   internal::complete_reduction();
+
    return spin_temp;
 
 }
@@ -173,6 +182,8 @@ const std::vector<double>& spin_temp_statistic_t::get_spin_temp(){
 //------------------------------------------------------------------------------------------------------
 void spin_temp_statistic_t::set_spin_temp(std::vector<double>& new_spin_temp, std::vector<double>& new_mean_spin_temp, long counter){
 
+   internal::complete_reduction();
+
    spin_temp = new_spin_temp;
 
    const size_t array_size = mean_spin_temp.size();
@@ -189,6 +200,8 @@ void spin_temp_statistic_t::set_spin_temp(std::vector<double>& new_spin_temp, st
 //------------------------------------------------------------------------------------------------------
 void spin_temp_statistic_t::reset_spin_temp_averages(){
 
+   internal::complete_reduction();
+
    std::fill(mean_spin_temp.begin(),mean_spin_temp.end(),0.0);
 
    // reset data counter
@@ -202,6 +215,8 @@ void spin_temp_statistic_t::reset_spin_temp_averages(){
 //------------------------------------------------------------------------------------------------------
 std::string spin_temp_statistic_t::output_spin_temp(bool header){
 
+   internal::complete_reduction();
+
    // result string stream
    std::ostringstream res;
 
@@ -229,6 +244,8 @@ std::string spin_temp_statistic_t::output_spin_temp(bool header){
 //------------------------------------------------------------------------------------------------------
 std::string spin_temp_statistic_t::output_mean_spin_temp(bool header){
 
+   internal::complete_reduction();
+
    // result string stream
    std::ostringstream res;
 
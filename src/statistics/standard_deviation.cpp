@@ -93,6 +93,8 @@ void standard_deviation_statistic_t::update(const std::vector<double>& magnetiza
 //------------------------------------------------------------------------------------------------------
 void standard_deviation_statistic_t::reset_averages(){
 
+   internal::complete_reduction();
+
    // reinitialise mean magnetization and residuals to zero
    std::fill(residual_sq.begin(),residual_sq.end(),0.0);
    std::fill(mean.begin(),mean.end(),0.0);
@@ -108,6 +110,8 @@ void standard_deviation_statistic_t::reset_averages(){
 //------------------------------------------------------------------------------------------------------
 std::string standard_deviation_statistic_t::output_standard_deviation(bool header){
 
+   internal::complete_reduction();
+
    // result string stream
    std::ostringstream res;
 
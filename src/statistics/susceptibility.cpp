@@ -132,6 +132,8 @@ void susceptibility_statistic_t::calculate(const std::vector<double>& magnetizat
 //------------------------------------------------------------------------------------------------------
 void susceptibility_statistic_t::save_checkpoint(std::ofstream& chkfile){
 
+   internal::complete_reduction();
+
    const uint64_t num_elements = mean_susceptibility.size();
 
    chkfile.write(reinterpret_cast<const char*>(&num_elements),sizeof(uint64_t));
@@ -148,6 +150,8 @@ void susceptibility_statistic_t::save_checkpoint(std::ofstream& chkfile){
 //------------------------------------------------------------------------------------------------------
 void susceptibility_statistic_t::load_checkpoint(std::ifstream& chkfile, bool chk_continue){
 
+   internal::complete_reduction();
+
    // load number of elements to see how much data to read
    uint64_t num_elements = 0;
    chkfile.read((char*)&num_elements,sizeof(uint64_t));
@@ -190,6 +194,8 @@ void susceptibility_statistic_t::load_checkpoint(std::ifstream& chkfile, bool ch
 //------------------------------------------------------------------------------------------------------
 void susceptibility_statistic_t::reset_averages(){
 
+   internal::complete_reduction();
+
    // reinitialise mean magnetization to zero
    std::fill(mean_susceptibility.begin(),mean_susceptibility.end(),0.0);
    std::fill(mean_susceptibility_squared.begin(),mean_susceptibility_squared.end(),0.0);
@@ -208,6 +214,8 @@ void susceptibility_statistic_t::reset_averages(){
 //------------------------------------------------------------------------------------------------------
 std::string susceptibility_statistic_t::output_mean_susceptibility(const double temperature, bool header){
 
+   internal::complete_reduction();
+
    // result string stream
    std::ostringstream res;
 
@@ -103,9 +103,10 @@ void torque_statistic_t::get_mask(std::vector<int>& out_mask){
 }
 
 //------------------------------------------------------------------------------------------------------
-// Function to calculate torques on spins given a mask and place result in a torque array
+// Function to calculate torques on spins on this processor given a mask and place result in a torque
+// array. The partial sums are added to the statistics reduction and finalised in finalize_torque().
 //------------------------------------------------------------------------------------------------------
-void torque_statistic_t::calculate_torque(const std::vector<double>& sx, // spin unit vector
+void torque_statistic_t::sum_torque(const std::vector<double>& sx, // spin unit vector
                                           const std::vector<double>& sy,
                                           const std::vector<double>& sz,
                                           const std::vector<double>& bxs, // spin fields (tesla)
@@ -145,9 +146,16 @@ void torque_statistic_t::calculate_torque(const std::vector<double>& sx, // spin
 	}
 
    // Reduce on all CPUS
-   #ifdef MPICF
-      MPI_Allreduce(MPI_IN_PLACE, &torque[0], 3*mask_size, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-   #endif
+   stats::internal::add_to_reduction(torque, 3*mask_size);
+
+   return;
+
+}
+
+//------------------------------------------------------------------------------------------------------
+// Function to add reduced torque to mean
+//------------------------------------------------------------------------------------------------------
+void torque_statistic_t::finalize_torque(){
 
    // Calculate magnetisation length and normalize
    /*for(int mask_id=0; mask_id < mask_size; ++mask_id){
@@ -178,6 +186,8 @@ void torque_statistic_t::calculate_torque(const std::vector<double>& sx, // spin
 //------------------------------------------------------------------------------------------------------
 const std::vector<double>& torque_statistic_t::get_torque(){
 
+   internal::complete_reduction();
+
    return torque;
 
 }
@@ -187,6 +197,8 @@ const std::vector<double>& torque_statistic_t::get_torque(){
 //------------------------------------------------------------------------------------------------------
 void torque_statistic_t::set_torque(std::vector<double>& new_torque, std::vector<double>& new_mean_torque, long counter){
 
+   internal::complete_reduction();
+
    // copy torque vector
    torque = new_torque;
 
@@ -205,6 +217,8 @@ void torque_statistic_t::set_torque(std::vector<double>& new_torque, std::vector
 //------------------------------------------------------------------------------------------------------
 void torque_statistic_t::reset_torque_averages(){
 
+   internal::complete_reduction();
+
    // reinitialise mean torque to zero
    std::fill(mean_torque.begin(),mean_torque.end(),0.0);
 
@@ -220,6 +234,8 @@ void torque_statistic_t::reset_torque_averages(){
 //------------------------------------------------------------------------------------------------------
 std::string torque_statistic_t::output_torque(bool header){
 
+   internal::complete_reduction();
+
    // result string stream
    std::ostringstream res;
 
@@ -253,6 +269,8 @@ std::string torque_statistic_t::output_torque(bool header){
 //------------------------------------------------------------------------------------------------------
 std::string torque_statistic_t::output_mean_torque(bool header){
 
+   internal::complete_reduction();
+
    // result string stream
    std::ostringstream res;
 
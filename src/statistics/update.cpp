@@ -15,8 +15,10 @@
 // Vampire headers
 #include "atoms.hpp"
 #include "gpu.hpp"
+#include "montecarlo.hpp"
 #include "sim.hpp"
 #include "stats.hpp"
+#include "vutil.hpp"
 
 namespace stats{
 
@@ -25,6 +27,98 @@ namespace stats{
    //-----------------------------------------------------------------------------
    namespace internal{
 
+      //------------------------------------------------------------------------------------------------------
+      // Function to collect the energy changes of accepted Monte Carlo moves since the last update and
+      // determine if they can be used to update the energies instead of a full calculation. Energies are
+      // calculated exactly after a reset, on changes of temperature or applied field (which change the
+      // energy of unmoved spins) and periodically to remove accumulated rounding errors.
+      //------------------------------------------------------------------------------------------------------
+      bool incremental_energy_update(const double temperature, std::vector<double>& delta_energy){
+
+         // maximum number of incremental updates between exact calculations
+         const int max_incremental_energy_updates = 100;
+
+         // always collect energy changes so that they are discarded after an exact calculation
+         const bool recorded = montecarlo::get_energy_change(delta_energy);
+
+         const bool monte_carlo = sim::integrator == sim::monte_carlo || sim::integrator == sim::cmc || sim::integrator == sim::hybrid_cmc;
+
+         const bool unchanged = temperature  == internal::last_energy_temperature &&
+                                sim::H_applied == internal::last_energy_applied_field[0] &&
+                                sim::H_vec[0]  == internal::last_energy_applied_field[1] &&
+                                sim::H_vec[1]  == internal::last_energy_applied_field[2] &&
+                                sim::H_vec[2]  == internal::last_energy_applied_field[3];
+
+         if(recorded && monte_carlo && unchanged && !internal::exact_energy_required &&
+            internal::num_incremental_energy_updates < max_incremental_energy_updates){
+            internal::num_incremental_energy_updates++;
+            return true;
+         }
+
+         // otherwise save state for exact calculation
+         internal::exact_energy_required = false;
+         internal::num_incremental_energy_updates = 0;
+         internal::last_energy_temperature = temperature;
+         internal::last_energy_applied_field[0] = sim::H_applied;
+         internal::last_energy_applied_field[1] = sim::H_vec[0];
+         internal::last_energy_applied_field[2] = sim::H_vec[1];
+         internal::last_energy_applied_field[3] = sim::H_vec[2];
+
+         return false;
+
+      }
+
+      //------------------------------------------------------------------------------------------------------
+      // Function to finalise statistics once the partial sums of the current update have been reduced
+      //------------------------------------------------------------------------------------------------------
+      void finalize_update(){
+
+         // update energy statistics
+         stats::internal::finalize_energies(stats::internal::exact_energy_statistics);
+         for(unsigned int i = 0; i < stats::internal::incremental_energy_statistics.size(); ++i){
+            stats::internal::incremental_energy_statistics[i]->add_energy_change(stats::internal::energy_change);
+         }
+
+         // update magnetization statistics
+         if(stats::calculate_system_magnetization)          stats::system_magnetization.finalize_magnetization();
+         if(stats::calculate_grain_magnetization)           stats::grain_magnetization.finalize_magnetization();
+         if(stats::calculate_material_magnetization)        stats::material_magnetization.finalize_magnetization();
+         if(stats::calculate_material_grain_magnetization)  stats::material_grain_magnetization.finalize_magnetization();
+         if(stats::calculate_height_magnetization)          stats::height_magnetization.finalize_magnetization();
+         if(stats::calculate_material_height_magnetization) stats::material_height_magnetization.finalize_magnetization();
+         if(stats::calculate_material_grain_height_magnetization) stats::material_grain_height_magnetization.finalize_magnetization();
+
+         // update torque statistics
+         if(stats::calculate_system_torque)          stats::system_torque.finalize_torque();
+         if(stats::calculate_grain_torque)           stats::grain_torque.finalize_torque();
+         if(stats::calculate_material_torque)        stats::material_torque.finalize_torque();
+
+         // update spin temp
+         if(stats::calculate_system_spin_temp)          stats::system_spin_temp.finalize_spin_temp();
+         if(stats::calculate_grain_spin_temp)           stats::grain_spin_temp.finalize_spin_temp();
+         if(stats::calculate_material_spin_temp)        stats::material_spin_temp.finalize_spin_temp();
+
+         // update specific heat statistics
+         if(stats::calculate_system_specific_heat)         stats::system_specific_heat.calculate(stats::system_energy.get_total_energy());
+         if(stats::calculate_grain_specific_heat)          stats::grain_specific_heat.calculate(stats::grain_energy.get_total_energy());
+         if(stats::calculate_material_specific_heat)       stats::material_specific_heat.calculate(stats::material_energy.get_total_energy());
+
+         // standard deviation in time-step
+         if(stats::calculate_material_standard_deviation)  stats::material_standard_deviation.update(stats::system_magnetization.get_magnetization());
+
+         // update susceptibility statistics
+         if(stats::calculate_system_susceptibility)        stats::system_susceptibility.calculate(stats::system_magnetization.get_magnetization());
+         if(stats::calculate_grain_susceptibility)         stats::grain_susceptibility.calculate(stats::grain_magnetization.get_magnetization());
+         if(stats::calculate_material_susceptibility)      stats::material_susceptibility.calculate(stats::material_magnetization.get_magnetization());
+
+         // update binder cumulant statistics
+         if(stats::calculate_system_binder_cumulant)         stats::system_binder_cumulant.calculate(stats::system_magnetization.get_magnetization());
+         if(stats::calculate_material_binder_cumulant)       stats::material_binder_cumulant.calculate(stats::material_magnetization.get_magnetization());
+
+         return;
+
+      }
+
       //------------------------------------------------------------------------------------------------------
       // Function to update required statistics classes
       //------------------------------------------------------------------------------------------------------
@@ -47,46 +141,52 @@ namespace stats{
             gpu::stats::update();
          }
          else{
-            // update energy statistics
-            if(stats::calculate_system_energy)                 stats::system_energy.calculate(sx, sy, sz, mm, mat, temperature);
-            if(stats::calculate_grain_energy)                  stats::grain_energy.calculate(sx, sy, sz, mm, mat, temperature);
-            if(stats::calculate_material_energy)               stats::material_energy.calculate(sx, sy, sz, mm, mat, temperature);
+
+            // finalise previous update if still waiting for reduction
+            stats::internal::complete_reduction();
+
+            // update energy statistics, using energy changes of Monte Carlo moves where possible
+            const bool incremental = stats::internal::incremental_energy_update(temperature, stats::internal::energy_change);
+            const int num_materials = stats::internal::energy_change.size()/4;
+
+            // list of energy statistics requiring a full calculation, evaluated together
+            std::vector<energy_statistic_t*>& exact = stats::internal::exact_energy_statistics;
+            std::vector<energy_statistic_t*>& changed = stats::internal::incremental_energy_statistics;
+            exact.clear();
+            changed.clear();
+            if(stats::calculate_system_energy){
+               if(incremental && stats::system_energy.has_material_mask(num_materials, mat)) changed.push_back(&stats::system_energy);
+               else exact.push_back(&stats::system_energy);
+            }
+            if(stats::calculate_grain_energy)                  exact.push_back(&stats::grain_energy);
+            if(stats::calculate_material_energy){
+               if(incremental && stats::material_energy.has_material_mask(num_materials, mat)) changed.push_back(&stats::material_energy);
+               else exact.push_back(&stats::material_energy);
+            }
+            stats::internal::sum_energies(exact, sx, sy, sz, mm, mat, temperature);
+            if(changed.size() > 0) stats::internal::add_to_reduction(stats::internal::energy_change, 4*num_materials);
 
             // update magnetization statistics
-            if(stats::calculate_system_magnetization)          stats::system_magnetization.calculate_magnetization(sx,sy,sz,mm);
-            if(stats::calculate_grain_magnetization)           stats::grain_magnetization.calculate_magnetization(sx,sy,sz,mm);
-            if(stats::calculate_material_magnetization)        stats::material_magnetization.calculate_magnetization(sx,sy,sz,mm);
-            if(stats::calculate_material_grain_magnetization)  stats::material_grain_magnetization.calculate_magnetization(sx,sy,sz,mm);
-            if(stats::calculate_height_magnetization)          stats::height_magnetization.calculate_magnetization(sx,sy,sz,mm);
-            if(stats::calculate_material_height_magnetization) stats::material_height_magnetization.calculate_magnetization(sx,sy,sz,mm);
-            if(stats::calculate_material_grain_height_magnetization) stats::material_grain_height_magnetization.calculate_magnetization(sx,sy,sz,mm);
+            if(stats::calculate_system_magnetization)          stats::system_magnetization.sum_magnetization(sx,sy,sz,mm);
+            if(stats::calculate_grain_magnetization)           stats::grain_magnetization.sum_magnetization(sx,sy,sz,mm);
+            if(stats::calculate_material_magnetization)        stats::material_magnetization.sum_magnetization(sx,sy,sz,mm);
+            if(stats::calculate_material_grain_magnetization)  stats::material_grain_magnetization.sum_magnetization(sx,sy,sz,mm);
+            if(stats::calculate_height_magnetization)          stats::height_magnetization.sum_magnetization(sx,sy,sz,mm);
+            if(stats::calculate_material_height_magnetization) stats::material_height_magnetization.sum_magnetization(sx,sy,sz,mm);
+            if(stats::calculate_material_grain_height_magnetization) stats::material_grain_height_magnetization.sum_magnetization(sx,sy,sz,mm);
 
             // update torque statistics
-            if(stats::calculate_system_torque)          stats::system_torque.calculate_torque(sx,sy,sz,bxs,bys,bzs,bxe,bye,bze,mm);
-            if(stats::calculate_grain_torque)           stats::grain_torque.calculate_torque(sx,sy,sz,bxs,bys,bzs,bxe,bye,bze,mm);
-            if(stats::calculate_material_torque)        stats::material_torque.calculate_torque(sx,sy,sz,bxs,bys,bzs,bxe,bye,bze,mm);
+            if(stats::calculate_system_torque)          stats::system_torque.sum_torque(sx,sy,sz,bxs,bys,bzs,bxe,bye,bze,mm);
+            if(stats::calculate_grain_torque)           stats::grain_torque.sum_torque(sx,sy,sz,bxs,bys,bzs,bxe,bye,bze,mm);
+            if(stats::calculate_material_torque)        stats::material_torque.sum_torque(sx,sy,sz,bxs,bys,bzs,bxe,bye,bze,mm);
 
             // update spin temp
-            if(stats::calculate_system_spin_temp)          stats::system_spin_temp.calculate_spin_temp(sx,sy,sz,bxs,bys,bzs,bxe,bye,bze,mm);
-            if(stats::calculate_grain_spin_temp)           stats::grain_spin_temp.calculate_spin_temp(sx,sy,sz,bxs,bys,bzs,bxe,bye,bze,mm);
-            if(stats::calculate_material_spin_temp)        stats::material_spin_temp.calculate_spin_temp(sx,sy,sz,bxs,bys,bzs,bxe,bye,bze,mm);
-
-            // update specific heat statistics
-            if(stats::calculate_system_specific_heat)         stats::system_specific_heat.calculate(stats::system_energy.get_total_energy());
-            if(stats::calculate_grain_specific_heat)          stats::grain_specific_heat.calculate(stats::grain_energy.get_total_energy());
-            if(stats::calculate_material_specific_heat)       stats::material_specific_heat.calculate(stats::material_energy.get_total_energy());
-
-            // standard deviation in time-step
-            if(stats::calculate_material_standard_deviation)  stats::material_standard_deviation.update(stats::system_magnetization.get_magnetization());
-
-            // update susceptibility statistics
-            if(stats::calculate_system_susceptibility)        stats::system_susceptibility.calculate(stats::system_magnetization.get_magnetization());
-            if(stats::calculate_grain_susceptibility)         stats::grain_susceptibility.calculate(stats::grain_magnetization.get_magnetization());
-            if(stats::calculate_material_susceptibility)      stats::material_susceptibility.calculate(stats::material_magnetization.get_magnetization());
+            if(stats::calculate_system_spin_temp)          stats::system_spin_temp.sum_spin_temp(sx,sy,sz,bxs,bys,bzs,bxe,bye,bze,mm);
+            if(stats::calculate_grain_spin_temp)           stats::grain_spin_temp.sum_spin_temp(sx,sy,sz,bxs,bys,bzs,bxe,bye,bze,mm);
+            if(stats::calculate_material_spin_temp)        stats::material_spin_temp.sum_spin_temp(sx,sy,sz,bxs,bys,bzs,bxe,bye,bze,mm);
 
-            // update binder cumulant statistics
-            if(stats::calculate_system_binder_cumulant)         stats::system_binder_cumulant.calculate(stats::system_magnetization.get_magnetization());
-            if(stats::calculate_material_binder_cumulant)       stats::material_binder_cumulant.calculate(stats::material_magnetization.get_magnetization());
+            // reduce partial sums of all statistics on all processors together
+            stats::internal::start_reduction();
 
          }
 
@@ -101,6 +201,9 @@ namespace stats{
    //------------------------------------------------------------------------------------------------------
    void update(){
 
+      // time statistics update
+      vutil::profile::scope_t profile(vutil::profile::stats);
+
       // call actual function, picking up arguments directly from namespace header files
       stats::internal::update(atoms::x_spin_array, 				  		atoms::y_spin_array, 				    atoms::z_spin_array,
    					            atoms::x_total_spin_field_array,     atoms::y_total_spin_field_array, 	 atoms::z_total_spin_field_array,
@@ -111,5 +214,17 @@ namespace stats{
 
    }
 
+   //------------------------------------------------------------------------------------------------------
+   // Function to restrict magnetization updates to ranges of atoms, for example in a region around a HAMR
+   // head. Spins outside the ranges are frozen, so their contributions are calculated once and cached.
+   //------------------------------------------------------------------------------------------------------
+   void set_active_atom_ranges(const std::vector<int>& ranges){
+
+      stats::internal::active_atom_ranges = ranges;
+      stats::internal::active_atom_ranges_id++;
+
+      return;
+
+   }
 
 } // end of stats namespace
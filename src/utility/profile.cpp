@@ -0,0 +1,113 @@
+//-----------------------------------------------------------------------------
+//
+// This source file is part of the VAMPIRE open source package under the
+// GNU GPL (version 2) licence (see licence file for details).
+//
+// (c) R F L Evans 2015. All rights reserved.
+//
+//-----------------------------------------------------------------------------
+
+// C++ standard library headers
+#include <fstream>
+#include <iomanip>
+#include <vector>
+
+// Vampire headers
+#include "vio.hpp"
+#include "vmpi.hpp"
+#include "vutil.hpp"
+
+namespace vutil{
+
+namespace profile{
+
+   //---------------------------------------------------------------------------
+   // Shared variables for profiler
+   //---------------------------------------------------------------------------
+   bool enabled = false; // flag to enable profiling
+
+   // accumulated time and number of calls for each section
+   double section_time[num_sections] = {0.0};
+   uint64_t section_calls[num_sections] = {0};
+
+   // names of sections for output
+   const char* section_names[num_sections] = { "integrate", "exchange", "anisotropy", "thermal", "applied-field",
+                                               "dipole", "cells", "statistics", "config", "halo-swap" };
+
+   //---------------------------------------------------------------------------
+   // Function to add time for single call of section
+   //---------------------------------------------------------------------------
+   void add(const section_t section, const double time){
+      // sections may be timed by several threads
+      #pragma omp atomic
+      section_time[section] += time;
+      #pragma omp atomic
+      section_calls[section]++;
+      return;
+   }
+
+   //---------------------------------------------------------------------------
+   // Function to output profile to profile.json and profile.csv with the
+   // minimum, average and maximum times across all processors
+   //---------------------------------------------------------------------------
+   void output(const double total_time){
+
+      if(!enabled) return;
+
+      std::vector<double> min_time(section_time, section_time + num_sections);
+      std::vector<double> max_time(section_time, section_time + num_sections);
+      std::vector<double> avg_time(section_time, section_time + num_sections);
+
+      // aggregate times over all processors
+      #ifdef MPICF
+         MPI_Reduce(section_time, &min_time[0], num_sections, MPI_DOUBLE, MPI_MIN, 0, MPI_COMM_WORLD);
+         MPI_Reduce(section_time, &max_time[0], num_sections, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+         MPI_Reduce(section_time, &avg_time[0], num_sections, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+         for(int s = 0; s < num_sections; s++) avg_time[s] /= double(vmpi::num_processors);
+      #endif
+
+      if(vmpi::my_rank != 0) return;
+
+      const double inv_total_time = total_time > 0.0 ? 1.0/total_time : 0.0;
+
+      // output machine readable json file
+      std::ofstream jfile("profile.json");
+      jfile << std::setprecision(6);
+      jfile << "{" << std::endl;
+      jfile << "   \"num_processors\": " << vmpi::num_processors << "," << std::endl;
+      jfile << "   \"total_time\": " << total_time << "," << std::endl;
+      jfile << "   \"sections\": [" << std::endl;
+      for(int s = 0; s < num_sections; s++){
+         jfile << "      { \"name\": \"" << section_names[s] << "\", \"calls\": " << section_calls[s]
+               << ", \"min_time\": " << min_time[s] << ", \"avg_time\": " << avg_time[s]
+               << ", \"max_time\": " << max_time[s] << ", \"fraction\": " << avg_time[s]*inv_total_time << " }";
+         if(s < num_sections - 1) jfile << ",";
+         jfile << std::endl;
+      }
+      jfile << "   ]" << std::endl;
+      jfile << "}" << std::endl;
+
+      // output csv file for spreadsheets and plotting
+      std::ofstream cfile("profile.csv");
+      cfile << std::setprecision(6);
+      cfile << "section,calls,min_time,avg_time,max_time,fraction" << std::endl;
+      for(int s = 0; s < num_sections; s++){
+         cfile << section_names[s] << "," << section_calls[s] << "," << min_time[s] << ","
+               << avg_time[s] << "," << max_time[s] << "," << avg_time[s]*inv_total_time << std::endl;
+      }
+
+      // print summary to log file
+      zlog << zTs() << "Performance profile (average time over " << vmpi::num_processors << " processors):" << std::endl;
+      for(int s = 0; s < num_sections; s++){
+         zlog << zTs() << "\t" << std::left << std::setw(16) << section_names[s] << std::right << std::setw(12) << avg_time[s]
+              << " s " << std::setw(8) << 100.0*avg_time[s]*inv_total_time << " %" << std::endl;
+      }
+      zlog << zTs() << "Profile written to profile.json and profile.csv" << std::endl;
+
+      return;
+
+   }
+
+} // end of namespace profile
+
+} // end of namespace vutil
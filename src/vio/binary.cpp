@@ -0,0 +1,181 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) Richard F L Evans 2022. All rights reserved.
+//
+//   Email: richard.evans@york.ac.uk
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <cstring>
+#include <limits>
+#include <sstream>
+
+// Vampire headers
+#include "errors.hpp"
+#include "vio.hpp"
+
+// vio module headers
+#include "internal.hpp"
+
+namespace vout{
+
+namespace binary{
+
+   file_t output_file; // binary output file
+   file_t grain_file; // binary grain file
+
+   //---------------------------------------------------------------------------
+   // Function to determine if text output files are written
+   //---------------------------------------------------------------------------
+   bool text_output(){
+      return format != binary;
+   }
+
+   //---------------------------------------------------------------------------
+   // Function to determine if binary output files are written
+   //---------------------------------------------------------------------------
+   bool binary_output(){
+      return format != text;
+   }
+
+   //---------------------------------------------------------------------------
+   // Function to determine if a file should be flushed to disk, resetting the
+   // time of the last flush if so
+   //---------------------------------------------------------------------------
+   bool flush_due(std::chrono::steady_clock::time_point& last_flush){
+
+      const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+      if(std::chrono::duration<double>(now - last_flush).count() < flush_interval) return false;
+
+      last_flush = now;
+
+      return true;
+
+   }
+
+   //---------------------------------------------------------------------------
+   // Function to append a double to a buffer in little endian byte order
+   //---------------------------------------------------------------------------
+   void append_little_endian(std::vector<char>& buffer, const double value){
+
+      char bytes[sizeof(double)];
+      std::memcpy(bytes, &value, sizeof(double));
+
+      // determine host byte order
+      const uint16_t test = 1;
+      const bool little_endian = *reinterpret_cast<const char*>(&test) == 1;
+
+      if(little_endian) buffer.insert(buffer.end(), bytes, bytes + sizeof(double));
+      else for(int i = sizeof(double) - 1; i >= 0; i--) buffer.push_back(bytes[i]);
+
+      return;
+
+   }
+
+   //---------------------------------------------------------------------------
+   // binary file class functions
+   //---------------------------------------------------------------------------
+   file_t::file_t():
+      num_columns(0),
+      column_warning(false),
+      last_flush(std::chrono::steady_clock::now())
+   {}
+
+   file_t::~file_t(){
+      if(file.is_open()){
+         flush();
+         file.close();
+      }
+   }
+
+   bool file_t::is_open(){
+      return file.is_open();
+   }
+
+   //---------------------------------------------------------------------------
+   // Function to open binary file with one column for each name. When
+   // appending to an existing file after a checkpoint the existing schema
+   // header is kept.
+   //---------------------------------------------------------------------------
+   void file_t::open(const std::string file_name, const bool append, const std::vector<std::string>& column_names){
+
+      if(append) file.open(file_name.c_str(), std::ofstream::binary | std::ofstream::app);
+      else file.open(file_name.c_str(), std::ofstream::binary | std::ofstream::trunc);
+
+      if(!file.is_open()){
+         terminaltextcolor(RED);
+         std::cerr << "Error - unable to open binary output file " << file_name << " for writing" << std::endl;
+         terminaltextcolor(WHITE);
+         zlog << zTs() << "Error - unable to open binary output file " << file_name << " for writing" << std::endl;
+         err::vexit();
+      }
+
+      num_columns = column_names.size();
+      buffer.reserve(buffer_size + 4096);
+      record.reserve(num_columns);
+      last_flush = std::chrono::steady_clock::now();
+
+      if(!append){
+         std::ostringstream header;
+         header << "# vampire binary output file\n";
+         header << "format float64-little-endian\n";
+         header << "columns " << num_columns << "\n";
+         for(unsigned int i = 0; i < num_columns; i++) header << column_names[i] << "\n";
+         header << "end-of-header\n";
+         const std::string header_str = header.str();
+         buffer.insert(buffer.end(), header_str.begin(), header_str.end());
+      }
+
+      zlog << zTs() << "Opened binary output file " << file_name << " with " << num_columns << " columns and write buffer of " << buffer_size/1024 << " kB" << std::endl;
+
+      return;
+
+   }
+
+   //---------------------------------------------------------------------------
+   // Function to add the current record of column values to the binary file
+   //---------------------------------------------------------------------------
+   void file_t::write_record(){
+
+      // pad or truncate values to the fixed record width
+      if(record.size() != num_columns){
+         if(!column_warning){
+            zlog << zTs() << "Warning - binary output row has " << record.size() << " columns but schema has " << num_columns << " columns" << std::endl;
+            column_warning = true;
+         }
+         record.resize(num_columns, std::numeric_limits<double>::quiet_NaN());
+      }
+
+      for(unsigned int i = 0; i < num_columns; i++) append_little_endian(buffer, record[i]);
+      record.clear();
+
+      // write buffer to disk when full or after flush interval
+      if(buffer.size() >= buffer_size || flush_due(last_flush)) flush();
+
+      return;
+
+   }
+
+   //---------------------------------------------------------------------------
+   // Function to write buffered records to disk
+   //---------------------------------------------------------------------------
+   void file_t::flush(){
+
+      if(buffer.size() > 0) file.write(&buffer[0], buffer.size());
+      file.flush();
+      buffer.clear();
+      last_flush = std::chrono::steady_clock::now();
+
+      return;
+
+   }
+
+} // end of binary namespace
+
+} // end of vout namespace
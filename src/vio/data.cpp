@@ -46,6 +46,8 @@ namespace vout{
    int fw_size_int = 11;
    bool fixed = false; // fixed precision output
    bool header_option = false; // output column headers on output file
+   std::vector<double>* column_values = NULL; // destination of column values for binary output
+   std::vector<std::string>* column_names = NULL; // destination of column names for binary output
    int max_header=14;
 	// Namespace variable declarations
 	std::vector<unsigned int> file_output_list(0);
@@ -67,4 +69,12 @@ namespace vout{
       std::vector<grain::output_t> output_list(0);
    }
 
+   namespace binary{
+
+      format_t format = text; // format of output and grain files
+      uint64_t buffer_size = 4*1024*1024; // size of write buffer before flushing to disk (bytes)
+      double flush_interval = 10.0; // maximum time between flushes of output files to disk (s)
+
+   }
+
 }
@@ -81,6 +81,9 @@ void write_output_file_header(std::ofstream& ofile, std::vector<unsigned int>& f
 
 namespace vout{
 
+   // time of last flush of output file to disk
+   std::chrono::steady_clock::time_point zmag_last_flush = std::chrono::steady_clock::now();
+
    void output_switch(std::ostream& stream,unsigned int idx,bool header){
       //stream.precision(vout::precision);
       switch(idx){
@@ -316,13 +319,55 @@ namespace vout{
          for(unsigned int item=0;item<list.size();item++){
             output_switch(stream,list[item],header);
          }
-         // Carriage return
-         if(list.size()>0) stream << std::endl;
+         // Carriage return (files are flushed periodically rather than on every line)
+         if(list.size()>0){
+            if(&stream == &std::cout) stream << std::endl;
+            else stream << "\n";
+         }
 
       } // end of code for rank 0 only
       header = false;
    }
 
+   //-------------------------------------------------------------------------
+   // Function to collect the names of all output columns for binary files
+   //-------------------------------------------------------------------------
+   std::vector<std::string> binary_column_names(std::vector<unsigned int>& list){
+
+      std::vector<std::string> names;
+      std::ostringstream unused; // nothing is written to stream while collecting names
+
+      vout::column_names = &names;
+      for(unsigned int item=0;item<list.size();item++) output_switch(unused,list[item],true);
+      vout::column_names = NULL;
+
+      return names;
+
+   }
+
+   //-------------------------------------------------------------------------
+   // Function to write a row of output data to a binary file. Values are
+   // collected directly from the output functions without text formatting.
+   //-------------------------------------------------------------------------
+   void write_binary_out(binary::file_t& file, std::vector<unsigned int>& list){
+
+      if(vmpi::my_rank != 0 || list.size() == 0) return;
+
+      // For gpu acceleration get statistics from device
+      if(gpu::acceleration) gpu::stats::get();
+
+      std::ostringstream unused; // nothing is written to stream while collecting values
+
+      vout::column_values = &file.record;
+      for(unsigned int item=0;item<list.size();item++) output_switch(unused,list[item],false);
+      vout::column_values = NULL;
+
+      file.write_record();
+
+      return;
+
+   }
+
    //-------------------------------------------
 	// Data output wrapper function
    //-------------------------------------------
@@ -359,21 +404,30 @@ namespace vout{
 
       // check for open ofstream on root process only
       if(vmpi::my_rank == 0){
+         const bool append = sim::load_checkpoint_flag && sim::load_checkpoint_continue_flag;
          if(!zmag.is_open()){
             // check for checkpoint continue and append data
-            if(sim::load_checkpoint_flag && sim::load_checkpoint_continue_flag) zmag.open(vout::output_file_name,std::ofstream::app);
+            if(append) zmag.open(vout::output_file_name,std::ofstream::app);
             // otherwise overwrite file
             else{
                zmag.open(vout::output_file_name,std::ofstream::trunc);
                // write file header information
                write_output_file_header(zmag, file_output_list);
+               if(!binary::text_output()) zmag << "# data written to binary file " << vout::output_file_name << ".bin" << std::endl;
             }
          }
+         if(binary::binary_output() && !binary::output_file.is_open()){
+            binary::output_file.open(vout::output_file_name + ".bin", append, binary_column_names(file_output_list));
+         }
       }
 
       // Only output 1/output_rate time steps// This is all serialised inside the write_output fn - AJN
       if(sim::time%vout::output_rate==0){
-         write_out(zmag,file_output_list);
+         if(binary::text_output()){
+            write_out(zmag,file_output_list);
+            if(vmpi::my_rank == 0 && binary::flush_due(zmag_last_flush)) zmag.flush();
+         }
+         if(binary::binary_output()) write_binary_out(binary::output_file,file_output_list);
       } // end of if statement for output rate
 
       if(sim::time%vout::output_rate==0){ // needs to be altered to separate variable at some point
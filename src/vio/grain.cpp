@@ -11,6 +11,7 @@
 //
 
 // C++ standard library headers
+#include <sstream>
 
 // Vampire headers
 #include "vio.hpp"
@@ -24,6 +25,104 @@
 
 namespace vout{
 
+// time of last flush of grain file to disk
+std::chrono::steady_clock::time_point zgrain_last_flush = std::chrono::steady_clock::now();
+
+//------------------------------------------------------------------------------
+// Function to write a row of grain data (or column names) to a stream
+//------------------------------------------------------------------------------
+void write_grain_row(std::ostream& stream, bool header){
+
+   // loop over all data in the output data list
+   for(unsigned int item=0; item < vout::grain::output_list.size(); item++){
+
+      switch(vout::grain::output_list[item]){
+         //------------------------------------------
+         case grain::time_steps:
+            vout::time(stream,header);
+            break;
+         //------------------------------------------
+         case grain::real_time:
+            vout::real_time(stream,header);
+            break;
+         //------------------------------------------
+         case grain::temperature:
+            vout::temperature(stream,header);
+            break;
+         //------------------------------------------
+         case grain::electron_temperature:
+            vout::temperature(stream,header);
+            break;
+         //------------------------------------------
+         case grain::phonon_temperature:
+            vout::phonon_temperature(stream,header);
+            break;
+         //------------------------------------------
+         case grain::applied_field:
+            vout::Happ(stream,header);
+            break;
+         //------------------------------------------
+         case grain::applied_field_unit_vector:
+            vout::Hvec(stream,header);
+            break;
+         //------------------------------------------
+         case grain::constraint_phi:
+            stream << generic_output_double("con_phi",sim::constraint_phi,header);
+            break;
+         //------------------------------------------
+         case grain::constraint_theta:
+            stream << generic_output_double("con_theta",sim::constraint_theta,header);
+            break;
+         //------------------------------------------
+         case grain::magnetisation:
+            // inline function to output grain data
+            stream << stats::grain_magnetization.output_normalized_magnetization(header);
+            break;
+         //------------------------------------------
+         case grain::mean_magnetisation_length:
+            // inline function to output grain data
+            stream << stats::grain_magnetization.output_normalized_mean_magnetization_length(header);
+            break;
+         //------------------------------------------
+         case grain::material_magnetisation:
+            // inline function to output grain data
+            stream << stats::material_grain_magnetization.output_normalized_magnetization(header);
+            break;
+         //------------------------------------------
+         case grain::material_height_magnetisation:
+            // inline function to output grain data
+            stream << stats::material_grain_height_magnetization.output_normalized_magnetization(header);
+            break;
+         //------------------------------------------
+         case grain::mean_torque:
+            // inline function to output grain data
+            stream << stats::grain_torque.output_mean_torque(header);
+            break;
+         //------------------------------------------
+         case grain::mean_susceptibility:
+            // inline function to output grain data
+            stream << stats::grain_susceptibility.output_mean_susceptibility(sim::temperature, header);
+            break;
+         //------------------------------------------
+         case grain::mean_specific_heat:
+            // inline function to output grain data
+            stream << stats::grain_specific_heat.output_mean_specific_heat(sim::temperature, header);
+            break;
+         //------------------------------------------
+         //case grain::mean_spin_temp:
+         //   // inline function to output grain data
+         //   stream << stats::grain_specific_heat.output_mean_specific_heat(sim::temperature, header);
+         //   break;
+         //------------------------------------------
+
+      } // end of case statement
+
+   } // end of output list loop
+
+   return;
+
+}
+
 void write_grain_file(){
 
    // do nothing if no grain items specified
@@ -32,108 +131,51 @@ void write_grain_file(){
    // check it is time to output a new data point
    if(sim::time % vout::grain::output_rate == 0){
 
-      // disable headers for variables
-      bool header = false;
-
       // Output data to zgrain
       if(vmpi::my_rank==0){
 
-         // check for open ofstream
-         if( !zgrain.is_open() ){
-            // check for checkpoint continue and append data
-            if(sim::load_checkpoint_flag && sim::load_checkpoint_continue_flag) zgrain.open("grain.txt",std::ofstream::app);
-            // otherwise overwrite file
-            else zgrain.open("grain.txt",std::ofstream::trunc);
+         const bool append = sim::load_checkpoint_flag && sim::load_checkpoint_continue_flag;
+
+         if(binary::text_output()){
+
+            // check for open ofstream
+            if( !zgrain.is_open() ){
+               // check for checkpoint continue and append data
+               if(append) zgrain.open("grain.txt",std::ofstream::app);
+               // otherwise overwrite file
+               else zgrain.open("grain.txt",std::ofstream::trunc);
+            }
+
+            // disable headers for variables
+            write_grain_row(zgrain, false);
+
+            // Carriage return (file is flushed periodically rather than on every line)
+            zgrain << "\n";
+            if(binary::flush_due(zgrain_last_flush)) zgrain.flush();
+
          }
 
-         // loop over all data in the output data list
-         for(unsigned int item=0; item < vout::grain::output_list.size(); item++){
-
-            switch(vout::grain::output_list[item]){
-               //------------------------------------------
-               case grain::time_steps:
-                  vout::time(zgrain,header);
-                  break;
-               //------------------------------------------
-               case grain::real_time:
-                  vout::real_time(zgrain,header);
-                  break;
-               //------------------------------------------
-               case grain::temperature:
-                  vout::temperature(zgrain,header);
-                  break;
-               //------------------------------------------
-               case grain::electron_temperature:
-                  vout::temperature(zgrain,header);
-                  break;
-               //------------------------------------------
-               case grain::phonon_temperature:
-                  vout::phonon_temperature(zgrain,header);
-                  break;
-               //------------------------------------------
-               case grain::applied_field:
-                  vout::Happ(zgrain,header);
-                  break;
-               //------------------------------------------
-               case grain::applied_field_unit_vector:
-                  vout::Hvec(zgrain,header);
-                  break;
-               //------------------------------------------
-               case grain::constraint_phi:
-                  zgrain << generic_output_double("con_phi",sim::constraint_phi,header);
-                  break;
-               //------------------------------------------
-               case grain::constraint_theta:
-                  zgrain << generic_output_double("con_theta",sim::constraint_theta,header);
-                  break;
-               //------------------------------------------
-               case grain::magnetisation:
-                  // inline function to output grain data
-                  zgrain << stats::grain_magnetization.output_normalized_magnetization(header);
-                  break;
-               //------------------------------------------
-               case grain::mean_magnetisation_length:
-                  // inline function to output grain data
-                  zgrain << stats::grain_magnetization.output_normalized_mean_magnetization_length(header);
-                  break;
-               //------------------------------------------
-               case grain::material_magnetisation:
-                  // inline function to output grain data
-                  zgrain << stats::material_grain_magnetization.output_normalized_magnetization(header);
-                  break;
-               //------------------------------------------
-               case grain::material_height_magnetisation:
-                  // inline function to output grain data
-                  zgrain << stats::material_grain_height_magnetization.output_normalized_magnetization(header);
-                  break;
-               //------------------------------------------
-               case grain::mean_torque:
-                  // inline function to output grain data
-                  zgrain << stats::grain_torque.output_mean_torque(header);
-                  break;
-               //------------------------------------------
-               case grain::mean_susceptibility:
-                  // inline function to output grain data
-                  zgrain << stats::grain_susceptibility.output_mean_susceptibility(sim::temperature, header);
-                  break;
-               //------------------------------------------
-               case grain::mean_specific_heat:
-                  // inline function to output grain data
-                  zgrain << stats::grain_specific_heat.output_mean_specific_heat(sim::temperature, header);
-                  break;
-               //------------------------------------------
-               //case grain::mean_spin_temp:
-               //   // inline function to output grain data
-               //   zgrain << stats::grain_specific_heat.output_mean_specific_heat(sim::temperature, header);
-               //   break;
-               //------------------------------------------
-
-            } // end of case statement
-
-         } // end of output list loop
-
-         // Carriage return
-         zgrain << std::endl;
+         if(binary::binary_output()){
+
+            std::ostringstream unused; // nothing is written to stream while collecting columns
+
+            // column names are collected once when the file is opened
+            if(!binary::grain_file.is_open()){
+               std::vector<std::string> names;
+               vout::column_names = &names;
+               write_grain_row(unused, true);
+               vout::column_names = NULL;
+               binary::grain_file.open("grain.bin", append, names);
+            }
+
+            // values are collected directly without text formatting
+            vout::column_values = &binary::grain_file.record;
+            write_grain_row(unused, false);
+            vout::column_values = NULL;
+
+            binary::grain_file.write_record();
+
+         }
 
       } // end of rank zero check
 
@@ -54,6 +54,52 @@ namespace vio{
         vout::header_option = true;
          return true;
       }
+      //-------------------------------------------------------------------
+      test="output-format";
+      if(word==test){
+         test="text";
+         if(value==test){
+            vout::binary::format = vout::binary::text;
+            return true;
+         }
+         test="binary";
+         if(value==test){
+            vout::binary::format = vout::binary::binary;
+            return true;
+         }
+         test="text-and-binary";
+         if(value==test){
+            vout::binary::format = vout::binary::text_and_binary;
+            return true;
+         }
+         terminaltextcolor(RED);
+         std::cerr << "Error - value for \'output:" << word << "\' must be one of:" << std::endl;
+         std::cerr << "\t\"text\"" << std::endl;
+         std::cerr << "\t\"binary\"" << std::endl;
+         std::cerr << "\t\"text-and-binary\"" << std::endl;
+         terminaltextcolor(WHITE);
+         zlog << zTs() << "Error - value for \'output:" << word << "\' must be one of:" << std::endl;
+         zlog << zTs() << "\t\"text\"" << std::endl;
+         zlog << zTs() << "\t\"binary\"" << std::endl;
+         zlog << zTs() << "\t\"text-and-binary\"" << std::endl;
+         err::vexit();
+      }
+      //-------------------------------------------------------------------
+      test="binary-buffer-size";
+      if(word==test){
+         int b=atoi(value.c_str());
+         vin::check_for_valid_int(b, word, line, prefix, 1, 1024,"input","1 - 1024 MB");
+         vout::binary::buffer_size = uint64_t(b)*1024*1024;
+         return true;
+      }
+      //-------------------------------------------------------------------
+      test="flush-interval";
+      if(word==test){
+         double t=atof(value.c_str());
+         vin::check_for_valid_value(t, word, line, prefix, unit, "none", 0.0, 86400.0,"input","0 - 86400 s");
+         vout::binary::flush_interval = t;
+         return true;
+      }
       //--------------------------------------------------------------------
       // Keyword not found
       //--------------------------------------------------------------------
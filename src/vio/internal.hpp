@@ -20,6 +20,8 @@
 //---------------------------------------------------------------------
 
 // C++ standard library headers
+#include <chrono>
+#include <fstream>
 #include <string>
 #include <vector>
 #include <iostream>
@@ -93,6 +95,57 @@ namespace vout{
 
    }
 
+   //-------------------------------------------------------------------------
+   // Binary columnar output files
+   //-------------------------------------------------------------------------
+   namespace binary{
+
+      // format of output and grain files
+      enum format_t { text, binary, text_and_binary };
+
+      extern format_t format; // format of output and grain files
+      extern uint64_t buffer_size; // size of write buffer before flushing to disk (bytes)
+      extern double flush_interval; // maximum time between flushes of output files to disk (s)
+
+      //----------------------------------------------------------------------
+      // Class for a binary file storing one fixed width record of little
+      // endian doubles per output row, preceded by a text schema header
+      // naming each column. Rows are buffered in memory and written to disk
+      // when the buffer is full or the flush interval has elapsed.
+      //----------------------------------------------------------------------
+      class file_t{
+
+         private:
+
+            std::ofstream file; // output file stream
+            std::vector<char> buffer; // buffered records
+            unsigned int num_columns; // number of columns in each record
+            bool column_warning; // flag to indicate column mismatch has been logged
+            std::chrono::steady_clock::time_point last_flush; // time of last flush to disk
+
+         public:
+
+            std::vector<double> record; // values of current record collected from output functions
+
+            file_t();
+            ~file_t();
+
+            bool is_open();
+            void open(const std::string file_name, const bool append, const std::vector<std::string>& column_names);
+            void write_record();
+            void flush();
+
+      };
+
+      extern file_t output_file;
+      extern file_t grain_file;
+
+      bool text_output(); // true if text files are written
+      bool binary_output(); // true if binary files are written
+      bool flush_due(std::chrono::steady_clock::time_point& last_flush);
+
+   }
+
    //-------------------------------------------------------------------------
    // New output functions
    //-------------------------------------------------------------------------
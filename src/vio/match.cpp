@@ -30,6 +30,7 @@
 #include "stats.hpp"
 #include "units.hpp"
 #include "config.hpp"
+#include "create.hpp"
 #include "demag.hpp"
 #include "cells.hpp"
 #include "voronoi.hpp"
@@ -37,6 +38,7 @@
 #include "montecarlo.hpp"
 #include "program.hpp"
 #include "random.hpp"
+#include "spectrum.hpp"
 #include "spintorque.hpp"
 #include "spintransport.hpp"
 #include "unitcell.hpp"
@@ -85,6 +87,7 @@ namespace vin{
         else if(montecarlo::match_input_parameter(key, word, value, unit, line)) return EXIT_SUCCESS;
         else if(program::match_input_parameter(key, word, value, unit, line)) return EXIT_SUCCESS;
         else if(sim::match_input_parameter(key, word, value, unit, line)) return EXIT_SUCCESS;
+        else if(spectrum::match_input_parameter(key, word, value, unit, line)) return EXIT_SUCCESS;
         else if(st::match_input_parameter(key, word, value, unit, line)) return EXIT_SUCCESS;
         else if(spin_transport::match_input_parameter(key, word, value, unit, line)) return EXIT_SUCCESS;
         else if(unitcell::match_input_parameter(key, word, value, unit, line)) return EXIT_SUCCESS;
@@ -1702,6 +1705,8 @@ namespace vin{
                 //std::cout << "\t" << "word: " << word << std::endl;
                 //std::cout << "\t" << "value:" << value << std::endl;
                 //std::cout << "\t" << "unit: " << unit << std::endl;
+                // add line to structure cache key
+                create::hash_input_line(key, word, value, unit, super_index, sub_index);
             int matchcheck = vin::match_material(word, value, unit, line_counter, super_index-1, sub_index-1, original_line, matfile);
                 if(matchcheck==EXIT_FAILURE){
                     err::vexit();
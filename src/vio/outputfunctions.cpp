@@ -361,7 +361,11 @@ namespace vout{
 
 	// Output Function 47 - with Header
 	void fmr_field_strength(std::ostream& stream, bool header){
-		stream << sim::fmr_field << "\t";
+		std::ostringstream res;
+		vout::fixed_width_output result(res,0);
+		if(header) result << "fmr_field";
+		else result << sim::fmr_field;
+		stream << result.str();
 	}
 
    // Output Function 48 - with Header
@@ -396,8 +400,17 @@ namespace vout{
 
 	// Output Function 60
 	void MPITimings(std::ostream& stream, bool header){
-		stream << vmpi::AverageComputeTime+vmpi::AverageWaitTime << "\t" << vmpi::AverageComputeTime << "\t" << vmpi::AverageWaitTime;
-		stream << "\t" << vmpi::MaximumComputeTime << "\t" << vmpi::MaximumWaitTime << "\t";
+		std::ostringstream res;
+		vout::fixed_width_output result(res,0);
+		if(header){
+			result << "MPI_total_time" << "MPI_compute_time" << "MPI_wait_time";
+			result << "MPI_max_compute_time" << "MPI_max_wait_time";
+		}
+		else{
+			result << vmpi::AverageComputeTime+vmpi::AverageWaitTime << vmpi::AverageComputeTime << vmpi::AverageWaitTime;
+			result << vmpi::MaximumComputeTime << vmpi::MaximumWaitTime;
+		}
+		stream << result.str();
 	}
 
    // Output Function 61 - with Header
@@ -432,47 +445,47 @@ namespace vout{
 
    // Output Function 67
    void domain_wall_position(std::ostream& stream, bool header){
-      stream << sim::domain_wall_centre;
+      std::ostringstream res;
+      vout::fixed_width_output result(res,0);
+      if(header) result << "DW_position";
+      else result << sim::domain_wall_centre;
+      stream << result.str();
    }
 
    // Output Function 68
    void MRresistance(std::ostream& stream, bool header){
-      if(header){
-         stream << "MR" << "\t";
-      }
-      else{
-         stream << micromagnetic::MR_resistance << "\t";
-      }
+      std::ostringstream res;
+      vout::fixed_width_output result(res,0);
+      if(header) result << "MR";
+      else result << micromagnetic::MR_resistance;
+      stream << result.str();
    }
 
    // Output Function 69
    void lfa_ms(std::ostream& stream, bool header){
-      if(header){
-         stream << "MS" << "\t";
-      }
-      else{
-         stream << sim::Ms << "\t";
-      }
+      std::ostringstream res;
+      vout::fixed_width_output result(res,0);
+      if(header) result << "MS";
+      else result << sim::Ms;
+      stream << result.str();
    }
 
    // Output Function 70
    void x_track_pos(std::ostream& stream, bool header){
-      if(header){
-         stream << "x-pos" << "\t";
-      }
-      else{
-         stream << sim::track_pos_x << "\t";
-      }
+      std::ostringstream res;
+      vout::fixed_width_output result(res,0);
+      if(header) result << "x-pos";
+      else result << sim::track_pos_x;
+      stream << result.str();
    }
 
    // Output Function 71
    void z_track_pos(std::ostream& stream, bool header){
-      if(header){
-         stream << "z pos" << "\t";
-      }
-      else{
-         stream << sim::track_pos_z << "\t";
-      }
+      std::ostringstream res;
+      vout::fixed_width_output result(res,0);
+      if(header) result << "z pos";
+      else result << sim::track_pos_z;
+      stream << result.str();
    }
 
    // Output Function 72
@@ -17,6 +17,7 @@
 #include <string>
 #include <iostream>
 // Vampire headers
+#include "create.hpp"
 #include "vio.hpp"
 #include "errors.hpp"
 
@@ -207,6 +208,9 @@ namespace vin{
 				superIndex = stoi(superIndexString);
 			}
 
+			// add line to structure cache key
+			if(key != empty) create::hash_input_line(key, word, value, unit, superIndex, subIndex);
+
 			// Call different overloads depending on whether super and sub indicies are present
 			if(key != empty && superIndex == 0 && subIndex == 0){
 				//	std::cout << "\t" << "key:  " << key << std::endl;
@@ -0,0 +1,575 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) Richard F L Evans 2022. All rights reserved.
+//
+//   Email: richard.evans@york.ac.uk
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+
+// Vampire headers
+#include "atoms.hpp"
+#include "cells.hpp"
+#include "create.hpp"
+#include "dipole.hpp"
+#include "exchange.hpp"
+#include "material.hpp"
+#include "montecarlo.hpp"
+#include "sim.hpp"
+#include "stats.hpp"
+#include "vio.hpp"
+#include "vmpi.hpp"
+
+// Vampire internal headers for direct access to kernels
+#include "../../../src/anisotropy/internal.hpp"
+#include "../../../src/exchange/internal.hpp"
+
+// module headers
+#include "internal.hpp"
+
+// prototype of thermal field generator in simulate module
+int calculate_thermal_fields(const int start_index, const int end_index);
+
+namespace vb{
+
+   //---------------------------------------------------------------------------
+   // Function to time a kernel, returning the minimum time per call (s) over
+   // a number of repeats, each running for at least min_time
+   //---------------------------------------------------------------------------
+   double time_kernel(std::function<void()> kernel, const settings_t& settings){
+
+      // warm up caches and any lazy initialisation
+      kernel();
+
+      double best = 1.0e300;
+
+      for(int r = 0; r < settings.repeats; r++){
+         int calls = 0;
+         double elapsed = 0.0;
+         const auto start = std::chrono::high_resolution_clock::now();
+         while(elapsed < settings.min_time){
+            kernel();
+            calls++;
+            elapsed = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+         }
+         best = std::min(best, elapsed/double(calls));
+      }
+
+      return best;
+
+   }
+
+   //---------------------------------------------------------------------------
+   // Function to write input and material files for synthetic system
+   //---------------------------------------------------------------------------
+   void write_input_files(const std::string crystal, const std::string group, const settings_t& settings){
+
+      //------------------------------------------------------------------------
+      // Triangular monolayer (such as Fe on Ir(111)) with four-spin exchange,
+      // defined by a rectangular unit cell with two atoms and six neighbours
+      //------------------------------------------------------------------------
+      if(crystal == "monolayer"){
+
+         const double a = 2.5; // nearest neighbour distance (Angstroms)
+         const double b = a*sqrt(3.0);
+
+         std::ofstream ufile("monolayer.ucf");
+         ufile << std::setprecision(10);
+         ufile << "# triangular monolayer\n";
+         ufile << a << " " << b << " " << 2.0*a << "\n";
+         ufile << "1 0 0\n0 1 0\n0 0 1\n";
+         ufile << "2\n";
+         ufile << "0 0.0 0.0 0.0 0 0 0\n";
+         ufile << "1 0.5 0.5 0.0 0 1 0\n";
+         // i j dx dy dz for six neighbours of each atom
+         const int neighbours[12][5] = { {0, 0,  1,  0, 0}, {0, 0, -1,  0, 0}, {0, 1, 0,  0, 0}, {0, 1, -1,  0, 0},
+                                         {0, 1,  0, -1, 0}, {0, 1, -1, -1, 0}, {1, 1, 1,  0, 0}, {1, 1, -1,  0, 0},
+                                         {1, 0,  0,  0, 0}, {1, 0,  1,  0, 0}, {1, 0, 0,  1, 0}, {1, 0,  1,  1, 0} };
+         ufile << "12 isotropic\n";
+         for(int n = 0; n < 12; n++){
+            ufile << n;
+            for(int c = 0; c < 5; c++) ufile << " " << neighbours[n][c];
+            ufile << " 5.0e-21\n";
+         }
+         ufile.close();
+
+         std::ofstream ifile("input");
+         ifile << std::setprecision(10);
+         ifile << "material:unit-cell-file = monolayer.ucf\n";
+         ifile << "create:periodic-boundaries-x\n";
+         ifile << "create:periodic-boundaries-y\n";
+         ifile << "dimensions:system-size-x = " << double(settings.size)*a*0.1 << " !nm\n";
+         ifile << "dimensions:system-size-y = " << double(settings.size)*b*0.1 << " !nm\n";
+         ifile << "dimensions:system-size-z = " << 0.1*a << " !nm\n";
+         ifile << "material:file = benchmark.mat\n";
+         ifile << "exchange:four-spin-cutoff-1 = " << a << " !A\n";
+         ifile << "exchange:four-spin-cutoff-2 = " << b << " !A\n";
+         ifile << "sim:temperature = 300.0\n";
+         ifile << "sim:time-step = 1.0e-16\n";
+         ifile << "sim:total-time-steps = 0\n";
+         ifile << "sim:program = benchmark\n";
+         ifile << "sim:integrator = llg-heun\n";
+         ifile.close();
+
+         std::ofstream mfile("benchmark.mat");
+         mfile << "material:num-materials = 1\n";
+         mfile << "material[1]:material-name = Fe\n";
+         mfile << "material[1]:damping-constant = 0.1\n";
+         mfile << "material[1]:atomic-spin-moment = 2.7 !muB\n";
+         mfile << "material[1]:four-spin-constant[1] = -1.0e-21\n";
+         mfile << "material[1]:initial-spin-direction = random\n";
+         mfile.close();
+
+         return;
+
+      }
+
+      const double lattice_constant = 3.54; // Angstroms
+      // integrator comparison runs many time steps so uses a small system
+      const int size = group == "integrators" ? std::min(settings.size, 8) : settings.size;
+      const double system_size = double(size)*lattice_constant*0.1; // nm
+
+      std::ofstream ifile("input");
+      ifile << "create:crystal-structure = " << crystal << "\n";
+      ifile << "create:periodic-boundaries-x\n";
+      ifile << "create:periodic-boundaries-y\n";
+      ifile << "create:periodic-boundaries-z\n";
+      ifile << "dimensions:unit-cell-size = " << lattice_constant << " !A\n";
+      ifile << "dimensions:system-size-x = " << system_size << " !nm\n";
+      ifile << "dimensions:system-size-y = " << system_size << " !nm\n";
+      ifile << "dimensions:system-size-z = " << system_size << " !nm\n";
+      ifile << "material:file = benchmark.mat\n";
+      ifile << "sim:temperature = 300.0\n";
+      ifile << "sim:time-step = 1.0e-16\n";
+      ifile << "sim:total-time-steps = 0\n";
+      ifile << "sim:program = benchmark\n";
+      ifile << "sim:integrator = llg-heun\n";
+      ifile << "cells:macro-cell-size = 1.0 !nm\n";
+      // dipole solver for dipole groups
+      if(group.substr(0, 7) == "dipole-") ifile << "dipole:solver = " << group.substr(7) << "\n";
+      ifile << "output:magnetisation\n";
+      ifile << "output:material-magnetisation\n";
+      ifile.close();
+
+      // two materials so that fixed and rotated anisotropy bases are both initialised
+      std::ofstream mfile("benchmark.mat");
+      mfile << "material:num-materials = 2\n";
+      for(int m = 1; m <= 2; m++){
+         mfile << "material[" << m << "]:material-name = M" << m << "\n";
+         mfile << "material[" << m << "]:damping-constant = 0.1\n";
+         mfile << "material[" << m << "]:exchange-matrix[1] = 10.0e-21\n";
+         mfile << "material[" << m << "]:exchange-matrix[2] = 10.0e-21\n";
+         mfile << "material[" << m << "]:atomic-spin-moment = 1.72 !muB\n";
+         // high anisotropy ordered system for integrator stability
+         if(group == "integrators"){
+            mfile << "material[" << m << "]:initial-spin-direction = 0.0, 0.0, 1.0\n";
+            mfile << "material[" << m << "]:second-order-uniaxial-anisotropy-constant = 1.0e-22\n";
+         }
+         else mfile << "material[" << m << "]:initial-spin-direction = random\n";
+         if(group == "core"){
+            mfile << "material[" << m << "]:second-order-uniaxial-anisotropy-constant = 1.0e-24\n";
+            mfile << "material[" << m << "]:fourth-order-uniaxial-anisotropy-constant = 1.0e-25\n";
+            mfile << "material[" << m << "]:fourth-order-biaxial-anisotropy-constant = 1.0e-25\n";
+            mfile << "material[" << m << "]:sixth-order-uniaxial-anisotropy-constant = 1.0e-26\n";
+            mfile << "material[" << m << "]:fourth-order-cubic-anisotropy-constant = 1.0e-25\n";
+            mfile << "material[" << m << "]:sixth-order-cubic-anisotropy-constant = 1.0e-26\n";
+            mfile << "material[" << m << "]:fourth-order-rotational-anisotropy-constant = 1.0e-25\n";
+            mfile << "material[" << m << "]:second-order-triaxial-anisotropy-vector = 1.0e-24, 0.5e-24, 0.0\n";
+            mfile << "material[" << m << "]:fourth-order-triaxial-anisotropy-vector = 1.0e-25, 0.5e-25, 0.0\n";
+            mfile << "material[" << m << "]:neel-anisotropy-constant[1] = 1.0e-23\n";
+            mfile << "material[" << m << "]:neel-anisotropy-constant[2] = 1.0e-23\n";
+            mfile << "material[" << m << "]:lattice-anisotropy-constant = 1.0e-24\n";
+            mfile << "material[" << m << "]:lattice-anisotropy-file = lattice.dat\n";
+         }
+         mfile << "material[" << m << "]:minimum-height = " << 0.5*double(m-1) << "\n";
+         mfile << "material[" << m << "]:maximum-height = " << 0.5*double(m) << "\n";
+      }
+      // rotated bases for second material
+      if(group == "core"){
+         const std::string basis[3] = { "0.70710678, 0.70710678, 0.0", "-0.70710678, 0.70710678, 0.0", "0.0, 0.0, 1.0" };
+         for(int b = 0; b < 3; b++){
+            mfile << "material[2]:second-order-triaxial-basis-vector-" << b+1 << " = " << basis[b] << "\n";
+            mfile << "material[2]:fourth-order-triaxial-basis-vector-" << b+1 << " = " << basis[b] << "\n";
+         }
+         mfile << "material[2]:cubic-anisotropy-direction-1 = " << basis[0] << "\n";
+         mfile << "material[2]:cubic-anisotropy-direction-2 = " << basis[1] << "\n";
+      }
+      mfile.close();
+
+      std::ofstream lfile("lattice.dat");
+      lfile << "3\n0.0 1.0\n500.0 0.5\n1000.0 0.1\n";
+      lfile.close();
+
+      return;
+
+   }
+
+   //---------------------------------------------------------------------------
+   // Function to benchmark core atomistic kernels
+   //---------------------------------------------------------------------------
+   void benchmark_core(const settings_t& settings, std::vector<result_t>& results){
+
+      const int num_atoms = atoms::num_atoms;
+      const double interactions_per_atom = double(atoms::neighbour_list_array.size())/double(num_atoms);
+
+      // modelled memory traffic: atom data (start/end index, type, spin, field read-modify-write)
+      // and neighbour data (list index, interaction type, neighbour spin) assuming no reuse. The
+      // exchange constants are indexed by interaction type and stay in cache so are not counted.
+      const double exchange_bytes = 12.0 + 24.0 + 48.0 + interactions_per_atom*(8.0 + 24.0);
+      const double anisotropy_bytes = 4.0 + 24.0 + 48.0;
+
+      auto add = [&](const std::string name, const double bytes, std::function<void()> kernel){
+         result_t result;
+         result.kernel = name;
+         result.bytes_per_atom = bytes;
+         result.ns_per_atom = 1.0e9*time_kernel(kernel, settings)/double(num_atoms);
+         results.push_back(result);
+         std::cout << name << " " << result.ns_per_atom << " ns/atom" << std::endl;
+      };
+
+      //------------------------------------------------------------------------
+      // exchange fields for isotropic, vectorial and tensorial interactions
+      //------------------------------------------------------------------------
+      std::vector<zvec_t> v_exchange_list(atoms::i_exchange_list.size());
+      std::vector<zten_t> t_exchange_list(atoms::i_exchange_list.size());
+      for(size_t i = 0; i < atoms::i_exchange_list.size(); i++){
+         for(int j = 0; j < 3; j++){
+            v_exchange_list[i].Jij[j] = atoms::i_exchange_list[i].Jij;
+            t_exchange_list[i].Jij[j][j] = atoms::i_exchange_list[i].Jij;
+         }
+      }
+
+      const exchange::exchange_t exchange_type = exchange::internal::exchange_type;
+      const exchange::exchange_t types[3] = { exchange::isotropic, exchange::vectorial, exchange::tensorial };
+      const std::string type_names[3] = { "isotropic", "vectorial", "tensorial" };
+      for(int t = 0; t < 3; t++){
+         exchange::internal::exchange_type = types[t];
+         add("exchange-" + type_names[t], exchange_bytes, [&](){
+            exchange::internal::exchange_fields(0, num_atoms,
+                                                atoms::neighbour_list_start_index, atoms::neighbour_list_end_index,
+                                                atoms::type_array, atoms::neighbour_list_array, atoms::neighbour_interaction_type_array,
+                                                atoms::i_exchange_list, v_exchange_list, t_exchange_list,
+                                                atoms::x_spin_array, atoms::y_spin_array, atoms::z_spin_array,
+                                                atoms::x_total_spin_field_array, atoms::y_total_spin_field_array, atoms::z_total_spin_field_array);
+         });
+      }
+      exchange::internal::exchange_type = exchange_type;
+
+      //------------------------------------------------------------------------
+      // anisotropy fields (fixed and rotated variants are mutually exclusive in
+      // a simulation, so enable each one explicitly while it is timed)
+      //------------------------------------------------------------------------
+      namespace ai = anisotropy::internal;
+      typedef void (*anisotropy_kernel_t)(std::vector<double>&, std::vector<double>&, std::vector<double>&, std::vector<int>&,
+                                          std::vector<double>&, std::vector<double>&, std::vector<double>&, const int, const int);
+      struct anisotropy_benchmark_t{
+         const char* name;
+         anisotropy_kernel_t kernel;
+         bool* enabled;
+      };
+      const anisotropy_benchmark_t anisotropy_benchmarks[] = {
+         { "anisotropy-uniaxial-2",        ai::uniaxial_second_order_fields,               &ai::enable_uniaxial_second_order },
+         { "anisotropy-uniaxial-4",        ai::uniaxial_fourth_order_fields,               &ai::enable_uniaxial_fourth_order },
+         { "anisotropy-biaxial-4",         ai::biaxial_fourth_order_simple_fields,         &ai::enable_biaxial_fourth_order_simple },
+         { "anisotropy-uniaxial-6",        ai::uniaxial_sixth_order_fields,                &ai::enable_uniaxial_sixth_order },
+         { "anisotropy-triaxial-2",        ai::triaxial_second_order_fields_fixed_basis,   &ai::enable_triaxial_anisotropy },
+         { "anisotropy-triaxial-2-rotated",ai::triaxial_second_order_fields,               &ai::enable_triaxial_anisotropy_rotated },
+         { "anisotropy-triaxial-4",        ai::triaxial_fourth_order_fields_fixed_basis,   &ai::enable_triaxial_fourth_order },
+         { "anisotropy-triaxial-4-rotated",ai::triaxial_fourth_order_fields,               &ai::enable_triaxial_fourth_order_rotated },
+         { "anisotropy-rotational-4",      ai::rotational_fourth_order_fields_fixed_basis, &ai::enable_fourth_order_rotational },
+         { "anisotropy-cubic-4",           ai::cubic_fourth_order_fields,                  &ai::enable_cubic_fourth_order },
+         { "anisotropy-cubic-4-rotated",   ai::cubic_fourth_order_rotation_fields,         &ai::enable_cubic_fourth_order_rotation },
+         { "anisotropy-cubic-6",           ai::cubic_sixth_order_fields,                   &ai::enable_cubic_sixth_order },
+         { "anisotropy-neel",              ai::neel_fields,                                &ai::enable_neel_anisotropy }
+      };
+
+      for(const anisotropy_benchmark_t& ab : anisotropy_benchmarks){
+         const bool enabled = *ab.enabled;
+         *ab.enabled = true;
+         add(ab.name, anisotropy_bytes, [&](){
+            ab.kernel(atoms::x_spin_array, atoms::y_spin_array, atoms::z_spin_array, atoms::type_array,
+                      atoms::x_total_spin_field_array, atoms::y_total_spin_field_array, atoms::z_total_spin_field_array, 0, num_atoms);
+         });
+         *ab.enabled = enabled;
+      }
+
+      // all terms above (except Neel) in a single pass of the per-material plan
+      add("anisotropy-plan", anisotropy_bytes, [&](){
+         ai::plan_fields(atoms::x_spin_array, atoms::y_spin_array, atoms::z_spin_array,
+                         atoms::x_total_spin_field_array, atoms::y_total_spin_field_array, atoms::z_total_spin_field_array, 0, num_atoms);
+      });
+
+      add("anisotropy-lattice", anisotropy_bytes, [&](){
+         ai::lattice_fields(atoms::x_spin_array, atoms::y_spin_array, atoms::z_spin_array, atoms::type_array,
+                            atoms::x_total_spin_field_array, atoms::y_total_spin_field_array, atoms::z_total_spin_field_array,
+                            0, num_atoms, sim::temperature);
+      });
+
+      //------------------------------------------------------------------------
+      // thermal noise generator (type, field write from generator then scale)
+      //------------------------------------------------------------------------
+      add("thermal-field", 4.0 + 24.0 + 48.0, [&](){ calculate_thermal_fields(0, num_atoms); });
+
+      //------------------------------------------------------------------------
+      // integrators and statistics (compound kernels, no bandwidth model)
+      //------------------------------------------------------------------------
+      add("llg-heun-step", 0.0, [&](){ sim::LLG_Heun(); });
+      add("monte-carlo-sweep", 0.0, [&](){ montecarlo::mc_step(atoms::x_spin_array, atoms::y_spin_array, atoms::z_spin_array, num_atoms, atoms::type_array); });
+      add("statistics-update", 0.0, [&](){ stats::update(); });
+
+      return;
+
+   }
+
+   //---------------------------------------------------------------------------
+   // Function to benchmark four-spin exchange relative to bilinear exchange
+   //---------------------------------------------------------------------------
+   void benchmark_four_spin(const settings_t& settings, std::vector<result_t>& results){
+
+      const int num_atoms = atoms::num_atoms;
+
+      std::vector<zvec_t> v_exchange_list(atoms::i_exchange_list.size());
+      std::vector<zten_t> t_exchange_list(atoms::i_exchange_list.size());
+
+      result_t bilinear;
+      bilinear.kernel = "exchange-bilinear";
+      bilinear.ns_per_atom = 1.0e9*time_kernel([&](){
+         exchange::internal::exchange_fields(0, num_atoms,
+                                             atoms::neighbour_list_start_index, atoms::neighbour_list_end_index,
+                                             atoms::type_array, atoms::neighbour_list_array, atoms::neighbour_interaction_type_array,
+                                             atoms::i_exchange_list, v_exchange_list, t_exchange_list,
+                                             atoms::x_spin_array, atoms::y_spin_array, atoms::z_spin_array,
+                                             atoms::x_total_spin_field_array, atoms::y_total_spin_field_array, atoms::z_total_spin_field_array);
+      }, settings)/double(num_atoms);
+      results.push_back(bilinear);
+
+      result_t four_spin;
+      four_spin.kernel = "exchange-four-spin";
+      four_spin.ns_per_atom = 1.0e9*time_kernel([&](){
+         exchange::internal::four_spin_exchange_fields(0, num_atoms,
+                                                       atoms::x_total_spin_field_array, atoms::y_total_spin_field_array, atoms::z_total_spin_field_array);
+      }, settings)/double(num_atoms);
+
+      std::stringstream note;
+      note << std::setprecision(3) << four_spin.ns_per_atom/bilinear.ns_per_atom << "x bilinear, "
+           << exchange::internal::four_spin_exchange_list.size()/num_atoms << " quartets per atom";
+      four_spin.note = note.str();
+      results.push_back(four_spin);
+
+      return;
+
+   }
+
+   //---------------------------------------------------------------------------
+   // Function to benchmark macrocell magnetisation
+   //---------------------------------------------------------------------------
+   void benchmark_cells(const settings_t& settings, std::vector<result_t>& results){
+
+      result_t result;
+      result.kernel = "cells-mag";
+
+      // check cell data are initialised before running kernel
+      if(int(cells::mag_array_x.size()) < cells::num_cells || int(cells::atom_cell_id_array.size()) < atoms::num_atoms){
+         result.available = false;
+         result.note = "macrocell arrays not initialised";
+      }
+      else{
+         // spin, cell id and type for each atom
+         result.bytes_per_atom = 24.0 + 4.0 + 4.0;
+         result.ns_per_atom = 1.0e9*time_kernel([](){ cells::mag(); }, settings)/double(atoms::num_atoms);
+      }
+
+      results.push_back(result);
+
+      return;
+
+   }
+
+   //---------------------------------------------------------------------------
+   // Function to benchmark dipole field update
+   //---------------------------------------------------------------------------
+   void benchmark_dipole(const std::string solver, const settings_t& settings, std::vector<result_t>& results){
+
+      result_t result;
+      result.kernel = "dipole-" + solver;
+
+      if(!dipole::activated){
+         result.available = false;
+         result.note = "dipole solver not activated";
+      }
+      #ifndef FFT
+      // fft solver is an empty stub unless compiled with FFTW
+      else if(solver == "fft"){
+         result.available = false;
+         result.note = "compiled without FFT support (-DFFT)";
+      }
+      #endif
+      else{
+         // advance time on every call so that the field is always updated
+         uint64_t time = 1;
+         result.ns_per_atom = 1.0e9*time_kernel([&](){
+            dipole::calculate_field(time++, atoms::x_spin_array, atoms::y_spin_array, atoms::z_spin_array, atoms::m_spin_array, atoms::magnetic);
+         }, settings)/double(atoms::num_atoms);
+      }
+
+      results.push_back(result);
+
+      return;
+
+   }
+
+   //---------------------------------------------------------------------------
+   // Function to compare the maximum stable time step of the LLG integrators
+   // and the wall time to simulate a fixed physical time at that time step.
+   // A time step is considered stable if the mean magnetisation length over
+   // the second half of the run agrees with a Heun run at the smallest time
+   // step. A larger time step is not tried once a time step is unstable.
+   //---------------------------------------------------------------------------
+   void benchmark_integrators(std::vector<result_t>& results){
+
+      const double physical_time = 1.0e-12; // s
+      const double tolerance = 0.02; // maximum difference in mean magnetisation length
+      const double time_steps[] = { 0.1e-15, 0.2e-15, 0.5e-15, 1.0e-15, 2.0e-15, 5.0e-15 }; // s
+
+      struct integrator_benchmark_t{
+         const char* name;
+         sim::integrator_t integrator;
+      };
+      const integrator_benchmark_t integrators[] = { { "llg-heun", sim::llg_heun }, { "llg-depondt", sim::llg_depondt } };
+
+      const int num_atoms = atoms::num_atoms;
+      const std::vector<double> sx = atoms::x_spin_array;
+      const std::vector<double> sy = atoms::y_spin_array;
+      const std::vector<double> sz = atoms::z_spin_array;
+      const double dt_SI = mp::dt_SI;
+      const sim::integrator_t integrator = sim::integrator;
+
+      // run system from initial state, returning mean magnetisation length over second half
+      auto run = [&](const sim::integrator_t type, const double dt, double& wall_time){
+         atoms::x_spin_array = sx;
+         atoms::y_spin_array = sy;
+         atoms::z_spin_array = sz;
+         sim::integrator = type;
+         mp::dt_SI = dt;
+         mp::set_derived_parameters();
+
+         const uint64_t steps = uint64_t(physical_time/dt + 0.5);
+         const uint64_t sample_rate = std::max(uint64_t(1), uint64_t(1.0e-14/dt + 0.5));
+         double sum_m = 0.0;
+         double samples = 0.0;
+
+         const auto start = std::chrono::high_resolution_clock::now();
+         for(uint64_t step = 0; step < steps; step += sample_rate){
+            sim::integrate(sample_rate);
+            if(step >= steps/2){
+               double m[3] = {0.0, 0.0, 0.0};
+               for(int atom = 0; atom < num_atoms; atom++){
+                  m[0] += atoms::x_spin_array[atom];
+                  m[1] += atoms::y_spin_array[atom];
+                  m[2] += atoms::z_spin_array[atom];
+               }
+               sum_m += sqrt(m[0]*m[0] + m[1]*m[1] + m[2]*m[2])/double(num_atoms);
+               samples += 1.0;
+            }
+         }
+         wall_time = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+
+         return samples > 0.0 ? sum_m/samples : 0.0;
+      };
+
+      double reference_time = 0.0;
+      const double reference = run(sim::llg_heun, time_steps[0], reference_time);
+      std::cout << "Reference mean magnetisation (llg-heun, " << time_steps[0]*1.0e15 << " fs) " << reference << std::endl;
+
+      for(const integrator_benchmark_t& ib : integrators){
+
+         double max_stable_dt = 0.0;
+         double best_wall_time = 0.0;
+
+         for(const double dt : time_steps){
+            double wall_time = 0.0;
+            const double m = run(ib.integrator, dt, wall_time);
+            const bool stable = std::isfinite(m) && fabs(m - reference) < tolerance;
+            std::cout << ib.name << " dt " << dt*1.0e15 << " fs mean magnetisation " << m << " wall time " << wall_time
+                      << " s " << (stable ? "stable" : "unstable") << std::endl;
+            if(!stable) break;
+            max_stable_dt = dt;
+            best_wall_time = wall_time;
+         }
+
+         result_t result;
+         result.kernel = std::string(ib.name) + "-1ps";
+         if(max_stable_dt > 0.0){
+            result.ns_per_atom = 1.0e9*best_wall_time/double(num_atoms);
+            std::stringstream note;
+            note << "max stable dt " << max_stable_dt*1.0e15 << " fs";
+            result.note = note.str();
+         }
+         else{
+            result.available = false;
+            result.note = "unstable at all time steps";
+         }
+         results.push_back(result);
+
+      }
+
+      // restore initial state
+      atoms::x_spin_array = sx;
+      atoms::y_spin_array = sy;
+      atoms::z_spin_array = sz;
+      sim::integrator = integrator;
+      mp::dt_SI = dt_SI;
+      mp::set_derived_parameters();
+
+      return;
+
+   }
+
+   //---------------------------------------------------------------------------
+   // Child process to initialise a system and benchmark a group of kernels
+   //---------------------------------------------------------------------------
+   int run_child(const std::string crystal, const std::string group, const settings_t& settings, const char* exe){
+
+      write_input_files(crystal, group, settings);
+
+      // initialise vampire as in main program
+      vout::output_file_name = "output";
+      vout::zLogTsInit(std::string(exe));
+      mp::initialise("input");
+      cs::create();
+      sim::run();
+
+      std::vector<result_t> results;
+
+      if(group == "core") benchmark_core(settings, results);
+      else if(group == "cells") benchmark_cells(settings, results);
+      else if(group.substr(0, 7) == "dipole-") benchmark_dipole(group.substr(7), settings, results);
+      else if(group == "integrators") benchmark_integrators(results);
+      else if(group == "four-spin") benchmark_four_spin(settings, results);
+      else{
+         std::cerr << "Error: unknown benchmark group " << group << std::endl;
+         return EXIT_FAILURE;
+      }
+
+      // write results for parent process
+      std::ofstream ofile("results");
+      ofile << "atoms " << atoms::num_atoms << "\n";
+      for(const result_t& r : results){
+         if(r.available) ofile << r.kernel << " " << r.ns_per_atom << " " << r.bytes_per_atom << " " << r.note << "\n";
+         else ofile << r.kernel << " unavailable " << r.note << "\n";
+      }
+
+      return EXIT_SUCCESS;
+
+   }
+
+}
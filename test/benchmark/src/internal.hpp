@@ -0,0 +1,56 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) Richard F L Evans 2022. All rights reserved.
+//
+//   Email: richard.evans@york.ac.uk
+//
+//------------------------------------------------------------------------------
+//
+// include file only once
+#pragma once
+
+// C++ standard library headers
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace vb{
+
+   //---------------------------------------------------------------------------
+   // Settings for benchmark run
+   //---------------------------------------------------------------------------
+   struct settings_t{
+      int size = 32;            // number of unit cells in each dimension
+      int repeats = 5;          // number of timed repeats for each kernel (minimum is reported)
+      double min_time = 0.05;   // minimum time for each repeat (s)
+   };
+
+   //---------------------------------------------------------------------------
+   // Result of a single kernel benchmark
+   //---------------------------------------------------------------------------
+   struct result_t{
+      std::string kernel;         // kernel name
+      bool available = true;      // flag if kernel could be run
+      double ns_per_atom = 0.0;   // time per atom per call (ns)
+      double bytes_per_atom = 0.0; // modelled memory traffic per atom (0 if not meaningful)
+      std::string note;           // reason kernel is unavailable or additional information
+   };
+
+   // child process running benchmarks for one crystal and kernel group
+   int run_child(const std::string crystal, const std::string group, const settings_t& settings, const char* exe);
+
+   // function to time a kernel, returning the minimum time per call (s)
+   double time_kernel(std::function<void()> kernel, const settings_t& settings);
+
+   // STREAM triad memory bandwidth (GB/s)
+   double stream_bandwidth();
+
+}
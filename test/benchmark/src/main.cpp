@@ -0,0 +1,259 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) Richard F L Evans 2022. All rights reserved.
+//
+//   Email: richard.evans@york.ac.uk
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <chrono>
+#include <iomanip>
+#include <map>
+
+// Vampire headers
+#include "vmpi.hpp"
+
+// module headers
+#include "internal.hpp"
+
+namespace vb{
+
+   //---------------------------------------------------------------------------
+   // Function to measure sustainable memory bandwidth with the STREAM triad
+   // a = b + s*c, returning the best of several trials in GB/s
+   //---------------------------------------------------------------------------
+   double stream_bandwidth(){
+
+      const size_t n = 1 << 23; // 64 MB per array, larger than last level cache
+      std::vector<double> a(n, 0.0), b(n, 1.0), c(n, 2.0);
+      const double s = 3.0;
+
+      double best = 1.0e300;
+      for(int trial = 0; trial < 6; trial++){
+         const auto start = std::chrono::high_resolution_clock::now();
+         for(size_t i = 0; i < n; i++) a[i] = b[i] + s*c[i];
+         const double elapsed = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+         // first trial only faults in pages
+         if(trial > 0) best = std::min(best, elapsed);
+      }
+
+      // prevent triad being optimised away
+      if(a[n/2] != 7.0) std::cerr << "Warning: STREAM triad validation failed" << std::endl;
+
+      return 3.0*sizeof(double)*double(n)/best/1.0e9;
+
+   }
+
+}
+
+//------------------------------------------------------------------------------
+// Function to print usage
+//------------------------------------------------------------------------------
+void usage(){
+   std::cout << "Usage: benchmarks [options]\n"
+             << "   --crystal sc|bcc|fcc|monolayer|all\n"
+             << "                             crystal structure of synthetic system (default all)\n"
+             << "   --size N                  number of unit cells in each dimension (default 32)\n"
+             << "   --repeats R               number of timed repeats per kernel (default 5)\n"
+             << "   --min-time T              minimum time per repeat in seconds (default 0.05)\n"
+             << "   --baseline FILE           baseline file to compare against (default benchmarks.baseline)\n"
+             << "   --save-baseline           overwrite baseline file with results of this run\n"
+             << "   --tolerance X             fractional slowdown reported as a regression (default 0.1)\n";
+}
+
+int main(int argc, char* argv[]){
+
+   vb::settings_t settings;
+   std::string crystal = "all";
+   std::string baseline_file = "benchmarks.baseline";
+   bool save_baseline = false;
+   double tolerance = 0.1;
+
+   // child process benchmarking a single group: --child crystal group size repeats min-time
+   if(argc == 7 && std::string(argv[1]) == "--child"){
+      settings.size = atoi(argv[4]);
+      settings.repeats = atoi(argv[5]);
+      settings.min_time = atof(argv[6]);
+      vmpi::initialise(argc, argv);
+      return vb::run_child(argv[2], argv[3], settings, argv[0]);
+   }
+
+   // read command line options
+   for(int arg = 1; arg < argc; arg++){
+      const std::string sw = argv[arg];
+      const bool has_value = arg + 1 < argc;
+      if(sw == "--crystal" && has_value) crystal = argv[++arg];
+      else if(sw == "--size" && has_value) settings.size = atoi(argv[++arg]);
+      else if(sw == "--repeats" && has_value) settings.repeats = atoi(argv[++arg]);
+      else if(sw == "--min-time" && has_value) settings.min_time = atof(argv[++arg]);
+      else if(sw == "--baseline" && has_value) baseline_file = argv[++arg];
+      else if(sw == "--save-baseline") save_baseline = true;
+      else if(sw == "--tolerance" && has_value) tolerance = atof(argv[++arg]);
+      else{
+         usage();
+         return EXIT_FAILURE;
+      }
+   }
+
+   if(settings.size < 1 || settings.repeats < 1){
+      std::cerr << "Error: size and repeats must be positive integers" << std::endl;
+      return EXIT_FAILURE;
+   }
+
+   std::vector<std::string> crystals;
+   if(crystal == "all") crystals = { "sc", "bcc", "fcc", "monolayer" };
+   else if(crystal == "sc" || crystal == "bcc" || crystal == "fcc" || crystal == "monolayer") crystals = { crystal };
+   else{
+      usage();
+      return EXIT_FAILURE;
+   }
+
+   const std::vector<std::string> bulk_groups = { "core", "cells", "dipole-tensor", "dipole-hierarchical", "dipole-fft", "integrators" };
+
+   // triangular monolayer with four-spin exchange
+   const std::vector<std::string> monolayer_groups = { "four-spin" };
+
+   std::cout << "---------------------------------------------------------------------" << std::endl;
+   std::cout << "    Running micro-benchmark suite for vampire code" << std::endl;
+   std::cout << "---------------------------------------------------------------------" << std::endl;
+
+   const double bandwidth = vb::stream_bandwidth();
+   std::cout << "Memory bandwidth (STREAM triad): " << std::fixed << std::setprecision(2) << bandwidth << " GB/s" << std::endl;
+   std::cout << "Kernels above 100% of peak are cache resident; increase --size to measure memory bound performance" << std::endl;
+
+   //---------------------------------------------------------------------------
+   // Load baseline results if available
+   //---------------------------------------------------------------------------
+   std::map<std::string, double> baseline;
+   {
+      std::ifstream bfile(baseline_file);
+      std::string line;
+      int baseline_size = -1;
+      while(getline(bfile, line)){
+         if(line.empty() || line[0] == '#') continue;
+         std::stringstream liness(line);
+         std::string first;
+         liness >> first;
+         if(first == "size"){
+            liness >> baseline_size;
+            continue;
+         }
+         std::string kernel;
+         double ns = 0.0;
+         if(liness >> kernel >> ns) baseline[first + " " + kernel] = ns;
+      }
+      if(!baseline.empty() && baseline_size != settings.size){
+         std::cout << "Baseline " << baseline_file << " was recorded for size " << baseline_size << ", not comparing" << std::endl;
+         baseline.clear();
+      }
+   }
+   if(baseline.empty()) save_baseline = true;
+
+   //---------------------------------------------------------------------------
+   // Run each benchmark group in a separate process so that a failing solver
+   // does not prevent the remaining kernels from being measured
+   //---------------------------------------------------------------------------
+   const std::string exe = std::filesystem::absolute(argv[0]).string();
+   const std::filesystem::path root = std::filesystem::current_path();
+
+   std::vector<std::pair<std::string, vb::result_t> > all_results;
+   unsigned int regressions = 0;
+
+   for(const std::string& c : crystals){
+
+      std::cout << "---------------------------------------------------------------------" << std::endl;
+      std::cout << std::left << std::setw(32) << ("Crystal " + c) << std::right << std::setw(10) << "ns/atom"
+                << std::setw(10) << "GB/s" << std::setw(9) << "% peak" << std::setw(12) << "vs base" << std::endl;
+
+      const std::vector<std::string>& groups = c == "monolayer" ? monolayer_groups : bulk_groups;
+
+      for(const std::string& g : groups){
+
+         const std::filesystem::path dir = root / "benchmark_work" / (c + "-" + g);
+         std::filesystem::create_directories(dir);
+         std::filesystem::remove(dir / "results");
+
+         std::stringstream cmd;
+         cmd << "cd \"" << dir.string() << "\" && \"" << exe << "\" --child " << c << " " << g << " " << settings.size
+             << " " << settings.repeats << " " << settings.min_time << " > benchmark.out 2>&1";
+         const int status = std::system(cmd.str().c_str());
+
+         std::ifstream rfile(dir / "results");
+         if(status != 0 || !rfile.is_open()){
+            std::cout << std::left << std::setw(32) << g << "failed (see " << (dir / "benchmark.out").string() << ")" << std::endl;
+            continue;
+         }
+
+         std::string line;
+         while(getline(rfile, line)){
+            std::stringstream liness(line);
+            vb::result_t r;
+            std::string value;
+            liness >> r.kernel >> value;
+            if(r.kernel == "atoms") continue;
+            if(value == "unavailable"){
+               r.available = false;
+               getline(liness, r.note);
+               std::cout << std::left << std::setw(32) << r.kernel << "unavailable:" << r.note << std::endl;
+               continue;
+            }
+            r.ns_per_atom = atof(value.c_str());
+            liness >> r.bytes_per_atom;
+            getline(liness >> std::ws, r.note);
+            all_results.push_back(std::make_pair(c, r));
+
+            std::cout << std::left << std::setw(32) << r.kernel << std::right << std::fixed << std::setprecision(3) << std::setw(10) << r.ns_per_atom;
+            if(r.bytes_per_atom > 0.0){
+               const double gbs = r.bytes_per_atom/r.ns_per_atom;
+               std::cout << std::setprecision(2) << std::setw(10) << gbs << std::setprecision(1) << std::setw(9) << 100.0*gbs/bandwidth;
+            }
+            else std::cout << std::setw(10) << "-" << std::setw(9) << "-";
+
+            // compare against baseline
+            const auto base = baseline.find(c + " " + r.kernel);
+            if(base != baseline.end() && base->second > 0.0){
+               const double change = r.ns_per_atom/base->second - 1.0;
+               std::cout << std::setprecision(1) << std::setw(11) << std::showpos << 100.0*change << "%" << std::noshowpos;
+               if(change > tolerance){
+                  std::cout << "  REGRESSION";
+                  regressions++;
+               }
+            }
+            if(!r.note.empty()) std::cout << " " << r.note;
+            std::cout << std::endl;
+         }
+
+      }
+   }
+
+   //---------------------------------------------------------------------------
+   // Save baseline
+   //---------------------------------------------------------------------------
+   if(save_baseline){
+      std::ofstream bfile(baseline_file);
+      bfile << "# vampire micro-benchmark baseline: crystal kernel ns/atom\n";
+      bfile << "# memory bandwidth " << bandwidth << " GB/s\n";
+      bfile << "size " << settings.size << "\n";
+      bfile << std::setprecision(6);
+      for(const auto& cr : all_results) bfile << cr.first << " " << cr.second.kernel << " " << cr.second.ns_per_atom << "\n";
+      std::cout << "Baseline written to " << baseline_file << std::endl;
+   }
+
+   // Summary
+   std::cout << "---------------------------------------------------------------------" << std::endl;
+   if(regressions > 0){
+      std::cout << regressions << " kernels slower than baseline by more than " << 100.0*tolerance << "% : OVERALL FAIL" << std::endl;
+   }
+   else{
+      std::cout << "No kernels slower than baseline : OVERALL PASS" << std::endl;
+   }
+   std::cout << "---------------------------------------------------------------------" << std::endl;
+
+   return regressions > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+
+}
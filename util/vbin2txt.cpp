@@ -0,0 +1,120 @@
+//-----------------------------------------------------------------------------
+//
+// This source file is part of the VAMPIRE open source package under the
+// GNU GPL (version 2) licence (see licence file for details).
+//
+// (c) R F L Evans 2022. All rights reserved.
+//
+//-----------------------------------------------------------------------------
+//
+// Program to convert vampire binary output files (output.bin, grain.bin) to
+// tab separated text with a header line of column names
+//
+// g++ -O2 -std=c++11 vbin2txt.cpp -o vbin2txt
+// ./vbin2txt output.bin [output.txt]
+//
+
+// Standard Libraries
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+int main(int argc, char* argv[]){
+
+   if(argc < 2 || argc > 3){
+      std::cerr << "Usage: vbin2txt binary-file [text-file]" << std::endl;
+      return EXIT_FAILURE;
+   }
+
+   // open binary file
+   std::ifstream ifile(argv[1], std::ios::binary);
+   if(!ifile.is_open()){
+      std::cerr << "Error: unable to open binary file " << argv[1] << std::endl;
+      return EXIT_FAILURE;
+   }
+
+   //--------------------------------------------------------------------------
+   // Read schema header
+   //--------------------------------------------------------------------------
+   std::string line;
+   std::string format;
+   unsigned int num_columns = 0;
+   std::vector<std::string> names;
+
+   getline(ifile, line);
+   if(line != "# vampire binary output file"){
+      std::cerr << "Error: " << argv[1] << " is not a vampire binary output file" << std::endl;
+      return EXIT_FAILURE;
+   }
+
+   while(getline(ifile, line)){
+      if(line == "end-of-header") break;
+      std::stringstream liness(line);
+      std::string key;
+      liness >> key;
+      if(key == "format") liness >> format;
+      else if(key == "columns"){
+         liness >> num_columns;
+         names.resize(num_columns);
+         for(unsigned int i = 0; i < num_columns; i++) getline(ifile, names[i]);
+      }
+   }
+
+   if(line != "end-of-header" || format != "float64-little-endian" || num_columns == 0){
+      std::cerr << "Error: invalid header in binary file " << argv[1] << std::endl;
+      return EXIT_FAILURE;
+   }
+
+   // open output stream
+   std::ofstream ofile;
+   if(argc == 3){
+      ofile.open(argv[2]);
+      if(!ofile.is_open()){
+         std::cerr << "Error: unable to open text file " << argv[2] << " for writing" << std::endl;
+         return EXIT_FAILURE;
+      }
+   }
+   std::ostream& out = argc == 3 ? ofile : std::cout;
+
+   out << "#";
+   for(unsigned int i = 0; i < num_columns; i++) out << " " << names[i];
+   out << "\n";
+
+   //--------------------------------------------------------------------------
+   // Convert records
+   //--------------------------------------------------------------------------
+   const uint16_t test = 1;
+   const bool little_endian = *reinterpret_cast<const char*>(&test) == 1;
+
+   std::vector<char> record(8*num_columns);
+   out << std::setprecision(17);
+
+   uint64_t num_records = 0;
+   while(ifile.read(&record[0], record.size())){
+      for(unsigned int i = 0; i < num_columns; i++){
+         char bytes[8];
+         if(little_endian) std::memcpy(bytes, &record[8*i], 8);
+         else for(int b = 0; b < 8; b++) bytes[b] = record[8*i + 7 - b];
+         double value;
+         std::memcpy(&value, bytes, 8);
+         out << value << "\t";
+      }
+      out << "\n";
+      num_records++;
+   }
+
+   if(ifile.gcount() != 0){
+      std::cerr << "Warning: ignoring incomplete final record of " << ifile.gcount() << " bytes" << std::endl;
+   }
+
+   std::cerr << "Converted " << num_records << " records of " << num_columns << " columns" << std::endl;
+
+   return EXIT_SUCCESS;
+
+}